@@ -53,7 +53,7 @@ set CLANG_LIBS=-L"%SDL2_DIR%\\lib\\x64" -lSDL2 -lSDL2main -lopengl32 -lshell32
 set VC_COMPILER_FLAGS=/nologo /EHsc /Zi /MD /utf-8 /std:c++20
 set VC_LINKER_FLAGS=/link %LIBS% /incremental:no /opt:ref /subsystem:console
 
-set CLANG_COMPILER_FLAGS=-fexceptions -g --std=c++20 -finput-charset=UTF-8 -Wno-deprecated
+set CLANG_COMPILER_FLAGS=-fexceptions -g --std=c++20 -finput-charset=UTF-8 -Wno-deprecated -msse4.1
 set CLANG_LINKER_FLAGS=%CLANG_LIBS% -Wl,/opt:ref -Wl,/subsystem:console
 
 ::---------------------------------------------------------------------------
@@ -60,6 +60,10 @@ VC_COMPILER_FLAGS="/nologo /EHsc /Zi /MD /utf-8 /std:c++20"
 VC_LINKER_FLAGS="/link ${LIBS} /incremental:no /opt:ref /subsystem:console"
 
 CLANG_COMPILER_FLAGS="-fexceptions -g --std=c++20 -finput-charset=UTF-8 -DSDL_MAIN_HANDLED"
+# The MMI instructions use SSE4.1 when it is available, same as the CMake build
+case "$(uname -m)" in
+  x86_64|amd64|AMD64) CLANG_COMPILER_FLAGS="${CLANG_COMPILER_FLAGS} -msse4.1" ;;
+esac
 # CLANG_LINKER_FLAGS="${CLANG_LIBS} -Wl,/opt:ref -Wl,/subsystem:console"
 
 if [ "$OS" = "Darwin" ]; then
@@ -1,12 +1,30 @@
 #include "iop/iop.h"
 
+// The EE kernel writes its console one character at a time, it is printed a line at a time
+static char console_line[256];
+static u32  console_length = 0;
+
+static void
+flush_console_line ()
+{
+   if (!console_length) return;
+
+   fwrite(console_line, 1, console_length, stdout);
+   console_length = 0;
+}
+
 void
 output_to_console (u32 value)
 {
-   //console << (char)value;
-   //console.flush();
-   if ((char)value == '#') printf("\n");
-   printf("%c", (char)value);
+   char c = (char)value;
+   if (c == '#')
+   {
+      console_line[console_length++] = '\n';
+      flush_console_line();
+   }
+
+   console_line[console_length++] = c;
+   if (c == '\n' || console_length == ArrayCount(console_line) - 1) flush_console_line();
 }
 
 void
@@ -37,7 +55,7 @@ iop_load_8 (u32 address)
    if (BIOS.contains(address))
       return *(u8*)&_bios_memory_[address & 0x3FFFFF];
 
-   errlog("[ERROR]: Could not read iop_load_memory8() at address [{:#09x}]\n", address);
+   errtrace("[ERROR]: Could not read iop_load_memory8() at address [{:#09x}]\n", address);
 
    return r;
 }
@@ -52,7 +70,7 @@ iop_load_16 (u32 address)
    if (BIOS.contains(address))
       return *(u16*)&_bios_memory_[address & 0x3FFFFF];
 
-   errlog("[ERROR]: Could not read iop_load_memory16() at address [{:#09x}]\n", address);
+   errtrace("[ERROR]: Could not read iop_load_memory16() at address [{:#09x}]\n", address);
 
    return r;
 }
@@ -67,10 +85,8 @@ iop_load_32 (u32 address)
       case 0x1f801010: return 0;      break; // BIOS_RAM
    }
 
-   if(address == 0x1D000000) {
-      printf("READ: EE->IOP communication\n");
-      return 0;
-   }
+   if (address >= 0x1D000000 && address < 0x1D000070)
+      return sif_iop_read(address);
 
    if ((address >= 0x1F801080 && address <= 0x1F8010EF) || (address >= 0x1F801500 && address <= 0x1F80155F)) {
       return iop_dmac_read_32(address);
@@ -81,7 +97,7 @@ iop_load_32 (u32 address)
    if (BIOS.contains(address))
       return *(u32*)&_bios_memory_[address & 0x3FFFFF];
 
-   errlog("[ERROR]: Could not read iop_load_memory32() at address [{:#09x}]\n", address);
+   errtrace("[ERROR]: Could not read iop_load_memory32() at address [{:#09x}]\n", address);
 
    return r;
 }
@@ -92,13 +108,14 @@ iop_store_8 (u32 address, u8 value)
    if (PSX_RAM.contains(address))  
    {
       *(u8*)&_iop_ram_[address] = value;
+      if (_iop_code_pages_[address >> 12]) iop_cache_invalidate_page(address >> 12);
       return;
    }
 
    // @@Note: This is a write to POST2 which is unknown as to what it does?
    if (address == 0x1F802070) return;
 
-   errlog("[ERROR]: Could not write iop_store_memory8() value: [{:#09x}] to address: [{:#09x}] \n", value, address);
+   errtrace("[ERROR]: Could not write iop_store_memory8() value: [{:#09x}] to address: [{:#09x}] \n", value, address);
 }
 
 void
@@ -107,10 +124,11 @@ iop_store_16 (u32 address, u16 value)
    if (PSX_RAM.contains(address)) 
    {
       *(u16*)&_iop_ram_[address] = value;
+      if (_iop_code_pages_[address >> 12]) iop_cache_invalidate_page(address >> 12);
       return;
    }
 
-   errlog("[ERROR]: Could not write iop_store_memory16() value: [{:#09x}] to address: [{:#09x}] \n", value, address);
+   errtrace("[ERROR]: Could not write iop_store_memory16() value: [{:#09x}] to address: [{:#09x}] \n", value, address);
 }
 
 void
@@ -146,15 +164,16 @@ iop_store_32 (u32 address, u32 value)
        return;
    }
 
-   if (address == 0x1D000010) 
+   if (address >= 0x1D000000 && address < 0x1D000070) 
    {
-      printf("WRITE: IOP->EE communication\n");
+      sif_iop_write(address, value);
       return;
    }
 
    if (PSX_RAM.contains(address))  
    {
       *(u32*)&_iop_ram_[address] = value;
+      if (_iop_code_pages_[address >> 12]) iop_cache_invalidate_page(address >> 12);
       return;
    }
 
@@ -165,7 +184,129 @@ iop_store_32 (u32 address, u32 value)
       return;
    }
 
-   errlog("[ERROR]: Could not write iop_store_memory32() value: [{:#09x}] to address: [{:#09x}] \n", value, address);
+   errtrace("[ERROR]: Could not write iop_store_memory32() value: [{:#09x}] to address: [{:#09x}] \n", value, address);
+}
+
+/*******************************************
+ * MMIO Dispatch
+*******************************************/
+static inline const MMIO_Handler *
+ee_mmio_lookup (u32 address)
+{
+   if ((address & 0xFFFF0000) == 0x10000000) return _ee_mmio_handlers_[(address & 0xFFFF) >> 4];
+   if ((address & 0xFFFFE000) == 0x12000000) return _ee_mmio_handlers_[EE_MMIO_IO_BLOCKS + ((address & 0x1FFF) >> 4)];
+
+   return NULL;
+}
+
+void
+ee_mmio_register (u32 address, u32 size, const MMIO_Handler *handler)
+{
+   for (u32 offset = 0; offset < size; offset += 16)
+   {
+      u32 block = address + offset;
+      if ((block & 0xFFFF0000) == 0x10000000)
+         _ee_mmio_handlers_[(block & 0xFFFF) >> 4] = handler;
+      else if ((block & 0xFFFFE000) == 0x12000000)
+         _ee_mmio_handlers_[EE_MMIO_IO_BLOCKS + ((block & 0x1FFF) >> 4)] = handler;
+      else
+         errlog("[ERROR]: {:s} tried to register MMIO outside of the I/O region [{:#09x}]\n", handler->name, block);
+   }
+}
+
+static inline void
+ee_mmio_unhandled (u32 address, u32 width, bool is_write)
+{
+   if (is_write) _ee_mmio_stats_.unhandled_writes[width]++;
+   else          _ee_mmio_stats_.unhandled_reads[width]++;
+
+   _ee_mmio_stats_.last_unhandled_address = address;
+}
+
+static u32
+mch_read (u32 address)
+{
+   if (address == 0x1000f430)
+   {
+      //printf("Read from MCH_RICM\n");
+      return 0;
+   }
+
+   uint8_t SOP = (MCH_RICM >> 6) & 0xF;
+   uint8_t SA  = (MCH_RICM >> 16) & 0xFFF;
+   if (!SOP)
+   {
+      switch (SA)
+      {
+         case 0x21:
+            if (_rdram_sdevid < 2)
+            {
+               _rdram_sdevid++;
+               return 0x1F;
+            }
+         return 0;
+      case 0x23:
+         return 0x0D0D;
+      case 0x24:
+         return 0x0090;
+      case 0x40:
+         return MCH_RICM & 0x1F;
+      }
+   }
+
+   return 0;
+}
+
+static void
+mch_write (u32 address, u32 value)
+{
+   if (address == 0x1000f430)
+   {
+      uint8_t SA = (value >> 16) & 0xFFF;
+      uint8_t SBC = (value >> 6) & 0xF;
+
+      if (SA == 0x21 && SBC == 0x1 && ((MCH_DRD >> 7) & 1) == 0)
+         _rdram_sdevid = 0;
+
+      MCH_RICM = value & ~0x80000000;
+      return;
+   }
+
+   //printf("Writing to MCH_DRD [%#08x]\n", value);
+   MCH_DRD = value;
+}
+
+static void console_write_8  (u32, u8 value)  { output_to_console(value); }
+static void console_write_16 (u32, u16 value) { output_to_console(value); }
+static void console_write_32 (u32, u32 value) { output_to_console(value); }
+
+static u32  unknown_read_32 (u32) { return 0; }
+static void unknown_write_32 (u32, u32) {}
+
+/* @@Move @@Incomplete: The VIF does not unpack anything yet */
+static void vif0_fifo_write (u32, u128) { printf("VIF0 FIFO Write \n"); }
+static void vif1_fifo_write (u32, u128) { printf("VIF1 FIFO Write \n"); }
+
+static const MMIO_Handler console_mmio   = { .name = "Console", .write_8 = console_write_8, .write_16 = console_write_16, .write_32 = console_write_32 };
+static const MMIO_Handler mch_mmio       = { .name = "MCH", .read_32 = mch_read, .write_32 = mch_write };
+static const MMIO_Handler unknown_mmio   = { .name = "Unknown", .read_32 = unknown_read_32, .write_32 = unknown_write_32 };
+static const MMIO_Handler vif0_fifo_mmio = { .name = "VIF0 FIFO", .write_128 = vif0_fifo_write };
+static const MMIO_Handler vif1_fifo_mmio = { .name = "VIF1 FIFO", .write_128 = vif1_fifo_write };
+
+// Clears the table and claims the registers that are not owned by any subsystem
+void
+ee_mmio_reset ()
+{
+   memset(_ee_mmio_handlers_, 0, sizeof(_ee_mmio_handlers_));
+   memset(&_ee_mmio_stats_, 0, sizeof(_ee_mmio_stats_));
+
+   ee_mmio_register(0x10004000, 16, &vif0_fifo_mmio);
+   ee_mmio_register(0x10005000, 16, &vif1_fifo_mmio);
+   ee_mmio_register(0x1000f130, 16, &unknown_mmio);
+   ee_mmio_register(0x1000f180, 16, &console_mmio);
+   ee_mmio_register(0x1000f430, 32, &mch_mmio);
+   //@@Note: Not sure what is this is
+   ee_mmio_register(0x1000f500, 16, &unknown_mmio);
 }
 
 /*******************************************
@@ -182,7 +323,12 @@ ee_load_8 (u32 address)
    if (address >= 0x1FC00000 && address < 0x20000000)
       return *(u8*)&_bios_memory_[address & 0x3FFFFF];
 
-   errlog("[ERROR]: Could not read load_memory8() at address [{:#09x}]\n", address);
+   const MMIO_Handler *handler = ee_mmio_lookup(address);
+   if (handler && handler->read_8)
+      return handler->read_8(address);
+
+   ee_mmio_unhandled(address, 0, false);
+   errtrace("[ERROR]: Could not read load_memory8() at address [{:#09x}]\n", address);
 
    return r;
 }
@@ -201,10 +347,15 @@ ee_load_16 (u32 address)
    if (address >= 0x1C000000 && address < 0x1C200000)
       return *(u16*)&_iop_ram_[address & 0x1FFFFF];
 
+   const MMIO_Handler *handler = ee_mmio_lookup(address);
+   if (handler && handler->read_16)
+      return handler->read_16(address);
+
    if (address == 0x1a000006)
       return 1;
 
-   errlog("[ERROR]: Could not read load_memory16() at address [{:#09x}]\n", address);
+   ee_mmio_unhandled(address, 1, false);
+   errtrace("[ERROR]: Could not read load_memory16() at address [{:#09x}]\n", address);
 
    return r;
 }
@@ -223,132 +374,213 @@ ee_load_32 (u32 address)
    if (address >= 0x1C000000 && address < 0x1C200000)
       return *(u32*)&_iop_ram_[address & 0x1FFFFF];
 
-   switch(address)
-   {
-      case 0x10002010:
-      {
-         return ipu_read_32(address);
-      } break;
+   const MMIO_Handler *handler = ee_mmio_lookup(address);
+   if (handler && handler->read_32)
+      return handler->read_32(address);
 
-      case 0x1000f130:
-      {
-         return 0;
-      } break;
+   ee_mmio_unhandled(address, 2, false);
+   errtrace("[ERROR]: Could not read load_memory32() at address [{:#09x}]\n", address);
 
-      case 0x1000f000:
-      {
-         return intc_read(address);
-      } break;
+   return r;
+}
 
-      case 0x1000f010:
-      {
-         return intc_read(address);
-      } break;
+u64
+ee_load_64 (u32 address)
+{
+   uint64_t r = 0;
 
-      case 0x1000f430:
-      {
-         //printf("Read from MCH_RICM\n");
-         return 0;
-      } break;
+   if (address < 0x10000000)
+      return *(uint64_t*)&_rdram_[address & 0x01FFFFFF];
 
-      case 0x1000f440:
-      {
-         uint8_t SOP = (MCH_RICM >> 6) & 0xF;
-         uint8_t SA  = (MCH_RICM >> 16) & 0xFFF;
-         if (!SOP)
-         {
-            switch (SA)
-            {
-               case 0x21:
-                  if (_rdram_sdevid < 2)
-                  {
-                     _rdram_sdevid++;
-                     return 0x1F;
-                  }
-               return 0;
-            case 0x23:
-               return 0x0D0D;
-            case 0x24:
-               return 0x0090;
-            case 0x40:
-               return MCH_RICM & 0x1F;
-            }
-         }
-      } break;
-   }
+   const MMIO_Handler *handler = ee_mmio_lookup(address);
+   if (handler && handler->read_64)
+      return handler->read_64(address);
+
+   ee_mmio_unhandled(address, 3, false);
+   // errlog("[ERROR]: Could not read load_memory64() at address [{:#09x}]\n", address);
+   return r;
+}
 
-   if (address >= 0x10008000 && address < 0x1000f590)
-      return dmac_read(address);
+u128
+ee_load_128 (u32 address)
+{
+   u128 r = {};
+   address &= ~0xF;
+
+   if (address < 0x10000000)
+      return ee_read_quad(&_rdram_[address & 0x01FFFFFF]);
+
+   if (address >= 0x1FC00000 && address < 0x20000000)
+      return ee_read_quad(&_bios_memory_[address & 0x3FFFFF]);
 
-   if ((address >= 0x10003000) && (address <= 0x100030A0))
-      return gif_read(address);
+   if (address >= 0x1C000000 && address < 0x1C200000)
+      return ee_read_quad(&_iop_ram_[address & 0x1FFFFF]);
 
-   if (address >= 0x1000F200 && address <= 0x1000F260)
-     return sif_read(address);
+   if (VU0_CODE_MEMORY.contains(address)) return ee_read_quad(&_vu0_code_memory_[address - VU0_CODE_MEMORY.start]);
+   if (VU0_DATA_MEMORY.contains(address)) return ee_read_quad(&_vu0_data_memory_[address - VU0_DATA_MEMORY.start]);
+   if (VU1_CODE_MEMORY.contains(address)) return ee_read_quad(&_vu1_code_memory_[address - VU1_CODE_MEMORY.start]);
+   if (VU1_DATA_MEMORY.contains(address)) return ee_read_quad(&_vu1_data_memory_[address - VU1_DATA_MEMORY.start]);
 
-   if (address >= 0x12000000 && address < 0x12002000)
-      return gs_read_32_priviledged(address);
+   const MMIO_Handler *handler = ee_mmio_lookup(address);
+   if (handler && handler->read_128)
+      return handler->read_128(address);
 
-   if (address >= 0x10000000 && address <= 0x10001840)
-      return timer_read(address);
+   if (handler && handler->read_64)
+   {
+      r.lo = handler->read_64(address);
+      r.hi = handler->read_64(address + 8);
+      return r;
+   }
 
-   errlog("[ERROR]: Could not read load_memory32() at address [{:#09x}]\n", address);
+   ee_mmio_unhandled(address, 4, false);
+   errtrace("[ERROR]: Could not read load_memory128() at address [{:#09x}]\n", address);
 
    return r;
 }
 
-u64
-ee_load_64 (u32 address)
+/*******************************************
+ * Memory Map
+*******************************************/
+void
+ee_map_pages (u32 address, u8 *memory, u32 size, bool writable)
 {
-   uint64_t r = 0;
+   if (!memory) return;
 
-   if (address < 0x10000000)
-      return *(uint64_t*)&_rdram_[address & 0x01FFFFFF];
+   for (u32 offset = 0; offset < size; offset += KILOBYTES(4))
+   {
+      u32 page = (address + offset) >> 12;
+      _ee_read_pages_[page]  = memory + offset;
+      _ee_write_pages_[page] = writable ? memory + offset : NULL;
+   }
+}
 
-   if (address >= 0x12000000 && address < 0x12002000)
-      return gs_read_64_priviledged(address);
+/*
+   Fills vpages with every virtual 4KB page that maps onto the RDRAM page.
+   Every 512MB segment and every RDRAM mirror alias the same physical page, plus the accelerated range
+   and whatever the TLB maps onto it.
+*/
+static u32
+ee_code_page_aliases (u32 page, u32 vpages[EE_CODE_PAGE_ALIASES])
+{
+   u32 offset = page << 12;
+   u32 count  = 0;
 
-   if (address == 0x10006000 || address == 0x10006008) 
+   for (u32 segment = 0; segment < 8; ++segment)
    {
-      gif_fifo_read(address);
-      return 0;
+      for (u32 mirror = 0; mirror < 8; ++mirror)
+         vpages[count++] = ((segment << 29) + (mirror * MEGABYTES(32)) + offset) >> 12;
    }
 
-   // errlog("[ERROR]: Could not read load_memory64() at address [{:#09x}]\n", address);
-   return r;
+   vpages[count++] = (0x30000000 + offset) >> 12;
+   count += ee_tlb_code_page_aliases(page, vpages + count);
+   return count;
 }
 
-u128 ee_load_128() 
+// @@Note: The scratchpad is owned by the EE core and gets mapped in ee_reset()
+void
+ee_map_memory ()
 {
-   u128 r = {};
-   return r;
+   memset(_ee_read_pages_,  0, sizeof(_ee_read_pages_));
+   memset(_ee_write_pages_, 0, sizeof(_ee_write_pages_));
+
+   // Every 512MB segment sees the same physical memory
+   for (u32 segment = 0; segment < 8; ++segment)
+   {
+      u32 base = segment << 29;
+      for (u32 mirror = 0; mirror < 8; ++mirror)
+         ee_map_pages(base + mirror * MEGABYTES(32), _rdram_, MEGABYTES(32), true);
+
+      ee_map_pages(base + BIOS.start,            _bios_memory_,     BIOS.size,            false);
+      ee_map_pages(base + IOP_RAM.start,         _iop_ram_,         IOP_RAM.size,         true);
+      ee_map_pages(base + VU0_CODE_MEMORY.start, _vu0_code_memory_, VU0_CODE_MEMORY.size, true);
+      ee_map_pages(base + VU0_DATA_MEMORY.start, _vu0_data_memory_, VU0_DATA_MEMORY.size, true);
+      ee_map_pages(base + VU1_CODE_MEMORY.start, _vu1_code_memory_, VU1_CODE_MEMORY.size, true);
+      ee_map_pages(base + VU1_DATA_MEMORY.start, _vu1_data_memory_, VU1_DATA_MEMORY.size, true);
+   }
+
+   // uncached and accelerated ram
+   ee_map_pages(0x30100000, _rdram_ + 0x100000, MEGABYTES(31), true);
+
+   for (u32 page = 0; page < MEGABYTES(32) / KILOBYTES(4); ++page)
+   {
+      if (_rdram_code_pages_[page]) ee_protect_code_page(page << 12);
+   }
+}
+
+// Stores to pages holding cached code have to go through ee_check_code_write()
+void
+ee_protect_code_page (u32 address)
+{
+   u32 page = (address & 0x01FFFFFF) >> 12;
+   _rdram_code_pages_[page] = 1;
+
+   u32 vpages[EE_CODE_PAGE_ALIASES];
+   u32 count = ee_code_page_aliases(page, vpages);
+
+   for (u32 i = 0; i < count; ++i)
+      _ee_write_pages_[vpages[i]] = NULL;
 }
 
 /*******************************************
  * Store Functions
 *******************************************/
+static inline void
+ee_check_code_write (u32 address)
+{
+   u32 page = (address & 0x01FFFFFF) >> 12;
+   if (_rdram_code_pages_[page])
+   {
+      _rdram_code_pages_[page] = 0;
+
+      u32 vpages[EE_CODE_PAGE_ALIASES];
+      u32 count = ee_code_page_aliases(page, vpages);
+
+      for (u32 i = 0; i < count; ++i)
+         _ee_write_pages_[vpages[i]] = _ee_read_pages_[vpages[i]];
+
+      ee_jit_invalidate_page(page);
+      ee_cache_invalidate_page(page);
+      ee_idle_invalidate_page(page);
+   }
+}
+
+// For anything that writes RDRAM without going through the store functions, like DMA transfers to memory
+void
+ee_check_code_range (u32 address, u32 size)
+{
+   if (!size) return;
+
+   u32 first   = (address & 0x01FFFFFF) >> 12;
+   u32 last    = ((address & 0x01FFFFFF) + size - 1) >> 12;
+   for (u32 page = first; page <= last; ++page)
+      ee_check_code_write(page << 12);
+}
+
 void
 ee_store_8 (u32 address, u8 value)
 {
    if (address < 0x10000000)
    {
+      ee_check_code_write(address);
       *(u8*)&_rdram_[address & 0x01FFFFFF] = value;
       return;
    }
 
-   if (address == 0x1000f180) 
+   if (address >= 0x1C000000 && address < 0x1C200000) 
    {
-      output_to_console(value);
+      *(u8*)&_iop_ram_[address & 0x1FFFFF] = value;
       return;
-   };
+   }
 
-   if (address >= 0x1C000000 && address < 0x1C200000) 
+   const MMIO_Handler *handler = ee_mmio_lookup(address);
+   if (handler && handler->write_8)
    {
-      *(u8*)&_iop_ram_[address & 0x1FFFFF] = value;
+      handler->write_8(address, value);
       return;
    }
 
-   errlog("[ERROR]: Could not write store_memory8() value: [{:#09x}] to address: [{:#09x}] \n", value, address);
+   ee_mmio_unhandled(address, 0, true);
+   errtrace("[ERROR]: Could not write store_memory8() value: [{:#09x}] to address: [{:#09x}] \n", value, address);
 }
 
 void
@@ -356,155 +588,68 @@ ee_store_16 (u32 address, u16 value)
 {
    if (address < 0x10000000) 
    {
+      ee_check_code_write(address);
       *(u16*)&_rdram_[address & 0x01FFFFFF] = value;
       return;
    }
 
-   if (address == 0x1000f180) 
+   if (address >= 0x1C000000 && address < 0x1C200000) 
    {
-      output_to_console(value);
+      *(u16*)&_iop_ram_[address & 0x1FFFFF] = value;
       return;
-   };
+   }
 
-   if (address >= 0x1C000000 && address < 0x1C200000) 
+   const MMIO_Handler *handler = ee_mmio_lookup(address);
+   if (handler && handler->write_16)
    {
-      *(u16*)&_iop_ram_[address & 0x1FFFFF] = value;
+      handler->write_16(address, value);
       return;
    }
 
-   errlog("[ERROR]: Could not write store_memory16() value: [{:#09x}] to address: [{:#09x}] \n", value, address);
+   ee_mmio_unhandled(address, 1, true);
+   errtrace("[ERROR]: Could not write store_memory16() value: [{:#09x}] to address: [{:#09x}] \n", value, address);
 }
 
 void
 ee_store_32 (u32 address, u32 value)
 {
-
-    if (address < 0x10000000)
-    {
-        *(u32*)&_rdram_[address & 0x01FFFFFF] = value;
-        return;
-    }
-
-    switch (address)
-    {
-        case 0x10002000:
-        {
-            ipu_write_32(address, value);
-            return;
-        } break;
-
-        case 0x10002010:
-        {
-            ipu_write_32(address, value);
-            return;
-        } break;
-
-        case 0x1000f180:
-        {
-            output_to_console(value);
-            return;
-        } break;
-
-        case 0x1000f000:
-        {
-            intc_write(address, value);
-            return;
-        } break;
-
-        case 0x1000f010:
-        {
-            intc_write(address, value);
-            return;
-        } break;
-
-        case 0x1000f430:
-        {
-            uint8_t SA = (value >> 16) & 0xFFF;
-            uint8_t SBC = (value >> 6) & 0xF;
-
-            if (SA == 0x21 && SBC == 0x1 && ((MCH_DRD >> 7) & 1) == 0)
-                _rdram_sdevid = 0;
-
-            MCH_RICM = value & ~0x80000000;
-            return;
-        } break;
-
-        case 0x1000f440:
-        {
-           //printf("Writing to MCH_DRD [%#08x]\n", value);
-            MCH_DRD = value;
-            return;
-        } break;
-
-        return;
-    }
-
-   if (address >= 0x10008000 && address < 0x1000f000) 
-   {
-      dmac_write(address, value);
-      return;
-   }
-
-   if ((address >= 0x10003000) && (address <= 0x100030A0)) 
-   {
-      gif_write(address, value);
-      return;
-   }
-
-   //@@Note: Not sure what is this is
-   if (address == 0x1000f500) return;
-
-   if (address >= 0x1000F200 && address <= 0x1000F260) 
-   {
-      sif_write(address, value);
-      return;
-   }
-
-   if (address >= 0x12000000 && address < 0x12002000) 
+   if (address < 0x10000000)
    {
-      gs_write_32_priviledged(address, value);
+      ee_check_code_write(address);
+      *(u32*)&_rdram_[address & 0x01FFFFFF] = value;
       return;
    }
 
-   if (address >= 0x10000000 && address <= 0x10001840) 
+   if (address >= 0x1C000000 && address < 0x1C200000) 
    {
-      timer_write(address, value);
+      *(u32*)&_iop_ram_[address & 0x1FFFFF] = value;
       return;
    }
 
-   if (address >= 0x1C000000 && address < 0x1C200000) 
+   const MMIO_Handler *handler = ee_mmio_lookup(address);
+   if (handler && handler->write_32)
    {
-      *(u32*)&_iop_ram_[address & 0x1FFFFF] = value;
+      handler->write_32(address, value);
       return;
    }
 
-   errlog("[ERROR]: Could not write store_memory32() value: [{:#09x}] to address: [{:#09x}] \n", value, address);
+   ee_mmio_unhandled(address, 2, true);
+   errtrace("[ERROR]: Could not write store_memory32() value: [{:#09x}] to address: [{:#09x}] \n", value, address);
 }
 
 void
 ee_store_64 (u32 address, u64 value)
 {
    if (address < 0x10000000) {
+      ee_check_code_write(address);
       *(u64*)&_rdram_[address & 0x01FFFFFF] = value;
       return;
    }
 
-   if (address >= 0x12000000 && address < 0x12002000) 
-   {
-      gs_write_64_priviledged(address, value);
-      return;
-   }
-
-   /* @@Move @@Incomplete: This is a 128 bit move this should be moved into a different function */
-   if (address == 0x10006000 || address == 0x10006008) 
-   {
-      gif_fifo_write(address);
-      return;
-   }
-
-   if (address ==  0x10007010 || address == 0x10007018) 
+   const MMIO_Handler *handler = ee_mmio_lookup(address);
+   if (handler && handler->write_64)
    {
-      ipu_fifo_write();
+      handler->write_64(address, value);
       return;
    }
 
@@ -536,21 +681,47 @@ ee_store_64 (u32 address, u64 value)
       return;
    }
 
-   /* @@Move @@Incomplete: This is a 128 bit move this should be moved into a different function */
-   if (address == 0x10004000 || address == 0x10004008) 
+   ee_mmio_unhandled(address, 3, true);
+   errtrace("[ERROR]: Could not write store_memory64() value: [{:#09x}] to address: [{:#09x}] \n", value, address);
+}
+
+void
+ee_store_128 (u32 address, u128 value)
+{
+   address &= ~0xF;
+
+   if (address < 0x10000000)
+   {
+      ee_check_code_write(address);
+      ee_write_quad(&_rdram_[address & 0x01FFFFFF], value);
+      return;
+   }
+
+   if (address >= 0x1C000000 && address < 0x1C200000)
+   {
+      ee_write_quad(&_iop_ram_[address & 0x1FFFFF], value);
+      return;
+   }
+
+   if (VU0_CODE_MEMORY.contains(address)) { ee_write_quad(&_vu0_code_memory_[address - VU0_CODE_MEMORY.start], value); return; }
+   if (VU0_DATA_MEMORY.contains(address)) { ee_write_quad(&_vu0_data_memory_[address - VU0_DATA_MEMORY.start], value); return; }
+   if (VU1_CODE_MEMORY.contains(address)) { ee_write_quad(&_vu1_code_memory_[address - VU1_CODE_MEMORY.start], value); return; }
+   if (VU1_DATA_MEMORY.contains(address)) { ee_write_quad(&_vu1_data_memory_[address - VU1_DATA_MEMORY.start], value); return; }
+
+   const MMIO_Handler *handler = ee_mmio_lookup(address);
+   if (handler && handler->write_128)
    {
-      printf("VIF0 FIFO Write \n");
+      handler->write_128(address, value);
       return;
    }
 
-   /* @@Move @@Incomplete: This is a 128 bit move this should be moved into a different function */
-   if (address == 0x10005000 || address == 0x10005008)
+   if (handler && handler->write_64)
    {
-      printf("VIF1 FIFO Write \n");
+      handler->write_64(address, value.lo);
+      handler->write_64(address + 8, value.hi);
       return;
    }
 
-   errlog("[ERROR]: Could not write store_memory64() value: [{:#09x}] to address: [{:#09x}] \n", value, address);
+   ee_mmio_unhandled(address, 4, true);
+   errtrace("[ERROR]: Could not write store_memory128() to address: [{:#09x}] \n", address);
 }
-
-void ee_store_128 (u32 address, u128 value) {}
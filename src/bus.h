@@ -43,6 +43,100 @@ static u8 *_vu1_data_memory_;
 
 static u8 *_iop_ram_;
 
+/*
+   Quadword transfers. LQ, SQ and the DMAC ignore the low 4 bits of the address and every block of
+   guest memory is at least 16 byte aligned on the host, so these always use aligned SSE moves.
+*/
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+
+static inline u128
+ee_read_quad (const u8 *memory)
+{
+   u128 value;
+   _mm_storeu_si128((__m128i *)&value, _mm_load_si128((const __m128i *)memory));
+   return value;
+}
+
+static inline void
+ee_write_quad (u8 *memory, u128 value)
+{
+   _mm_store_si128((__m128i *)memory, _mm_loadu_si128((const __m128i *)&value));
+}
+#else
+static inline u128
+ee_read_quad (const u8 *memory)
+{
+   u128 value;
+   memcpy(&value, memory, sizeof(u128));
+   return value;
+}
+
+static inline void
+ee_write_quad (u8 *memory, u128 value)
+{
+   memcpy(memory, &value, sizeof(u128));
+}
+#endif
+
+// One entry per 4KB RDRAM page, set while the page holds code translated by the EE JIT, decoded by the block cache
+// or known to the idle loop detection
+static u8 _rdram_code_pages_[MEGABYTES(32) / KILOBYTES(4)];
+
+/*
+   Host pointers for every 4KB page of the EE virtual address space. Loads and stores that hit a
+   NULL page go through ee_load_* and ee_store_*, which covers MMIO, writes to the BIOS and writes to
+   RDRAM pages that hold cached code.
+*/
+#define EE_PAGE_COUNT            (1 << 20)
+#define EE_CODE_PAGE_ALIASES     (65 + 2 * EE_TLB_ENTRIES)
+
+static u8 *_ee_read_pages_[EE_PAGE_COUNT];
+static u8 *_ee_write_pages_[EE_PAGE_COUNT];
+
+/*
+   MMIO dispatch. Every 16 byte register block of the I/O region (0x10000000) and the privileged GS
+   registers (0x12000000) has a slot, subsystems claim their blocks with ee_mmio_register() when they
+   are reset. A missing handler for the width of an access counts as unhandled.
+*/
+typedef u8   (*MMIO_Read_8)   (u32 address);
+typedef u16  (*MMIO_Read_16)  (u32 address);
+typedef u32  (*MMIO_Read_32)  (u32 address);
+typedef u64  (*MMIO_Read_64)  (u32 address);
+typedef void (*MMIO_Write_8)  (u32 address, u8 value);
+typedef void (*MMIO_Write_16) (u32 address, u16 value);
+typedef void (*MMIO_Write_32) (u32 address, u32 value);
+typedef void (*MMIO_Write_64) (u32 address, u64 value);
+typedef u128 (*MMIO_Read_128) (u32 address);
+typedef void (*MMIO_Write_128)(u32 address, u128 value);
+
+typedef struct _MMIO_Handler_ {
+   const char     *name       = NULL;
+   MMIO_Read_8    read_8      = NULL;
+   MMIO_Read_16   read_16     = NULL;
+   MMIO_Read_32   read_32     = NULL;
+   MMIO_Read_64   read_64     = NULL;
+   MMIO_Write_8   write_8     = NULL;
+   MMIO_Write_16  write_16    = NULL;
+   MMIO_Write_32  write_32    = NULL;
+   MMIO_Write_64  write_64    = NULL;
+   MMIO_Read_128  read_128    = NULL;   // Quadword accesses fall back to two 64 bit accesses when these are missing
+   MMIO_Write_128 write_128   = NULL;
+} MMIO_Handler;
+
+// Indexed by log2 of the access size in bytes
+typedef struct _MMIO_Stats_ {
+   u64 unhandled_reads[5];
+   u64 unhandled_writes[5];
+   u32 last_unhandled_address;
+} MMIO_Stats;
+
+#define EE_MMIO_IO_BLOCKS   (KILOBYTES(64) / 16)
+#define EE_MMIO_GS_BLOCKS   (KILOBYTES(8) / 16)
+
+static const MMIO_Handler *_ee_mmio_handlers_[EE_MMIO_IO_BLOCKS + EE_MMIO_GS_BLOCKS];
+static MMIO_Stats _ee_mmio_stats_;
+
 u32 MCH_RICM      = 0;
 u32 MCH_DRD       = 0;
 u8 _rdram_sdevid  = 0;
@@ -52,12 +146,21 @@ uint8_t     ee_load_8  (uint32_t address);
 uint16_t    ee_load_16 (uint32_t address);
 uint32_t    ee_load_32 (uint32_t address);
 uint64_t    ee_load_64 (uint32_t address);
-//void      ee_load_128() {return;}
+u128        ee_load_128 (uint32_t address);
 
 void        ee_store_8  (uint32_t address, uint8_t value);
 void        ee_store_16 (uint32_t address, uint16_t value);
 void        ee_store_32 (uint32_t address, uint32_t value);
 void        ee_store_64 (uint32_t address, uint64_t value);
+void        ee_store_128 (uint32_t address, u128 value);
+
+void        ee_map_pages (uint32_t address, uint8_t *memory, uint32_t size, bool writable);
+void        ee_map_memory ();
+void        ee_protect_code_page (uint32_t address);
+void        ee_check_code_range (uint32_t address, uint32_t size);
+
+void        ee_mmio_reset ();
+void        ee_mmio_register (uint32_t address, uint32_t size, const MMIO_Handler *handler);
 
 uint8_t     iop_load_8 (uint32_t address);
 uint16_t    iop_load_16 (uint32_t address);
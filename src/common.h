@@ -12,26 +12,36 @@
 
 #define ArrayCount(Array) (sizeof(Array) / sizeof((Array)[0]))
 
-// Messy system I know....
-#define DISASM 0
-#define NESSENTIAL_LOGS 1
-#define NINTERPRETER_LOGS 1
-
-#ifdef DISASM
-   #ifdef NESSENTIAL_LOGS
-      #define syslog(fmt, ...) (void)0
-   #else
-       #define syslog(...) fmt::print(__VA_ARGS__)
-   #endif
-
-   #ifdef NINTERPRETER_LOGS
-      #define intlog(fmt, ...) (void)0
-   #else
-      #define intlog(...) fmt::print(__VA_ARGS__)
-   #endif
+/*
+   Log levels, everything above MIKU_LOG_LEVEL is compiled out. Set it from the build, the default only
+   keeps errors. errtrace() and systrace() are the hot path versions of errlog() and syslog(), see trace.h
+*/
+#define LOG_LEVEL_NONE           0
+#define LOG_LEVEL_ERROR          1
+#define LOG_LEVEL_SYSTEM         2
+#define LOG_LEVEL_INTERPRETER    3
+
+#ifndef MIKU_LOG_LEVEL
+   #define MIKU_LOG_LEVEL LOG_LEVEL_ERROR
+#endif
+
+#if MIKU_LOG_LEVEL >= LOG_LEVEL_ERROR
+   #define errlog(...) fmt::print(fg(fmt::color::crimson) | fmt::emphasis::bold, __VA_ARGS__)
+#else
+   #define errlog(...) (void)0
+#endif
+
+#if MIKU_LOG_LEVEL >= LOG_LEVEL_SYSTEM
+   #define syslog(...) fmt::print(__VA_ARGS__)
+#else
+   #define syslog(...) (void)0
 #endif
 
-#define errlog(...) fmt::print(fg(fmt::color::crimson) | fmt::emphasis::bold, __VA_ARGS__)
+#if MIKU_LOG_LEVEL >= LOG_LEVEL_INTERPRETER
+   #define intlog(...) fmt::print(__VA_ARGS__)
+#else
+   #define intlog(...) (void)0
+#endif
 
 /*
 *   @@Incomplete: Create a safe malloc and free system here
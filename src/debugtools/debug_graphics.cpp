@@ -48,6 +48,7 @@ imgui_end_frame()
 
 bool view_ee_registers     = false;
 bool view_ee_timers        = false;
+bool view_ee_jit           = false;
 bool open_gpr_registers    = true;
 bool open_cop1_registers   = true;
 
@@ -117,7 +118,37 @@ imgui_render_frame(R5900_Core *ee)
                view_ee_registers = true;
             }
          }
+
+         if (ImGui::MenuItem("View EE JIT")) 
+         {
+            if (view_ee_jit == true) {
+               view_ee_jit = false;
+            } else {
+               view_ee_jit = true;
+            }
+         }
+         ImGui::Separator();
+         ImGui::EndMenu();
+      }
+
+      if (ImGui::BeginMenu("Emulation")) 
+      {
+         if (ImGui::MenuItem("EE Interpreter", NULL, ee_execution_mode == EE_MODE_INTERPRETER)) 
+            ee_execution_mode = EE_MODE_INTERPRETER;
+         if (ImGui::MenuItem("EE Cached Interpreter", NULL, ee_execution_mode == EE_MODE_CACHED_INTERPRETER)) 
+            ee_execution_mode = EE_MODE_CACHED_INTERPRETER;
+         if (ImGui::MenuItem("EE JIT", NULL, ee_execution_mode == EE_MODE_JIT)) 
+            ee_execution_mode = EE_MODE_JIT;
          ImGui::Separator();
+         if (ImGui::MenuItem("Flush EE JIT Cache")) 
+            ee_jit_flush();
+         if (ImGui::MenuItem("Flush EE Block Cache")) 
+            ee_cache_flush();
+         ImGui::Separator();
+         if (ImGui::MenuItem("Skip EE Idle Loops", NULL, ee_idle.enabled)) 
+            ee_idle.enabled = !ee_idle.enabled;
+         if (ImGui::MenuItem("Strict EE Float Accuracy", NULL, cop1_float_mode == COP1_FLOAT_STRICT)) 
+            cop1_float_mode = cop1_float_mode == COP1_FLOAT_STRICT ? COP1_FLOAT_FAST : COP1_FLOAT_STRICT;
          ImGui::EndMenu();
       }
    }
@@ -209,6 +240,69 @@ imgui_render_frame(R5900_Core *ee)
       ImGui::End();
    }
 
+   if (view_ee_jit == true)
+   {
+      ImGui::Begin("EE JIT");
+      {
+         EE_JIT_Stats stats = ee_jit_get_stats();
+         const char *backend = "Interpreter";
+         if (ee_execution_mode == EE_MODE_JIT)                 backend = "JIT";
+         if (ee_execution_mode == EE_MODE_CACHED_INTERPRETER)  backend = "Cached Interpreter";
+
+         ImGui::Text("%s: [%s] \n", "Backend", backend);
+         ImGui::Separator();
+         ImGui::Text("%s: [%llu] \n", "Blocks compiled",        stats.blocks_compiled);
+         ImGui::Text("%s: [%llu] \n", "Block entries",          stats.block_entries);
+         ImGui::Text("%s: [%llu] \n", "Native instructions",    stats.native_instructions);
+         ImGui::Text("%s: [%llu] \n", "Fallback instructions",  stats.fallback_instructions);
+         ImGui::Text("%s: [%llu] \n", "Fastmem loads",          stats.fastmem_loads);
+         ImGui::Text("%s: [%llu] \n", "Fastmem faults",         ee_vmem.faults);
+         ImGui::Text("%s: [%llu] \n", "Slow loads",             stats.slow_loads);
+         ImGui::Text("%s: [%llu] \n", "Pages invalidated",      stats.pages_invalidated);
+         ImGui::Text("%s: [%llu] \n", "Cache flushes",          stats.cache_flushes);
+         ImGui::Text("%s: [%u KB] \n", "Code buffer used",      stats.code_bytes_used / 1024);
+
+         EE_Cache_Stats cache_stats = ee_cache_get_stats();
+         ImGui::Separator();
+         ImGui::Text("%s: [%llu] \n", "Blocks decoded",         cache_stats.blocks_decoded);
+         ImGui::Text("%s: [%llu] \n", "Block runs",             cache_stats.block_runs);
+         ImGui::Text("%s: [%u] \n",   "Blocks alive",           cache_stats.blocks_alive);
+         ImGui::Text("%s: [%llu] \n", "Pages invalidated",      cache_stats.pages_invalidated);
+
+         GS_Raster_Stats raster_stats = gs_raster_get_stats();
+         ImGui::Separator();
+         ImGui::Text("%s: [%u] \n",   "GS raster threads",      gs_raster_binner.thread_count);
+         ImGui::Text("%s: [%llu] \n", "GS triangles",           raster_stats.triangles);
+         ImGui::Text("%s: [%llu] \n", "GS raster flushes",      raster_stats.flushes);
+         ImGui::Text("%s: [%llu] \n", "GS aliased flushes",     raster_stats.aliased_flushes);
+         ImGui::Text("%s: [%llu] \n", "GS tiles covered",       raster_stats.tiles_covered);
+         ImGui::Text("%s: [%llu] \n", "GS tiles partial",       raster_stats.tiles_partial);
+         ImGui::Text("%s: [%llu] \n", "GS tiles rejected",      raster_stats.tiles_rejected);
+         ImGui::Text("%s: [%llu] \n", "GS pixels",              raster_stats.pixels);
+         ImGui::Separator();
+         ImGui::Text("%s: [%llu] \n", "Scheduler cycles",       scheduler.cycles);
+         ImGui::Text("%s: [%llu] \n", "Events dispatched",      scheduler.events_dispatched);
+         for (u32 i = 0; i < scheduler.heap_size; ++i)
+         {
+            Scheduler_Event *event = &scheduler.events[scheduler.heap[i]];
+            ImGui::Text("%s: [%llu] \n", event->name, event->timestamp - scheduler.cycles);
+         }
+
+         ImGui::Separator();
+         ImGui::Text("%s: [%u] \n",   "Idle loop sites",         ee_idle.site_count);
+         ImGui::Text("%s: [%llu] \n", "Idle loop sites dropped", ee_idle.dropped);
+         for (u32 i = 0; i < EE_IDLE_MAX_SITES; ++i)
+         {
+            EE_Idle_Site *site = &ee_idle.sites[i];
+            if (site->state != EE_IDLE_SITE_LOOP || !site->length) continue;
+
+            ImGui::Text("Idle loop [%08x] [%u] instructions: [%llu] skips [%llu] cycles \n", site->head, site->length,
+                        site->skips, site->cycles_skipped);
+         }
+      }
+      ImGui::End();
+   }
+
    imgui_end_frame();
 }
 
@@ -9,11 +9,48 @@
 DMAC dmac = {};
 const int stop_dma_transfer = ~0x100;
 
+// @@Note: The DMAC runs at half the EE clock, a burst moves this many quadwords before the EE runs again
+#define DMAC_BURST_QUADWORDS 64
+
+static Event_Handle dmac_transfer_event = -1;
+
+static inline bool
+dmac_transfer_active ()
+{
+   return dmac.control.enable && dmac.channels[2].control.start;
+}
+
+// Only schedules the next burst while a channel is running so an idle DMAC costs nothing
+static void
+dmac_schedule_transfer ()
+{
+   if (dmac_transfer_active() && !scheduler_is_scheduled(dmac_transfer_event))
+      scheduler_schedule(dmac_transfer_event, DMAC_BURST_QUADWORDS * 2);
+}
+
+static void
+dmac_transfer_callback (u64, u64 cycles_late)
+{
+   u64 steps = DMAC_BURST_QUADWORDS + cycles_late / 2;
+   for (u64 done = 0; done < steps && dmac_transfer_active();)
+      done += dmac_cycle((u32)std::min<u64>(steps - done, UINT32_MAX));
+
+   dmac_schedule_transfer();
+}
+
+static const MMIO_Handler dmac_mmio = { .name = "DMAC", .read_32 = dmac_read, .write_32 = dmac_write };
+
 void
 dmac_reset ()
 {
    printf("Resetting DMAC Controller\n");
 
+   ee_mmio_register(0x10008000, 0x7000, &dmac_mmio);
+   ee_mmio_register(D_ENABLER,  16,     &dmac_mmio);
+   ee_mmio_register(D_ENABLEW,  16,     &dmac_mmio);
+
+   dmac_transfer_event = scheduler_register_event("DMAC Transfer", dmac_transfer_callback);
+
    dmac.control.enable = true;
    for (int i = 0; i < DMAC_CHANNEL_COUNT; ++i) 
    {
@@ -29,6 +66,19 @@ dmac_reset ()
    }
 }
 
+// INT1 is raised while any channel, stall or MFIFO empty interrupt is both set and unmasked in D_STAT
+static void
+dmac_update_interrupt ()
+{
+   bool int1 = (dmac.interrupt_status.stall_status     && dmac.interrupt_status.stall_mask) ||
+               (dmac.interrupt_status.mem_empty_status && dmac.interrupt_status.mem_empty_mask);
+
+   for (int i = 0; i < DMAC_CHANNEL_COUNT; ++i)
+      int1 |= dmac.interrupt_status.channel_status[i] && dmac.interrupt_status.channel_mask[i];
+
+   ee_set_interrupt_line(EE_INTERRUPT_INT1, int1);
+}
+
 // @Incomplete: This only works for GIF channel aswell as normal and interleave transfer mode
 static void
 end_of_transfer()
@@ -39,8 +89,7 @@ end_of_transfer()
       dmac.channels[2].control.value &= stop_dma_transfer;
 
       dmac.interrupt_status.channel_status[2] = true;
-      bool int1 = (dmac.interrupt_status.channel_status[2] & dmac.interrupt_status.channel_mask[2]) != 0;
-      check_interrupt(int1, false, true);
+      dmac_update_interrupt();
       syslog("End of transfer\n");
    }
 }
@@ -168,18 +217,50 @@ source_chain_mode()
    syslog("New Address: [{:#08x}]\n", gif_channel->address);
 }
 
-void
-dmac_cycle ()
+// Returns the quadwords moved, a tag or the end of the transfer counts as one
+u32
+dmac_cycle (u32 budget)
 {
-   u128 data = {};
-
-   if (!dmac.control.enable) return;
-   if (!dmac.channels[2].control.start) return;
+   if (!dmac.control.enable) return 1;
+   if (!dmac.channels[2].control.start) return 1;
 
    if (dmac.channels[2].quadword_count.quadwords) {
-      data.lo = ee_load_64(dmac.channels[2].address);
-      data.hi = ee_load_64(dmac.channels[2].address + 8);
+      // Runs to and from RDRAM never go past the end of it
+      u32 address = dmac.channels[2].address;
+      u32 offset  = address & 0x01FFFFF0;
+      u32 run     = std::min({ budget, (u32)dmac.channels[2].quadword_count.quadwords, (MEGABYTES(32) - offset) / 16 });
+
+      // With BUSDIR set the GIF sends Local => Host data the other way, straight into RDRAM
+      if (dmac.channels[2].control.dir == 0 && gs_bus_to_host())
+      {
+         u32 moved = 1;
+         if (address < 0x10000000)
+         {
+            // Code on those pages is stale the same as after a store
+            ee_check_code_range(offset, run * 16);
+            moved = gif_readback(&_rdram_[offset], run);
+         }
+         else
+            ee_store_128(address, gif_fifo_read(0x10006000));
+
+         dmac.channels[2].address += moved * 16;
+         dmac.channels[2].quadword_count.quadwords -= moved;
+         return moved;
+      }
+
+      // IMAGE data straight out of RDRAM goes to the GIF a run at a time
+      if (address < 0x10000000)
+      {
+         u32 taken   = gif_process_image(&_rdram_[offset], run);
+         if (taken)
+         {
+            dmac.channels[2].address += taken * 16;
+            dmac.channels[2].quadword_count.quadwords -= taken;
+            return taken;
+         }
+      }
 
+      u128 data = ee_load_128(dmac.channels[2].address);
       gif_process_path3(data);
 
       dmac.channels[2].address += 16;
@@ -197,6 +278,7 @@ dmac_cycle ()
          source_chain_mode();
       }
    }
+   return 1;
 }
 
 static inline void
@@ -339,6 +421,7 @@ dmac_write (u32 address, u32 value)
          dmac.interrupt_status.stall_mask          = (value >> 29) & 0x1;
          dmac.interrupt_status.mem_empty_mask      = (value >> 30) & 0x1;
          //dmac.interrupt_status.value               = value;
+         dmac_update_interrupt();
          syslog("DMAC_WRITE: to D_STAT value: [{:#08x}]\n", value);
       } break;
 
@@ -391,7 +474,7 @@ dmac_write (u32 address, u32 value)
       #if 0
       default:
       {
-         errlog("[ERROR]Unhandled Write32 to DMAC addr: [{:#08x}] value: [{:#08x}]\n", address, value);
+         errtrace("[ERROR]Unhandled Write32 to DMAC addr: [{:#08x}] value: [{:#08x}]\n", address, value);
       } break;
       #endif
    }
@@ -467,10 +550,12 @@ dmac_write (u32 address, u32 value)
 #if 0
       default:
       {
-         printf("Unhandled Write32 to DMAC addr: [{:#08x}] value: [{:#08x}]\n", address, value);
+         errtrace("Unhandled Write32 to DMAC addr: [{:#08x}] value: [{:#08x}]\n", address, value);
       } break;
 #endif
    }
+
+   dmac_schedule_transfer();
    return;
 }
 
@@ -545,7 +630,7 @@ dmac_read (u32 address)
       #if 0
       default:
       {
-         printf("Unhandled Read32 to DMAC [{:#08x}]\n", address);
+         errtrace("Unhandled Read32 to DMAC [{:#08x}]\n", address);
       } break;
       #endif
       }
@@ -616,7 +701,7 @@ dmac_read (u32 address)
       #if 0
       default:
       {
-         printf("Unhandled Read32 to DMAC [{:#08x}]\n", address);
+         errtrace("Unhandled Read32 to DMAC [{:#08x}]\n", address);
       } break;
       #endif
    }
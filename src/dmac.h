@@ -192,6 +192,6 @@ typedef struct _DMAController_ {
 void    dmac_reset();
 void    dmac_write(u32 address, u32 value);
 u32     dmac_read(u32 address);
-void    dmac_cycle();
+u32     dmac_cycle(u32 budget);
 
 #endif
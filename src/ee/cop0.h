@@ -140,14 +140,4 @@ get_exception(ExceptionVectors vector, ExceptionCodes code)
 
 static u32 handle_exception_level_1 (COP0_Registers *cop0, Exception *exc, unsigned int current_pc, bool is_branching);
 
-/*
-inline void
-cop0_timer_compare_check(_R5900Core_ *ee)
-{
-    bool are_equal = ee->cop0.regs[9] == ee->cop0.regs[11];
-    if (are_equal) {
-        ee->cop0.cause.timer_pending = 1;
-        ee->cop0.status.IM_7 = 1;
-    }
-}*/
 #endif
\ No newline at end of file
@@ -16,6 +16,15 @@ enum Instruction_Type
 	W_INSTR = 0x14,
 };
 
+#define COP1_FD(instruction) (((instruction) >> 6)  & 0x1F)
+#define COP1_FS(instruction) (((instruction) >> 11) & 0x1F)
+#define COP1_FT(instruction) (((instruction) >> 16) & 0x1F)
+
+#define FLOAT_SIGN           0x80000000
+#define FLOAT_MAX            0x7FFFFFFF
+#define FLOAT_EXPONENT(x)    (((x) >> 23) & 0xFF)
+#define FLOAT_MANTISSA(x)    (((x) & 0x7FFFFF) | 0x800000)
+
 f32
 dump_cop1_register(int reg_index)
 {
@@ -30,24 +39,546 @@ cop1_reset()
 	cop1.fcr0 = 0x2e30;
 }
 
-static f32
-convert (u32 index)
-{
-	return *(f32*)&cop1.fpr[index].u;
-}
-
 void
 cop1_setFPR (u32 index, u32 data)
 {
 	cop1.fpr[index].u = data;
 }
 
-f32
+u32
 cop1_getFPR (u32 index)
 {
 	return cop1.fpr[index].u;
 }
 
+/*******************************************
+ * Reference Arithmetic
+*******************************************/
+/*
+   Software versions of the FPU arithmetic that work on the register bits. Exponent 255 is a normal
+   exponent, zero and denormal operands are zero, results are truncated to 24 bits and clamp to the
+   largest value on overflow and to zero on underflow.
+   @@Incomplete: The real adder keeps fewer guard bits and the multiplier is off by one in a few cases,
+   this truncates the exact result.
+*/
+// Builds the float closest to zero from value * 2^scale
+static u32
+float_truncate (u32 sign, s32 scale, u64 value, u32 *flags)
+{
+	s32 top       = (s32)std::bit_width(value) - 1;
+	s32 exponent  = scale + top + 127;
+	u32 mantissa  = (u32)(top >= 23 ? value >> (top - 23) : value << (23 - top));
+
+	if (exponent > 255)
+	{
+		*flags |= COP1_FLAG_O;
+		return sign | FLOAT_MAX;
+	}
+
+	if (exponent < 1)
+	{
+		*flags |= COP1_FLAG_U;
+		return sign;
+	}
+
+	return sign | ((u32)exponent << 23) | (mantissa & 0x7FFFFF);
+}
+
+static u32
+float_add (u32 a, u32 b, u32 *flags)
+{
+	if (FLOAT_EXPONENT(a) == 0 && FLOAT_EXPONENT(b) == 0) return a & b & FLOAT_SIGN;
+	if (FLOAT_EXPONENT(a) == 0) return b;
+	if (FLOAT_EXPONENT(b) == 0) return a;
+
+	if ((a & ~FLOAT_SIGN) < (b & ~FLOAT_SIGN))
+	{
+		u32 swap = a;
+		a = b;
+		b = swap;
+	}
+
+	// The bits shifted out of the smaller operand stay around as one sticky bit so the result still
+	// truncates the same way as the exact sum
+	u32 shift = FLOAT_EXPONENT(a) - FLOAT_EXPONENT(b);
+	u64 large = (u64)FLOAT_MANTISSA(a) << 32;
+	u64 small = (u64)FLOAT_MANTISSA(b) << 32;
+	if (shift >= 56)  small = 1;
+	else if (shift)   small = (small >> shift) | ((small & ((1ull << shift) - 1)) != 0);
+
+	u64 sum = ((a ^ b) & FLOAT_SIGN) ? large - small : large + small;
+	if (!sum) return 0;
+
+	return float_truncate(a & FLOAT_SIGN, (s32)FLOAT_EXPONENT(a) - 150 - 32, sum, flags);
+}
+
+static u32
+float_sub (u32 a, u32 b, u32 *flags)
+{
+	return float_add(a, b ^ FLOAT_SIGN, flags);
+}
+
+static u32
+float_mul (u32 a, u32 b, u32 *flags)
+{
+	u32 sign = (a ^ b) & FLOAT_SIGN;
+	if (FLOAT_EXPONENT(a) == 0 || FLOAT_EXPONENT(b) == 0) return sign;
+
+	u64 product = (u64)FLOAT_MANTISSA(a) * FLOAT_MANTISSA(b);
+	return float_truncate(sign, (s32)FLOAT_EXPONENT(a) + (s32)FLOAT_EXPONENT(b) - 300, product, flags);
+}
+
+static u32
+float_div (u32 a, u32 b, u32 *flags)
+{
+	u32 sign = (a ^ b) & FLOAT_SIGN;
+	if (FLOAT_EXPONENT(b) == 0)
+	{
+		// 0/0 raises I, anything else over zero raises D and both give the largest value
+		*flags |= FLOAT_EXPONENT(a) == 0 ? COP1_FLAG_I : COP1_FLAG_D;
+		return sign | FLOAT_MAX;
+	}
+
+	if (FLOAT_EXPONENT(a) == 0) return sign;
+
+	u64 quotient = ((u64)FLOAT_MANTISSA(a) << 40) / FLOAT_MANTISSA(b);
+	return float_truncate(sign, (s32)FLOAT_EXPONENT(a) - (s32)FLOAT_EXPONENT(b) - 40, quotient, flags);
+}
+
+static u64
+float_isqrt (u64 value)
+{
+	u64 root = 0;
+	u64 bit  = 1ull << 62;
+	while (bit > value) bit >>= 2;
+
+	while (bit)
+	{
+		if (value >= root + bit)
+		{
+			value -= root + bit;
+			root   = (root >> 1) + bit;
+		}
+		else
+		{
+			root >>= 1;
+		}
+		bit >>= 2;
+	}
+
+	return root;
+}
+
+static u32
+float_sqrt (u32 a, u32 *flags)
+{
+	if (FLOAT_EXPONENT(a) == 0) return a & FLOAT_SIGN;
+
+	// Negative values raise I and give the root of the magnitude
+	if (a & FLOAT_SIGN) *flags |= COP1_FLAG_I;
+
+	s32 exponent = (s32)FLOAT_EXPONENT(a) - 127;
+	u64 mantissa = FLOAT_MANTISSA(a);
+	if (exponent & 1)
+	{
+		mantissa <<= 1;
+		exponent  -= 1;
+	}
+
+	return float_truncate(0, exponent / 2 - 24, float_isqrt(mantissa << 25), flags);
+}
+
+static u32
+float_cvt_s_w (u32 word)
+{
+	s32 value = (s32)word;
+	if (!value) return 0;
+
+	u32 flags = 0;
+	u64 magnitude = value < 0 ? (u64)-(s64)value : (u64)value;
+	return float_truncate(value < 0 ? FLOAT_SIGN : 0, 0, magnitude, &flags);
+}
+
+static u32
+float_cvt_w_s (u32 a)
+{
+	u32 exponent = FLOAT_EXPONENT(a);
+	if (exponent < 127) return 0;
+	if (exponent >= 158) return (a & FLOAT_SIGN) ? 0x80000000 : 0x7FFFFFFF;
+
+	u32 mantissa  = FLOAT_MANTISSA(a);
+	u32 value     = exponent >= 150 ? mantissa << (exponent - 150) : mantissa >> (150 - exponent);
+	return (a & FLOAT_SIGN) ? (u32)-(s32)value : value;
+}
+
+// Zero and denormals compare equal, everything else compares by sign and magnitude
+static inline s32
+float_order (u32 a)
+{
+	if (FLOAT_EXPONENT(a) == 0) return 0;
+	return (a & FLOAT_SIGN) ? -(s32)(a & ~FLOAT_SIGN) : (s32)a;
+}
+
+/*******************************************
+ * Host Arithmetic
+*******************************************/
+#if COP1_SSE
+#define COP1_MXCSR_DAZ           (1 << 6)
+#define COP1_MXCSR_ROUND_MASK    (3 << 13)
+#define COP1_MXCSR_ROUND_ZERO    (3 << 13)
+#define COP1_MXCSR_FTZ           (1 << 15)
+
+// Returns the host mode for cop1_host_leave()
+static inline u32
+cop1_host_enter ()
+{
+	u32 csr = _mm_getcsr();
+	_mm_setcsr((csr & ~COP1_MXCSR_ROUND_MASK) | COP1_MXCSR_ROUND_ZERO | COP1_MXCSR_DAZ | COP1_MXCSR_FTZ);
+	return csr;
+}
+
+static inline void
+cop1_host_leave (u32 csr)
+{
+	_mm_setcsr(csr);
+}
+
+static inline __m128
+host_float (u32 a)
+{
+	return _mm_castsi128_ps(_mm_cvtsi32_si128((s32)a));
+}
+
+static inline u32
+host_bits (__m128 a)
+{
+	return (u32)_mm_cvtsi128_si32(_mm_castps_si128(a));
+}
+
+/*
+   With round toward zero the host never overflows into infinity, it stops at its own largest value.
+   So a zero result might have underflowed and a result at the host maximum might have gone past it,
+   those two go through the reference version to get the flags and the extra exponent right. Operands
+   with exponent 255 are infinities and NaNs to the host and go there as well.
+*/
+static inline bool
+host_result_edge (u32 result)
+{
+	return FLOAT_EXPONENT(result) == 0 || (result & ~FLOAT_SIGN) == 0x7F7FFFFF;
+}
+
+static u32
+host_add (u32 a, u32 b, u32 *flags)
+{
+	if (FLOAT_EXPONENT(a) == 255 || FLOAT_EXPONENT(b) == 255) return float_add(a, b, flags);
+
+	u32 result = host_bits(_mm_add_ss(host_float(a), host_float(b)));
+	if (host_result_edge(result)) return float_add(a, b, flags);
+	return result;
+}
+
+static u32
+host_sub (u32 a, u32 b, u32 *flags)
+{
+	if (FLOAT_EXPONENT(a) == 255 || FLOAT_EXPONENT(b) == 255) return float_sub(a, b, flags);
+
+	u32 result = host_bits(_mm_sub_ss(host_float(a), host_float(b)));
+	if (host_result_edge(result)) return float_sub(a, b, flags);
+	return result;
+}
+
+static u32
+host_mul (u32 a, u32 b, u32 *flags)
+{
+	if (FLOAT_EXPONENT(a) == 255 || FLOAT_EXPONENT(b) == 255) return float_mul(a, b, flags);
+
+	u32 result = host_bits(_mm_mul_ss(host_float(a), host_float(b)));
+	if (host_result_edge(result)) return float_mul(a, b, flags);
+	return result;
+}
+
+static u32
+host_div (u32 a, u32 b, u32 *flags)
+{
+	if (FLOAT_EXPONENT(a) == 255 || FLOAT_EXPONENT(b) == 255 || FLOAT_EXPONENT(b) == 0) return float_div(a, b, flags);
+
+	u32 result = host_bits(_mm_div_ss(host_float(a), host_float(b)));
+	if (host_result_edge(result)) return float_div(a, b, flags);
+	return result;
+}
+
+// The root of a positive normal value is always in range
+static u32
+host_sqrt (u32 a, u32 *flags)
+{
+	if ((a & FLOAT_SIGN) || FLOAT_EXPONENT(a) == 0 || FLOAT_EXPONENT(a) == 255) return float_sqrt(a, flags);
+	return host_bits(_mm_sqrt_ss(host_float(a)));
+}
+
+static u32
+host_cvt_s_w (u32 word)
+{
+	return host_bits(_mm_cvtsi32_ss(_mm_setzero_ps(), (s32)word));
+}
+
+// Truncates by itself, out of range values come back as 0x80000000 and only need the positive side fixed
+static u32
+host_cvt_w_s (u32 a)
+{
+	u32 value = (u32)_mm_cvttss_si32(host_float(a));
+	if (value == 0x80000000 && !(a & FLOAT_SIGN)) return 0x7FFFFFFF;
+	return value;
+}
+#else
+#define cop1_host_enter()     0u
+#define cop1_host_leave(csr)  (void)(csr)
+
+#define host_add              float_add
+#define host_sub              float_sub
+#define host_mul              float_mul
+#define host_div              float_div
+#define host_sqrt             float_sqrt
+#define host_cvt_s_w          float_cvt_s_w
+#define host_cvt_w_s          float_cvt_w_s
+#endif
+
+#define COP1_FLOAT(function, ...) \
+	(cop1_float_mode == COP1_FLOAT_STRICT ? float_##function(__VA_ARGS__) : host_##function(__VA_ARGS__))
+
+/*******************************************
+ * Execution
+*******************************************/
+// O and U describe the last operation, their sticky copies and D and I stay set
+static inline void
+cop1_set_flags (u32 flags)
+{
+	cop1.fcr31 = (cop1.fcr31 & ~(COP1_FLAG_O | COP1_FLAG_U)) | flags | COP1_STICKY(flags);
+}
+
+static u32
+cop1_rsqrt (u32 a, u32 b, u32 *flags)
+{
+	if (FLOAT_EXPONENT(b) == 0)
+	{
+		*flags |= COP1_FLAG_D;
+		return ((a ^ b) & FLOAT_SIGN) | FLOAT_MAX;
+	}
+
+	u32 root = COP1_FLOAT(sqrt, b, flags);
+	return COP1_FLOAT(div, a, root, flags);
+}
+
+// The product is rounded and clamped on its own before it goes into the accumulator
+static u32
+cop1_madd (u32 acc, u32 a, u32 b, u32 *flags)
+{
+	u32 product = COP1_FLOAT(mul, a, b, flags);
+	return COP1_FLOAT(add, acc, product, flags);
+}
+
+static u32
+cop1_msub (u32 acc, u32 a, u32 b, u32 *flags)
+{
+	u32 product = COP1_FLOAT(mul, a, b, flags);
+	return COP1_FLOAT(sub, acc, product, flags);
+}
+
+// Moves, compares and the sign operations are integer work and run outside the host rounding mode
+static inline bool
+cop1_uses_host (u32 format, u32 function)
+{
+	if (format == W_INSTR) return function == 0x20;
+	return function <= 0x04 || function == 0x16 || (function >= 0x18 && function <= 0x1F);
+}
+
+static void
+cop1_execute_s (u32 instruction)
+{
+	u32 fd      = COP1_FD(instruction);
+	u32 fs      = COP1_FS(instruction);
+	u32 ft      = COP1_FT(instruction);
+	u32 a       = cop1.fpr[fs].u;
+	u32 b       = cop1.fpr[ft].u;
+	u32 flags   = 0;
+
+	switch (instruction & 0x3F)
+	{
+		case 0x00:
+		{
+			cop1.fpr[fd].u = COP1_FLOAT(add, a, b, &flags);
+			cop1_set_flags(flags);
+			// intlog("ADD.S [{:d}] [{:d}] [{:d}] \n", fd, fs, ft);
+		} break;
+
+		case 0x01:
+		{
+			cop1.fpr[fd].u = COP1_FLOAT(sub, a, b, &flags);
+			cop1_set_flags(flags);
+			// intlog("SUB.S [{:d}] [{:d}] [{:d}] \n", fd, fs, ft);
+		} break;
+
+		case 0x02:
+		{
+			cop1.fpr[fd].u = COP1_FLOAT(mul, a, b, &flags);
+			cop1_set_flags(flags);
+			// intlog("MUL.S [{:d}] [{:d}] [{:d}] \n", fd, fs, ft);
+		} break;
+
+		case 0x03:
+		{
+			cop1.fpr[fd].u = COP1_FLOAT(div, a, b, &flags);
+			cop1_set_flags(flags);
+			// intlog("DIV.S [{:d}] [{:d}] [{:d}] \n", fd, fs, ft);
+		} break;
+
+		case 0x04:
+		{
+			cop1.fpr[fd].u = COP1_FLOAT(sqrt, b, &flags);
+			cop1_set_flags(flags);
+			// intlog("SQRT.S [{:d}] [{:d}] \n", fd, ft);
+		} break;
+
+		case 0x05:
+		{
+			cop1.fpr[fd].u = a & ~FLOAT_SIGN;
+			cop1_set_flags(0);
+			// intlog("ABS.S [{:d}] [{:d}] \n", fd, fs);
+		} break;
+
+		case 0x06:
+		{
+			cop1.fpr[fd].u = a;
+			// intlog("MOV.S [{:d}] [{:d}]\n", fd, fs);
+		} break;
+
+		case 0x07:
+		{
+			cop1.fpr[fd].u = a ^ FLOAT_SIGN;
+			cop1_set_flags(0);
+			// intlog("NEG.S [{:d}] [{:d}] \n", fd, fs);
+		} break;
+
+		case 0x16:
+		{
+			cop1.fpr[fd].u = cop1_rsqrt(a, b, &flags);
+			cop1_set_flags(flags);
+			// intlog("RSQRT.S [{:d}] [{:d}] [{:d}] \n", fd, fs, ft);
+		} break;
+
+		case 0x18:
+		{
+			cop1.ACC.u = COP1_FLOAT(add, a, b, &flags);
+			cop1_set_flags(flags);
+			// intlog("ADDA.S [{:d}] [{:d}] \n", fs, ft);
+		} break;
+
+		case 0x19:
+		{
+			cop1.ACC.u = COP1_FLOAT(sub, a, b, &flags);
+			cop1_set_flags(flags);
+			// intlog("SUBA.S [{:d}] [{:d}] \n", fs, ft);
+		} break;
+
+		case 0x1A:
+		{
+			cop1.ACC.u = COP1_FLOAT(mul, a, b, &flags);
+			cop1_set_flags(flags);
+			// intlog("MULA.S [{:d}] [{:d}] \n", fs, ft);
+		} break;
+
+		case 0x1C:
+		{
+			cop1.fpr[fd].u = cop1_madd(cop1.ACC.u, a, b, &flags);
+			cop1_set_flags(flags);
+			// intlog("MADD.S [{:d}] [{:d}] [{:d}] \n", fd, fs, ft);
+		} break;
+
+		case 0x1D:
+		{
+			cop1.fpr[fd].u = cop1_msub(cop1.ACC.u, a, b, &flags);
+			cop1_set_flags(flags);
+			// intlog("MSUB.S [{:d}] [{:d}] [{:d}] \n", fd, fs, ft);
+		} break;
+
+		case 0x1E:
+		{
+			cop1.ACC.u = cop1_madd(cop1.ACC.u, a, b, &flags);
+			cop1_set_flags(flags);
+			// intlog("MADDA.S [{:d}] [{:d}] \n", fs, ft);
+		} break;
+
+		case 0x1F:
+		{
+			cop1.ACC.u = cop1_msub(cop1.ACC.u, a, b, &flags);
+			cop1_set_flags(flags);
+			// intlog("MSUBA.S [{:d}] [{:d}] \n", fs, ft);
+		} break;
+
+		case 0x24:
+		{
+			cop1.fpr[fd].u = COP1_FLOAT(cvt_w_s, a);
+			// intlog("CVT.W.S [{:d}] [{:d}] \n", fd, fs);
+		} break;
+
+		case 0x28:
+		{
+			cop1.fpr[fd].u = float_order(a) >= float_order(b) ? a : b;
+			cop1_set_flags(0);
+			// intlog("MAX.S [{:d}] [{:d}] [{:d}] \n", fd, fs, ft);
+		} break;
+
+		case 0x29:
+		{
+			cop1.fpr[fd].u = float_order(a) <= float_order(b) ? a : b;
+			cop1_set_flags(0);
+			// intlog("MIN.S [{:d}] [{:d}] [{:d}] \n", fd, fs, ft);
+		} break;
+
+		case 0x30:
+		case 0x32:
+		case 0x34:
+		case 0x36:
+		{
+			bool condition = false;
+			switch (instruction & 0x3F)
+			{
+				case 0x32: condition = float_order(a) == float_order(b); break;
+				case 0x34: condition = float_order(a) <  float_order(b); break;
+				case 0x36: condition = float_order(a) <= float_order(b); break;
+			}
+
+			if (condition)	cop1.fcr31 |= COP1_FLAG_C;
+			else 			cop1.fcr31 &= ~COP1_FLAG_C;
+			// intlog("C.cond.S [{:d}] [{:d}] \n", fs, ft);
+		} break;
+
+		default:
+		{
+			errlog("ERROR: Could not interpret COP1 S instruction [{:#x}]\n", instruction & 0x3F);
+		} break;
+	}
+}
+
+static void
+cop1_execute_w (u32 instruction)
+{
+	switch (instruction & 0x3F)
+	{
+		case 0x20:
+		{
+			u32 fd = COP1_FD(instruction);
+			u32 fs = COP1_FS(instruction);
+			cop1.fpr[fd].u = COP1_FLOAT(cvt_s_w, cop1.fpr[fs].u);
+			// intlog("CVT.S.W [{:d}] [{:d}] \n", fd, fs);
+		} break;
+
+		default:
+		{
+			errlog("ERROR: Could not interpret COP1 W instruction [{:#x}]\n", instruction & 0x3F);
+		} break;
+	}
+}
+
 void
 cop1_decode_and_execute (R5900_Core *ee, u32 instruction)
 {
@@ -62,6 +593,15 @@ cop1_decode_and_execute (R5900_Core *ee, u32 instruction)
 			// intlog("MFC1 [{:d}] [{:d}] \n", rt, fs);
 		} break;
 
+		case 0x02:
+		{
+			u32 fs 			= (instruction >> 11) & 0x1F;
+			u32 rt 			= (instruction >> 16) & 0x1F;
+			if (fs == 0)  ee->reg.r[rt].SD[0] = (s32)cop1.fcr0;
+			if (fs == 31) ee->reg.r[rt].SD[0] = (s32)cop1.fcr31;
+			// intlog("CFC1 [{:d}] [{:d}] \n", rt, fs);
+		} break;
+
 		case 0x04:
 		{
 			u32 fs 			= (instruction >> 11) & 0x1F;
@@ -97,111 +637,168 @@ cop1_decode_and_execute (R5900_Core *ee, u32 instruction)
 		} break;
 
 		case S_INSTR:
+		case W_INSTR:
 		{
-			u16 s = instruction & 0x3F;
-			switch(s)
+			// Only the host arithmetic runs in the COP1 float mode, nothing else on the EE thread ever sees it
+			if (cop1_float_mode == COP1_FLOAT_FAST && cop1_uses_host(opcode, instruction & 0x3F))
 			{
-				case 0x02:
-				{
-					u32 fd = (instruction >> 6) & 0x1F;
-					u32 fs = (instruction >> 11) & 0x1F;
-					u32 ft = (instruction >> 16) & 0x1F;
-					f32 reg1 = convert(fs);
-					f32 reg2 = convert(ft);
+				u32 csr = cop1_host_enter();
+				if (opcode == S_INSTR)  cop1_execute_s(instruction);
+				else                    cop1_execute_w(instruction);
+				cop1_host_leave(csr);
+				return;
+			}
 
-					cop1.fpr[fd].f = reg1 * reg2;
+			if (opcode == S_INSTR)  cop1_execute_s(instruction);
+			else                    cop1_execute_w(instruction);
+		} break;
 
-					/* @@Incomplete: Add exponent overflow and undeflow */
-					// intlog("MUL.S [{:d}] [{:d}] [{:d}] \n", fd, fs, ft);
-				} break;
+		default:
+		{
+			errlog("ERROR: Could not interpret COP1 instruction [{:#x}]\n", instruction);
+		} break;
+	}
+}
 
-				case 0x03:
-				{
-					u32 fd = (instruction >> 6) & 0x1F;
-					u32 fs = (instruction >> 11) & 0x1F;
-					u32 ft = (instruction >> 16) & 0x1F;
-
-					f32 nom 	= convert(fs);
-					f32 denom 	= convert(ft);
-
-					if ((denom == 0) && nom != 0) {
-						//@@Incomplete: +maximum and -maximum
-						// Set D and SD bits
-						cop1.fcr31 |= (1 << 5);
-						cop1.fcr31 |= (1 << 16);
-					} else if ((denom == 0) && (nom == 0)) {
-						// Set I and SI bits
-						cop1.fcr31 |= (1 << 6);
-						cop1.fcr31 |= (1 << 17);
-					}
-
-					cop1.fpr[fd].f = nom / denom;
-
-					/* @@Incomplete: Add exponent overflow and undeflow */
-					// intlog("DIV.S [{:d}] [{:d}] [{:d}] \n", fd, fs, ft);
-				} break;
+/*******************************************
+ * Benchmark
+*******************************************/
+static u64 cop1_random_state = 0x2545F4914F6CDD1D;
 
-				case 0x06:
-				{
-					u32 fd = (instruction >> 6) & 0x1F;
-					u32 fs = (instruction >> 11) & 0x1F;
-					cop1.fpr[fd].f = cop1.fpr[fs].f;
+static inline u64
+cop1_random ()
+{
+	cop1_random_state ^= cop1_random_state << 13;
+	cop1_random_state ^= cop1_random_state >> 7;
+	cop1_random_state ^= cop1_random_state << 17;
+	return cop1_random_state;
+}
 
-					// intlog("MOV.S [{:d}] [{:d}]\n", fd, fs);
-				}
-				case 0x18:
-				{
-					u32 fs 		= (instruction >> 11) & 0x1F;
-					u32 ft 		= (instruction >> 16) & 0x1F;
-					f32 reg1 	= convert(fs);
-					f32 reg2 	= convert(ft);
-					cop1.ACC.f 	= reg1 + reg2;
-					// intlog("ADDA.S [{:d}] [{:d}] \n", fs, ft);
-				} break;
+// Mostly exponents where overflow, underflow and cancellation happen, with the special encodings mixed in
+static u32
+cop1_random_float ()
+{
+	static const u32 edges[] = { 0x00000000, 0x80000000, 0x00000001, 0x807FFFFF, 0x00800000, 0x3F800000,
+	                             0xBF800000, 0x7F7FFFFF, 0x7F800000, 0x7FFFFFFF, 0xFFFFFFFF, 0x4F000000 };
 
-				case 0x24:
-				{
-					u32 fd = (instruction >> 6) & 0x1F;
-					u32 fs = (instruction >> 11) & 0x1F;
-					s32 k = (s32)floor(cop1.fpr[fs].f);
-					cop1.fpr[fd].u = (u32)k;
-					// intlog("CVT.W.S [{:d}] [{:d}] \n", fd, fs);
-				} break;
+	u64 random     = cop1_random();
+	u32 sign       = (u32)(random >> 32) & FLOAT_SIGN;
+	u32 mantissa   = (u32)(random >> 8) & 0x7FFFFF;
+	u32 exponent   = 0;
 
-				default:
-				{
-					errlog("ERROR: Could not interpret COP1 S instruction [{:#x}]\n", s);
-					return;
-				} break;
-			}
-		} break;
+	switch (random & 7)
+	{
+		case 0:  return edges[(random >> 40) % (sizeof(edges) / sizeof(edges[0]))];
+		case 1:  return (u32)(random >> 16);
+		case 2:  exponent = 224 + ((random >> 40) & 31); break;
+		case 3:  exponent = (random >> 40) & 31; break;
+		default: exponent = 120 + ((random >> 40) & 15); break;
+	}
 
-		case W_INSTR:
+	return sign | (exponent << 23) | mantissa;
+}
+
+typedef struct _COP1_Benchmark_Op_ {
+	const char  *name;
+	u32         format;
+	u32         function;
+} COP1_Benchmark_Op;
+
+static const COP1_Benchmark_Op cop1_benchmark_ops[] = {
+	{ "ADD.S",   S_INSTR, 0x00 }, { "SUB.S",   S_INSTR, 0x01 }, { "MUL.S",   S_INSTR, 0x02 },
+	{ "DIV.S",   S_INSTR, 0x03 }, { "SQRT.S",  S_INSTR, 0x04 }, { "RSQRT.S", S_INSTR, 0x16 },
+	{ "ADDA.S",  S_INSTR, 0x18 }, { "SUBA.S",  S_INSTR, 0x19 }, { "MULA.S",  S_INSTR, 0x1A },
+	{ "MADD.S",  S_INSTR, 0x1C }, { "MSUB.S",  S_INSTR, 0x1D }, { "MADDA.S", S_INSTR, 0x1E },
+	{ "MSUBA.S", S_INSTR, 0x1F }, { "CVT.W.S", S_INSTR, 0x24 }, { "CVT.S.W", W_INSTR, 0x20 },
+};
+
+static f64
+cop1_time_instruction (COP1_Float_Mode mode, R5900_Core *ee, u32 instruction, u32 iterations)
+{
+	cop1_float_mode = mode;
+	cop1.fpr[2].u   = 0x3F9E0419;
+	cop1.fpr[3].u   = 0x40490FDB;
+	cop1.ACC.u      = 0x42280000;
+
+	u64 start = SDL_GetPerformanceCounter();
+	for (u32 i = 0; i < iterations; ++i)
+		cop1_decode_and_execute(ee, instruction);
+	u64 end = SDL_GetPerformanceCounter();
+
+	return (f64)(end - start) * 1e9 / (f64)SDL_GetPerformanceFrequency() / iterations;
+}
+
+/*
+   Runs every arithmetic instruction in both modes on the same random registers, the fast mode has to
+   produce the same registers and flags as the software reference, and times both. Run with
+   --cop1-benchmark, the times include the decode and the MXCSR switch around every instruction.
+*/
+void
+cop1_benchmark ()
+{
+	const u32 checks     = 1 << 18;
+	const u32 iterations = 1 << 22;
+
+	static R5900_Core ee;
+	COP1_Float_Mode mode = cop1_float_mode;
+	u32 mismatches = 0;
+
+	printf("COP1 benchmark, host %s\n", COP1_SSE ? "SSE" : "fallback to the reference");
+	printf("%-8s %12s %12s %8s\n", "", "strict ns", "fast ns", "speedup");
+
+	for (u32 i = 0; i < sizeof(cop1_benchmark_ops) / sizeof(cop1_benchmark_ops[0]); ++i)
+	{
+		const COP1_Benchmark_Op *op = &cop1_benchmark_ops[i];
+		u32 instruction = ((u32)INSTR_COP1 << 26) | (op->format << 21) | (3 << 16) | (2 << 11) | (1 << 6) | op->function;
+
+		u32 failed = 0;
+		COP1_Registers first_strict = {}, first_fast = {};
+		for (u32 check = 0; check < checks; ++check)
 		{
-			u16 w = instruction & 0x3F;
-			switch (w)
-			{
-				case 0x20:
-				{
-					u32 fd = (instruction >> 6) & 0x1F;
-					u32 fs = (instruction >> 11) & 0x1F;
-					f32 k = (f32)cop1.fpr[fs].u;
-					cop1.fpr[fd].f = k;
-					// intlog("CVT.S.W [{:d}] [{:d}] \n", fd, fs);
-				} break;
+			memset(&cop1, 0, sizeof(cop1));
+			cop1.fpr[1].u  = cop1_random_float();
+			cop1.fpr[2].u  = cop1_random_float();
+			cop1.fpr[3].u  = cop1_random_float();
+			cop1.ACC.u     = cop1_random_float();
 
-				default:
+			// Operands that cancel each other out
+			if ((cop1_random() & 15) == 0) cop1.fpr[3].u = cop1.fpr[2].u ^ (u32)(cop1_random() & FLOAT_SIGN);
+
+			COP1_Registers start = cop1;
+			cop1_float_mode = COP1_FLOAT_STRICT;
+			cop1_decode_and_execute(&ee, instruction);
+			COP1_Registers strict = cop1;
+
+			cop1 = start;
+			cop1_float_mode = COP1_FLOAT_FAST;
+			cop1_decode_and_execute(&ee, instruction);
+
+			if (memcmp(&strict, &cop1, sizeof(COP1_Registers)) != 0)
+			{
+				if (!failed)
 				{
-					errlog("ERROR: Could not interpret COP1 W instruction [{:#x}]\n", w);
-					return;
-				} break;
+					first_strict   = strict;
+					first_fast     = cop1;
+				}
+				failed++;
 			}
+		}
 
-		} break;
+		f64 strict_time = cop1_time_instruction(COP1_FLOAT_STRICT, &ee, instruction, iterations);
+		f64 fast_time   = cop1_time_instruction(COP1_FLOAT_FAST, &ee, instruction, iterations);
 
-		default:
+		printf("%-8s %12.2f %12.2f %7.2fx", op->name, strict_time, fast_time, strict_time / fast_time);
+		if (failed)
 		{
-			errlog("ERROR: Could not interpret COP1 instruction [{:#x}]\n", instruction);
-		} break;
+			printf("  MISMATCH %u/%u (strict %08x %08x %08x, fast %08x %08x %08x)", failed, checks,
+			       first_strict.fpr[1].u, first_strict.ACC.u, first_strict.fcr31, first_fast.fpr[1].u, first_fast.ACC.u, first_fast.fcr31);
+			mismatches++;
+		}
+		printf("\n");
 	}
-}
\ No newline at end of file
+
+	printf("%u COP1 instructions did not match the reference\n", mismatches);
+
+	cop1_float_mode = mode;
+	cop1_reset();
+}
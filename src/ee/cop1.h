@@ -12,23 +12,58 @@ union FPRreg {
 };
 	
 // @@Rename: Possibly rename this to FPU registers.
-union COP1_Registers {
-   struct {
-      FPRreg
-         f0, f1, f2, f3, // return values
-         f4, f5, f6, f7, f8, f9, f10, f11, // temporary registers
-         f12, f13, f14, f15, f16, f17, f18, f19, // argument registers
-         f20, f21, f22, f23, f24, f25, f26, f27, f28, f29, f30, f31; // saved registers
+struct COP1_Registers {
+   union {
+      struct {
+         FPRreg
+            f0, f1, f2, f3, // return values
+            f4, f5, f6, f7, f8, f9, f10, f11, // temporary registers
+            f12, f13, f14, f15, f16, f17, f18, f19, // argument registers
+            f20, f21, f22, f23, f24, f25, f26, f27, f28, f29, f30, f31; // saved registers
+      };
+      FPRreg fpr[32];
    };
-   FPRreg fpr[32];
    u32 fcr0; // reports implementation and revision of fpu
    u32 fcr31; // control register, stores status flags
    FPRreg ACC; /* accumulator register */
    u32 ACCflag;
 };
 
+// FCR31 flags, the sticky copy of O, U, D and I sits 11 bits lower
+#define COP1_FLAG_C        (1 << 23)
+#define COP1_FLAG_I        (1 << 17)
+#define COP1_FLAG_D        (1 << 16)
+#define COP1_FLAG_O        (1 << 15)
+#define COP1_FLAG_U        (1 << 14)
+#define COP1_STICKY(flags) (((flags) >> 11) & 0x78)
+
+/*
+   The PS2 FPU has no denormals, infinities or NaNs and rounds toward zero. The fast mode runs the
+   arithmetic on host SSE scalar ops with FTZ, DAZ and round toward zero set in the MXCSR and only hands
+   the results that could have overflowed or underflowed to the software version. The strict mode runs
+   everything in software.
+
+   The MXCSR is switched around every instruction that uses the host, so the COP1 mode never leaks into
+   anything else that runs on the EE thread.
+*/
+#if defined(__SSE2__) || defined(_M_X64)
+#define COP1_SSE 1
+#include <emmintrin.h>
+#else
+#define COP1_SSE 0
+#endif
+
+enum COP1_Float_Mode
+{
+	COP1_FLOAT_FAST,
+	COP1_FLOAT_STRICT,
+};
+
+static COP1_Float_Mode cop1_float_mode = COP1_FLOAT_FAST;
+
 void    cop1_setFPR(u32 index, u32 data);
-f32     cop1_getFPR(u32 index);
+u32     cop1_getFPR(u32 index);
 void    cop1_reset();
 void    cop1_decode_and_execute(R5900_Core *ee, u32 instruction);
+void    cop1_benchmark();
 #endif
\ No newline at end of file
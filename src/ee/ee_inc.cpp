@@ -1,4 +1,9 @@
 #include "r5900Interpreter.cpp"
+#include "r5900Tlb.cpp"
+#include "r5900Mmi.cpp"
+#include "r5900Idle.cpp"
+#include "r5900Jit.cpp"
+#include "r5900BlockCache.cpp"
 #include "cop0.cpp"
 #include "cop1.cpp"
 #include "timer.cpp"
\ No newline at end of file
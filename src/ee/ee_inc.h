@@ -1,6 +1,11 @@
 #ifndef EE_INC_H
 
 #include "r5900Interpreter.h"
+#include "r5900Tlb.h"
+#include "r5900Mmi.h"
+#include "r5900Idle.h"
+#include "r5900Jit.h"
+#include "r5900BlockCache.h"
 #include "cop0.h"
 #include "cop1.h"
 #include "timer.h"
@@ -0,0 +1,293 @@
+/*
+ * Copyright 2023 Xaviar Roach
+ * SPDX-License-Identifier: MIT
+ */
+
+#define CACHE_PAGE_COUNT  (1 << 20)
+
+// One per 4KB page of guest virtual address space that has decoded blocks in it
+typedef struct _EE_Cache_Page_ {
+   EE_Cached_Block *blocks[1024];
+} EE_Cache_Page;
+
+typedef struct _EE_Block_Cache_ {
+   EE_Cache_Page **pages;
+
+   // Invalidated blocks can still be running, so they are only freed on the next r5900_cached_cycle()
+   std::vector<EE_Cached_Block *> retired;
+
+   bool block_invalidated;
+   EE_Cache_Stats stats;
+} EE_Block_Cache;
+
+static EE_Block_Cache block_cache = {};
+
+static void
+ee_cache_nop (R5900_Core *, u32, const Instruction &) {}
+
+/*******************************************
+ * Block Decoding
+*******************************************/
+static inline EE_Cached_Block *
+cache_lookup (u32 pc)
+{
+   EE_Cache_Page *page = block_cache.pages[pc >> 12];
+   if (!page) return NULL;
+
+   return page->blocks[(pc >> 2) & 0x3FF];
+}
+
+static inline void
+cache_decode_instruction (EE_Decoded_Instruction *decoded, u32 instruction)
+{
+   decoded->handler     = (instruction == 0x00000000) ? ee_cache_nop : ee_lookup_handler(instruction);
+   decoded->instruction = instruction;
+   decoded->instr       = ee_decode(instruction);
+}
+
+static EE_Cached_Block *
+cache_decode_block (u32 pc)
+{
+   if (!ee_is_cacheable_code(pc) || (pc & 0x3)) return NULL;
+
+   EE_Decoded_Instruction decoded[EE_CACHE_MAX_BLOCK_INSTRUCTIONS];
+   u32 current  = pc;
+   u32 count    = 0;
+
+   while (count < EE_CACHE_MAX_BLOCK_INSTRUCTIONS)
+   {
+      // Blocks never cross a page so a write only has to invalidate the page it hit
+      if (count && (current & 0xFFF) == 0) break;
+
+      u32 instruction = ee_core_load_32(current);
+      if (ee_is_branch_instruction(instruction))
+      {
+         // A delay slot on the next page is picked up by r5900_cycle once the block returns
+         if ((current & 0xFFF) == 0xFFC)
+         {
+            cache_decode_instruction(&decoded[count++], instruction);
+            break;
+         }
+
+         // @Incomplete: Branches in delay slots are left to the interpreter
+         u32 delay_slot = ee_core_load_32(current + 4);
+         if (ee_is_branch_instruction(delay_slot) || count + 2 > EE_CACHE_MAX_BLOCK_INSTRUCTIONS) break;
+
+         cache_decode_instruction(&decoded[count++], instruction);
+         cache_decode_instruction(&decoded[count++], delay_slot);
+         break;
+      }
+
+      cache_decode_instruction(&decoded[count++], instruction);
+      current += 4;
+   }
+
+   if (count == 0) return NULL;
+
+   EE_Cached_Block *block = (EE_Cached_Block *)malloc(sizeof(EE_Cached_Block) + count * sizeof(EE_Decoded_Instruction));
+   block->pc            = pc;
+   block->count         = count;
+   block->idle_loop     = ee_idle_is_loop(pc);
+   block->instructions  = (EE_Decoded_Instruction *)(block + 1);
+   memcpy(block->instructions, decoded, count * sizeof(EE_Decoded_Instruction));
+
+   u32 address = ee_code_address_to_physical(pc);
+   if (address < 0x10000000) ee_protect_code_page(address);
+
+   EE_Cache_Page **page = &block_cache.pages[pc >> 12];
+   if (!*page) *page = (EE_Cache_Page *)calloc(1, sizeof(EE_Cache_Page));
+   (*page)->blocks[(pc >> 2) & 0x3FF] = block;
+
+   block_cache.stats.blocks_decoded++;
+   block_cache.stats.blocks_alive++;
+   return block;
+}
+
+/*******************************************
+ * Invalidation
+*******************************************/
+static void
+cache_invalidate_virtual_page (u32 vpage)
+{
+   EE_Cache_Page *page = block_cache.pages[vpage];
+   if (!page) return;
+
+   for (u32 i = 0; i < 1024; ++i)
+   {
+      if (page->blocks[i])
+      {
+         block_cache.retired.push_back(page->blocks[i]);
+         block_cache.stats.blocks_alive--;
+      }
+   }
+
+   free(page);
+   block_cache.pages[vpage] = NULL;
+}
+
+static void
+cache_free_retired ()
+{
+   for (EE_Cached_Block *block : block_cache.retired)
+      free(block);
+
+   block_cache.retired.clear();
+}
+
+// Called from the bus when a store hits an RDRAM page that holds decoded code
+void
+ee_cache_invalidate_page (u32 page)
+{
+   if (!block_cache.pages) return;
+
+   block_cache.block_invalidated = true;
+   block_cache.stats.pages_invalidated++;
+
+   u32 vpages[EE_CODE_PAGE_ALIASES];
+   u32 count = ee_code_page_aliases(page, vpages);
+
+   for (u32 i = 0; i < count; ++i)
+      cache_invalidate_virtual_page(vpages[i]);
+}
+
+// Called from the TLB when a virtual page gets mapped to different memory
+void
+ee_cache_invalidate_virtual_page (u32 vpage)
+{
+   if (!block_cache.pages || !block_cache.pages[vpage]) return;
+
+   block_cache.block_invalidated = true;
+   block_cache.stats.pages_invalidated++;
+   cache_invalidate_virtual_page(vpage);
+}
+
+void
+ee_cache_flush ()
+{
+   if (!block_cache.pages) return;
+
+   for (u32 i = 0; i < CACHE_PAGE_COUNT; ++i)
+      cache_invalidate_virtual_page(i);
+}
+
+void
+ee_cache_init ()
+{
+   if (block_cache.pages) return;
+
+   block_cache.pages = (EE_Cache_Page **)calloc(CACHE_PAGE_COUNT, sizeof(EE_Cache_Page *));
+}
+
+void
+ee_cache_shutdown ()
+{
+   if (!block_cache.pages) return;
+
+   ee_cache_flush();
+   cache_free_retired();
+   free(block_cache.pages);
+
+   block_cache = {};
+}
+
+/*******************************************
+ * Execution
+*******************************************/
+// Same order of operations as r5900_cycle, except the branch target is left for the next block
+static u32
+cache_run_block (R5900_Core *ee, EE_Cached_Block *block)
+{
+   u32 executed = 0;
+
+   for (u32 i = 0; i < block->count; ++i)
+   {
+      EE_Decoded_Instruction *decoded = &block->instructions[i];
+      u32 pc              = ee->pc;
+      bool in_delay_slot  = ee->is_branching;
+
+      ee->is_branching = false;
+      decoded->handler(ee, decoded->instruction, decoded->instr);
+      ee->reg.r[0].SD[0] = 0;
+      executed += 1;
+
+      if (in_delay_slot)
+      {
+         ee->pc = ee->branch_pc;
+         break;
+      }
+
+      // Exceptions, ERET and branch likely that was not taken all move the pc themselves
+      if (!ee->is_branching && ee->pc != pc)
+      {
+         ee->pc += 4;
+         break;
+      }
+
+      ee->pc += 4;
+      if (block_cache.block_invalidated && !ee->is_branching) break;
+   }
+
+   return executed;
+}
+
+/*
+   Replays decoded blocks until the cycle budget is used up and returns the amount of guest instructions
+   that were executed. Pending delay slots and code that cannot be cached are stepped through r5900_cycle.
+*/
+u32
+r5900_cached_cycle (R5900_Core *ee, u32 budget)
+{
+   if (!block_cache.pages)
+   {
+      for (u32 i = 0; i < budget; ++i)
+         r5900_cycle(ee);
+
+      return budget;
+   }
+
+   cache_free_retired();
+
+   u32 executed = 0;
+   while (executed < budget)
+   {
+      // Ends the slice so the interrupt is taken on the next one
+      if (ee->interrupt_pending && !ee->is_branching) break;
+
+      block_cache.block_invalidated = false;
+
+      EE_Cached_Block *block = NULL;
+      if (!ee->is_branching)
+      {
+         block = cache_lookup(ee->pc);
+         if (!block) block = cache_decode_block(ee->pc);
+      }
+
+      if (!block)
+      {
+         r5900_cycle(ee);
+         executed += 1;
+         continue;
+      }
+
+      if (block->idle_loop)
+      {
+         u32 idle = ee_idle_check(ee, ee->pc, budget - executed);
+         executed += idle;
+         if (idle) continue;
+      }
+
+      u32 count = cache_run_block(ee, block);
+      ee->cop0.regs[9] += count;
+      executed += count;
+
+      block_cache.stats.block_runs++;
+   }
+
+   return executed;
+}
+
+EE_Cache_Stats
+ee_cache_get_stats ()
+{
+   return block_cache.stats;
+}
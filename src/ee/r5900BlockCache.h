@@ -0,0 +1,47 @@
+/*
+ * Copyright 2023 Xaviar Roach
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef R5900BLOCKCACHE_H
+#define R5900BLOCKCACHE_H
+
+/*
+   Cached interpreter for the EE core.
+
+   Guest basic blocks are fetched and decoded once into an array of pre-extracted operands plus a
+   handler pointer, stored by virtual pc and replayed on later runs. Blocks are thrown away when a store
+   hits the RDRAM page they were decoded from.
+*/
+
+#define EE_CACHE_MAX_BLOCK_INSTRUCTIONS   64
+
+typedef struct _EE_Decoded_Instruction_ {
+   EE_Handler  handler;
+   u32         instruction;
+   Instruction instr;
+} EE_Decoded_Instruction;
+
+typedef struct _EE_Cached_Block_ {
+   u32 pc;
+   u32 count;
+   bool idle_loop;
+   EE_Decoded_Instruction *instructions;
+} EE_Cached_Block;
+
+typedef struct _EE_Cache_Stats_ {
+   u64 blocks_decoded;
+   u64 block_runs;
+   u64 pages_invalidated;
+   u32 blocks_alive;
+} EE_Cache_Stats;
+
+void           ee_cache_init();
+void           ee_cache_shutdown();
+void           ee_cache_flush();
+void           ee_cache_invalidate_page(u32 page);
+void           ee_cache_invalidate_virtual_page(u32 vpage);
+u32            r5900_cached_cycle(R5900_Core *ee, u32 budget);
+EE_Cache_Stats ee_cache_get_stats();
+
+#endif
@@ -0,0 +1,381 @@
+/*
+ * Copyright 2023 Xaviar Roach
+ * SPDX-License-Identifier: MIT
+ */
+
+/*******************************************
+ * Loop Analysis
+*******************************************/
+// Register masks of an instruction, false for anything that is not allowed inside an idle loop
+static bool
+idle_instruction_registers (u32 instruction, u32 *reads, u32 *writes)
+{
+   u32 opcode  = instruction >> 26;
+   u32 rs      = (instruction >> 21) & 0x1F;
+   u32 rt      = (instruction >> 16) & 0x1F;
+   u32 rd      = (instruction >> 11) & 0x1F;
+
+   *reads  = 0;
+   *writes = 0;
+
+   switch (opcode)
+   {
+      case INSTR_SPECIAL:
+      {
+         switch (instruction & 0x3F)
+         {
+            // SLL SRL SRA DSLL DSRL DSRA DSLL32 DSRL32 DSRA32
+            case 0x00: case 0x02: case 0x03: case 0x38: case 0x3A: case 0x3B: case 0x3C: case 0x3E: case 0x3F:
+               *reads = 1u << rt; *writes = 1u << rd;
+            return true;
+
+            // SYNC
+            case 0x0F:
+            return true;
+
+            // MFHI MFLO, nothing in an idle loop writes HI or LO
+            case 0x10: case 0x12:
+               *writes = 1u << rd;
+            return true;
+
+            // MOVZ MOVN keep the old rd when the condition fails
+            case 0x0A: case 0x0B:
+               *reads = (1u << rs) | (1u << rt) | (1u << rd); *writes = 1u << rd;
+            return true;
+
+            // SLLV SRLV SRAV DSLLV DSRLV DSRAV ADD ADDU SUB SUBU AND OR XOR NOR SLT SLTU DADD DADDU DSUB DSUBU
+            case 0x04: case 0x06: case 0x07: case 0x14: case 0x16: case 0x17:
+            case 0x20: case 0x21: case 0x22: case 0x23: case 0x24: case 0x25: case 0x26: case 0x27:
+            case 0x2A: case 0x2B: case 0x2C: case 0x2D: case 0x2E: case 0x2F:
+               *reads = (1u << rs) | (1u << rt); *writes = 1u << rd;
+            return true;
+         }
+      } return false;
+
+      // ADDI ADDIU SLTI SLTIU ANDI ORI XORI DADDI DADDIU
+      case 0x08: case 0x09: case 0x0A: case 0x0B: case 0x0C: case 0x0D: case 0x0E: case 0x18: case 0x19:
+         *reads = 1u << rs; *writes = 1u << rt;
+      return true;
+
+      // LUI
+      case 0x0F:
+         *writes = 1u << rt;
+      return true;
+
+      // LB LH LW LBU LHU LWU LD LQ, LWL and friends merge with the old rt so they are left out
+      case 0x20: case 0x21: case 0x23: case 0x24: case 0x25: case 0x27: case 0x37: case 0x1E:
+         *reads = 1u << rs; *writes = 1u << rt;
+      return true;
+   }
+
+   return false;
+}
+
+// Only conditional branches back to the head of the loop close an idle loop
+static bool
+idle_branch_registers (u32 instruction, u32 pc, u32 head, u32 *reads)
+{
+   u32 opcode  = instruction >> 26;
+   u32 rs      = (instruction >> 21) & 0x1F;
+   u32 rt      = (instruction >> 16) & 0x1F;
+   u32 target  = pc + 4 + ((s32)(s16)(instruction & 0xFFFF) << 2);
+
+   if (target != head) return false;
+
+   switch (opcode)
+   {
+      // BEQ BNE BEQL BNEL
+      case 0x04: case 0x05: case 0x14: case 0x15:
+         *reads = (1u << rs) | (1u << rt);
+      return true;
+
+      // BLEZ BGTZ BLEZL
+      case 0x06: case 0x07: case 0x16:
+         *reads = 1u << rs;
+      return true;
+
+      // BLTZ BGEZ
+      case INSTR_REGIMM:
+         *reads = 1u << rs;
+      return rt == 0x00 || rt == 0x01;
+   }
+
+   return false;
+}
+
+// RDRAM page of a code address, EE_IDLE_NO_PAGE for the BIOS which can not be written
+static u16
+idle_code_page (u32 pc)
+{
+   u32 address = ee_code_address_to_physical(pc);
+   return address < 0x10000000 ? (u16)((address & 0x01FFFFFF) >> 12) : EE_IDLE_NO_PAGE;
+}
+
+/*
+   A loop is idle when it has nothing but loads and register arithmetic and every register it writes is
+   written before it is read in the same iteration, the branch reads included. Then no value is carried
+   from one iteration to the next and an iteration only depends on memory.
+
+   The pages of every word that was looked at are kept whether the loop is idle or not, a write to them
+   is what makes the answer stale.
+*/
+static void
+idle_analyze (EE_Idle_Site *site)
+{
+   u32 code[EE_IDLE_MAX_LOOP_INSTRUCTIONS];
+   u32 words = 0;
+
+   site->length   = 0;
+   site->pages[0] = idle_code_page(site->head);
+   site->pages[1] = site->pages[0];
+
+   auto fetch = [&](u32 index) {
+      code[index]    = ee_core_load_32(site->head + index * 4);
+      site->pages[1] = idle_code_page(site->head + index * 4);
+      words          = index + 1;
+      return code[index];
+   };
+
+   u32 branch = 0;
+   while (true)
+   {
+      if (branch + 2 > EE_IDLE_MAX_LOOP_INSTRUCTIONS) return;
+      if (ee_is_branch_instruction(fetch(branch))) break;
+      branch++;
+   }
+
+   u32 length = branch + 2;
+   if (ee_is_branch_instruction(fetch(branch + 1))) return;
+
+   u32 reads, writes;
+   u32 written = 0;
+   for (u32 i = 0; i < length; ++i)
+   {
+      if (i == branch) continue;
+      if (!idle_instruction_registers(code[i], &reads, &writes)) return;
+      written |= writes;
+   }
+   written &= ~1u;
+
+   // Execution order is the body, the branch and then its delay slot
+   u32 defined = 0;
+   for (u32 i = 0; i < length; ++i)
+   {
+      if (i == branch)
+      {
+         writes = 0;
+         if (!idle_branch_registers(code[i], site->head + i * 4, site->head, &reads)) return;
+      }
+      else
+      {
+         idle_instruction_registers(code[i], &reads, &writes);
+      }
+
+      if (reads & written & ~defined) return;
+      defined |= writes;
+   }
+
+   site->length = length;
+}
+
+static void
+idle_count_pages (const u16 pages[2], s32 delta)
+{
+   for (u32 i = 0; i < 2; ++i)
+   {
+      if (pages[i] == EE_IDLE_NO_PAGE || (i == 1 && pages[1] == pages[0])) continue;
+
+      ee_idle.page_heads[pages[i]] += delta;
+      if (delta > 0 && !_rdram_code_pages_[pages[i]]) ee_protect_code_page(pages[i] << 12);
+   }
+}
+
+static void
+idle_reject (u32 head, const u16 pages[2])
+{
+   EE_Idle_Rejected *rejected = &ee_idle.rejected[(head >> 2) & (EE_IDLE_REJECTED_SLOTS - 1)];
+   if (rejected->valid) idle_count_pages(rejected->pages, -1);
+
+   rejected->valid    = true;
+   rejected->head     = head;
+   rejected->pages[0] = pages[0];
+   rejected->pages[1] = pages[1];
+   idle_count_pages(rejected->pages, 1);
+}
+
+/*
+   Only heads that turn out to be idle loops get a site. Everything else is remembered in the rejected
+   table, so a backward branch that is not an idle loop costs a probe of the sites and one compare after
+   the first time. Probes are bounded, an idle loop that finds no room is dropped like a rejected head.
+*/
+static EE_Idle_Site *
+idle_find_site (u32 head)
+{
+   u32 index            = (head >> 2) & (EE_IDLE_MAX_SITES - 1);
+   EE_Idle_Site *free   = NULL;
+   for (u32 i = 0; i < EE_IDLE_MAX_PROBE; ++i)
+   {
+      EE_Idle_Site *site = &ee_idle.sites[(index + i) & (EE_IDLE_MAX_SITES - 1)];
+      if (site->state == EE_IDLE_SITE_LOOP && site->head == head) return site;
+      if (site->state != EE_IDLE_SITE_LOOP && !free) free = site;
+      if (site->state == EE_IDLE_SITE_EMPTY) break;
+   }
+
+   EE_Idle_Rejected *rejected = &ee_idle.rejected[(head >> 2) & (EE_IDLE_REJECTED_SLOTS - 1)];
+   if (rejected->valid && rejected->head == head) return NULL;
+
+   // Code outside of RDRAM and the BIOS can change without anybody noticing, it is never cached either way
+   if (!ee_is_cacheable_code(head) || (head & 0x3)) return NULL;
+
+   EE_Idle_Site site = {};
+   site.head         = head;
+   idle_analyze(&site);
+   if (!site.length || !free)
+   {
+      if (site.length) ee_idle.dropped++;
+      idle_reject(head, site.pages);
+      return NULL;
+   }
+
+   *free       = site;
+   free->state = EE_IDLE_SITE_LOOP;
+   idle_count_pages(free->pages, 1);
+   ee_idle.site_count++;
+   return free;
+}
+
+/*******************************************
+ * Skipping
+*******************************************/
+// Loads that give the same value until the next event, see r5900Idle.h
+static bool
+idle_load_is_pure (u32 address)
+{
+   if (address >= 0x70000000 && address < 0x70004000) return true;    // Scratchpad
+
+   u32 physical = ee_virtual_to_physical(address);
+   if (physical < 0x10000000) return true;                              // RDRAM
+   if (physical >= 0x10008000 && physical < 0x1000F000) return true;   // DMAC channels and D_* registers
+   return physical == 0x1000F000 || physical == 0x1000F010;            // INTC_STAT and INTC_MASK
+}
+
+// Same order of operations as cache_run_block, false when the instruction was a load that can not be skipped
+static inline bool
+idle_step (R5900_Core *ee)
+{
+   bool in_delay_slot   = ee->is_branching;
+   u32 instruction      = ee_core_load_32(ee->pc);
+   bool pure            = true;
+
+   // The loop only has loads and register arithmetic, see idle_instruction_registers()
+   switch (instruction >> 26)
+   {
+      case 0x20: case 0x21: case 0x23: case 0x24: case 0x25: case 0x27: case 0x37: case 0x1E:
+      {
+         u32 rs   = (instruction >> 21) & 0x1F;
+         pure     = idle_load_is_pure(ee->reg.r[rs].UW[0] + (s16)(instruction & 0xFFFF));
+      } break;
+   }
+
+   ee->is_branching = false;
+   ee_decode_and_execute(ee, instruction);
+   ee->reg.r[0].SD[0] = 0;
+
+   ee->pc = in_delay_slot ? ee->branch_pc : ee->pc + 4;
+   return pure;
+}
+
+// The head goes to the rejected table, for when a site turns out not to be skippable after all
+static void
+idle_drop_site (EE_Idle_Site *site, bool reject)
+{
+   idle_count_pages(site->pages, -1);
+   site->state = EE_IDLE_SITE_DELETED;
+   ee_idle.site_count--;
+
+   if (reject) idle_reject(site->head, site->pages);
+}
+
+void
+ee_idle_reset ()
+{
+   bool enabled = ee_idle.enabled;
+   memset(&ee_idle, 0, sizeof(ee_idle));
+   ee_idle.enabled = enabled;
+}
+
+// Lets the block backends know which blocks to hand to ee_idle_check()
+bool
+ee_idle_is_loop (u32 head)
+{
+   return idle_find_site(head) != NULL;
+}
+
+/*
+   Called by the backends when the EE is about to go around the loop starting at head again, either at
+   the head itself or right after the branch back to it. Runs one iteration and when the EE comes back to
+   the exact same state the rest of the budget is skipped. Returns the amount of cycles that were used,
+   0 when nothing was run.
+*/
+u32
+ee_idle_check (R5900_Core *ee, u32 head, u32 cycles_left)
+{
+   if (!ee_idle.enabled) return 0;
+
+   EE_Idle_Site *site = idle_find_site(head);
+   if (!site || cycles_left < site->length) return 0;
+
+   GP_Registers registers  = ee->reg;
+   u32 pc                  = ee->pc;
+   u32 branch_pc           = ee->branch_pc;
+   bool is_branching       = ee->is_branching;
+
+   u32 executed = site->length;
+   bool pure    = true;
+   for (u32 i = 0; i < executed; ++i)
+      pure &= idle_step(ee);
+
+   ee->cop0.regs[9] += executed;
+
+   // A loop polling something that changes under it is never skipped, the iteration still counts
+   if (!pure)
+   {
+      idle_drop_site(site, true);
+      return executed;
+   }
+
+   bool unchanged = ee->pc == pc && ee->branch_pc == branch_pc && ee->is_branching == is_branching &&
+                    memcmp(&registers, &ee->reg, sizeof(GP_Registers)) == 0;
+   if (!unchanged) return executed;
+
+   u32 skipped = cycles_left - executed;
+   ee->cop0.regs[9]     += skipped;
+   site->skips          += 1;
+   site->cycles_skipped += skipped;
+
+   return cycles_left;
+}
+
+// Called when a store hits a protected code page, whatever was found out about loops in it is stale
+void
+ee_idle_invalidate_page (u32 page)
+{
+   if (!ee_idle.page_heads[page]) return;
+
+   for (u32 i = 0; i < EE_IDLE_MAX_SITES; ++i)
+   {
+      EE_Idle_Site *site = &ee_idle.sites[i];
+      if (site->state != EE_IDLE_SITE_LOOP || (site->pages[0] != page && site->pages[1] != page)) continue;
+
+      idle_drop_site(site, false);
+   }
+
+   for (u32 i = 0; i < EE_IDLE_REJECTED_SLOTS; ++i)
+   {
+      EE_Idle_Rejected *rejected = &ee_idle.rejected[i];
+      if (!rejected->valid || (rejected->pages[0] != page && rejected->pages[1] != page)) continue;
+
+      idle_count_pages(rejected->pages, -1);
+      rejected->valid = false;
+   }
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright 2023 Xaviar Roach
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef R5900IDLE_H
+#define R5900IDLE_H
+
+/*
+   Idle loop detection for the EE core.
+
+   A short loop that ends in a branch back to its first instruction, has no stores and recomputes every
+   register it writes from memory or from registers it never touches is only waiting for memory to change.
+   Once one iteration leaves the registers exactly as they were the rest of the slice can be skipped and
+   the loop picks up again after the next event.
+
+   That is only exact for memory nothing else changes within a slice. RDRAM and the scratchpad are only
+   written by the EE and by DMA, which runs from scheduler events between slices. INTC_STAT, INTC_MASK and
+   the DMAC registers only change from events as well and reading them has no side effects. The addresses
+   of the loads are checked on the iteration that is run, a loop that reads anything else is never skipped:
+   IOP RAM and the SIF registers are written by the IOP thread, the GS registers by the GS thread, timer
+   counts move on their own and FIFO reads pop data.
+
+   Backward branch targets are looked up on every taken branch, so only idle loops get a site and every
+   other head lands in a small table of rejected heads. Both tables keep the RDRAM pages their code came
+   from protected like JIT code, a store to one of them throws away what was found out about it.
+*/
+
+#define EE_IDLE_MAX_LOOP_INSTRUCTIONS  16
+#define EE_IDLE_MAX_SITES              4096  // Has to be a power of two
+#define EE_IDLE_MAX_PROBE              16    // Slots looked at before a head is given up on
+#define EE_IDLE_REJECTED_SLOTS         4096  // Has to be a power of two
+#define EE_IDLE_NO_PAGE                0xFFFF
+
+enum EE_Idle_Site_State : u8
+{
+   EE_IDLE_SITE_EMPTY   = 0x0,
+   EE_IDLE_SITE_LOOP    = 0x1,
+   EE_IDLE_SITE_DELETED = 0x2, // Keeps the probe going past a loop that was overwritten
+};
+
+// RDRAM pages the loop sits in, writes to them through the code page protection drop the site
+typedef struct _EE_Idle_Site_ {
+   EE_Idle_Site_State state;
+   u32 head;
+   u32 length;       // Instructions per iteration with the delay slot
+   u16 pages[2];
+
+   u64 skips;
+   u64 cycles_skipped;
+} EE_Idle_Site;
+
+// Heads that are not idle loops, direct mapped so a busy game only ever evicts the oldest ones
+typedef struct _EE_Idle_Rejected_ {
+   bool valid;
+   u32 head;
+   u16 pages[2];
+} EE_Idle_Rejected;
+
+typedef struct _EE_Idle_ {
+   EE_Idle_Site sites[EE_IDLE_MAX_SITES];
+   EE_Idle_Rejected rejected[EE_IDLE_REJECTED_SLOTS];
+   u16 page_heads[MEGABYTES(32) / KILOBYTES(4)];   // Sites and rejected heads in every RDRAM page
+   u32 site_count;
+   u64 dropped;                                    // Idle loops that found no free slot
+   bool enabled;
+} EE_Idle;
+
+static EE_Idle ee_idle = { .sites = {}, .rejected = {}, .page_heads = {}, .site_count = 0, .dropped = 0, .enabled = true };
+
+void  ee_idle_reset();
+bool  ee_idle_is_loop(u32 head);
+u32   ee_idle_check(R5900_Core *ee, u32 head, u32 cycles_left);
+void  ee_idle_invalidate_page(u32 page);
+
+#endif
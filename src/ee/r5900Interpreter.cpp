@@ -13,7 +13,6 @@
 #define SignExtend(x)
 #define ZeroExtend(x)
 
-//std::array<TLB_Entry, 48> TLBS;
 // FILE* dis = fopen("disasm.txt", "w+");
 
 // std::ofstream console("disasm.txt", std::ios::out);
@@ -22,6 +21,8 @@
 // static u8 *_dcache_         = (u8 *)malloc(sizeof(u8) * KILOBYTES(8));
 static u8 *_scratchpad_     = (u8 *)malloc(sizeof(u8) * KILOBYTES(16));
 
+EE_Execution_Mode ee_execution_mode = EE_MODE_INTERPRETER;
+
 //Range SCRATCHPAD = Range(0x70000000, KILOBYTES(16));
 
 
@@ -83,14 +84,14 @@ get_sa_register (R5900_Core *ee)
 static inline u8
 ee_core_load_8 (u32 address)
 {
+   u8 *page = _ee_read_pages_[address >> 12];
+   if (page) return *(u8*)&page[address & 0xFFF];
+
    // if (SCRATCHPAD.contains(address))
    if (address >= 0x70000000 && address < 0x70004000)
       return *(uint8_t*)&_scratchpad_[address & 0x3FFF];
-   if (address >= 0x30100000 && address < 0x31FFFFFF) // uncached and accelerated ram
-      address -= 0x10000000; // move to unaccelerated ram
-
    // mask from virtual memory to physical
-   address &= 0x1FFFFFFF;
+   address = ee_virtual_to_physical(address);
 
    return ee_load_8(address);
 }
@@ -98,13 +99,14 @@ ee_core_load_8 (u32 address)
 static inline u16
 ee_core_load_16 (u32 address)
 {
+   u8 *page = _ee_read_pages_[address >> 12];
+   if (page) return *(u16*)&page[address & 0xFFF];
+
    // if (SCRATCHPAD.contains(address))
    if (address >= 0x70000000 && address < 0x70004000)
       return *(uint16_t*)&_scratchpad_[address & 0x3FFF];
-   if (address >= 0x30100000 && address < 0x31FFFFFF) // uncached and accelerated ram
-      address -= 0x10000000;// move to unaccelerated ram
-
-   address &= 0x1FFFFFFF;
+   // mask from virtual memory to physical
+   address = ee_virtual_to_physical(address);
 
    return ee_load_16(address);
 }
@@ -112,13 +114,14 @@ ee_core_load_16 (u32 address)
 static inline u32
 ee_core_load_32 (u32 address)
 {
+   u8 *page = _ee_read_pages_[address >> 12];
+   if (page) return *(u32*)&page[address & 0xFFF];
+
    // if (SCRATCHPAD.contains(address))
    if (address >= 0x70000000 && address < 0x70004000)
       return *(uint32_t*)&_scratchpad_[address & 0x3FFF];
-   if (address >= 0x30100000 && address < 0x31FFFFFF) // uncached and accelerated ram
-      address -= 0x10000000; // move to unaccelerated ram
-
-   address &= 0x1FFFFFFF;
+   // mask from virtual memory to physical
+   address = ee_virtual_to_physical(address);
 
    return ee_load_32(address);
 }
@@ -126,18 +129,34 @@ ee_core_load_32 (u32 address)
 static inline u64
 ee_core_load_64 (u32 address)
 {
+   u8 *page = _ee_read_pages_[address >> 12];
+   if (page) return *(u64*)&page[address & 0xFFF];
+
    // if (SCRATCHPAD.contains(address))
    if (address >= 0x70000000 && address < 0x70004000)
       return *(uint64_t*)&_scratchpad_[address & 0x3FFF];
-   if (address >= 0x30100000 && address < 0x31FFFFFF) // uncached and accelerated
-      address -= 0x10000000; // move to unaccelerated ram
-
-   address &= 0x1FFFFFFF;
+   // mask from virtual memory to physical
+   address = ee_virtual_to_physical(address);
 
    return ee_load_64(address);
 }
 
-static inline void ee_core_load_128(u32 address) {return;}
+// LQ ignores the low 4 bits of the address
+static inline u128
+ee_core_load_128 (u32 address)
+{
+   address &= ~0xF;
+
+   u8 *page = _ee_read_pages_[address >> 12];
+   if (page) return ee_read_quad(&page[address & 0xFFF]);
+
+   if (address >= 0x70000000 && address < 0x70004000)
+      return ee_read_quad(&_scratchpad_[address & 0x3FFF]);
+   // mask from virtual memory to physical
+   address = ee_virtual_to_physical(address);
+
+   return ee_load_128(address);
+}
 
 /*******************************************
  * Store Functions
@@ -145,6 +164,13 @@ static inline void ee_core_load_128(u32 address) {return;}
 static inline void
 ee_core_store_8 (u32 address, u8 value)
 {
+   u8 *page = _ee_write_pages_[address >> 12];
+   if (page)
+   {
+      *(u8*)&page[address & 0xFFF] = value;
+      return;
+   }
+
    // if (SCRATCHPAD.contains(address)) {
    if (address >= 0x70000000 && address < 0x70004000) 
    {
@@ -152,13 +178,20 @@ ee_core_store_8 (u32 address, u8 value)
       return;
    }
 
-   address &= 0x1FFFFFFF;
+   address = ee_virtual_to_physical(address);
    ee_store_8(address, value);
 }
 
 static inline void
 ee_core_store_16 (u32 address, u16 value)
 {
+   u8 *page = _ee_write_pages_[address >> 12];
+   if (page)
+   {
+      *(u16*)&page[address & 0xFFF] = value;
+      return;
+   }
+
    // if (SCRATCHPAD.contains(address)) {
    if (address >= 0x70000000 && address < 0x70004000) 
    {
@@ -166,13 +199,20 @@ ee_core_store_16 (u32 address, u16 value)
       return;
    }
 
-   address &= 0x1FFFFFFF;
+   address = ee_virtual_to_physical(address);
    ee_store_16(address, value);
 }
 
 static inline void
 ee_core_store_32 (u32 address, u32 value)
 {
+   u8 *page = _ee_write_pages_[address >> 12];
+   if (page)
+   {
+      *(u32*)&page[address & 0xFFF] = value;
+      return;
+   }
+
    // if (SCRATCHPAD.contains(address)) {
    if (address >= 0x70000000 && address < 0x70004000) 
    {
@@ -180,13 +220,20 @@ ee_core_store_32 (u32 address, u32 value)
       return;
    }
 
-   address &= 0x1FFFFFFF;
+   address = ee_virtual_to_physical(address);
    ee_store_32(address, value);
 }
 
 static inline void
 ee_core_store_64 (u32 address, u64 value)
 {
+   u8 *page = _ee_write_pages_[address >> 12];
+   if (page)
+   {
+      *(u64*)&page[address & 0xFFF] = value;
+      return;
+   }
+
    // if (SCRATCHPAD.contains(address)) {
    if (address >= 0x70000000 && address < 0x70004000) 
    {
@@ -194,11 +241,32 @@ ee_core_store_64 (u32 address, u64 value)
       return;
    }
 
-   address &= 0x1FFFFFFF;
+   address = ee_virtual_to_physical(address);
    ee_store_64(address, value);
 }
 
-static inline void ee_core_store_128() {return;}
+// SQ ignores the low 4 bits of the address
+static inline void
+ee_core_store_128 (u32 address, u128 value)
+{
+   address &= ~0xF;
+
+   u8 *page = _ee_write_pages_[address >> 12];
+   if (page)
+   {
+      ee_write_quad(&page[address & 0xFFF], value);
+      return;
+   }
+
+   if (address >= 0x70000000 && address < 0x70004000)
+   {
+      ee_write_quad(&_scratchpad_[address & 0x3FFF], value);
+      return;
+   }
+
+   address = ee_virtual_to_physical(address);
+   ee_store_128(address, value);
+}
 
 // @@Note: Fuck everything I said previously. On the r5900load delay slots are optional
 static void load_delay() {}
@@ -378,7 +446,7 @@ SYSCALL (R5900_Core *ee)
       case 0x71: GsPutIMR((u64)param0);                                                                                 break;
       default:
       {
-         errlog("Unknown Syscall: [%#x]\n", syscall);
+         errtrace("Unknown Syscall: [{:#x}]\n", syscall);
          return;
       }
    }
@@ -405,21 +473,86 @@ set_kernel_mode (COP0_Registers *cop0)
    };
 }
 
-inline void
-cop0_timer_compare_check (R5900_Core *ee)
+/*******************************************
+ * Interrupts
+*******************************************/
+/*
+   Recomputes interrupt_pending, called whenever a line, the mask or the enable bits change. The core
+   only tests that word between blocks so nothing is spent on interrupts while none are pending.
+*/
+void
+ee_update_interrupts (R5900_Core *ee)
 {
-   bool are_equal = ee->cop0.regs[9] == ee->cop0.regs[11];
-   if (are_equal) {
-      ee->cop0.cause.timer_pending = 1;
-      ee->cop0.status.IM_7 = 1;
-   }
+   u32 lines = 0;
+   if (ee->cop0.cause.int0_pending  && ee->cop0.status.IM_2) lines |= EE_INTERRUPT_INT0;
+   if (ee->cop0.cause.int1_pending  && ee->cop0.status.IM_3) lines |= EE_INTERRUPT_INT1;
+   if (ee->cop0.cause.timer_pending && ee->cop0.status.IM_7) lines |= EE_INTERRUPT_TIMER;
+
+   bool enabled = ee->cop0.status.IE && ee->cop0.status.EIE && !ee->cop0.status.EXL && !ee->cop0.status.ERL;
+   ee->interrupt_pending = enabled ? lines : 0;
 }
 
+// Exceptions raised since the last update only ever mask interrupts, so the word is checked again first
 static void
-ee_decode_and_execute (R5900_Core *ee, u32 instruction)
+r5900_interrupt (R5900_Core *ee)
+{
+   ee_update_interrupts(ee);
+   if (!ee->interrupt_pending) return;
+
+   Exception exc           = get_exception(V_INTERRUPT, __INTERRUPT);
+   ee->pc                  = handle_exception_level_1(&ee->cop0, &exc, ee->pc, ee->is_branching);
+   ee->is_branching        = false;
+   ee->delay_slot          = 0;
+   ee->interrupt_pending   = 0;
+}
+
+// The core inside r5900_run(), NULL between slices
+static R5900_Core *ee_slice_core = NULL;
+
+/*
+   EE cycles run so far in the current slice. The scheduler only moves forward once r5900_run() returns,
+   so anything that measures time from inside a slice has to add these on top of scheduler.cycles. Every
+   backend keeps COP0 Count up to date as it runs, the distance from the Count the slice started with is
+   the time spent in it.
+*/
+u32
+ee_slice_cycles ()
 {
-   if (instruction == 0x00000000) return;
+   if (!ee_slice_core) return 0;
+   return ee_slice_core->cop0.regs[9] - ee_slice_core->slice_start;
+}
+
+u64
+ee_current_cycles ()
+{
+   return scheduler.cycles + ee_slice_cycles();
+}
+
+static Event_Handle cop0_compare_event = -1;
+
+// Count advances once per instruction so the next match is always (Compare - Count) cycles away
+static void
+cop0_schedule_compare (R5900_Core *ee)
+{
+   u64 cycles = (u32)(ee->cop0.regs[11] - ee->cop0.regs[9]);
+   if (cycles == 0) cycles = 1ull << 32;
+
+   scheduler_schedule(cop0_compare_event, ee_slice_cycles() + cycles, (u64)ee);
+}
+
+static void
+cop0_compare_callback (u64 param, u64)
+{
+   R5900_Core *ee = (R5900_Core *)param;
+   ee->cop0.cause.timer_pending = 1;
+
+   ee_update_interrupts(ee);
+   cop0_schedule_compare(ee);
+}
 
+static inline Instruction
+ee_decode (u32 instruction)
+{
    Instruction instr = {
       .rd          = (u8)((instruction >> 11) & 0x1F),
       .rt          = (u8)((instruction >> 16) & 0x1F),
@@ -433,893 +566,1185 @@ ee_decode_and_execute (R5900_Core *ee, u32 instruction)
       .instr_index = (u32)(instruction & 0x3FFFFFF),
    };
 
-   int opcode = instruction >> 26;
-   switch (opcode)
-   {
-/*
-*-----------------------------------------------------------------------------
-* COP0 Instructions
-*-----------------------------------------------------------------------------
-*/
-      case INSTR_COP0:
-      {
-         int fmt = instruction >> 21 & 0x3F;
-         if(fmt == 0x10) return; // @Hack: putting this here so that it doesnt spam console
-         switch (fmt)
-         {
-            case 0x00:
-            {
-               u32 cop0                = instr.rd;
-               u32 gpr                 = instr.rt;
-               ee->reg.r[gpr].SD[0]    = ee->cop0.regs[cop0];
-               // intlog("MFC0 GPR: [{:d}] COP0: [{:d}]\n", gpr, cop0);
-            } break;
-
-            case 0x04:
-            {
-               u32 cop0    = instr.rd;
-               s32 gpr     = ee->reg.r[instr.rt].SW[0];
-
-               if(cop0 == 12) {
-                  ee->cop0.status.IE              = (gpr >> 0) & 0x1;
-                  ee->cop0.status.EXL             = (gpr >> 1) & 0x1;
-                  ee->cop0.status.ERL             = (gpr >> 2) & 0x1;
-                  ee->cop0.status.KSU             = (gpr >> 3) & 0x1;
-                  ee->cop0.status.IM_2            = (gpr >> 10) & 0x1;
-                  ee->cop0.status.IM_3            = (gpr >> 11) & 0x1;
-                  ee->cop0.status.BEM             = (gpr >> 12) & 0x1;
-                  ee->cop0.status.IM_7            = (gpr >> 15) & 0x1;
-                  ee->cop0.status.EIE             = (gpr >> 16) & 0x1;
-                  ee->cop0.status.EDI             = (gpr >> 17) & 0x1;
-                  ee->cop0.status.CH              = (gpr >> 18) & 0x1;
-                  ee->cop0.status.BEV             = (gpr >> 22) & 0x1;
-                  ee->cop0.status.DEV             = (gpr >> 23) & 0x1;
-                  ee->cop0.status.CU              = (gpr >> 28) & 0xF;
-               } else if (cop0 == 13) {
-                  ee->cop0.cause.ex_code          = (gpr >> 2)  & 0x1F;
-                  ee->cop0.cause.int0_pending     = (gpr >> 10) & 0x1;
-                  ee->cop0.cause.int1_pending     = (gpr >> 11) & 0x1;
-                  ee->cop0.cause.timer_pending    = (gpr >> 15) & 0x1;
-                  ee->cop0.cause.EXC2             = (gpr >> 16) & 0x3;
-                  ee->cop0.cause.CE               = (gpr >> 28) & 0x3;
-                  ee->cop0.cause.BD2              = (gpr >> 30) & 0x1;
-                  ee->cop0.cause.BD               = (gpr >> 31) & 0x1;
-                 } else {
-                  ee->cop0.regs[cop0] = gpr;
-                 }
-                 // intlog("MTC0 GPR: [{:d}] COP0: [{:d}]\n", gpr, cop0);
-            } break;
-
-            case 0x08:
-            {
-               int tlb = instruction & 0x3F;
-               switch(tlb)
-               {
-                  case 0x2:
-                  {
-                     // @@Implemtation: implement TLB
-                     //int index = ee->cop0.regs[0];
-                     //TLB_Entry current = TLBS.at(index);
-                     // intlog("TLBWI not yet implemented\n");
-                  } break;
-
-                  case 0x18:
-                  {
-                     ee->pc = ee->cop0.EPC;
-                     intlog("ERET");
-                  } break;
-               }
-            } break;
-
-            default:
-            {
-               errlog("[ERROR]: Could not interpret COP0 instruction format opcode [{:#09x}]\n", fmt);
-            } break;
-         }
-      } break;
+   return instr;
+}
 
-/*
-*-----------------------------------------------------------------------------
-* COP1 Instructions
-*-----------------------------------------------------------------------------
-*/
-      case INSTR_COP1: { cop1_decode_and_execute(ee, instruction); } break;
+/*******************************************
+ * COP0 Instructions
+*******************************************/
+static void
+ee_op_mfc0 (R5900_Core *ee, u32, const Instruction &instr)
+{
+   u32 cop0                = instr.rd;
+   u32 gpr                 = instr.rt;
+   ee->reg.r[gpr].SD[0]    = ee->cop0.regs[cop0];
+   // intlog("MFC0 GPR: [{:d}] COP0: [{:d}]\n", gpr, cop0);
+}
 
-/*
-*-----------------------------------------------------------------------------
-* Special Instructions
-*-----------------------------------------------------------------------------
-*/
-      case INSTR_SPECIAL:
-      {
-         u32 special = instruction & 0x3F; // DSRA32 is 63 so make it up to 64
-         switch(special)
-         {
-            case 0x00:
-            {
-               u32 sa                      = instr.sa;
-               ee->reg.r[instr.rd].SD[0]   = (u64)((s32)ee->reg.r[instr.rt].UW[0] << sa);
-               intlog("SLL source: [{:d}] dest: [{:d}] [{:#x}]\n", instr.rd, instr.rt, instr.sa);
-            } break;
-
-            case 0x02:
-            {
-               u32 result                  = (ee->reg.r[instr.rt].UW[0] >> instr.sa);
-               ee->reg.r[instr.rd].SD[0]   = (s32)result;
-               intlog("SRL source: [{:d}] dest: [{:d}] [{:#x}]\n", instr.rd, instr.rt, instr.sa);
-            } break;
-
-            case 0x03:
-            {
-               s32 result                  = (ee->reg.r[instr.rt].SW[0]) >> (s32)instr.sa;
-               ee->reg.r[instr.rd].SD[0]   = result;
-               intlog("SRA source: [{:d}] dest: [{:d}] [{:#x}]\n", instr.rd, instr.rt, (s32)instr.sa);
-            } break;
-
-            case 0x04:
-            {
-               u32 sa                      = ee->reg.r[instr.rs].SW[0] & 0x1F;
-               ee->reg.r[instr.rd].SD[0]   = (s64)(ee->reg.r[instr.rt].SW[0] << sa);
-               intlog("SLLV source: [{:d}] dest: [{:d}] [{:#x}]\n", instr.rd, instr.rt, sa);
-            } break;
-
-            case 0x06:
-            {
-               u32 sa                      = ee->reg.r[instr.rs].SW[0] & 0x1F;
-               ee->reg.r[instr.rd].SD[0]   = (s64)(ee->reg.r[instr.rt].SW[0] >> sa);
-               intlog("SRLV source: [{:d}] dest: [{:d}] [{:#x}]\n", instr.rd, instr.rt, sa);
-            } break;
-
-            case 0x07:
-            {
-               u32 sa                      = ee->reg.r[instr.rs].UB[0] & 0x1F;
-               s32 result                  = ee->reg.r[instr.rt].SW[0] >> sa;
-               ee->reg.r[instr.rd].SD[0]   = (s64)result;
-               intlog("SRAV [{:d}] [{:d}] [{:d}]\n", instr.rd, instr.rt, instr.rs);
-            } break;
-
-            case 0x08:
-            {
-               // @TODO: Check if the LSB is 0
-               jump_to(ee, ee->reg.r[instr.rs].UW[0]);
-               intlog("JR source: [{:d}] pc_dest: [{:#x}]\n", instr.rs, ee->reg.r[instr.rs].UW[0]);
-            } break;
-
-            case 0x09:
-            {
-               u32 return_addr = ee->pc + 8;
-
-               if (instr.rd != 0) {
-                  ee->reg.r[instr.rd].UD[0] = return_addr;
-               } else {
-                  ee->reg.r[31].UD[0] = return_addr;
-               }
-
-               jump_to(ee, ee->reg.r[instr.rs].UW[0]);
-
-               intlog("JALR [{:d}]\n", instr.rs);
-            } break;
-
-            case 0x0A:
-            {
-               if (ee->reg.r[instr.rt].SD[0] == 0) {
-                  ee->reg.r[instr.rd].SD[0] = ee->reg.r[instr.rs].SD[0];
-               }
-               intlog("MOVZ [{:d}] [{:d}] [{:d}]\n",instr.rd, instr.rs, instr.rt);
-            } break;
-
-            case 0x0B:
-            {
-               if (ee->reg.r[instr.rt].UD[0] != 0) {
-                  ee->reg.r[instr.rd].UD[0] = ee->reg.r[instr.rs].UD[0];
-               }
-               intlog("MOVN [{:d}] [{:d}] [{:d}]\n", instr.rd, instr.rs, instr.rt);
-            } break;
-
-            case 0x0C:
-            {
-               SYSCALL(ee);
-            } break;
-
-            case 0x0D:
-            {
-               // @@Implementation We have no debugger yet so theres no need to implement this now
-               // intlog("BREAKPOINT\n");
-            } break;
-
-            case 0x0F:
-            {
-               // @@Note: Issued after every MTC0 write The PS2 possibly executes millions of memory loads / stores per second,
-               // which is entirely feasible in hardware. But a complete pain in software as that would completely kill performance
-               // May be cool to implement this for accuracy since that is the purpose of the emulator
-               // intlog("SYNC\n");
-            } break;
-
-            case 0x10:
-            {
-               ee->reg.r[instr.rd].UD[0] = ee->HI;
-               intlog("MFHI [{:d}]\n", instr.rd);
-            } break;
-
-            case 0x11:
-            {
-               ee->HI = ee->reg.r[instr.rs].UD[0];
-               intlog("MTHI [{:d}]\n", instr.rs);
-            } break;
-
-            case 0x12:
-            {
-               ee->reg.r[instr.rd].UD[0] = ee->LO;
-               intlog("MFLO [{:d}] \n", instr.rd);
-            } break;
-
-            case 0x13:
-            {
-               ee->LO = ee->reg.r[instr.rs].UD[0];
-               intlog("MTLO [{:d}]\n", instr.rs);
-            } break;
-
-            case 0x14:
-            {
-               s32 sa                      = ee->reg.r[instr.rs].UW[0] & 0x3F;
-               ee->reg.r[instr.rd].UD[0]   = ee->reg.r[instr.rt].UD[0] << sa;
-               intlog("DSLLV [{:d}] [{:d}] [{:d}]\n", instr.rd, instr.rt, instr.rs);
-            } break;
-
-            case 0x17:
-            {
-               u32 sa                      = ee->reg.r[instr.rs].UW[0] & 0x3F;
-               ee->reg.r[instr.rd].SD[0]   = ee->reg.r[instr.rt].SD[0] >> sa;
-               intlog("DSRAV [{:d}] [{:d}] [{:d}]\n", instr.rd, instr.rt, instr.rs);
-            } break;
-
-            case 0x18:
-            {
-              s64 w1      = (s64)ee->reg.r[instr.rs].SW[0];
-              s64 w2      = (s64)ee->reg.r[instr.rt].SW[0];
-              s64 prod    = (w1 * w2);
-
-              ee->LO      = (s32)(prod & 0xFFFFFFFF);
-              ee->HI      = (s32)(prod >> 32);
-              // @@Note: C790 apparently states that the chip does not always call mflo everytime
-              // during a 3 operand mult
-              // But we could always use mflo because of the pipeline interlock
-              ee->reg.r[instr.rd].SD[0] = ee->LO;
-              intlog("MULT [{:d}] [{:d}] [{:d}]\n", instr.rs, instr.rt, instr.rd);
-            } break;
-
-            case 0x1A:
-            {
-               if (ee->reg.r[instr.rt].UD[0] == 0) {
-                  ee->LO = (int)0xffffffff;
-                  ee->HI = ee->reg.r[instr.rs].UD[0];
-                  errlog("[ERROR]: Tried to Divide by zero\n");
-               //return;
-               }
-               s32 d   = ee->reg.r[instr.rs].SW[0] / ee->reg.r[instr.rt].SW[0];
-               s32 q   = ee->reg.r[instr.rs].SW[0] % ee->reg.r[instr.rt].SW[0];
-               ee->LO  = (s64)d;
-               ee->HI  = (s64)q;
-               intlog("DIV [{:d}] [{:d}]\n", instr.rs, instr.rt);
-            } break;
-
-            case 0x1B:
-            {
-               s64 w1 = (s64)ee->reg.r[instr.rs].SW[0];
-               s64 w2 = (s64)ee->reg.r[instr.rt].SW[0];
-
-               if (w2 == 0) {
-                  errlog("[ERROR]: Tried to Divide by zero\n");
-                  //return;
-               }
-               // @@Note: Sign extend by 64?
-               s64 q   = (s32)(w1 / w2);
-               ee->LO  = q;
-               s64 r   = (s32)(w1 % w2);
-               ee->HI  = r;
-               intlog("DIVU [{:d}] [{:d}]\n", instr.rs, instr.rt);
-            } break;
-
-            case 0x20:
-            {
-               // @@Incomplete: The add instruction must signal an exception on overflow
-               // but we have no overflow detection for now
-               int temp                    = ee->reg.r[instr.rs].SW[0] + ee->reg.r[instr.rt].SW[0];
-               ee->reg.r[instr.rd].SD[0]   = (s64)temp;
-               intlog("ADD [{:d}] [{:d}] [{:d}]\n", instr.rd, instr.rs, instr.rt);
-            } break;
-
-            case 0x21:
-            {
-               s32 result                  = ee->reg.r[instr.rs].SW[0] + ee->reg.r[instr.rt].SW[0];
-               ee->reg.r[instr.rd].UD[0]   = result;
-               intlog("ADDU [{:d}] [{:d}] [{:d}]\n", instr.rd, instr.rs, instr.rt);
-            } break;
-
-            case 0x22:
-            {
-               s32 result                  = ee->reg.r[instr.rs].SW[0] - ee->reg.r[instr.rt].SW[0];
-               ee->reg.r[instr.rd].UD[0]   = (s64)result;
-
-               /* @@Incomplete: No 2 complement Arithmetic Overflow error implementation*/
-               intlog("SUB [{:d}] [{:d}] [{:d}]\n", instr.rd, instr.rs, instr.rt);
-            } break;
-
-            case 0x23:
-            {
-               s32 result                  = ee->reg.r[instr.rs].SW[0] - ee->reg.r[instr.rt].SW[0];
-               ee->reg.r[instr.rd].UD[0]   = (u64)result;
-               intlog("SUBU [{:d}] [{:d}] [{:d}]\n", instr.rd, instr.rs, instr.rt);
-            } break;
-
-            case 0x24:
-            {
-               ee->reg.r[instr.rd].UD[0] = ee->reg.r[instr.rs].UD[0] & ee->reg.r[instr.rt].UD[0];
-               intlog("AND [{:d}] [{:d}] [{:d}] \n", instr.rd, instr.rs, instr.rt);
-            } break;
-
-            case 0x25:
-            {
-               ee->reg.r[instr.rd].SD[0] = ee->reg.r[instr.rs].SD[0] | ee->reg.r[instr.rt].SD[0];
-               intlog("OR [{:d}] [{:d}] [{:d}]\n", instr.rd, instr.rs, instr.rt);
-            } break;
-
-            case 0x27:
-            {
-               ee->reg.r[instr.rd].SD[0] = ~(ee->reg.r[instr.rs].SD[0] | ee->reg.r[instr.rt].SD[0]);
-               // assert(1);
-               intlog("NOR [{:d}] [{:d}] [{:d}]\n", instr.rd, instr.rs, instr.rt);
-            } break;
-
-            case 0x2A:
-            {
-               s32 result                  = ee->reg.r[instr.rs].SD[0] < ee->reg.r[instr.rt].SD[0] ? 1 : 0;
-               ee->reg.r[instr.rd].SD[0]   = result;
-               intlog("SLT [{:d}] [{:d}] [{:d}]\n", instr.rd, instr.rs, instr.rt);
-            } break;
-
-            case 0x2B:
-            {
-               u32 result                  = (ee->reg.r[instr.rs].UD[0] < ee->reg.r[instr.rt].UD[0]) ? 1 : 0;
-               ee->reg.r[instr.rd].UD[0]   = result;
-               intlog("SLTU [{:d}] [{:d}] [{:d}]\n", instr.rd, instr.rs, instr.rt);
-            } break;
-
-            case 0x2D:
-            {
-               ee->reg.r[instr.rd].UD[0] = ee->reg.r[instr.rs].SD[0] + ee->reg.r[instr.rt].SD[0];
-               intlog("DADDU [{:d}] [{:d}] [{:d}]\n", instr.rd, instr.rs, instr.rt);
-            } break;
-
-            case 0x38:
-            {
-               ee->reg.r[instr.rd].UD[0] = ee->reg.r[instr.rt].UD[0] << instr.sa;
-               intlog("DSLL source: [{:d}] dest: [{:d}] [{:#x}]\n", instr.rd, instr.rt, instr.sa);
-            } break;
-
-            case 0x3A:
-            {
-               ee->reg.r[instr.rd].UD[0] = ee->reg.r[instr.rt].UD[0] >> instr.sa;
-               intlog("DSRL source: [{:d}] dest: [{:d}] s: [{:#x}] \n", instr.rd, instr.rt, instr.sa);
-            } break;
-
-            case 0x3C:
-            {
-               u32 s                       = instr.sa + 32;
-               ee->reg.r[instr.rd].UD[0]   = ee->reg.r[instr.rt].UD[0] << s;
-               intlog("DSLL32 source: [{:d}] dest: [{:d}] s: [{:#x}] \n", instr.rd, instr.rt, s);
-            } break;
-
-            case 0x3E:
-            {
-               u32 s                       = instr.sa + 32;
-               ee->reg.r[instr.rd].UD[0]   = ee->reg.r[instr.rt].UD[0] >> s;
-               intlog("DSRL32 source: [{:d}] dest: [{:d}] s: [{:#x}] \n", instr.rd, instr.rt, s);
-            } break;
-
-            case 0x3F:
-            {
-               u32 s = instr.sa + 32;
-               s64 result = ee->reg.r[instr.rt].SD[0] >> s;
-               ee->reg.r[instr.rd].SD[0] = result;
-               intlog("DSRA32 source: [{:d}] dest: [{:d}] s: [{:#x}] \n", instr.rd, instr.rt, s);
-            } break;
-
-            default:
-            {
-               errlog("[ERROR]: Could not interpret special instruction: [{:#09x}]\n", instruction);
-            } break;
-         }
-      } break;
-/*
-*-----------------------------------------------------------------------------
-* MMI Instructions
-*-----------------------------------------------------------------------------
-*/
-      case INSTR_MMI:
-      {
-         int fmt = instruction & 0x3f;
-         switch(fmt)
-         {
-            case 0x01:
-            {
-               errlog("LOL\n");
-               // intlog("MADDU\n");
-               printf("lol");
-            } break;
-
-            case 0x12:
-            {
-               ee->reg.r[instr.rd].UD[0] = ee->LO1;
-               intlog("MFLO_1 [{:d}]\n", instr.rd);
-            } break;
-
-            case 0x18:
-            {
-               s32 w1 = (s32)ee->reg.r[instr.rs].SW[0];
-               s32 w2 = (s32)ee->reg.r[instr.rt].SW[0];
-               s64 prod = (s64)(w1 * w2);
-
-               ee->LO1 = (s32)(prod & 0xFFFFFFFF);
-               ee->HI1 = (s32)(prod >> 32);
-               // @@Note: C790 apparently states that the chip does not always call mflo everytime
-               // during a 3-operand mult
-               // But we could always use mflo because of the pipeline interlock
-               ee->reg.r[instr.rd].SD[0] = ee->LO1;
-
-               intlog("MULT1 [{:d}] [{:d}] [{:d}]\n", instr.rs, instr.rt, instr.rd);
-            } break;
-
-            case 0x1B:
-            {
-               s32 w1 = ee->reg.r[instr.rs].SW[0];
-               s32 w2 = ee->reg.r[instr.rt].SW[0];
-
-               if (w2 == 0) {
-                  ee->LO1 = (int)0xffffffff;
-                  ee->HI1 = ee->reg.r[instr.rs].UD[0];
-                  errlog("[ERROR] tried to divide by 0, result is Undefined\n");
-                  //exit(1);
-               }
-
-               s64 q   = (w1 / w2);
-               ee->LO1 = q;
-               s64 r   = (w1 % w2);
-               ee->HI1 = r;
-
-               intlog("DIVU_1 [{:d}] [{:d}]\n", instr.rs, instr.rt);
-            } break;
-
-            case 0x29:
-            {
-               // intlog("Dunno what this is\n");
-            } break;
-
-            default:
-            {
-               errlog("[ERROR]: Could not interpret MMI instruction [{:#09x}]\n", fmt);
-            } break;
-         }
+static void
+ee_op_mtc0 (R5900_Core *ee, u32, const Instruction &instr)
+{
+   u32 cop0    = instr.rd;
+   s32 gpr     = ee->reg.r[instr.rt].SW[0];
+
+   if(cop0 == 12) {
+      ee->cop0.status.IE              = (gpr >> 0) & 0x1;
+      ee->cop0.status.EXL             = (gpr >> 1) & 0x1;
+      ee->cop0.status.ERL             = (gpr >> 2) & 0x1;
+      ee->cop0.status.KSU             = (gpr >> 3) & 0x1;
+      ee->cop0.status.IM_2            = (gpr >> 10) & 0x1;
+      ee->cop0.status.IM_3            = (gpr >> 11) & 0x1;
+      ee->cop0.status.BEM             = (gpr >> 12) & 0x1;
+      ee->cop0.status.IM_7            = (gpr >> 15) & 0x1;
+      ee->cop0.status.EIE             = (gpr >> 16) & 0x1;
+      ee->cop0.status.EDI             = (gpr >> 17) & 0x1;
+      ee->cop0.status.CH              = (gpr >> 18) & 0x1;
+      ee->cop0.status.BEV             = (gpr >> 22) & 0x1;
+      ee->cop0.status.DEV             = (gpr >> 23) & 0x1;
+      ee->cop0.status.CU              = (gpr >> 28) & 0xF;
+   } else if (cop0 == 13) {
+      ee->cop0.cause.ex_code          = (gpr >> 2)  & 0x1F;
+      ee->cop0.cause.int0_pending     = (gpr >> 10) & 0x1;
+      ee->cop0.cause.int1_pending     = (gpr >> 11) & 0x1;
+      ee->cop0.cause.timer_pending    = (gpr >> 15) & 0x1;
+      ee->cop0.cause.EXC2             = (gpr >> 16) & 0x3;
+      ee->cop0.cause.CE               = (gpr >> 28) & 0x3;
+      ee->cop0.cause.BD2              = (gpr >> 30) & 0x1;
+      ee->cop0.cause.BD               = (gpr >> 31) & 0x1;
+     } else {
+      // Writing Count must not move the time already spent in the slice
+      if (cop0 == 9) ee->slice_start += gpr - ee->cop0.regs[9];
+      ee->cop0.regs[cop0] = gpr;
+      if (cop0 == 9 || cop0 == 11) cop0_schedule_compare(ee);
+      if (cop0 == 11) ee->cop0.cause.timer_pending = 0; // Writing Compare acknowledges the timer
+      if (cop0 == 6)  ee->cop0.random = EE_TLB_ENTRIES - 1;
+      if (cop0 == 10) ee_tlb_set_asid(gpr & 0xFF);
+     }
+
+     if (cop0 == 11 || cop0 == 12 || cop0 == 13) ee_update_interrupts(ee);
+     // intlog("MTC0 GPR: [{:d}] COP0: [{:d}]\n", gpr, cop0);
+}
 
-      } break;
-/*
-*-----------------------------------------------------------------------------
-* REGIMM Instructions
-*-----------------------------------------------------------------------------
-*/
-      case INSTR_REGIMM:
-      {
-         int regimm_function = instruction >> 16 & 0x1f;
-         switch(regimm_function)
-         {
-            case 0x00:
-            {
-               s32 offset      = instr.sign_offset << 2;
-               bool condition  = ee->reg.r[instr.rs].SD[0] < 0;
-               branch(ee, condition, offset);
-
-               intlog("BLTZ [{:d}] [{:#x}] \n", instr.rs, offset);
-            } break;
-
-            case 0x01:
-            {
-               s32 offset      = instr.sign_offset << 2;
-               bool condition  = ee->reg.r[instr.rs].SD[0] >= 0;
-               branch(ee, condition, offset);
-
-               intlog("BGEZ [{:d}] [{:#x}] \n", instr.rs, offset);
-            } break;
-
-            default:
-            {
-               errlog("[ERROR]: Could not interpret REGIMM instruction [{:#09x}]\n", regimm_function);
-            } break;
-         }
-      } break;
-/*
-*-----------------------------------------------------------------------------
-* Normal Instructions
-*-----------------------------------------------------------------------------
-*/
-      case 0x02:
+static void
+ee_op_cop0_tlb (R5900_Core *ee, u32 instruction, const Instruction &)
+{
+   int tlb = instruction & 0x3F;
+   switch(tlb)
+   {
+      case 0x1:
       {
-         u32 offset = ((ee->pc + 4) & 0xF0000000) + (instr.instr_index << 2);
-         jump_to(ee, offset);
-         intlog("J [{:#x}]\n", offset);
+         ee_tlb_read(ee);
+         intlog("TLBR");
       } break;
 
-      case 0x03:
+      case 0x2:
       {
-         u32 instr_index     = instr.instr_index;
-         u32 target_address  = ((ee->pc + 4) & 0xF0000000) + (instr_index << 2);
-
-         jump_to(ee, target_address);
-         ee->reg.r[31].UD[0]  = ee->pc + 8;
-
-         intlog("JAL [{:#x}] \n", target_address);
+         ee_tlb_write(ee, ee->cop0.index);
+         intlog("TLBWI");
       } break;
 
-      case 0x04:
+      // @Incomplete: Random only moves on TLBWR instead of on every cycle
+      case 0x6:
       {
-         s32 imm         = instr.sign_imm << 2;
-         bool condition  = ee->reg.r[instr.rs].SD[0] == ee->reg.r[instr.rt].SD[0];
-
-         branch(ee, condition, imm);
-
-         intlog("BEQ [{:d}] [{:d}] [{:#x}] \n", instr.rs, instr.rt, imm);
+         ee_tlb_write(ee, ee->cop0.random);
+         ee->cop0.random = (ee->cop0.random <= ee->cop0.wired) ? EE_TLB_ENTRIES - 1 : ee->cop0.random - 1;
+         intlog("TLBWR");
       } break;
 
-      case 0x05:
+      case 0x8:
       {
-         s32 imm         = instr.sign_imm << 2;
-         bool condition  = ee->reg.r[instr.rs].SD[0] != ee->reg.r[instr.rt].SD[0];
-
-         branch(ee, condition, imm);
-
-         intlog("BNE [{:d}] [{:d}], [{:#x}]\n", instr.rt, instr.rs, imm);
+         ee_tlb_probe(ee);
+         intlog("TLBP");
       } break;
 
-      case 0x06:
+      // The pc still gets advanced after the instruction, like it does for a jump
+      case 0x18:
       {
-         s32 offset      = (instr.sign_offset << 2);
-         bool condition  = ee->reg.r[instr.rs].SD[0] <= 0;
-
-         branch(ee, condition, offset);
-
-         intlog("BLEZ [{:d}] [{:#x}]\n", instr.rs, offset);
+         if (ee->cop0.status.ERL)
+         {
+            ee->pc                  = ee->cop0.errorEPC - 4;
+            ee->cop0.status.ERL     = 0;
+         }
+         else
+         {
+            ee->pc                  = ee->cop0.EPC - 4;
+            ee->cop0.status.EXL     = 0;
+         }
+         ee_update_interrupts(ee);
+         intlog("ERET");
       } break;
 
-      case 0x07:
+      // @Incomplete: EDI is not checked, EI and DI work in every mode
+      case 0x38:
       {
-         s32 offset      = instr.sign_offset << 2;
-         bool condition  = ee->reg.r[instr.rs].SD[0] > 0;
-
-         branch(ee, condition, offset);
-
-         intlog("BGTZ [{:d}] [{:#x}] \n", instr.rs, offset);
+         ee->cop0.status.EIE = 1;
+         ee_update_interrupts(ee);
+         intlog("EI");
       } break;
 
-      case 0x08:
+      case 0x39:
       {
-         s32 result                  = ee->reg.r[instr.rs].SD[0] + instr.sign_imm;
-         ee->reg.r[instr.rt].SD[0]   = result;
-         /* @@Incomplete: No 2 complement Arithmetic Overflow error implementation*/
-         intlog("ADDI: [{:d}] [{:d}] [{:#x}] \n", instr.rt, instr.rs, instr.sign_imm);
+         ee->cop0.status.EIE = 0;
+         ee_update_interrupts(ee);
+         intlog("DI");
       } break;
+   }
+}
 
-      case 0x09:
-      {
-         s32 result                  = ee->reg.r[instr.rs].SD[0] + instr.sign_imm;
-         ee->reg.r[instr.rt].SD[0]   = result;
-         intlog("ADDIU: [{:d}] [{:d}] [{:#x}] \n", instr.rt, instr.rs, instr.sign_imm);
-      } break;
+// @Hack: BC0F, BC0T and friends do nothing so that they dont spam console
+static void
+ee_op_cop0_bc0 (R5900_Core *, u32, const Instruction &) {}
 
-      case 0x0A:
-      {
-         s32 result                  = (ee->reg.r[instr.rs].SD[0] < (s32)instr.sign_imm) ? 1 : 0;
-         ee->reg.r[instr.rt].SD[0]   = result;
+static void
+ee_op_cop0_unknown (R5900_Core *, u32 instruction, const Instruction &)
+{
+   errtrace("[ERROR]: Could not interpret COP0 instruction format opcode [{:#09x}]\n", (instruction >> 21) & 0x3F);
+}
 
-         intlog("SLTI [{:d}] [{:d}], [{:#x}]\n", instr.rt, instr.rs, instr.sign_imm);
-      } break;
+/*******************************************
+ * COP1 Instructions
+*******************************************/
+static void
+ee_op_cop1 (R5900_Core *ee, u32 instruction, const Instruction &)
+{
+   cop1_decode_and_execute(ee, instruction);
+}
 
-      case 0x0B:
-      {
-         u32 result                  = (ee->reg.r[instr.rs].UD[0] < (u64)instr.sign_imm) ? 1 : 0;
-         ee->reg.r[instr.rt].UD[0]   = result;
+/*******************************************
+ * Special Instructions
+*******************************************/
+static void
+ee_op_sll (R5900_Core *ee, u32, const Instruction &instr)
+{
+   u32 sa                      = instr.sa;
+   ee->reg.r[instr.rd].SD[0]   = (u64)((s32)ee->reg.r[instr.rt].UW[0] << sa);
+   intlog("SLL source: [{:d}] dest: [{:d}] [{:#x}]\n", instr.rd, instr.rt, instr.sa);
+}
 
-         intlog("SLTIU [{:d}] [{:d}] [{:#x}]\n", instr.rt, instr.rs, (u64)instr.sign_imm);
-      } break;
+static void
+ee_op_srl (R5900_Core *ee, u32, const Instruction &instr)
+{
+   u32 result                  = (ee->reg.r[instr.rt].UW[0] >> instr.sa);
+   ee->reg.r[instr.rd].SD[0]   = (s32)result;
+   intlog("SRL source: [{:d}] dest: [{:d}] [{:#x}]\n", instr.rd, instr.rt, instr.sa);
+}
 
-      case 0x0C:
-      {
-         ee->reg.r[instr.rt].UD[0] = ee->reg.r[instr.rs].UD[0] & (u64)instr.imm;
-         intlog("ANDI: [{:d}] [{:d}] [{:#x}] \n", instr.rt, instr.rs, (u64)instr.imm);
-      } break;
+static void
+ee_op_sra (R5900_Core *ee, u32, const Instruction &instr)
+{
+   s32 result                  = (ee->reg.r[instr.rt].SW[0]) >> (s32)instr.sa;
+   ee->reg.r[instr.rd].SD[0]   = result;
+   intlog("SRA source: [{:d}] dest: [{:d}] [{:#x}]\n", instr.rd, instr.rt, (s32)instr.sa);
+}
 
-      case 0x0D:
-      {
-         ee->reg.r[instr.rt].UD[0] = ee->reg.r[instr.rs].UD[0] | (u64)instr.imm;
-         intlog("ORI: [{:d}] [{:d}] [{:#x}] \n", instr.rt, instr.rs, (u64)instr.imm);
-      } break;
+static void
+ee_op_sllv (R5900_Core *ee, u32, const Instruction &instr)
+{
+   u32 sa                      = ee->reg.r[instr.rs].SW[0] & 0x1F;
+   ee->reg.r[instr.rd].SD[0]   = (s64)(ee->reg.r[instr.rt].SW[0] << sa);
+   intlog("SLLV source: [{:d}] dest: [{:d}] [{:#x}]\n", instr.rd, instr.rt, sa);
+}
 
-      case 0x0E:
-      {
-         ee->reg.r[instr.rt].UD[0] = ee->reg.r[instr.rs].UD[0] ^ (u64)instr.imm;
-         intlog("XORI [{:d}] [{:d}] [{:#x}] \n", instr.rt, instr.rs, (u64)instr.imm);
-      } break;
+static void
+ee_op_srlv (R5900_Core *ee, u32, const Instruction &instr)
+{
+   u32 sa                      = ee->reg.r[instr.rs].SW[0] & 0x1F;
+   ee->reg.r[instr.rd].SD[0]   = (s64)(ee->reg.r[instr.rt].SW[0] >> sa);
+   intlog("SRLV source: [{:d}] dest: [{:d}] [{:#x}]\n", instr.rd, instr.rt, sa);
+}
 
-      case 0x0F:
-      {
-         s64 imm                     = (s64)(s32)((instr.imm) << 16);
-         ee->reg.r[instr.rt].UD[0]   = imm;
+static void
+ee_op_srav (R5900_Core *ee, u32, const Instruction &instr)
+{
+   u32 sa                      = ee->reg.r[instr.rs].UB[0] & 0x1F;
+   s32 result                  = ee->reg.r[instr.rt].SW[0] >> sa;
+   ee->reg.r[instr.rd].SD[0]   = (s64)result;
+   intlog("SRAV [{:d}] [{:d}] [{:d}]\n", instr.rd, instr.rt, instr.rs);
+}
 
-         intlog("LUI [{:d}] [{:#x}]\n", instr.rt, imm);
-         // printf("LUI [{%d}] [{%#08x}]\n", rt, imm);
-      } break;
+static void
+ee_op_jr (R5900_Core *ee, u32, const Instruction &instr)
+{
+   // @TODO: Check if the LSB is 0
+   jump_to(ee, ee->reg.r[instr.rs].UW[0]);
+   intlog("JR source: [{:d}] pc_dest: [{:#x}]\n", instr.rs, ee->reg.r[instr.rs].UW[0]);
+}
 
-      case 0x14:
-      {
-         s32 imm         = instr.sign_imm << 2;
-         bool condition  = ee->reg.r[instr.rs].SD[0] == ee->reg.r[instr.rt].SD[0];
+static void
+ee_op_jalr (R5900_Core *ee, u32, const Instruction &instr)
+{
+   u32 return_addr = ee->pc + 8;
 
-         branch_likely(ee, condition, imm);
+   if (instr.rd != 0) {
+      ee->reg.r[instr.rd].UD[0] = return_addr;
+   } else {
+      ee->reg.r[31].UD[0] = return_addr;
+   }
 
-         intlog("BEQL [{:d}] [{:d}] [{:#x}]\n", instr.rs, instr.rt, imm);
-      } break;
+   jump_to(ee, ee->reg.r[instr.rs].UW[0]);
 
-      case 0x15:
-      {
-         s32 imm         = instr.sign_imm << 2;
-         bool condition  = ee->reg.r[instr.rs].SD[0] != ee->reg.r[instr.rt].SD[0];
+   intlog("JALR [{:d}]\n", instr.rs);
+}
 
-         branch_likely(ee, condition, imm);
+static void
+ee_op_movz (R5900_Core *ee, u32, const Instruction &instr)
+{
+   if (ee->reg.r[instr.rt].SD[0] == 0) {
+      ee->reg.r[instr.rd].SD[0] = ee->reg.r[instr.rs].SD[0];
+   }
+   intlog("MOVZ [{:d}] [{:d}] [{:d}]\n",instr.rd, instr.rs, instr.rt);
+}
 
-         intlog("BNEL [{:d}] [{:d}] [{:#x}]\n", instr.rs, instr.rt, imm);
-      } break;
+static void
+ee_op_movn (R5900_Core *ee, u32, const Instruction &instr)
+{
+   if (ee->reg.r[instr.rt].UD[0] != 0) {
+      ee->reg.r[instr.rd].UD[0] = ee->reg.r[instr.rs].UD[0];
+   }
+   intlog("MOVN [{:d}] [{:d}] [{:d}]\n", instr.rd, instr.rs, instr.rt);
+}
 
-      case 0x16:
-      {
-         s32 offset      = (instr.sign_offset << 2);
-         bool condition  = ee->reg.r[instr.rs].SD[0] <= 0;
+static void
+ee_op_syscall (R5900_Core *ee, u32, const Instruction &)
+{
+   SYSCALL(ee);
+}
 
-         branch_likely(ee, condition, offset);
+static void
+ee_op_break (R5900_Core *, u32, const Instruction &)
+{
+   // @@Implementation We have no debugger yet so theres no need to implement this now
+   // intlog("BREAKPOINT\n");
+}
 
-         intlog("BLEZL [{:d}] [{:#x}]\n", instr.rs, offset);
-      } break;
+static void
+ee_op_sync (R5900_Core *, u32, const Instruction &)
+{
+   // @@Note: Issued after every MTC0 write The PS2 possibly executes millions of memory loads / stores per second,
+   // which is entirely feasible in hardware. But a complete pain in software as that would completely kill performance
+   // May be cool to implement this for accuracy since that is the purpose of the emulator
+   // intlog("SYNC\n");
+}
 
-      case 0x19:
-      {
-         ee->reg.r[instr.rt].UD[0] = ee->reg.r[instr.rs].SD[0] + instr.sign_imm;
-         intlog("DADDIU [{:d}] [{:d}] [{:#x}]\n", instr.rt, instr.rs, instr.sign_imm);
-      } break;
+static void
+ee_op_mfhi (R5900_Core *ee, u32, const Instruction &instr)
+{
+   ee->reg.r[instr.rd].UD[0] = ee->HI;
+   intlog("MFHI [{:d}]\n", instr.rd);
+}
 
-      case 0x1A:
-      {
-         u32 vaddr           = ee->reg.r[instr.rs].UW[0] + (s32)instr.sign_offset;
-         u32 aligned_vaddr   = vaddr & ~0x7;
-         u32 shift           = vaddr & 0x7;
-
-         u64 aligned_dword   = ee_core_load_64(aligned_vaddr);
-         u64 result          = ((ee->reg.r[instr.rt].UD[0] & LDL_MASK[shift]) | (aligned_vaddr << LDL_SHIFT[shift]));
-         ee->reg.r[instr.rt].UD[0] = result;
-         intlog("LDL [{:d}] [{:#x}] [{:d}]\n", instr.rt, (s32)instr.sign_offset, instr.rs);
-      } break;
+static void
+ee_op_mthi (R5900_Core *ee, u32, const Instruction &instr)
+{
+   ee->HI = ee->reg.r[instr.rs].UD[0];
+   intlog("MTHI [{:d}]\n", instr.rs);
+}
 
-      case 0x1B:
-      {
-         u32 vaddr           = ee->reg.r[instr.rs].UW[0] + (s32)instr.sign_offset;
-         u32 aligned_vaddr   = vaddr & ~0x7;
-         u32 shift           = vaddr & 0x7;
-
-         u64 aligned_dword   = ee_core_load_64(aligned_vaddr);
-         u64 result          = ((ee->reg.r[instr.rt].UD[0] & LDR_MASK[shift]) | (aligned_vaddr << LDR_SHIFT[shift]));
-         ee->reg.r[instr.rt].UD[0] = result;
-         intlog("LDR [{:d}] [{:#x}] [{:d}]\n", instr.rt, (s32)instr.sign_offset, instr.rs);
-         printf("LDR [{%d}] [{%#x}] [{%d}]\n", instr.rt, (s32)instr.sign_offset, instr.rs);
-      } break;
+static void
+ee_op_mflo (R5900_Core *ee, u32, const Instruction &instr)
+{
+   ee->reg.r[instr.rd].UD[0] = ee->LO;
+   intlog("MFLO [{:d}] \n", instr.rd);
+}
 
-      case 0x1E:
-      {
-         u32 vaddr = ee->reg.r[instr.rs].UW[0] + (s32)instr.sign_offset;
+static void
+ee_op_mtlo (R5900_Core *ee, u32, const Instruction &instr)
+{
+   ee->LO = ee->reg.r[instr.rs].UD[0];
+   intlog("MTLO [{:d}]\n", instr.rs);
+}
 
-         if (check_address_error_exception(ee, _LOAD, _QUAD, vaddr))
-            return;
+static void
+ee_op_dsllv (R5900_Core *ee, u32, const Instruction &instr)
+{
+   s32 sa                      = ee->reg.r[instr.rs].UW[0] & 0x3F;
+   ee->reg.r[instr.rd].UD[0]   = ee->reg.r[instr.rt].UD[0] << sa;
+   intlog("DSLLV [{:d}] [{:d}] [{:d}]\n", instr.rd, instr.rt, instr.rs);
+}
 
-         ee->reg.r[instr.rt].UD[0] = ee_core_load_64(vaddr);
-         ee->reg.r[instr.rt].UD[1] = ee_core_load_64(vaddr + 8);
-         // intlog("LQ [{:d}] [{:#x}] [{:d}]\n", instr.rt, (s32)instr.sign_offset, instr.rs);
-      } break;
+static void
+ee_op_dsrav (R5900_Core *ee, u32, const Instruction &instr)
+{
+   u32 sa                      = ee->reg.r[instr.rs].UW[0] & 0x3F;
+   ee->reg.r[instr.rd].SD[0]   = ee->reg.r[instr.rt].SD[0] >> sa;
+   intlog("DSRAV [{:d}] [{:d}] [{:d}]\n", instr.rd, instr.rt, instr.rs);
+}
 
-      case 0x1F:
-      {
-         u32 vaddr   = ee->reg.r[instr.rs].UW[0] + instr.sign_offset;
-         u64 lov     = ee->reg.r[instr.rt].UD[0];
-         u64 hiv     = ee->reg.r[instr.rt].UD[1];
+static void
+ee_op_mult (R5900_Core *ee, u32, const Instruction &instr)
+{
+   s64 w1      = (s64)ee->reg.r[instr.rs].SW[0];
+   s64 w2      = (s64)ee->reg.r[instr.rt].SW[0];
+   s64 prod    = (w1 * w2);
+
+   ee->LO      = (s32)(prod & 0xFFFFFFFF);
+   ee->HI      = (s32)(prod >> 32);
+   // @@Note: C790 apparently states that the chip does not always call mflo everytime
+   // during a 3 operand mult
+   // But we could always use mflo because of the pipeline interlock
+   ee->reg.r[instr.rd].SD[0] = ee->LO;
+   intlog("MULT [{:d}] [{:d}] [{:d}]\n", instr.rs, instr.rt, instr.rd);
+}
 
-         if (check_address_error_exception(ee, _STORE, _QUAD, vaddr))
-            return;
+static void
+ee_op_div (R5900_Core *ee, u32, const Instruction &instr)
+{
+   if (ee->reg.r[instr.rt].UD[0] == 0) {
+      ee->LO = (int)0xffffffff;
+      ee->HI = ee->reg.r[instr.rs].UD[0];
+      errtrace("[ERROR]: Tried to Divide by zero\n");
+   //return;
+   }
+   s32 d   = ee->reg.r[instr.rs].SW[0] / ee->reg.r[instr.rt].SW[0];
+   s32 q   = ee->reg.r[instr.rs].SW[0] % ee->reg.r[instr.rt].SW[0];
+   ee->LO  = (s64)d;
+   ee->HI  = (s64)q;
+   intlog("DIV [{:d}] [{:d}]\n", instr.rs, instr.rt);
+}
 
-         ee_core_store_64(vaddr, lov);
-         ee_core_store_64(vaddr + 8, hiv);
-         // intlog("SQ [{:d}] [{:#x}] [{:d}] \n", instr.rt, instr.sign_offset, base);
-      } break;
+static void
+ee_op_divu (R5900_Core *ee, u32, const Instruction &instr)
+{
+   s64 w1 = (s64)ee->reg.r[instr.rs].SW[0];
+   s64 w2 = (s64)ee->reg.r[instr.rt].SW[0];
 
-      case 0x20:
-      {
-         u32 vaddr = ee->reg.r[instr.rs].UW[0] + (s32)instr.sign_offset;
+   if (w2 == 0) {
+      errtrace("[ERROR]: Tried to Divide by zero\n");
+      //return;
+   }
+   // @@Note: Sign extend by 64?
+   s64 q   = (s32)(w1 / w2);
+   ee->LO  = q;
+   s64 r   = (s32)(w1 % w2);
+   ee->HI  = r;
+   intlog("DIVU [{:d}] [{:d}]\n", instr.rs, instr.rt);
+}
 
-         ee->reg.r[instr.rt].SD[0] = (s64)ee_core_load_8(vaddr);
-         intlog("LB [{:d}] [{:#x}] [{:d}] \n", instr.rt, (s32)instr.sign_offset, instr.rs);
-      } break;
+static void
+ee_op_add (R5900_Core *ee, u32, const Instruction &instr)
+{
+   // @@Incomplete: The add instruction must signal an exception on overflow
+   // but we have no overflow detection for now
+   int temp                    = ee->reg.r[instr.rs].SW[0] + ee->reg.r[instr.rt].SW[0];
+   ee->reg.r[instr.rd].SD[0]   = (s64)temp;
+   intlog("ADD [{:d}] [{:d}] [{:d}]\n", instr.rd, instr.rs, instr.rt);
+}
 
-      case 0x21:
-      {
-         u32 vaddr = ee->reg.r[instr.rs].UW[0] + (s32)instr.sign_offset;
+static void
+ee_op_addu (R5900_Core *ee, u32, const Instruction &instr)
+{
+   s32 result                  = ee->reg.r[instr.rs].SW[0] + ee->reg.r[instr.rt].SW[0];
+   ee->reg.r[instr.rd].UD[0]   = result;
+   intlog("ADDU [{:d}] [{:d}] [{:d}]\n", instr.rd, instr.rs, instr.rt);
+}
 
-         if (check_address_error_exception(ee, _LOAD, _HALF, vaddr))
-            return;
+static void
+ee_op_sub (R5900_Core *ee, u32, const Instruction &instr)
+{
+   s32 result                  = ee->reg.r[instr.rs].SW[0] - ee->reg.r[instr.rt].SW[0];
+   ee->reg.r[instr.rd].UD[0]   = (s64)result;
 
-         ee->reg.r[instr.rt].SD[0] = (s64)ee_core_load_16(vaddr);
-         intlog("LH [{:d}] [{:#x}] [{:d}] \n", instr.rt, (s32)instr.sign_offset, instr.rs);
-      } break;
+   /* @@Incomplete: No 2 complement Arithmetic Overflow error implementation*/
+   intlog("SUB [{:d}] [{:d}] [{:d}]\n", instr.rd, instr.rs, instr.rt);
+}
 
-      case 0x23:
-      {
-         u32 vaddr = ee->reg.r[instr.rs].UW[0] + (s32)instr.sign_offset;
+static void
+ee_op_subu (R5900_Core *ee, u32, const Instruction &instr)
+{
+   s32 result                  = ee->reg.r[instr.rs].SW[0] - ee->reg.r[instr.rt].SW[0];
+   ee->reg.r[instr.rd].UD[0]   = (u64)result;
+   intlog("SUBU [{:d}] [{:d}] [{:d}]\n", instr.rd, instr.rs, instr.rt);
+}
 
-         if (check_address_error_exception(ee, _LOAD, _WORD, vaddr))
-             return;
+static void
+ee_op_and (R5900_Core *ee, u32, const Instruction &instr)
+{
+   ee->reg.r[instr.rd].UD[0] = ee->reg.r[instr.rs].UD[0] & ee->reg.r[instr.rt].UD[0];
+   intlog("AND [{:d}] [{:d}] [{:d}] \n", instr.rd, instr.rs, instr.rt);
+}
 
-         ee->reg.r[instr.rt].SD[0] = (s64)ee_core_load_32(vaddr);
-         intlog("LW [{:d}] [{:#x}] [{:d}] \n", instr.rt, (s32)instr.sign_offset, instr.rs);
-      } break;
+static void
+ee_op_or (R5900_Core *ee, u32, const Instruction &instr)
+{
+   ee->reg.r[instr.rd].SD[0] = ee->reg.r[instr.rs].SD[0] | ee->reg.r[instr.rt].SD[0];
+   intlog("OR [{:d}] [{:d}] [{:d}]\n", instr.rd, instr.rs, instr.rt);
+}
 
-      case 0x24:
-      {
-         u32 vaddr                   = ee->reg.r[instr.rs].UW[0] + (s32)instr.sign_offset;
-         ee->reg.r[instr.rt].UD[0]   = (u64)ee_core_load_8(vaddr);
-         intlog("LBU [{:d}] [{:#x}] [{:d}] \n", instr.rt, (s32)instr.sign_offset, instr.rs);
-      } break;
+static void
+ee_op_nor (R5900_Core *ee, u32, const Instruction &instr)
+{
+   ee->reg.r[instr.rd].SD[0] = ~(ee->reg.r[instr.rs].SD[0] | ee->reg.r[instr.rt].SD[0]);
+   // assert(1);
+   intlog("NOR [{:d}] [{:d}] [{:d}]\n", instr.rd, instr.rs, instr.rt);
+}
 
-      case 0x25:
-      {
-         u32 vaddr = ee->reg.r[instr.rs].UW[0] + (s32)instr.sign_offset;
+static void
+ee_op_mfsa (R5900_Core *ee, u32, const Instruction &instr)
+{
+   ee->reg.r[instr.rd].UD[0] = ee->sa;
+   intlog("MFSA [{:d}]\n", instr.rd);
+}
 
-         if (check_address_error_exception(ee, _LOAD, _HALF, vaddr))
-            return;
+static void
+ee_op_mtsa (R5900_Core *ee, u32, const Instruction &instr)
+{
+   ee->sa = ee->reg.r[instr.rs].UW[0];
+   intlog("MTSA [{:d}]\n", instr.rs);
+}
 
-         ee->reg.r[instr.rt].UD[0] = (u64)ee_core_load_16(vaddr);
-         intlog("LHU [{:d}] [{:#x}] [{:d}] \n", instr.rt, (s32)instr.sign_offset, instr.rs);
-      } break;
+static void
+ee_op_slt (R5900_Core *ee, u32, const Instruction &instr)
+{
+   s32 result                  = ee->reg.r[instr.rs].SD[0] < ee->reg.r[instr.rt].SD[0] ? 1 : 0;
+   ee->reg.r[instr.rd].SD[0]   = result;
+   intlog("SLT [{:d}] [{:d}] [{:d}]\n", instr.rd, instr.rs, instr.rt);
+}
 
-      case 0x27:
-      {
-         u32 vaddr = ee->reg.r[instr.rs].UW[0] + (s32)instr.sign_offset;
+static void
+ee_op_sltu (R5900_Core *ee, u32, const Instruction &instr)
+{
+   u32 result                  = (ee->reg.r[instr.rs].UD[0] < ee->reg.r[instr.rt].UD[0]) ? 1 : 0;
+   ee->reg.r[instr.rd].UD[0]   = result;
+   intlog("SLTU [{:d}] [{:d}] [{:d}]\n", instr.rd, instr.rs, instr.rt);
+}
 
-         if (check_address_error_exception(ee, _LOAD, _WORD, vaddr))
-            return;
+static void
+ee_op_daddu (R5900_Core *ee, u32, const Instruction &instr)
+{
+   ee->reg.r[instr.rd].UD[0] = ee->reg.r[instr.rs].SD[0] + ee->reg.r[instr.rt].SD[0];
+   intlog("DADDU [{:d}] [{:d}] [{:d}]\n", instr.rd, instr.rs, instr.rt);
+}
 
-         ee->reg.r[instr.rt].SD[0] = (u64)ee_core_load_32(vaddr);
-         intlog("LWU [{:d}] [{:#x}] [{:d}] \n", instr.rt, (s32)instr.sign_offset, instr.rs);
-      } break;
+static void
+ee_op_dsll (R5900_Core *ee, u32, const Instruction &instr)
+{
+   ee->reg.r[instr.rd].UD[0] = ee->reg.r[instr.rt].UD[0] << instr.sa;
+   intlog("DSLL source: [{:d}] dest: [{:d}] [{:#x}]\n", instr.rd, instr.rt, instr.sa);
+}
 
-      case 0x28:
-      {
-         u32 vaddr   = ee->reg.r[instr.rs].UW[0] + (s32)instr.sign_offset;
-         s8 value    = ee->reg.r[instr.rt].SB[0];
+static void
+ee_op_dsrl (R5900_Core *ee, u32, const Instruction &instr)
+{
+   ee->reg.r[instr.rd].UD[0] = ee->reg.r[instr.rt].UD[0] >> instr.sa;
+   intlog("DSRL source: [{:d}] dest: [{:d}] s: [{:#x}] \n", instr.rd, instr.rt, instr.sa);
+}
 
-         ee_core_store_8(vaddr, value);
-         intlog("SB [{:d}] [{:#x}] [{:d}] \n", instr.rt, (s32)instr.sign_offset, instr.rs);
-      } break;
+static void
+ee_op_dsll32 (R5900_Core *ee, u32, const Instruction &instr)
+{
+   u32 s                       = instr.sa + 32;
+   ee->reg.r[instr.rd].UD[0]   = ee->reg.r[instr.rt].UD[0] << s;
+   intlog("DSLL32 source: [{:d}] dest: [{:d}] s: [{:#x}] \n", instr.rd, instr.rt, s);
+}
 
-      case 0x29:
-      {
-         u32 vaddr   = ee->reg.r[instr.rs].UW[0] + (s32)instr.sign_offset;
-         s16 value   = ee->reg.r[instr.rt].SH[0];
+static void
+ee_op_dsrl32 (R5900_Core *ee, u32, const Instruction &instr)
+{
+   u32 s                       = instr.sa + 32;
+   ee->reg.r[instr.rd].UD[0]   = ee->reg.r[instr.rt].UD[0] >> s;
+   intlog("DSRL32 source: [{:d}] dest: [{:d}] s: [{:#x}] \n", instr.rd, instr.rt, s);
+}
 
-         if (check_address_error_exception(ee, _STORE, _HALF, vaddr))
-            return;
+static void
+ee_op_dsra32 (R5900_Core *ee, u32, const Instruction &instr)
+{
+   u32 s = instr.sa + 32;
+   s64 result = ee->reg.r[instr.rt].SD[0] >> s;
+   ee->reg.r[instr.rd].SD[0] = result;
+   intlog("DSRA32 source: [{:d}] dest: [{:d}] s: [{:#x}] \n", instr.rd, instr.rt, s);
+}
 
-         ee_core_store_16(vaddr, value);
-         intlog("SH [{:d}] [{:#x}] [{:d}] \n", instr.rt, (s32)instr.sign_offset, instr.rs);
-      } break;
+static void
+ee_op_special_unknown (R5900_Core *, u32 instruction, const Instruction &)
+{
+   errtrace("[ERROR]: Could not interpret special instruction: [{:#09x}]\n", instruction);
+}
 
-      case 0x2B:
-      {
-         u32 vaddr = ee->reg.r[instr.rs].UW[0] + (s32)instr.sign_offset;
-         s32 value = ee->reg.r[instr.rt].SW[0];
+/*******************************************
+ * MMI Instructions
+*******************************************/
+static void
+ee_op_mmi (R5900_Core *ee, u32 instruction, const Instruction &)
+{
+   ee_mmi_execute(ee, instruction);
+   intlog("MMI [{:#09x}]\n", instruction);
+}
 
-         if (check_address_error_exception(ee, _STORE, _WORD, vaddr))
-            return;
+/*******************************************
+ * REGIMM Instructions
+*******************************************/
+static void
+ee_op_bltz (R5900_Core *ee, u32, const Instruction &instr)
+{
+   s32 offset      = instr.sign_offset << 2;
+   bool condition  = ee->reg.r[instr.rs].SD[0] < 0;
+   branch(ee, condition, offset);
 
-         ee_core_store_32(vaddr, value);
-         intlog("SW [{:d}] [{:#x}] [{:d}] \n", instr.rt, instr.sign_offset, instr.rs);
-      } break;
+   intlog("BLTZ [{:d}] [{:#x}] \n", instr.rs, offset);
+}
 
-      case 0x2C:
-      {
-         u32 vaddr           = ee->reg.r[instr.rs].UW[0] + instr.sign_offset;
-         u32 aligned_vaddr   = vaddr & ~0x7;
-         u32 shift           = vaddr & 0x7;
-
-         u64 aligned_dword   = ee_core_load_64(aligned_vaddr);
-         u64 result          = ((ee->reg.r[instr.rt].UD[0] & SDL_MASK[shift]) | (aligned_vaddr << SDL_SHIFT[shift]));
-         ee_core_store_64(aligned_vaddr, result);
-         intlog("SDL [{:d}] [{:#x}] [{:d}]\n", instr.rt, instr.sign_offset, instr.rs);
-         printf("SDL [{%d}] [{%#x}] [{%d}]\n", instr.rt, instr.sign_offset, instr.rs);
-      } break;
+static void
+ee_op_bgez (R5900_Core *ee, u32, const Instruction &instr)
+{
+   s32 offset      = instr.sign_offset << 2;
+   bool condition  = ee->reg.r[instr.rs].SD[0] >= 0;
+   branch(ee, condition, offset);
 
-      case 0x2D:
-      {
-         u32 vaddr           = ee->reg.r[instr.rs].UW[0] + instr.sign_offset;
-         u32 aligned_vaddr   = vaddr & ~0x7;
-         u32 shift           = vaddr & 0x7;
-
-         u64 aligned_dword   = ee_core_load_64(aligned_vaddr);
-         u64 result          = ((ee->reg.r[instr.rt].UD[0] & SDR_MASK[shift]) | (aligned_vaddr << SDR_SHIFT[shift]));
-         ee_core_store_64(aligned_vaddr, result);
-         intlog("SDR [{:d}] [{:#x}] [{:d}]\n", instr.rt, instr.sign_offset, instr.rs);
-         printf("SDR [{%d}] [{%#x}] [{%d}]\n", instr.rt, instr.sign_offset, instr.rs);
-      } break;
+   intlog("BGEZ [{:d}] [{:#x}] \n", instr.rs, offset);
+}
 
-      case 0x2F:
-      {
-         // intlog("Invalidate instruction cache");
-      } break;
+// @@Note: SA holds the byte shift amount of QFSRV
+static void
+ee_op_mtsab (R5900_Core *ee, u32, const Instruction &instr)
+{
+   ee->sa = (ee->reg.r[instr.rs].UW[0] & 0xF) ^ (instr.imm & 0xF);
+   intlog("MTSAB [{:d}] [{:#x}]\n", instr.rs, instr.imm);
+}
 
-      case 0x31:
-      {
-         u32 vaddr = ee->reg.r[instr.rs].UW[0] + (s32)instr.sign_offset;
+static void
+ee_op_mtsah (R5900_Core *ee, u32, const Instruction &instr)
+{
+   ee->sa = ((ee->reg.r[instr.rs].UW[0] & 0x7) ^ (instr.imm & 0x7)) << 1;
+   intlog("MTSAH [{:d}] [{:#x}]\n", instr.rs, instr.imm);
+}
 
-         if (check_address_error_exception(ee, _LOAD, _WORD, vaddr))
-            return;
+static void
+ee_op_regimm_unknown (R5900_Core *, u32 instruction, const Instruction &)
+{
+   errtrace("[ERROR]: Could not interpret REGIMM instruction [{:#09x}]\n", (instruction >> 16) & 0x1F);
+}
 
-         u32 data = (u32)ee_core_load_32(vaddr);
+/*******************************************
+ * Normal Instructions
+*******************************************/
+static void
+ee_op_j (R5900_Core *ee, u32, const Instruction &instr)
+{
+   u32 offset = ((ee->pc + 4) & 0xF0000000) + (instr.instr_index << 2);
+   jump_to(ee, offset);
+   intlog("J [{:#x}]\n", offset);
+}
 
-         cop1_setFPR(instr.rt, data);
-         intlog("LWC1 [{:d}] [{:#x}] [{:d}] \n", instr.rt, (s32)instr.sign_offset, instr.rs);
-      } break;
+static void
+ee_op_jal (R5900_Core *ee, u32, const Instruction &instr)
+{
+   u32 instr_index     = instr.instr_index;
+   u32 target_address  = ((ee->pc + 4) & 0xF0000000) + (instr_index << 2);
 
-      case 0x37:
-      {
-         u32 vaddr = ee->reg.r[instr.rs].UW[0] + (s32)instr.sign_offset;
+   jump_to(ee, target_address);
+   ee->reg.r[31].UD[0]  = ee->pc + 8;
 
-         if (check_address_error_exception(ee, _LOAD, _DOUBLE, vaddr))
-            return;
+   intlog("JAL [{:#x}] \n", target_address);
+}
 
-         ee->reg.r[instr.rt].UD[0] = ee_core_load_64(vaddr);
-         intlog("LD [{:d}] [{:#x}] [{:d}]\n", instr.rt, (s32)instr.sign_offset, instr.rs);
-      } break;
+static void
+ee_op_beq (R5900_Core *ee, u32, const Instruction &instr)
+{
+   s32 imm         = instr.sign_imm << 2;
+   bool condition  = ee->reg.r[instr.rs].SD[0] == ee->reg.r[instr.rt].SD[0];
 
-      case 0x39:
-      {
-         u32 vaddr = ee->reg.r[instr.rs].UW[0] + (s32)instr.sign_offset;
+   branch(ee, condition, imm);
 
-         if (check_address_error_exception(ee, _STORE, _WORD, vaddr))
-            return;
+   intlog("BEQ [{:d}] [{:d}] [{:#x}] \n", instr.rs, instr.rt, imm);
+}
 
-         ee_core_store_32(vaddr, cop1_getFPR(instr.rt));
-         intlog("SWC1 [{:d}] [{:#x}] [{:d}] \n", instr.rt, (s32)instr.sign_offset, instr.rs);
-      } break;
+static void
+ee_op_bne (R5900_Core *ee, u32, const Instruction &instr)
+{
+   s32 imm         = instr.sign_imm << 2;
+   bool condition  = ee->reg.r[instr.rs].SD[0] != ee->reg.r[instr.rt].SD[0];
 
-      case 0x3F:
-      {
-         u32 vaddr   = ee->reg.r[instr.rs].UW[0] + (s32)instr.sign_offset;
-         u64 value   = ee->reg.r[instr.rt].UD[0];
+   branch(ee, condition, imm);
 
-         if (check_address_error_exception(ee, _STORE, _DOUBLE, vaddr))
-            return;
+   intlog("BNE [{:d}] [{:d}], [{:#x}]\n", instr.rt, instr.rs, imm);
+}
 
-         ee_core_store_64(vaddr, value);
+static void
+ee_op_blez (R5900_Core *ee, u32, const Instruction &instr)
+{
+   s32 offset      = (instr.sign_offset << 2);
+   bool condition  = ee->reg.r[instr.rs].SD[0] <= 0;
 
-         // intlog("SD [{:d}] [{:#x}] [{:d}] \n", instr.rt, (s32)instr.sign_offset, instr.rs);
-      } break;
+   branch(ee, condition, offset);
 
-      default:
+   intlog("BLEZ [{:d}] [{:#x}]\n", instr.rs, offset);
+}
+
+static void
+ee_op_bgtz (R5900_Core *ee, u32, const Instruction &instr)
+{
+   s32 offset      = instr.sign_offset << 2;
+   bool condition  = ee->reg.r[instr.rs].SD[0] > 0;
+
+   branch(ee, condition, offset);
+
+   intlog("BGTZ [{:d}] [{:#x}] \n", instr.rs, offset);
+}
+
+static void
+ee_op_addi (R5900_Core *ee, u32, const Instruction &instr)
+{
+   s32 result                  = ee->reg.r[instr.rs].SD[0] + instr.sign_imm;
+   ee->reg.r[instr.rt].SD[0]   = result;
+   /* @@Incomplete: No 2 complement Arithmetic Overflow error implementation*/
+   intlog("ADDI: [{:d}] [{:d}] [{:#x}] \n", instr.rt, instr.rs, instr.sign_imm);
+}
+
+static void
+ee_op_addiu (R5900_Core *ee, u32, const Instruction &instr)
+{
+   s32 result                  = ee->reg.r[instr.rs].SD[0] + instr.sign_imm;
+   ee->reg.r[instr.rt].SD[0]   = result;
+   intlog("ADDIU: [{:d}] [{:d}] [{:#x}] \n", instr.rt, instr.rs, instr.sign_imm);
+}
+
+static void
+ee_op_slti (R5900_Core *ee, u32, const Instruction &instr)
+{
+   s32 result                  = (ee->reg.r[instr.rs].SD[0] < (s32)instr.sign_imm) ? 1 : 0;
+   ee->reg.r[instr.rt].SD[0]   = result;
+
+   intlog("SLTI [{:d}] [{:d}], [{:#x}]\n", instr.rt, instr.rs, instr.sign_imm);
+}
+
+static void
+ee_op_sltiu (R5900_Core *ee, u32, const Instruction &instr)
+{
+   u32 result                  = (ee->reg.r[instr.rs].UD[0] < (u64)instr.sign_imm) ? 1 : 0;
+   ee->reg.r[instr.rt].UD[0]   = result;
+
+   intlog("SLTIU [{:d}] [{:d}] [{:#x}]\n", instr.rt, instr.rs, (u64)instr.sign_imm);
+}
+
+static void
+ee_op_andi (R5900_Core *ee, u32, const Instruction &instr)
+{
+   ee->reg.r[instr.rt].UD[0] = ee->reg.r[instr.rs].UD[0] & (u64)instr.imm;
+   intlog("ANDI: [{:d}] [{:d}] [{:#x}] \n", instr.rt, instr.rs, (u64)instr.imm);
+}
+
+static void
+ee_op_ori (R5900_Core *ee, u32, const Instruction &instr)
+{
+   ee->reg.r[instr.rt].UD[0] = ee->reg.r[instr.rs].UD[0] | (u64)instr.imm;
+   intlog("ORI: [{:d}] [{:d}] [{:#x}] \n", instr.rt, instr.rs, (u64)instr.imm);
+}
+
+static void
+ee_op_xori (R5900_Core *ee, u32, const Instruction &instr)
+{
+   ee->reg.r[instr.rt].UD[0] = ee->reg.r[instr.rs].UD[0] ^ (u64)instr.imm;
+   intlog("XORI [{:d}] [{:d}] [{:#x}] \n", instr.rt, instr.rs, (u64)instr.imm);
+}
+
+static void
+ee_op_lui (R5900_Core *ee, u32, const Instruction &instr)
+{
+   s64 imm                     = (s64)(s32)((instr.imm) << 16);
+   ee->reg.r[instr.rt].UD[0]   = imm;
+
+   intlog("LUI [{:d}] [{:#x}]\n", instr.rt, imm);
+   // printf("LUI [{%d}] [{%#08x}]\n", rt, imm);
+}
+
+static void
+ee_op_beql (R5900_Core *ee, u32, const Instruction &instr)
+{
+   s32 imm         = instr.sign_imm << 2;
+   bool condition  = ee->reg.r[instr.rs].SD[0] == ee->reg.r[instr.rt].SD[0];
+
+   branch_likely(ee, condition, imm);
+
+   intlog("BEQL [{:d}] [{:d}] [{:#x}]\n", instr.rs, instr.rt, imm);
+}
+
+static void
+ee_op_bnel (R5900_Core *ee, u32, const Instruction &instr)
+{
+   s32 imm         = instr.sign_imm << 2;
+   bool condition  = ee->reg.r[instr.rs].SD[0] != ee->reg.r[instr.rt].SD[0];
+
+   branch_likely(ee, condition, imm);
+
+   intlog("BNEL [{:d}] [{:d}] [{:#x}]\n", instr.rs, instr.rt, imm);
+}
+
+static void
+ee_op_blezl (R5900_Core *ee, u32, const Instruction &instr)
+{
+   s32 offset      = (instr.sign_offset << 2);
+   bool condition  = ee->reg.r[instr.rs].SD[0] <= 0;
+
+   branch_likely(ee, condition, offset);
+
+   intlog("BLEZL [{:d}] [{:#x}]\n", instr.rs, offset);
+}
+
+static void
+ee_op_daddiu (R5900_Core *ee, u32, const Instruction &instr)
+{
+   ee->reg.r[instr.rt].UD[0] = ee->reg.r[instr.rs].SD[0] + instr.sign_imm;
+   intlog("DADDIU [{:d}] [{:d}] [{:#x}]\n", instr.rt, instr.rs, instr.sign_imm);
+}
+
+static void
+ee_op_ldl (R5900_Core *ee, u32, const Instruction &instr)
+{
+   u32 vaddr           = ee->reg.r[instr.rs].UW[0] + (s32)instr.sign_offset;
+   u32 aligned_vaddr   = vaddr & ~0x7;
+   u32 shift           = vaddr & 0x7;
+
+   u64 aligned_dword   = ee_core_load_64(aligned_vaddr);
+   u64 result          = ((ee->reg.r[instr.rt].UD[0] & LDL_MASK[shift]) | (aligned_vaddr << LDL_SHIFT[shift]));
+   ee->reg.r[instr.rt].UD[0] = result;
+   intlog("LDL [{:d}] [{:#x}] [{:d}]\n", instr.rt, (s32)instr.sign_offset, instr.rs);
+}
+
+static void
+ee_op_ldr (R5900_Core *ee, u32, const Instruction &instr)
+{
+   u32 vaddr           = ee->reg.r[instr.rs].UW[0] + (s32)instr.sign_offset;
+   u32 aligned_vaddr   = vaddr & ~0x7;
+   u32 shift           = vaddr & 0x7;
+
+   u64 aligned_dword   = ee_core_load_64(aligned_vaddr);
+   u64 result          = ((ee->reg.r[instr.rt].UD[0] & LDR_MASK[shift]) | (aligned_vaddr << LDR_SHIFT[shift]));
+   ee->reg.r[instr.rt].UD[0] = result;
+   intlog("LDR [{:d}] [{:#x}] [{:d}]\n", instr.rt, (s32)instr.sign_offset, instr.rs);
+   systrace("LDR [{:d}] [{:#x}] [{:d}]\n", instr.rt, (u32)instr.sign_offset, instr.rs);
+}
+
+static void
+ee_op_lq (R5900_Core *ee, u32, const Instruction &instr)
+{
+   u32 vaddr = ee->reg.r[instr.rs].UW[0] + (s32)instr.sign_offset;
+
+   ee->reg.r[instr.rt].UQ = ee_core_load_128(vaddr);
+   // intlog("LQ [{:d}] [{:#x}] [{:d}]\n", instr.rt, (s32)instr.sign_offset, instr.rs);
+}
+
+static void
+ee_op_sq (R5900_Core *ee, u32, const Instruction &instr)
+{
+   u32 vaddr = ee->reg.r[instr.rs].UW[0] + (s32)instr.sign_offset;
+
+   ee_core_store_128(vaddr, ee->reg.r[instr.rt].UQ);
+   // intlog("SQ [{:d}] [{:#x}] [{:d}] \n", instr.rt, instr.sign_offset, base);
+}
+
+static void
+ee_op_lb (R5900_Core *ee, u32, const Instruction &instr)
+{
+   u32 vaddr = ee->reg.r[instr.rs].UW[0] + (s32)instr.sign_offset;
+
+   ee->reg.r[instr.rt].SD[0] = (s64)ee_core_load_8(vaddr);
+   intlog("LB [{:d}] [{:#x}] [{:d}] \n", instr.rt, (s32)instr.sign_offset, instr.rs);
+}
+
+static void
+ee_op_lh (R5900_Core *ee, u32, const Instruction &instr)
+{
+   u32 vaddr = ee->reg.r[instr.rs].UW[0] + (s32)instr.sign_offset;
+
+   if (check_address_error_exception(ee, _LOAD, _HALF, vaddr))
+      return;
+
+   ee->reg.r[instr.rt].SD[0] = (s64)ee_core_load_16(vaddr);
+   intlog("LH [{:d}] [{:#x}] [{:d}] \n", instr.rt, (s32)instr.sign_offset, instr.rs);
+}
+
+static void
+ee_op_lw (R5900_Core *ee, u32, const Instruction &instr)
+{
+   u32 vaddr = ee->reg.r[instr.rs].UW[0] + (s32)instr.sign_offset;
+
+   if (check_address_error_exception(ee, _LOAD, _WORD, vaddr))
+       return;
+
+   ee->reg.r[instr.rt].SD[0] = (s64)ee_core_load_32(vaddr);
+   intlog("LW [{:d}] [{:#x}] [{:d}] \n", instr.rt, (s32)instr.sign_offset, instr.rs);
+}
+
+static void
+ee_op_lbu (R5900_Core *ee, u32, const Instruction &instr)
+{
+   u32 vaddr                   = ee->reg.r[instr.rs].UW[0] + (s32)instr.sign_offset;
+   ee->reg.r[instr.rt].UD[0]   = (u64)ee_core_load_8(vaddr);
+   intlog("LBU [{:d}] [{:#x}] [{:d}] \n", instr.rt, (s32)instr.sign_offset, instr.rs);
+}
+
+static void
+ee_op_lhu (R5900_Core *ee, u32, const Instruction &instr)
+{
+   u32 vaddr = ee->reg.r[instr.rs].UW[0] + (s32)instr.sign_offset;
+
+   if (check_address_error_exception(ee, _LOAD, _HALF, vaddr))
+      return;
+
+   ee->reg.r[instr.rt].UD[0] = (u64)ee_core_load_16(vaddr);
+   intlog("LHU [{:d}] [{:#x}] [{:d}] \n", instr.rt, (s32)instr.sign_offset, instr.rs);
+}
+
+static void
+ee_op_lwu (R5900_Core *ee, u32, const Instruction &instr)
+{
+   u32 vaddr = ee->reg.r[instr.rs].UW[0] + (s32)instr.sign_offset;
+
+   if (check_address_error_exception(ee, _LOAD, _WORD, vaddr))
+      return;
+
+   ee->reg.r[instr.rt].SD[0] = (u64)ee_core_load_32(vaddr);
+   intlog("LWU [{:d}] [{:#x}] [{:d}] \n", instr.rt, (s32)instr.sign_offset, instr.rs);
+}
+
+static void
+ee_op_sb (R5900_Core *ee, u32, const Instruction &instr)
+{
+   u32 vaddr   = ee->reg.r[instr.rs].UW[0] + (s32)instr.sign_offset;
+   s8 value    = ee->reg.r[instr.rt].SB[0];
+
+   ee_core_store_8(vaddr, value);
+   intlog("SB [{:d}] [{:#x}] [{:d}] \n", instr.rt, (s32)instr.sign_offset, instr.rs);
+}
+
+static void
+ee_op_sh (R5900_Core *ee, u32, const Instruction &instr)
+{
+   u32 vaddr   = ee->reg.r[instr.rs].UW[0] + (s32)instr.sign_offset;
+   s16 value   = ee->reg.r[instr.rt].SH[0];
+
+   if (check_address_error_exception(ee, _STORE, _HALF, vaddr))
+      return;
+
+   ee_core_store_16(vaddr, value);
+   intlog("SH [{:d}] [{:#x}] [{:d}] \n", instr.rt, (s32)instr.sign_offset, instr.rs);
+}
+
+static void
+ee_op_sw (R5900_Core *ee, u32, const Instruction &instr)
+{
+   u32 vaddr = ee->reg.r[instr.rs].UW[0] + (s32)instr.sign_offset;
+   s32 value = ee->reg.r[instr.rt].SW[0];
+
+   if (check_address_error_exception(ee, _STORE, _WORD, vaddr))
+      return;
+
+   ee_core_store_32(vaddr, value);
+   intlog("SW [{:d}] [{:#x}] [{:d}] \n", instr.rt, instr.sign_offset, instr.rs);
+}
+
+static void
+ee_op_sdl (R5900_Core *ee, u32, const Instruction &instr)
+{
+   u32 vaddr           = ee->reg.r[instr.rs].UW[0] + instr.sign_offset;
+   u32 aligned_vaddr   = vaddr & ~0x7;
+   u32 shift           = vaddr & 0x7;
+
+   u64 aligned_dword   = ee_core_load_64(aligned_vaddr);
+   u64 result          = ((ee->reg.r[instr.rt].UD[0] & SDL_MASK[shift]) | (aligned_vaddr << SDL_SHIFT[shift]));
+   ee_core_store_64(aligned_vaddr, result);
+   intlog("SDL [{:d}] [{:#x}] [{:d}]\n", instr.rt, instr.sign_offset, instr.rs);
+   systrace("SDL [{:d}] [{:#x}] [{:d}]\n", instr.rt, (u32)instr.sign_offset, instr.rs);
+}
+
+static void
+ee_op_sdr (R5900_Core *ee, u32, const Instruction &instr)
+{
+   u32 vaddr           = ee->reg.r[instr.rs].UW[0] + instr.sign_offset;
+   u32 aligned_vaddr   = vaddr & ~0x7;
+   u32 shift           = vaddr & 0x7;
+
+   u64 aligned_dword   = ee_core_load_64(aligned_vaddr);
+   u64 result          = ((ee->reg.r[instr.rt].UD[0] & SDR_MASK[shift]) | (aligned_vaddr << SDR_SHIFT[shift]));
+   ee_core_store_64(aligned_vaddr, result);
+   intlog("SDR [{:d}] [{:#x}] [{:d}]\n", instr.rt, instr.sign_offset, instr.rs);
+   systrace("SDR [{:d}] [{:#x}] [{:d}]\n", instr.rt, (u32)instr.sign_offset, instr.rs);
+}
+
+static void
+ee_op_cache (R5900_Core *, u32, const Instruction &)
+{
+   // intlog("Invalidate instruction cache");
+}
+
+static void
+ee_op_lwc1 (R5900_Core *ee, u32, const Instruction &instr)
+{
+   u32 vaddr = ee->reg.r[instr.rs].UW[0] + (s32)instr.sign_offset;
+
+   if (check_address_error_exception(ee, _LOAD, _WORD, vaddr))
+      return;
+
+   u32 data = (u32)ee_core_load_32(vaddr);
+
+   cop1_setFPR(instr.rt, data);
+   intlog("LWC1 [{:d}] [{:#x}] [{:d}] \n", instr.rt, (s32)instr.sign_offset, instr.rs);
+}
+
+static void
+ee_op_ld (R5900_Core *ee, u32, const Instruction &instr)
+{
+   u32 vaddr = ee->reg.r[instr.rs].UW[0] + (s32)instr.sign_offset;
+
+   if (check_address_error_exception(ee, _LOAD, _DOUBLE, vaddr))
+      return;
+
+   ee->reg.r[instr.rt].UD[0] = ee_core_load_64(vaddr);
+   intlog("LD [{:d}] [{:#x}] [{:d}]\n", instr.rt, (s32)instr.sign_offset, instr.rs);
+}
+
+static void
+ee_op_swc1 (R5900_Core *ee, u32, const Instruction &instr)
+{
+   u32 vaddr = ee->reg.r[instr.rs].UW[0] + (s32)instr.sign_offset;
+
+   if (check_address_error_exception(ee, _STORE, _WORD, vaddr))
+      return;
+
+   ee_core_store_32(vaddr, cop1_getFPR(instr.rt));
+   intlog("SWC1 [{:d}] [{:#x}] [{:d}] \n", instr.rt, (s32)instr.sign_offset, instr.rs);
+}
+
+static void
+ee_op_sd (R5900_Core *ee, u32, const Instruction &instr)
+{
+   u32 vaddr   = ee->reg.r[instr.rs].UW[0] + (s32)instr.sign_offset;
+   u64 value   = ee->reg.r[instr.rt].UD[0];
+
+   if (check_address_error_exception(ee, _STORE, _DOUBLE, vaddr))
+      return;
+
+   ee_core_store_64(vaddr, value);
+
+   // intlog("SD [{:d}] [{:#x}] [{:d}] \n", instr.rt, (s32)instr.sign_offset, instr.rs);
+}
+
+static void
+ee_op_unknown (R5900_Core *, u32 instruction, const Instruction &)
+{
+   errtrace("[ERROR]: Could not interpret instructino.. opcode: [{:#09x}]\n", instruction);
+}
+
+/*******************************************
+ * Dispatch
+*******************************************/
+/*
+   All handlers sit in one flat table. The first level of the dispatch looks up where the instructions of
+   a primary opcode start in it and which bits of the instruction pick the entry, so SPECIAL, REGIMM and
+   COP0 get to their handler with two table loads and no switch. EE_INSTRUCTIONS lists every handler with
+   its index, both the table and the threaded loop are generated from it.
+*/
+#define EE_PRIMARY(opcode)    (opcode)
+#define EE_SPECIAL(function)  (64  + (function))
+#define EE_REGIMM(function)   (128 + (function))
+#define EE_COP0(format)       (160 + (format))
+
+#define EE_HANDLER_TABLE_SIZE (160 + 32)
+
+
+#define EE_INSTRUCTIONS(X)             \
+   X(mfc0,     EE_COP0(0x00))          \
+   X(mtc0,     EE_COP0(0x04))          \
+   X(cop0_bc0, EE_COP0(0x08))          \
+   X(cop0_tlb, EE_COP0(0x10))          \
+   X(cop1,     EE_PRIMARY(INSTR_COP1)) \
+   X(mmi,      EE_PRIMARY(INSTR_MMI))  \
+   X(sll,      EE_SPECIAL(0x00))       \
+   X(srl,      EE_SPECIAL(0x02))       \
+   X(sra,      EE_SPECIAL(0x03))       \
+   X(sllv,     EE_SPECIAL(0x04))       \
+   X(srlv,     EE_SPECIAL(0x06))       \
+   X(srav,     EE_SPECIAL(0x07))       \
+   X(jr,       EE_SPECIAL(0x08))       \
+   X(jalr,     EE_SPECIAL(0x09))       \
+   X(movz,     EE_SPECIAL(0x0A))       \
+   X(movn,     EE_SPECIAL(0x0B))       \
+   X(syscall,  EE_SPECIAL(0x0C))       \
+   X(break,    EE_SPECIAL(0x0D))       \
+   X(sync,     EE_SPECIAL(0x0F))       \
+   X(mfhi,     EE_SPECIAL(0x10))       \
+   X(mthi,     EE_SPECIAL(0x11))       \
+   X(mflo,     EE_SPECIAL(0x12))       \
+   X(mtlo,     EE_SPECIAL(0x13))       \
+   X(dsllv,    EE_SPECIAL(0x14))       \
+   X(dsrav,    EE_SPECIAL(0x17))       \
+   X(mult,     EE_SPECIAL(0x18))       \
+   X(div,      EE_SPECIAL(0x1A))       \
+   X(divu,     EE_SPECIAL(0x1B))       \
+   X(add,      EE_SPECIAL(0x20))       \
+   X(addu,     EE_SPECIAL(0x21))       \
+   X(sub,      EE_SPECIAL(0x22))       \
+   X(subu,     EE_SPECIAL(0x23))       \
+   X(and,      EE_SPECIAL(0x24))       \
+   X(or,       EE_SPECIAL(0x25))       \
+   X(nor,      EE_SPECIAL(0x27))       \
+   X(mfsa,     EE_SPECIAL(0x28))       \
+   X(mtsa,     EE_SPECIAL(0x29))       \
+   X(slt,      EE_SPECIAL(0x2A))       \
+   X(sltu,     EE_SPECIAL(0x2B))       \
+   X(daddu,    EE_SPECIAL(0x2D))       \
+   X(dsll,     EE_SPECIAL(0x38))       \
+   X(dsrl,     EE_SPECIAL(0x3A))       \
+   X(dsll32,   EE_SPECIAL(0x3C))       \
+   X(dsrl32,   EE_SPECIAL(0x3E))       \
+   X(dsra32,   EE_SPECIAL(0x3F))       \
+   X(bltz,     EE_REGIMM(0x00))        \
+   X(bgez,     EE_REGIMM(0x01))        \
+   X(mtsab,    EE_REGIMM(0x18))        \
+   X(mtsah,    EE_REGIMM(0x19))        \
+   X(j,        EE_PRIMARY(0x02))       \
+   X(jal,      EE_PRIMARY(0x03))       \
+   X(beq,      EE_PRIMARY(0x04))       \
+   X(bne,      EE_PRIMARY(0x05))       \
+   X(blez,     EE_PRIMARY(0x06))       \
+   X(bgtz,     EE_PRIMARY(0x07))       \
+   X(addi,     EE_PRIMARY(0x08))       \
+   X(addiu,    EE_PRIMARY(0x09))       \
+   X(slti,     EE_PRIMARY(0x0A))       \
+   X(sltiu,    EE_PRIMARY(0x0B))       \
+   X(andi,     EE_PRIMARY(0x0C))       \
+   X(ori,      EE_PRIMARY(0x0D))       \
+   X(xori,     EE_PRIMARY(0x0E))       \
+   X(lui,      EE_PRIMARY(0x0F))       \
+   X(beql,     EE_PRIMARY(0x14))       \
+   X(bnel,     EE_PRIMARY(0x15))       \
+   X(blezl,    EE_PRIMARY(0x16))       \
+   X(daddiu,   EE_PRIMARY(0x19))       \
+   X(ldl,      EE_PRIMARY(0x1A))       \
+   X(ldr,      EE_PRIMARY(0x1B))       \
+   X(lq,       EE_PRIMARY(0x1E))       \
+   X(sq,       EE_PRIMARY(0x1F))       \
+   X(lb,       EE_PRIMARY(0x20))       \
+   X(lh,       EE_PRIMARY(0x21))       \
+   X(lw,       EE_PRIMARY(0x23))       \
+   X(lbu,      EE_PRIMARY(0x24))       \
+   X(lhu,      EE_PRIMARY(0x25))       \
+   X(lwu,      EE_PRIMARY(0x27))       \
+   X(sb,       EE_PRIMARY(0x28))       \
+   X(sh,       EE_PRIMARY(0x29))       \
+   X(sw,       EE_PRIMARY(0x2B))       \
+   X(sdl,      EE_PRIMARY(0x2C))       \
+   X(sdr,      EE_PRIMARY(0x2D))       \
+   X(cache,    EE_PRIMARY(0x2F))       \
+   X(lwc1,     EE_PRIMARY(0x31))       \
+   X(ld,       EE_PRIMARY(0x37))       \
+   X(swc1,     EE_PRIMARY(0x39))       \
+   X(sd,       EE_PRIMARY(0x3F))
+
+typedef struct _EE_Dispatch_Level_ {
+   u8 base;    // First entry of the opcode in the handler table
+   u8 shift;
+   u8 mask;    // 0 for opcodes that are a single instruction
+} EE_Dispatch_Level;
+
+typedef struct _EE_Dispatch_Tables_ {
+   EE_Dispatch_Level levels[64];
+   EE_Handler        handlers[EE_HANDLER_TABLE_SIZE];
+} EE_Dispatch_Tables;
+
+static constexpr EE_Dispatch_Tables
+ee_build_dispatch_tables ()
+{
+   EE_Dispatch_Tables tables = {};
+
+   for (u32 opcode = 0; opcode < 64; ++opcode)
+      tables.levels[opcode] = { (u8)EE_PRIMARY(opcode), 0, 0 };
+
+   tables.levels[INSTR_SPECIAL]  = { EE_SPECIAL(0), 0,  0x3F };
+   tables.levels[INSTR_REGIMM]   = { EE_REGIMM(0),  16, 0x1F };
+   tables.levels[INSTR_COP0]     = { EE_COP0(0),    21, 0x1F };
+
+   for (u32 i = 0; i < EE_HANDLER_TABLE_SIZE; ++i)
+   {
+      if      (i >= EE_COP0(0))    tables.handlers[i] = ee_op_cop0_unknown;
+      else if (i >= EE_REGIMM(0))  tables.handlers[i] = ee_op_regimm_unknown;
+      else if (i >= EE_SPECIAL(0)) tables.handlers[i] = ee_op_special_unknown;
+      else                         tables.handlers[i] = ee_op_unknown;
+   }
+
+#define EE_TABLE_ENTRY(name, index) tables.handlers[index] = ee_op_##name;
+   EE_INSTRUCTIONS(EE_TABLE_ENTRY)
+#undef EE_TABLE_ENTRY
+
+   return tables;
+}
+
+static constexpr EE_Dispatch_Tables ee_dispatch = ee_build_dispatch_tables();
+
+static inline u32
+ee_handler_index (u32 instruction)
+{
+   const EE_Dispatch_Level &level = ee_dispatch.levels[instruction >> 26];
+   return level.base + ((instruction >> level.shift) & level.mask);
+}
+
+// Lets the block cache resolve the handler once when it decodes a block
+static inline EE_Handler
+ee_lookup_handler (u32 instruction)
+{
+   return ee_dispatch.handlers[ee_handler_index(instruction)];
+}
+
+// @@Note: Split from the decoding so the block cache can replay instructions it decoded ahead of time
+static void
+ee_execute (R5900_Core *ee, u32 instruction, const Instruction &instr)
+{
+   ee_lookup_handler(instruction)(ee, instruction, instr);
+}
+
+// NOPs are SLL r0 and go through the table like everything else
+static void
+ee_decode_and_execute (R5900_Core *ee, u32 instruction)
+{
+   Instruction instr = ee_decode(instruction);
+   ee_execute(ee, instruction, instr);
+}
+
+// Jumps and branches that are followed by a delay slot
+static bool
+ee_is_branch_instruction (u32 instruction)
+{
+   u32 opcode = instruction >> 26;
+   switch (opcode)
+   {
+      case INSTR_SPECIAL:
       {
-         errlog("[ERROR]: Could not interpret instructino.. opcode: [{:#09x}]\n", instruction);
-      } break;
+         u32 special = instruction & 0x3F;
+         return special == 0x08 || special == 0x09;
+      }
+
+      case INSTR_REGIMM:
+      {
+         u32 regimm_function = (instruction >> 16) & 0x1F;
+         return regimm_function == 0x00 || regimm_function == 0x01;
+      }
+
+      case 0x02: case 0x03: case 0x04: case 0x05: case 0x06: case 0x07:
+      case 0x14: case 0x15: case 0x16:
+         return true;
    }
+
+   return false;
+}
+
+/*******************************************
+ * Code Address Helpers
+*******************************************/
+static inline u32
+ee_code_address_to_physical (u32 pc)
+{
+   return ee_virtual_to_physical(pc);
+}
+
+// Only code in RDRAM and the BIOS is cached, anything else always goes through r5900_cycle
+static inline bool
+ee_is_cacheable_code (u32 pc)
+{
+   if (pc >= 0x70000000 && pc < 0x70004000) return false;
+   if (_ee_tlb_pages_[pc >> 12] & EE_TLB_SCRATCHPAD) return false;
+
+   u32 address = ee_code_address_to_physical(pc);
+   return address < 0x10000000 || (address >= 0x1FC00000 && address < 0x20000000);
 }
 
 void
@@ -1330,6 +1755,15 @@ ee_reset(R5900_Core *ee)
    ee->pc            = 0xbfc00000;
    ee->current_cycle = 0;
    ee->cop0.regs[15] = 0x2e20;
+   ee->cop0.random   = EE_TLB_ENTRIES - 1;
+
+   ee_map_pages(0x70000000, _scratchpad_, KILOBYTES(16), true);
+   ee_tlb_reset();
+   ee_idle_reset();
+   ee_mmi_init();
+
+   cop0_compare_event = scheduler_register_event("COP0 Compare", cop0_compare_callback);
+   cop0_schedule_compare(ee);
 
    // _scratchpad_        = (u8 *)malloc(sizeof(u8) * KILOBYTES(16));
    // _icache_            = (u8 *)malloc(sizeof(u8) * KILOBYTES(16));
@@ -1364,6 +1798,163 @@ r5900_cycle(R5900_Core *ee)
    // set_kernel_mode(&ee->cop0);
 }
 
+/*
+   Runs the selected backend for about the given amount of cycles and returns how many guest instructions
+   were executed. The block based backends can run a little past the budget.
+*/
+#if EE_THREADED_DISPATCH
+/*
+   Threaded version of the interpreter loop below. Every handler gets its own label followed by its own
+   copy of the fetch and the indirect jump to the next handler, so the host predicts each jump from the
+   instruction that ran before it instead of sharing one jump between all of them. The order of
+   operations is the same as r5900_cycle.
+*/
+static inline void
+r5900_threaded_fetch (R5900_Core *ee, u32 *instruction)
+{
+   ee->current_instruction = ee_core_load_32(ee->pc);
+   ee->next_instruction    = ee_core_load_32(ee->pc + 4);
+   *instruction            = ee->current_instruction;
+}
+
+// Start of an r5900_cycle, the delay slot of a taken branch runs before the instruction at its target
+static inline void
+r5900_threaded_begin (R5900_Core *ee, bool *in_delay_slot, u32 *instruction)
+{
+   if (ee->delay_slot > 0) ee->delay_slot -= 1;
+
+   if (ee->is_branching)
+   {
+      ee->is_branching     = false;
+      ee->next_instruction = ee_core_load_32(ee->pc);
+      *in_delay_slot       = true;
+      *instruction         = ee->next_instruction;
+      return;
+   }
+
+   r5900_threaded_fetch(ee, instruction);
+}
+
+// Finishes the instruction that just ran and fetches the next one, false once the budget is used up
+static inline bool
+r5900_threaded_next (R5900_Core *ee, bool *in_delay_slot, u32 *executed, u32 cycles, u32 *instruction)
+{
+   if (*in_delay_slot)
+   {
+      *in_delay_slot = false;
+      ee->pc         = ee->branch_pc;
+      r5900_threaded_fetch(ee, instruction);
+      return true;
+   }
+
+   ee->pc              += 4;
+   ee->cop0.regs[9]    += 1;
+   ee->reg.r[0].SD[0]  = 0;
+   *executed           += 1;
+
+   if (ee->is_branching && ee->branch_pc < ee->pc)
+      *executed += ee_idle_check(ee, ee->branch_pc, cycles - *executed);
+   else if (ee->interrupt_pending && !ee->is_branching)
+      return false;
+   if (*executed >= cycles) return false;
+
+   r5900_threaded_begin(ee, in_delay_slot, instruction);
+   return true;
+}
+
+#define EE_THREADED_NEXT()                                                       \
+   if (!r5900_threaded_next(ee, &in_delay_slot, &executed, cycles, &instruction)) \
+      return executed;                                                           \
+   instr = ee_decode(instruction);                                               \
+   goto *labels[ee_handler_index(instruction)]
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+static u32
+r5900_threaded_cycle (R5900_Core *ee, u32 cycles)
+{
+   static void *labels[EE_HANDLER_TABLE_SIZE];
+   static bool labels_ready = false;
+
+   if (!labels_ready)
+   {
+      for (u32 i = 0; i < EE_HANDLER_TABLE_SIZE; ++i)
+      {
+         if      (i >= EE_COP0(0))    labels[i] = &&op_cop0_unknown;
+         else if (i >= EE_REGIMM(0))  labels[i] = &&op_regimm_unknown;
+         else if (i >= EE_SPECIAL(0)) labels[i] = &&op_special_unknown;
+         else                         labels[i] = &&op_unknown;
+      }
+
+#define EE_LABEL_ENTRY(name, index) labels[index] = &&op_##name;
+      EE_INSTRUCTIONS(EE_LABEL_ENTRY)
+#undef EE_LABEL_ENTRY
+
+      labels_ready = true;
+   }
+
+   u32 executed         = 0;
+   bool in_delay_slot   = false;
+   u32 instruction;
+   Instruction instr;
+
+   if (!cycles) return 0;
+
+   r5900_threaded_begin(ee, &in_delay_slot, &instruction);
+   instr = ee_decode(instruction);
+   goto *labels[ee_handler_index(instruction)];
+
+#define EE_LABEL_HANDLER(name, index) op_##name: ee_op_##name(ee, instruction, instr); EE_THREADED_NEXT();
+   EE_INSTRUCTIONS(EE_LABEL_HANDLER)
+   EE_LABEL_HANDLER(cop0_unknown, 0)
+   EE_LABEL_HANDLER(regimm_unknown, 0)
+   EE_LABEL_HANDLER(special_unknown, 0)
+   EE_LABEL_HANDLER(unknown, 0)
+#undef EE_LABEL_HANDLER
+}
+#pragma GCC diagnostic pop
+#endif
+
+u32
+r5900_run (R5900_Core *ee, u32 cycles)
+{
+   u32 executed = 0;
+   ee->slice_start   = ee->cop0.regs[9];
+   ee_slice_core     = ee;
+   if (ee->interrupt_pending) r5900_interrupt(ee);
+
+   switch (ee_execution_mode)
+   {
+      case EE_MODE_JIT:                 executed = r5900_jit_cycle(ee, cycles); break;
+      case EE_MODE_CACHED_INTERPRETER:  executed = r5900_cached_cycle(ee, cycles); break;
+
+      case EE_MODE_INTERPRETER:
+      default:
+      {
+#if EE_THREADED_DISPATCH
+         executed = r5900_threaded_cycle(ee, cycles);
+#else
+         while (executed < cycles)
+         {
+            r5900_cycle(ee);
+            executed += 1;
+
+            // A taken backward branch is the only way around a loop
+            if (ee->is_branching && ee->branch_pc < ee->pc)
+               executed += ee_idle_check(ee, ee->branch_pc, cycles - executed);
+
+            // Ends the slice so the interrupt is taken on the next one
+            else if (ee->interrupt_pending && !ee->is_branching)
+               break;
+         }
+#endif
+      } break;
+   }
+
+   ee_slice_core = NULL;
+   return executed;
+}
+
 void
 r5900_shutdown()
 {
@@ -37,12 +37,12 @@ union GP_Registers {
 typedef struct _TLB_Entry_ {
    bool valid[2];
    bool dirty[2];
-   int cache_mode;
+   u32 cache_mode[2];
    u32 page_frame_number[2]; // even and odd pages
    bool set_scratchpad;
    u32 asid;
    bool set_global;
-   u32 vpn2;
+   u32 vpn2;                 // Bits 31:13 of the even page, already masked with page_mask
    u32 page_mask;
 } TLB_Entry;
 
@@ -52,6 +52,13 @@ enum Cache_Mode : int {
    UNCACHED_ACCELERATED = 7,
 };
 
+// Selectable at runtime so the backends can be compared against each other
+enum EE_Execution_Mode : int {
+   EE_MODE_INTERPRETER,
+   EE_MODE_CACHED_INTERPRETER,
+   EE_MODE_JIT,
+};
+
 enum INSTRUCTION_TYPE : int {
    INSTR_COP0      = 0b010000, 
    INSTR_SPECIAL   = 0b000000,
@@ -168,11 +175,38 @@ typedef struct _R5900Core_ {
    u32 current_cycle;
    u32 current_instruction;
    u32 next_instruction;
+   u32 interrupt_pending;   // Cause bits of the lines that would be taken right now, see ee_update_interrupts()
+   u32 slice_start;         // COP0 Count when the running slice started, see ee_slice_cycles()
 } R5900_Core;
 
+// Interrupt lines as they appear in the IP field of Cause and the IM field of Status
+enum EE_Interrupt_Line : u32 {
+   EE_INTERRUPT_INT0    = 1 << 10,  // INTC
+   EE_INTERRUPT_INT1    = 1 << 11,  // DMAC
+   EE_INTERRUPT_TIMER   = 1 << 15,  // COP0 Count/Compare
+};
+
+/*
+   The interpreter dispatches through a table of one handler per instruction. On GCC and Clang the
+   interpreter loop also has a threaded version using computed gotos, build with EE_THREADED_DISPATCH=1
+   to use it. It is off by default since it has not been faster than the table loop so far.
+*/
+#if !defined(__GNUC__) && !defined(__clang__)
+#undef EE_THREADED_DISPATCH
+#define EE_THREADED_DISPATCH 0
+#elif !defined(EE_THREADED_DISPATCH)
+#define EE_THREADED_DISPATCH 0
+#endif
+
+typedef void (*EE_Handler)(R5900_Core *ee, u32 instruction, const Instruction &instr);
+
 u64 dump_ee_register(R5900_Core *ee, int register_num);
 
 void r5900_cycle(R5900_Core *ee);
+u32  r5900_run(R5900_Core *ee, u32 cycles);
+u32  ee_slice_cycles();
+u64  ee_current_cycles();
+void ee_update_interrupts(R5900_Core *ee);
 void ee_reset(R5900_Core *ee);
 void r5900_shutdown();
 
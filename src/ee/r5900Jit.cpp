@@ -0,0 +1,1117 @@
+/*
+ * Copyright 2023 Xaviar Roach
+ * SPDX-License-Identifier: MIT
+ */
+
+#if EE_JIT_SUPPORTED
+
+#ifdef _WIN32
+// @Hack: extern/windows.h is a stub that shadows the SDK header so declare the two calls we need
+extern "C" __declspec(dllimport) void * __stdcall VirtualAlloc (void *address, size_t size, unsigned long type, unsigned long protect);
+extern "C" __declspec(dllimport) int __stdcall VirtualFree (void *address, size_t size, unsigned long type);
+#define JIT_MEM_COMMIT              0x00001000
+#define JIT_MEM_RESERVE             0x00002000
+#define JIT_MEM_RELEASE             0x00008000
+#define JIT_PAGE_EXECUTE_READWRITE  0x40
+#else
+#include <sys/mman.h>
+#include <ucontext.h>
+#endif
+
+enum JIT_Register : u8 {
+   RAX = 0, RCX = 1, RDX = 2,  RBX = 3,  RSP = 4,  RBP = 5,  RSI = 6,  RDI = 7,
+   R8  = 8, R9  = 9, R10 = 10, R11 = 11, R12 = 12, R13 = 13, R14 = 14, R15 = 15,
+};
+
+/*
+   Register usage inside translated blocks:
+   rbx     R5900_Core *
+   r12d    Remaining cycle budget, blocks leave once it runs out
+   r13d    Branch condition, evaluated before the delay slot runs
+   r14d    Jump register target, read before the delay slot runs
+   r15     Base of the EE address space when the host virtual memory map is enabled
+*/
+#ifdef _WIN32
+#define JIT_ARG0           RCX
+#define JIT_ARG1           RDX
+#define JIT_ARG2           R8
+#define JIT_STACK_RESERVE  40 // 32 bytes of shadow space + 8 to keep the stack 16 byte aligned
+#else
+#define JIT_ARG0           RDI
+#define JIT_ARG1           RSI
+#define JIT_ARG2           RDX
+#define JIT_STACK_RESERVE  8
+#endif
+
+enum JIT_Condition : u8 {
+   CC_B  = 0x2, CC_AE = 0x3, CC_E  = 0x4, CC_NE = 0x5,
+   CC_L  = 0xC, CC_GE = 0xD, CC_LE = 0xE, CC_G  = 0xF,
+};
+
+enum JIT_Alu : u8 {
+   ALU_ADD = 0, ALU_OR = 1, ALU_AND = 4, ALU_SUB = 5, ALU_XOR = 6, ALU_CMP = 7,
+};
+
+enum JIT_Shift : u8 {
+   SHIFT_SHL = 4, SHIFT_SHR = 5, SHIFT_SAR = 7,
+};
+
+enum JIT_Interpret_Result : u32 {
+   JIT_CONTINUE            = 0,
+   JIT_CONTROL_FLOW        = 1, // pc was changed by an exception, eret or an uncovered branch
+   JIT_CODE_INVALIDATED    = 2, // a store hit a page holding translated code
+};
+
+#define JIT_GPR(r)            (u32)(offsetof(R5900_Core, reg) + (r) * sizeof(CPU_Types))
+#define JIT_HI                (u32)offsetof(R5900_Core, HI)
+#define JIT_LO                (u32)offsetof(R5900_Core, LO)
+#define JIT_PC                (u32)offsetof(R5900_Core, pc)
+
+#define JIT_PAGE_COUNT        (1 << 20)
+#define JIT_MAX_BLOCK_BYTES   KILOBYTES(64)
+
+typedef s32 (*JIT_Entry)(R5900_Core *ee, u8 *code, s32 cycles);
+
+typedef struct _JIT_Link_ {
+   u32 target;
+   u8  *patch; // rel32 of the jmp that leaves the source block
+} JIT_Link;
+
+// One per 4KB page of guest virtual address space that has been translated or is jumped into
+typedef struct _JIT_Page_ {
+   u8 *blocks[1024];
+   bool idle_loops[1024];
+   bool slow_loads[1024];  // Loads that hit MMIO once, they are translated as interpreter calls from then on
+   std::vector<JIT_Link> links;
+} JIT_Page;
+
+// Host address of a fastmem load and the guest pc it was translated from
+typedef struct _JIT_Load_Site_ {
+   u8  *code;
+   u32 pc;
+} JIT_Load_Site;
+
+typedef struct _EE_JIT_ {
+   u8 *code_buffer;
+   u8 *code_start;
+   u8 *code_ptr;
+   u8 *code_end;
+   u8 *exit_stub;
+
+   JIT_Entry enter;
+   JIT_Page  **pages;
+
+   // Loads go straight to the address space when it is mapped, see vmem.h
+   u8 *fastmem_base;
+   std::vector<JIT_Load_Site> load_sites;    // In code order, so the fault handler can binary search it
+
+   // Set while an idle loop is being compiled, its branch back to the head is not linked
+   bool compiling_idle_loop;
+   u32  idle_loop_head;
+
+   bool block_invalidated;
+   EE_JIT_Stats stats;
+} EE_JIT;
+
+static EE_JIT jit = {};
+
+/*******************************************
+ * x86-64 Emitter
+*******************************************/
+static inline void
+emit_8 (u8 value)
+{
+   *jit.code_ptr++ = value;
+}
+
+static inline void
+emit_32 (u32 value)
+{
+   memcpy(jit.code_ptr, &value, sizeof(u32));
+   jit.code_ptr += sizeof(u32);
+}
+
+static inline void
+emit_64 (u64 value)
+{
+   memcpy(jit.code_ptr, &value, sizeof(u64));
+   jit.code_ptr += sizeof(u64);
+}
+
+static inline void
+emit_rex (bool w, u8 reg, u8 rm)
+{
+   u8 rex = 0x40 | (w << 3) | ((reg & 8) >> 1) | ((rm & 8) >> 3);
+   if (rex != 0x40) emit_8(rex);
+}
+
+// op reg, [rbx + disp32] or op [rbx + disp32], reg depending on the opcode
+static inline void
+emit_reg_mem (bool w, u8 opcode, u8 reg, u32 disp)
+{
+   emit_rex(w, reg, RBX);
+   emit_8(opcode);
+   emit_8(0x80 | ((reg & 7) << 3) | RBX);
+   emit_32(disp);
+}
+
+static inline void
+emit_reg_reg (bool w, u8 opcode, u8 reg, u8 rm)
+{
+   emit_rex(w, reg, rm);
+   emit_8(opcode);
+   emit_8(0xC0 | ((reg & 7) << 3) | (rm & 7));
+}
+
+static inline void
+emit_alu_imm (bool w, JIT_Alu op, u8 rm, s32 imm)
+{
+   emit_rex(w, 0, rm);
+   emit_8(0x81);
+   emit_8(0xC0 | (op << 3) | (rm & 7));
+   emit_32((u32)imm);
+}
+
+static inline void
+emit_shift_imm (bool w, JIT_Shift op, u8 rm, u8 amount)
+{
+   emit_rex(w, 0, rm);
+   emit_8(0xC1);
+   emit_8(0xC0 | (op << 3) | (rm & 7));
+   emit_8(amount);
+}
+
+static inline void
+emit_shift_cl (bool w, JIT_Shift op, u8 rm)
+{
+   emit_rex(w, 0, rm);
+   emit_8(0xD3);
+   emit_8(0xC0 | (op << 3) | (rm & 7));
+}
+
+static inline void
+emit_mov_imm32 (u8 reg, u32 imm)
+{
+   emit_rex(false, 0, reg);
+   emit_8(0xB8 + (reg & 7));
+   emit_32(imm);
+}
+
+static inline void
+emit_mov_imm64 (u8 reg, u64 imm)
+{
+   emit_rex(true, 0, reg);
+   emit_8(0xB8 + (reg & 7));
+   emit_64(imm);
+}
+
+// mov dword/qword [rbx + disp32], imm32. The qword form sign extends the immediate
+static inline void
+emit_store_imm (bool w, u32 disp, u32 imm)
+{
+   emit_rex(w, 0, RBX);
+   emit_8(0xC7);
+   emit_8(0x80 | RBX);
+   emit_32(disp);
+   emit_32(imm);
+}
+
+static inline void emit_load_64   (u8 reg, u32 disp) { emit_reg_mem(true,  0x8B, reg, disp); }
+static inline void emit_load_32   (u8 reg, u32 disp) { emit_reg_mem(false, 0x8B, reg, disp); }
+static inline void emit_store_64  (u32 disp, u8 reg) { emit_reg_mem(true,  0x89, reg, disp); }
+static inline void emit_store_32  (u32 disp, u8 reg) { emit_reg_mem(false, 0x89, reg, disp); }
+static inline void emit_movsxd    (u8 dst, u8 src)   { emit_reg_reg(true,  0x63, dst, src); }
+static inline void emit_test_64   (u8 a, u8 b)       { emit_reg_reg(true,  0x85, b, a); }
+
+// setcc al, movzx reg, al
+static inline void
+emit_setcc (JIT_Condition cc, u8 reg)
+{
+   emit_8(0x0F);
+   emit_8(0x90 + cc);
+   emit_8(0xC0 | RAX);
+
+   emit_rex(false, reg, RAX);
+   emit_8(0x0F);
+   emit_8(0xB6);
+   emit_8(0xC0 | ((reg & 7) << 3) | RAX);
+}
+
+static inline u8 *
+emit_jcc_32 (JIT_Condition cc)
+{
+   emit_8(0x0F);
+   emit_8(0x80 + cc);
+   emit_32(0);
+   return jit.code_ptr - 4;
+}
+
+static inline u8 *
+emit_jmp_32 ()
+{
+   emit_8(0xE9);
+   emit_32(0);
+   return jit.code_ptr - 4;
+}
+
+static inline u8 *
+emit_jcc_8 (JIT_Condition cc)
+{
+   emit_8(0x70 + cc);
+   emit_8(0);
+   return jit.code_ptr - 1;
+}
+
+static inline void
+patch_rel_32 (u8 *patch, u8 *target)
+{
+   s32 rel = (s32)(target - (patch + 4));
+   memcpy(patch, &rel, sizeof(s32));
+}
+
+static inline void
+patch_rel_8 (u8 *patch, u8 *target)
+{
+   s32 rel = (s32)(target - (patch + 1));
+   assert(rel >= -128 && rel <= 127);
+   *patch = (u8)(s8)rel;
+}
+
+static inline void
+emit_call (void *function)
+{
+   emit_mov_imm64(RAX, (u64)function);
+   emit_8(0xFF);
+   emit_8(0xD0);
+}
+
+/*******************************************
+ * Block Linking
+*******************************************/
+static JIT_Page *
+jit_get_page (u32 pc)
+{
+   JIT_Page **page = &jit.pages[pc >> 12];
+   if (!*page) *page = new JIT_Page{};
+
+   return *page;
+}
+
+static inline u8 *
+jit_lookup (u32 pc)
+{
+   JIT_Page *page = jit.pages[pc >> 12];
+   if (!page) return NULL;
+
+   return page->blocks[(pc >> 2) & 0x3FF];
+}
+
+// The jump goes back to the dispatcher until the target block exists
+static void
+jit_link (u32 target, u8 *patch)
+{
+   JIT_Page *page = jit_get_page(target);
+   page->links.push_back({target, patch});
+
+   u8 *code = page->blocks[(target >> 2) & 0x3FF];
+   patch_rel_32(patch, code ? code : jit.exit_stub);
+}
+
+static void
+emit_exit_static (u32 target, u32 executed)
+{
+   emit_store_imm(false, JIT_PC, target);
+   emit_alu_imm(false, ALU_SUB, R12, executed);
+   patch_rel_32(emit_jcc_32(CC_LE), jit.exit_stub);
+
+   // Idle loops go back through the dispatcher every iteration so ee_idle_check() gets to see them
+   if (jit.compiling_idle_loop && target == jit.idle_loop_head) patch_rel_32(emit_jmp_32(), jit.exit_stub);
+   else                                                         jit_link(target, emit_jmp_32());
+}
+
+static void
+emit_exit_dynamic (u32 executed)
+{
+   emit_store_32(JIT_PC, R14);
+   emit_alu_imm(false, ALU_SUB, R12, executed);
+   patch_rel_32(emit_jmp_32(), jit.exit_stub);
+}
+
+/*******************************************
+ * Interpreter Fallback
+*******************************************/
+static u32
+jit_interpret (R5900_Core *ee, u32 instruction, u32 pc)
+{
+   ee->pc = pc;
+   ee_decode_and_execute(ee, instruction);
+   ee->reg.r[0].SD[0] = 0;
+
+   // @@Note: Mirrors r5900_cycle, the pc is always advanced after the instruction is executed
+   if (ee->is_branching || ee->pc != pc)
+   {
+      ee->pc += 4;
+      return JIT_CONTROL_FLOW;
+   }
+
+   // Writes that unmask an interrupt leave translated code the same way so it is taken between blocks
+   if (jit.block_invalidated || ee->interrupt_pending)
+   {
+      jit.block_invalidated = false;
+      ee->pc = pc + 4;
+      return JIT_CODE_INVALIDATED;
+   }
+
+   return JIT_CONTINUE;
+}
+
+static void
+emit_interpret (u32 instruction, u32 pc, u32 executed, bool in_delay_slot)
+{
+   emit_reg_reg(true, 0x89, RBX, JIT_ARG0);
+   emit_mov_imm32(JIT_ARG1, instruction);
+   emit_mov_imm32(JIT_ARG2, pc);
+   emit_call((void *)jit_interpret);
+
+   // The branch still has to be taken when only the code got invalidated inside a delay slot
+   if (in_delay_slot) {
+      emit_alu_imm(false, ALU_CMP, RAX, JIT_CONTROL_FLOW);
+      u8 *skip = emit_jcc_8(CC_NE);
+      emit_alu_imm(false, ALU_SUB, R12, executed);
+      patch_rel_32(emit_jmp_32(), jit.exit_stub);
+      patch_rel_8(skip, jit.code_ptr);
+   } else {
+      emit_reg_reg(false, 0x85, RAX, RAX);
+      u8 *skip = emit_jcc_8(CC_E);
+      emit_alu_imm(false, ALU_SUB, R12, executed);
+      patch_rel_32(emit_jmp_32(), jit.exit_stub);
+      patch_rel_8(skip, jit.code_ptr);
+   }
+
+   jit.stats.fallback_instructions++;
+}
+
+/*******************************************
+ * Instruction Translation
+*******************************************/
+// Fills the destination with the sign extended low word of eax
+static inline void
+emit_store_word_result (u32 rd)
+{
+   emit_movsxd(RAX, RAX);
+   emit_store_64(JIT_GPR(rd), RAX);
+}
+
+static inline void
+emit_shift_word (u32 rd, u32 rt, JIT_Shift op, u32 sa)
+{
+   emit_load_32(RAX, JIT_GPR(rt));
+   if (sa) emit_shift_imm(false, op, RAX, sa);
+   emit_store_word_result(rd);
+}
+
+static inline void
+emit_shift_word_variable (u32 rd, u32 rt, u32 rs, JIT_Shift op)
+{
+   emit_load_32(RCX, JIT_GPR(rs));
+   emit_load_32(RAX, JIT_GPR(rt));
+   emit_shift_cl(false, op, RAX);
+   emit_store_word_result(rd);
+}
+
+static inline void
+emit_shift_double (u32 rd, u32 rt, JIT_Shift op, u32 sa)
+{
+   emit_load_64(RAX, JIT_GPR(rt));
+   if (sa) emit_shift_imm(true, op, RAX, sa);
+   emit_store_64(JIT_GPR(rd), RAX);
+}
+
+static inline void
+emit_shift_double_variable (u32 rd, u32 rt, u32 rs, JIT_Shift op)
+{
+   emit_load_32(RCX, JIT_GPR(rs));
+   emit_load_64(RAX, JIT_GPR(rt));
+   emit_shift_cl(true, op, RAX);
+   emit_store_64(JIT_GPR(rd), RAX);
+}
+
+// op eax/rax, [rt]
+static inline void
+emit_alu_reg (bool w, u8 opcode, u32 rd, u32 rs, u32 rt)
+{
+   if (w) emit_load_64(RAX, JIT_GPR(rs));
+   else   emit_load_32(RAX, JIT_GPR(rs));
+
+   emit_reg_mem(w, opcode, RAX, JIT_GPR(rt));
+
+   if (w) emit_store_64(JIT_GPR(rd), RAX);
+   else   emit_store_word_result(rd);
+}
+
+static inline void
+emit_set_less_than (u32 rd, u32 rs, u32 rt, JIT_Condition cc)
+{
+   emit_load_64(RAX, JIT_GPR(rs));
+   emit_reg_mem(true, 0x3B, RAX, JIT_GPR(rt));
+   emit_setcc(cc, RAX);
+   emit_store_64(JIT_GPR(rd), RAX);
+}
+
+static inline void
+emit_set_less_than_imm (u32 rt, u32 rs, s32 imm, JIT_Condition cc)
+{
+   emit_load_64(RAX, JIT_GPR(rs));
+   emit_alu_imm(true, ALU_CMP, RAX, imm);
+   emit_setcc(cc, RAX);
+   emit_store_64(JIT_GPR(rt), RAX);
+}
+
+static inline void
+emit_move_conditional (u32 rd, u32 rs, u32 rt, JIT_Condition skip_cc)
+{
+   emit_load_64(RAX, JIT_GPR(rt));
+   emit_test_64(RAX, RAX);
+   u8 *skip = emit_jcc_8(skip_cc);
+   emit_load_64(RAX, JIT_GPR(rs));
+   emit_store_64(JIT_GPR(rd), RAX);
+   patch_rel_8(skip, jit.code_ptr);
+}
+
+static inline void
+emit_move_64 (u32 dst, u32 src)
+{
+   emit_load_64(RAX, src);
+   emit_store_64(dst, RAX);
+}
+
+// Returns false when the instruction has to go through the interpreter
+static bool
+jit_translate_native (u32 instruction)
+{
+   u32 rs        = (instruction >> 21) & 0x1F;
+   u32 rt        = (instruction >> 16) & 0x1F;
+   u32 rd        = (instruction >> 11) & 0x1F;
+   u32 sa        = (instruction >> 6)  & 0x1F;
+   u32 imm       = instruction & 0xFFFF;
+   s32 sign_imm  = (s16)(instruction & 0xFFFF);
+
+   if (instruction == 0x00000000) return true;
+
+   u32 opcode = instruction >> 26;
+   switch (opcode)
+   {
+      case INSTR_SPECIAL:
+      {
+         u32 special = instruction & 0x3F;
+
+         // Writes to r0 are discarded, MTHI and MTLO are the only ones without a GPR destination
+         bool writes_gpr = special != 0x11 && special != 0x13 && special != 0x0D && special != 0x0F;
+         bool supported  = true;
+
+         switch (special)
+         {
+            case 0x00: case 0x02: case 0x03: case 0x04: case 0x07:
+            case 0x0A: case 0x0B: case 0x0D: case 0x0F: case 0x10:
+            case 0x11: case 0x12: case 0x13: case 0x14: case 0x17:
+            case 0x20: case 0x21: case 0x22: case 0x23: case 0x24:
+            case 0x25: case 0x27: case 0x2A: case 0x2B: case 0x2D:
+            case 0x38: case 0x3A: case 0x3C: case 0x3E: case 0x3F:
+               break;
+
+            default: supported = false; break;
+         }
+
+         if (!supported) return false;
+         if (writes_gpr && rd == 0) return true;
+
+         switch (special)
+         {
+            case 0x00: emit_shift_word(rd, rt, SHIFT_SHL, sa);                  break; // SLL
+            case 0x02: emit_shift_word(rd, rt, SHIFT_SHR, sa);                  break; // SRL
+            case 0x03: emit_shift_word(rd, rt, SHIFT_SAR, sa);                  break; // SRA
+            case 0x04: emit_shift_word_variable(rd, rt, rs, SHIFT_SHL);         break; // SLLV
+            case 0x07: emit_shift_word_variable(rd, rt, rs, SHIFT_SAR);         break; // SRAV
+            case 0x0A: emit_move_conditional(rd, rs, rt, CC_NE);                break; // MOVZ
+            case 0x0B: emit_move_conditional(rd, rs, rt, CC_E);                 break; // MOVN
+            case 0x0D:                                                          break; // BREAK
+            case 0x0F:                                                          break; // SYNC
+            case 0x10: emit_move_64(JIT_GPR(rd), JIT_HI);                       break; // MFHI
+            case 0x11: emit_move_64(JIT_HI, JIT_GPR(rs));                       break; // MTHI
+            case 0x12: emit_move_64(JIT_GPR(rd), JIT_LO);                       break; // MFLO
+            case 0x13: emit_move_64(JIT_LO, JIT_GPR(rs));                       break; // MTLO
+            case 0x14: emit_shift_double_variable(rd, rt, rs, SHIFT_SHL);       break; // DSLLV
+            case 0x17: emit_shift_double_variable(rd, rt, rs, SHIFT_SAR);       break; // DSRAV
+            case 0x20: emit_alu_reg(false, 0x03, rd, rs, rt);                   break; // ADD
+            case 0x21: emit_alu_reg(false, 0x03, rd, rs, rt);                   break; // ADDU
+            case 0x22: emit_alu_reg(false, 0x2B, rd, rs, rt);                   break; // SUB
+            case 0x23: emit_alu_reg(false, 0x2B, rd, rs, rt);                   break; // SUBU
+            case 0x24: emit_alu_reg(true,  0x23, rd, rs, rt);                   break; // AND
+            case 0x25: emit_alu_reg(true,  0x0B, rd, rs, rt);                   break; // OR
+            case 0x27: // NOR
+            {
+               emit_load_64(RAX, JIT_GPR(rs));
+               emit_reg_mem(true, 0x0B, RAX, JIT_GPR(rt));
+               emit_reg_reg(true, 0xF7, 2, RAX);
+               emit_store_64(JIT_GPR(rd), RAX);
+            } break;
+            case 0x2A: emit_set_less_than(rd, rs, rt, CC_L);                    break; // SLT
+            case 0x2B: emit_set_less_than(rd, rs, rt, CC_B);                    break; // SLTU
+            case 0x2D: emit_alu_reg(true,  0x03, rd, rs, rt);                   break; // DADDU
+            case 0x38: emit_shift_double(rd, rt, SHIFT_SHL, sa);                break; // DSLL
+            case 0x3A: emit_shift_double(rd, rt, SHIFT_SHR, sa);                break; // DSRL
+            case 0x3C: emit_shift_double(rd, rt, SHIFT_SHL, sa + 32);           break; // DSLL32
+            case 0x3E: emit_shift_double(rd, rt, SHIFT_SHR, sa + 32);           break; // DSRL32
+            case 0x3F: emit_shift_double(rd, rt, SHIFT_SAR, sa + 32);           break; // DSRA32
+         }
+         return true;
+      } break;
+
+      case 0x08: // ADDI
+      case 0x09: // ADDIU
+      {
+         if (rt == 0) return true;
+         emit_load_32(RAX, JIT_GPR(rs));
+         emit_alu_imm(false, ALU_ADD, RAX, sign_imm);
+         emit_store_word_result(rt);
+      } return true;
+
+      case 0x0A: if (rt) emit_set_less_than_imm(rt, rs, sign_imm, CC_L); return true; // SLTI
+      case 0x0B: if (rt) emit_set_less_than_imm(rt, rs, sign_imm, CC_B); return true; // SLTIU
+
+      case 0x0C: // ANDI
+      case 0x0D: // ORI
+      case 0x0E: // XORI
+      {
+         if (rt == 0) return true;
+         JIT_Alu op = opcode == 0x0C ? ALU_AND : opcode == 0x0D ? ALU_OR : ALU_XOR;
+         emit_load_64(RAX, JIT_GPR(rs));
+         emit_alu_imm(true, op, RAX, (s32)imm);
+         emit_store_64(JIT_GPR(rt), RAX);
+      } return true;
+
+      case 0x0F: // LUI
+      {
+         if (rt) emit_store_imm(true, JIT_GPR(rt), imm << 16);
+      } return true;
+
+      case 0x19: // DADDIU
+      {
+         if (rt == 0) return true;
+         emit_load_64(RAX, JIT_GPR(rs));
+         emit_alu_imm(true, ALU_ADD, RAX, sign_imm);
+         emit_store_64(JIT_GPR(rt), RAX);
+      } return true;
+
+      case 0x2F: return true; // CACHE
+   }
+
+   return false;
+}
+
+/*
+   Loads are a single access relative to r15, anything that is not backed by memory faults and ends up in
+   ee_jit_handle_fault(). The address is always in eax and the result in eax/rax so the handler only has
+   to know these four encodings. A load that faulted once is marked in slow_loads and goes through the
+   interpreter after its page is translated again, so MMIO polling only pays for the signal one time.
+*/
+static bool
+jit_translate_load (u32 instruction, u32 pc, u32 executed, bool in_delay_slot)
+{
+   u32 rs        = (instruction >> 21) & 0x1F;
+   u32 rt        = (instruction >> 16) & 0x1F;
+   s32 sign_imm  = (s16)(instruction & 0xFFFF);
+   u32 opcode    = instruction >> 26;
+
+   // Loads into r0 are left to the interpreter since MMIO reads can have side effects
+   if (!jit.fastmem_base || rt == 0) return false;
+   if (jit_get_page(pc)->slow_loads[(pc >> 2) & 0x3FF]) return false;
+
+   u32 alignment_mask = 0;
+   switch (opcode)
+   {
+      case 0x20: case 0x24:   alignment_mask = 0; break; // LB, LBU
+      case 0x21: case 0x25:   alignment_mask = 1; break; // LH, LHU
+      case 0x23: case 0x27:   alignment_mask = 3; break; // LW, LWU
+      case 0x37:              alignment_mask = 7; break; // LD
+      default: return false;
+   }
+
+   emit_load_32(RAX, JIT_GPR(rs));
+   emit_alu_imm(false, ALU_ADD, RAX, sign_imm);
+
+   // Misaligned addresses raise an address error through the interpreter
+   u8 *done = NULL;
+   if (alignment_mask)
+   {
+      emit_8(0xA9);
+      emit_32(alignment_mask);
+      u8 *aligned = emit_jcc_32(CC_E);
+      emit_interpret(instruction, pc, executed, in_delay_slot);
+      done = emit_jmp_32();
+      patch_rel_32(aligned, jit.code_ptr);
+   }
+
+   // @@Note: LB and LH zero extend like they do in ee_execute
+   jit.load_sites.push_back({jit.code_ptr, pc});
+   switch (alignment_mask)
+   {
+      case 0: emit_8(0x41); emit_8(0x0F); emit_8(0xB6); break; // movzx eax, byte [r15 + rax]
+      case 1: emit_8(0x41); emit_8(0x0F); emit_8(0xB7); break; // movzx eax, word [r15 + rax]
+      case 3: emit_8(0x41); emit_8(0x8B);               break; // mov eax, [r15 + rax]
+      case 7: emit_8(0x49); emit_8(0x8B);               break; // mov rax, [r15 + rax]
+   }
+   emit_8(0x04);
+   emit_8(0x07);
+
+   emit_store_64(JIT_GPR(rt), RAX);
+   if (done) patch_rel_32(done, jit.code_ptr);
+
+   jit.stats.fastmem_loads++;
+   return true;
+}
+
+static void
+jit_translate_instruction (u32 instruction, u32 pc, u32 executed, bool in_delay_slot)
+{
+   if (jit_translate_native(instruction)) {
+      jit.stats.native_instructions++;
+      return;
+   }
+
+   if (jit_translate_load(instruction, pc, executed, in_delay_slot)) {
+      jit.stats.native_instructions++;
+      return;
+   }
+
+   emit_interpret(instruction, pc, executed, in_delay_slot);
+}
+
+static inline u32
+jit_fetch (u32 pc)
+{
+   return ee_core_load_32(pc);
+}
+
+// Evaluates the branch condition into r13d, delay slots are allowed to overwrite the registers it reads
+static void
+emit_branch_condition (u32 instruction)
+{
+   u32 rs      = (instruction >> 21) & 0x1F;
+   u32 rt      = (instruction >> 16) & 0x1F;
+   u32 opcode  = instruction >> 26;
+
+   JIT_Condition cc = CC_E;
+   emit_load_64(RAX, JIT_GPR(rs));
+
+   switch (opcode)
+   {
+      case 0x04: case 0x14: cc = CC_E;  emit_reg_mem(true, 0x3B, RAX, JIT_GPR(rt)); break; // BEQ, BEQL
+      case 0x05: case 0x15: cc = CC_NE; emit_reg_mem(true, 0x3B, RAX, JIT_GPR(rt)); break; // BNE, BNEL
+      case 0x06: case 0x16: cc = CC_LE; emit_test_64(RAX, RAX);                      break; // BLEZ, BLEZL
+      case 0x07:            cc = CC_G;  emit_test_64(RAX, RAX);                      break; // BGTZ
+      case INSTR_REGIMM:
+      {
+         cc = (rt == 0x00) ? CC_L : CC_GE; // BLTZ, BGEZ
+         emit_test_64(RAX, RAX);
+      } break;
+   }
+
+   emit_setcc(cc, R13);
+}
+
+static void
+jit_translate_branch (u32 instruction, u32 pc, u32 executed)
+{
+   u32 delay_slot = jit_fetch(pc + 4);
+   u32 opcode     = instruction >> 26;
+
+   // Jump Register
+   if (opcode == INSTR_SPECIAL)
+   {
+      if ((instruction & 0x3F) == 0x09)
+      {
+         u32 rd = (instruction >> 11) & 0x1F;
+         emit_mov_imm32(RAX, pc + 8);
+         emit_store_64(JIT_GPR(rd != 0 ? rd : 31), RAX);
+      }
+
+      emit_load_32(R14, JIT_GPR((instruction >> 21) & 0x1F));
+      jit_translate_instruction(delay_slot, pc + 4, executed + 2, true);
+      emit_exit_dynamic(executed + 2);
+      return;
+   }
+
+   // Jump
+   if (opcode == 0x02 || opcode == 0x03)
+   {
+      u32 target = ((pc + 4) & 0xF0000000) + ((instruction & 0x3FFFFFF) << 2);
+      if (opcode == 0x03)
+      {
+         emit_mov_imm32(RAX, pc + 8);
+         emit_store_64(JIT_GPR(31), RAX);
+      }
+
+      jit_translate_instruction(delay_slot, pc + 4, executed + 2, true);
+      emit_exit_static(target, executed + 2);
+      return;
+   }
+
+   u32 target    = pc + 4 + ((s32)(s16)(instruction & 0xFFFF) << 2);
+   bool likely   = opcode == 0x14 || opcode == 0x15 || opcode == 0x16;
+
+   emit_branch_condition(instruction);
+
+   if (likely)
+   {
+      // Branch likely nullifies the delay slot when the branch is not taken
+      emit_reg_reg(false, 0x85, R13, R13);
+      u8 *not_taken = emit_jcc_32(CC_E);
+      jit_translate_instruction(delay_slot, pc + 4, executed + 2, true);
+      emit_exit_static(target, executed + 2);
+
+      patch_rel_32(not_taken, jit.code_ptr);
+      emit_exit_static(pc + 8, executed + 1);
+   }
+   else
+   {
+      jit_translate_instruction(delay_slot, pc + 4, executed + 2, true);
+      emit_reg_reg(false, 0x85, R13, R13);
+      u8 *not_taken = emit_jcc_32(CC_E);
+      emit_exit_static(target, executed + 2);
+
+      patch_rel_32(not_taken, jit.code_ptr);
+      emit_exit_static(pc + 8, executed + 2);
+   }
+}
+
+/*******************************************
+ * Block Cache
+*******************************************/
+static u8 *
+jit_compile_block (u32 pc)
+{
+   if (!ee_is_cacheable_code(pc) || (pc & 0x3)) return NULL;
+   if ((size_t)(jit.code_end - jit.code_ptr) < JIT_MAX_BLOCK_BYTES) ee_jit_flush();
+
+   u8 *code         = jit.code_ptr;
+   u32 current      = pc;
+   u32 executed     = 0;
+   bool terminated  = false;
+
+   jit.compiling_idle_loop = ee_idle_is_loop(pc);
+   jit.idle_loop_head      = pc;
+
+   while (executed < EE_JIT_MAX_BLOCK_INSTRUCTIONS)
+   {
+      // Blocks never cross a page so a write only has to invalidate the page it hit
+      if (executed && (current & 0xFFF) == 0) break;
+
+      u32 instruction = jit_fetch(current);
+      if (ee_is_branch_instruction(instruction))
+      {
+         // @Incomplete: Branches in delay slots and delay slots on the next page are left to the interpreter
+         if ((current & 0xFFF) == 0xFFC || ee_is_branch_instruction(jit_fetch(current + 4))) break;
+
+         jit_translate_branch(instruction, current, executed);
+         executed    += 2;
+         terminated  = true;
+         break;
+      }
+
+      executed += 1;
+      jit_translate_instruction(instruction, current, executed, false);
+      current += 4;
+   }
+
+   if (executed == 0)
+   {
+      jit.code_ptr = code;
+      return NULL;
+   }
+
+   if (!terminated) emit_exit_static(current, executed);
+
+   u32 address = ee_code_address_to_physical(pc);
+   if (address < 0x10000000) ee_protect_code_page(address);
+
+   JIT_Page *page = jit_get_page(pc);
+   page->blocks[(pc >> 2) & 0x3FF]     = code;
+   page->idle_loops[(pc >> 2) & 0x3FF] = jit.compiling_idle_loop;
+
+   for (JIT_Link &link : page->links)
+   {
+      if (link.target == pc) patch_rel_32(link.patch, code);
+   }
+
+   jit.stats.blocks_compiled++;
+   jit.stats.code_bytes_used = (u32)(jit.code_ptr - jit.code_start);
+   return code;
+}
+
+static void
+jit_invalidate_virtual_page (u32 vpage)
+{
+   JIT_Page *page = jit.pages[vpage];
+   if (!page) return;
+
+   memset(page->blocks, 0, sizeof(page->blocks));
+
+   // Links are kept so they can be patched again once the blocks get translated again
+   for (JIT_Link &link : page->links)
+      patch_rel_32(link.patch, jit.exit_stub);
+}
+
+// Called from the bus when a store hits an RDRAM page that holds translated code
+void
+ee_jit_invalidate_page (u32 page)
+{
+   if (!jit.pages) return;
+
+   jit.block_invalidated = true;
+   jit.stats.pages_invalidated++;
+
+   u32 vpages[EE_CODE_PAGE_ALIASES];
+   u32 count = ee_code_page_aliases(page, vpages);
+
+   for (u32 i = 0; i < count; ++i)
+      jit_invalidate_virtual_page(vpages[i]);
+}
+
+// Called from the TLB when a virtual page gets mapped to different memory
+void
+ee_jit_invalidate_virtual_page (u32 vpage)
+{
+   if (!jit.pages || !jit.pages[vpage]) return;
+
+   jit.block_invalidated = true;
+   jit.stats.pages_invalidated++;
+   jit_invalidate_virtual_page(vpage);
+}
+
+void
+ee_jit_flush ()
+{
+   if (!jit.pages) return;
+
+   for (u32 i = 0; i < JIT_PAGE_COUNT; ++i)
+   {
+      if (jit.pages[i])
+      {
+         delete jit.pages[i];
+         jit.pages[i] = NULL;
+      }
+   }
+
+   jit.load_sites.clear();
+   jit.code_ptr                = jit.code_start;
+   jit.stats.code_bytes_used   = 0;
+   jit.stats.cache_flushes++;
+}
+
+/*******************************************
+ * Entry and Exit
+*******************************************/
+static void
+jit_emit_trampolines ()
+{
+   static const u8 saved[] = { RBP, RBX, R12, R13, R14, R15 };
+
+   jit.enter = (JIT_Entry)jit.code_ptr;
+   for (u8 reg : saved)
+   {
+      emit_rex(false, 0, reg);
+      emit_8(0x50 + (reg & 7));
+   }
+   emit_alu_imm(true, ALU_SUB, RSP, JIT_STACK_RESERVE);
+   emit_reg_reg(true, 0x89, JIT_ARG0, RBX);
+   emit_reg_reg(false, 0x89, JIT_ARG2, R12);
+   if (jit.fastmem_base) emit_mov_imm64(R15, (u64)jit.fastmem_base);
+   emit_rex(false, 0, JIT_ARG1);
+   emit_8(0xFF);
+   emit_8(0xE0 | (JIT_ARG1 & 7));
+
+   jit.exit_stub = jit.code_ptr;
+   emit_reg_reg(false, 0x89, R12, RAX);
+   emit_alu_imm(true, ALU_ADD, RSP, JIT_STACK_RESERVE);
+   for (s32 i = sizeof(saved) - 1; i >= 0; --i)
+   {
+      emit_rex(false, 0, saved[i]);
+      emit_8(0x58 + (saved[i] & 7));
+   }
+   emit_8(0xC3);
+
+   jit.code_start = jit.code_ptr;
+}
+
+void
+ee_jit_init ()
+{
+   if (jit.code_buffer) return;
+
+#ifdef _WIN32
+   jit.code_buffer = (u8 *)VirtualAlloc(NULL, EE_JIT_CODE_BUFFER_SIZE, JIT_MEM_COMMIT | JIT_MEM_RESERVE, JIT_PAGE_EXECUTE_READWRITE);
+#else
+   void *buffer    = mmap(NULL, EE_JIT_CODE_BUFFER_SIZE, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+   jit.code_buffer = (buffer == MAP_FAILED) ? NULL : (u8 *)buffer;
+#endif
+
+   if (!jit.code_buffer)
+   {
+      errlog("[ERROR]: Could not allocate the EE JIT code buffer, using the interpreter\n");
+      return;
+   }
+
+   jit.code_ptr  = jit.code_buffer;
+   jit.code_end  = jit.code_buffer + EE_JIT_CODE_BUFFER_SIZE;
+   jit.pages     = (JIT_Page **)calloc(JIT_PAGE_COUNT, sizeof(JIT_Page *));
+   jit.fastmem_base = ee_vmem.base;
+
+   jit_emit_trampolines();
+   printf("EE JIT: Reserved %d MB of code memory\n", EE_JIT_CODE_BUFFER_SIZE / MEGABYTES(1));
+}
+
+void
+ee_jit_shutdown ()
+{
+   if (!jit.code_buffer) return;
+
+   ee_jit_flush();
+   free(jit.pages);
+
+#ifdef _WIN32
+   VirtualFree(jit.code_buffer, 0, JIT_MEM_RELEASE);
+#else
+   munmap(jit.code_buffer, EE_JIT_CODE_BUFFER_SIZE);
+#endif
+
+   jit = {};
+}
+
+/*
+   Runs translated blocks until the cycle budget is used up and returns the amount of guest instructions
+   that were executed. A block is never cut short so the result can overshoot the budget by part of a block.
+   Pending delay slots and code that cannot be translated are stepped through r5900_cycle.
+*/
+u32
+r5900_jit_cycle (R5900_Core *ee, u32 budget)
+{
+   if (!jit.code_buffer)
+   {
+      for (u32 i = 0; i < budget; ++i)
+         r5900_cycle(ee);
+
+      return budget;
+   }
+
+   s32 cycles = (s32)budget;
+   jit.block_invalidated = false;
+
+   while (cycles > 0)
+   {
+      // Ends the slice so the interrupt is taken on the next one
+      if (ee->interrupt_pending && !ee->is_branching) break;
+
+      u8 *code = NULL;
+      if (!ee->is_branching)
+      {
+         code = jit_lookup(ee->pc);
+         if (!code) code = jit_compile_block(ee->pc);
+      }
+
+      if (!code)
+      {
+         r5900_cycle(ee);
+         cycles -= 1;
+         continue;
+      }
+
+      if (jit.pages[ee->pc >> 12]->idle_loops[(ee->pc >> 2) & 0x3FF])
+      {
+         u32 idle = ee_idle_check(ee, ee->pc, (u32)cycles);
+         cycles -= (s32)idle;
+         if (idle) continue;
+      }
+
+      s32 remaining = jit.enter(ee, code, cycles);
+      ee->cop0.regs[9] += cycles - remaining;
+      cycles = remaining;
+
+      jit.stats.block_entries++;
+   }
+
+   return (u32)((s32)budget - cycles);
+}
+
+#if EE_VMEM_SUPPORTED
+// Called from the SIGSEGV handler when a load from translated code hits an unmapped page
+bool
+ee_jit_handle_fault (void *context)
+{
+   ucontext_t *uc  = (ucontext_t *)context;
+   u8 *rip         = (u8 *)uc->uc_mcontext.gregs[REG_RIP];
+   if (rip < jit.code_start || rip >= jit.code_end) return false;
+
+   u32 address = (u32)uc->uc_mcontext.gregs[REG_RAX];
+   u64 value   = 0;
+   u32 length  = 0;
+
+   if      (rip[0] == 0x41 && rip[1] == 0x0F && rip[2] == 0xB6) { value = ee_core_load_8(address);  length = 5; }
+   else if (rip[0] == 0x41 && rip[1] == 0x0F && rip[2] == 0xB7) { value = ee_core_load_16(address); length = 5; }
+   else if (rip[0] == 0x41 && rip[1] == 0x8B)                   { value = ee_core_load_32(address); length = 4; }
+   else if (rip[0] == 0x49 && rip[1] == 0x8B)                   { value = ee_core_load_64(address); length = 4; }
+   else return false;
+
+   uc->uc_mcontext.gregs[REG_RAX]  = (greg_t)value;
+   uc->uc_mcontext.gregs[REG_RIP] += length;
+
+   // The block keeps running, the next translation of its page calls the interpreter for this load
+   auto site = std::lower_bound(jit.load_sites.begin(), jit.load_sites.end(), rip,
+                                [](const JIT_Load_Site &site, u8 *code) { return site.code < code; });
+
+   if (site != jit.load_sites.end() && site->code == rip)
+   {
+      JIT_Page *page = jit.pages[site->pc >> 12];
+      if (page && !page->slow_loads[(site->pc >> 2) & 0x3FF])
+      {
+         page->slow_loads[(site->pc >> 2) & 0x3FF] = true;
+         jit_invalidate_virtual_page(site->pc >> 12);
+         jit.stats.slow_loads++;
+      }
+   }
+
+   return true;
+}
+#else
+bool ee_jit_handle_fault(void *) { return false; }
+#endif
+
+#else
+
+bool ee_jit_handle_fault(void *) { return false; }
+void ee_jit_init() {}
+void ee_jit_shutdown() {}
+void ee_jit_flush() {}
+void ee_jit_invalidate_page(u32 page) {}
+void ee_jit_invalidate_virtual_page(u32 vpage) {}
+
+u32
+r5900_jit_cycle (R5900_Core *ee, u32 budget)
+{
+   for (u32 i = 0; i < budget; ++i)
+      r5900_cycle(ee);
+
+   return budget;
+}
+
+#endif
+
+EE_JIT_Stats
+ee_jit_get_stats ()
+{
+#if EE_JIT_SUPPORTED
+   return jit.stats;
+#else
+   return {};
+#endif
+}
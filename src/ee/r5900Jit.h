@@ -0,0 +1,48 @@
+/*
+ * Copyright 2023 Xaviar Roach
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef R5900JIT_H
+#define R5900JIT_H
+
+/*
+   x86-64 dynamic recompiler for the EE core.
+
+   Guest basic blocks are translated into host code the first time they are reached, cached by
+   their virtual pc and linked to each other on static exits. Simple ALU ops, shifts, HI/LO moves,
+   jumps and branches (including delay slots and branch likely) are emitted natively, everything else
+   calls back into ee_decode_and_execute so both backends share the same instruction semantics.
+*/
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define EE_JIT_SUPPORTED 1
+#else
+#define EE_JIT_SUPPORTED 0
+#endif
+
+#define EE_JIT_CODE_BUFFER_SIZE        MEGABYTES(32)
+#define EE_JIT_MAX_BLOCK_INSTRUCTIONS  128
+
+typedef struct _EE_JIT_Stats_ {
+   u64 blocks_compiled;
+   u64 block_entries;
+   u64 native_instructions;
+   u64 fallback_instructions;
+   u64 fastmem_loads;
+   u64 slow_loads;            // Fastmem loads that faulted into MMIO and were moved to the interpreter
+   u64 pages_invalidated;
+   u64 cache_flushes;
+   u32 code_bytes_used;
+} EE_JIT_Stats;
+
+void           ee_jit_init();
+void           ee_jit_shutdown();
+void           ee_jit_flush();
+void           ee_jit_invalidate_page(u32 page);
+void           ee_jit_invalidate_virtual_page(u32 vpage);
+u32            r5900_jit_cycle(R5900_Core *ee, u32 budget);
+bool           ee_jit_handle_fault(void *context);
+EE_JIT_Stats   ee_jit_get_stats();
+
+#endif
@@ -0,0 +1,1107 @@
+/*
+ * Copyright 2023 Xaviar Roach
+ * SPDX-License-Identifier: MIT
+ */
+
+#define MMI_RS(instruction) (((instruction) >> 21) & 0x1F)
+#define MMI_RT(instruction) (((instruction) >> 16) & 0x1F)
+#define MMI_RD(instruction) (((instruction) >> 11) & 0x1F)
+#define MMI_SA(instruction) (((instruction) >> 6)  & 0x1F)
+
+#define MMI_TOP(function)  (function)
+#define MMI0(function)     (64  + (function))
+#define MMI1(function)     (96  + (function))
+#define MMI2(function)     (128 + (function))
+#define MMI3(function)     (160 + (function))
+
+static_assert(offsetof(R5900_Core, HI1) == offsetof(R5900_Core, HI) + 8, "HI and HI1 have to form one 128 bit register");
+static_assert(offsetof(R5900_Core, LO1) == offsetof(R5900_Core, LO) + 8, "LO and LO1 have to form one 128 bit register");
+
+static inline u32
+mmi_index (u32 instruction)
+{
+   u32 function = instruction & 0x3F;
+   u32 sub      = MMI_SA(instruction);
+
+   switch (function)
+   {
+      case 0x08: return MMI0(sub);
+      case 0x28: return MMI1(sub);
+      case 0x09: return MMI2(sub);
+      case 0x29: return MMI3(sub);
+   }
+
+   return MMI_TOP(function);
+}
+
+static inline CPU_Types
+mmi_get_hi (R5900_Core *ee)
+{
+   CPU_Types hi;
+   hi.UD[0] = ee->HI;
+   hi.UD[1] = ee->HI1;
+   return hi;
+}
+
+static inline CPU_Types
+mmi_get_lo (R5900_Core *ee)
+{
+   CPU_Types lo;
+   lo.UD[0] = ee->LO;
+   lo.UD[1] = ee->LO1;
+   return lo;
+}
+
+static inline void
+mmi_set_hi_lo (R5900_Core *ee, const CPU_Types &hi, const CPU_Types &lo)
+{
+   ee->HI   = hi.UD[0];
+   ee->HI1  = hi.UD[1];
+   ee->LO   = lo.UD[0];
+   ee->LO1  = lo.UD[1];
+}
+
+static inline s64
+mmi_clamp (s64 value, s64 low, s64 high)
+{
+   return value < low ? low : value > high ? high : value;
+}
+
+static inline u32
+mmi_ext5 (u32 value)
+{
+   return ((value & 0x1F) << 3) | ((value & 0x3E0) << 6) | ((value & 0x7C00) << 9) | ((value & 0x8000) << 16);
+}
+
+static inline u32
+mmi_pac5 (u32 value)
+{
+   return ((value >> 3) & 0x1F) | ((value >> 6) & 0x3E0) | ((value >> 9) & 0x7C00) | ((value >> 16) & 0x8000);
+}
+
+// Signed division as the EE does it, dividing by zero and overflowing do not trap
+static inline void
+mmi_divide (s32 dividend, s32 divisor, s32 *quotient, s32 *remainder)
+{
+   if (dividend == INT32_MIN && divisor == -1)
+   {
+      *quotient   = INT32_MIN;
+      *remainder  = 0;
+   }
+   else if (divisor != 0)
+   {
+      *quotient   = dividend / divisor;
+      *remainder  = dividend % divisor;
+   }
+   else
+   {
+      *quotient   = dividend < 0 ? 1 : -1;
+      *remainder  = dividend;
+   }
+}
+
+static inline void
+mmi_divide_unsigned (u32 dividend, u32 divisor, u32 *quotient, u32 *remainder)
+{
+   if (divisor != 0)
+   {
+      *quotient   = dividend / divisor;
+      *remainder  = dividend % divisor;
+   }
+   else
+   {
+      *quotient   = 0xFFFFFFFF;
+      *remainder  = dividend;
+   }
+}
+
+/*******************************************
+ * Scalar Implementation
+*******************************************/
+// Runs expression once per lane of rd, s and t are copies of rs and rt so rd can alias either of them
+#define MMI_LANES(name, field, lanes, expression)              \
+static void                                                    \
+name (R5900_Core *ee, u32 instruction)                         \
+{                                                              \
+   CPU_Types s = ee->reg.r[MMI_RS(instruction)];               \
+   CPU_Types t = ee->reg.r[MMI_RT(instruction)];               \
+   u32 sa      = MMI_SA(instruction);                          \
+   CPU_Types d;                                                \
+   (void)s; (void)t; (void)sa;                                 \
+                                                               \
+   for (int i = 0; i < lanes; ++i)                             \
+      d.field[i] = expression;                                 \
+                                                               \
+   ee->reg.r[MMI_RD(instruction)] = d;                         \
+}
+
+static const u8 mmi_pexeh_lanes[8]  = { 2, 1, 0, 3, 6, 5, 4, 7 };
+static const u8 mmi_prevh_lanes[8]  = { 3, 2, 1, 0, 7, 6, 5, 4 };
+static const u8 mmi_pexch_lanes[8]  = { 0, 2, 1, 3, 4, 6, 5, 7 };
+static const u8 mmi_pcpyh_lanes[8]  = { 0, 0, 0, 0, 4, 4, 4, 4 };
+static const u8 mmi_pexew_lanes[4]  = { 2, 1, 0, 3 };
+static const u8 mmi_prot3w_lanes[4] = { 1, 2, 0, 3 };
+static const u8 mmi_pexcw_lanes[4]  = { 0, 2, 1, 3 };
+
+// MMI0
+MMI_LANES(mmi_paddw,  UW, 4,  s.UW[i] + t.UW[i])
+MMI_LANES(mmi_psubw,  UW, 4,  s.UW[i] - t.UW[i])
+MMI_LANES(mmi_pcgtw,  UW, 4,  s.SW[i] > t.SW[i] ? 0xFFFFFFFF : 0)
+MMI_LANES(mmi_pmaxw,  SW, 4,  s.SW[i] > t.SW[i] ? s.SW[i] : t.SW[i])
+MMI_LANES(mmi_paddh,  UH, 8,  (u16)(s.UH[i] + t.UH[i]))
+MMI_LANES(mmi_psubh,  UH, 8,  (u16)(s.UH[i] - t.UH[i]))
+MMI_LANES(mmi_pcgth,  UH, 8,  s.SH[i] > t.SH[i] ? 0xFFFF : 0)
+MMI_LANES(mmi_pmaxh,  SH, 8,  s.SH[i] > t.SH[i] ? s.SH[i] : t.SH[i])
+MMI_LANES(mmi_paddb,  UB, 16, (u8)(s.UB[i] + t.UB[i]))
+MMI_LANES(mmi_psubb,  UB, 16, (u8)(s.UB[i] - t.UB[i]))
+MMI_LANES(mmi_pcgtb,  UB, 16, s.SB[i] > t.SB[i] ? 0xFF : 0)
+MMI_LANES(mmi_paddsw, SW, 4,  (s32)mmi_clamp((s64)s.SW[i] + t.SW[i], INT32_MIN, INT32_MAX))
+MMI_LANES(mmi_psubsw, SW, 4,  (s32)mmi_clamp((s64)s.SW[i] - t.SW[i], INT32_MIN, INT32_MAX))
+MMI_LANES(mmi_pextlw, UW, 4,  (i & 1 ? s : t).UW[i >> 1])
+MMI_LANES(mmi_ppacw,  UW, 4,  (i < 2 ? t : s).UW[(i & 1) * 2])
+MMI_LANES(mmi_paddsh, SH, 8,  (s16)mmi_clamp((s32)s.SH[i] + t.SH[i], INT16_MIN, INT16_MAX))
+MMI_LANES(mmi_psubsh, SH, 8,  (s16)mmi_clamp((s32)s.SH[i] - t.SH[i], INT16_MIN, INT16_MAX))
+MMI_LANES(mmi_pextlh, UH, 8,  (i & 1 ? s : t).UH[i >> 1])
+MMI_LANES(mmi_ppach,  UH, 8,  (i < 4 ? t : s).UH[(i & 3) * 2])
+MMI_LANES(mmi_paddsb, SB, 16, (s8)mmi_clamp((s32)s.SB[i] + t.SB[i], INT8_MIN, INT8_MAX))
+MMI_LANES(mmi_psubsb, SB, 16, (s8)mmi_clamp((s32)s.SB[i] - t.SB[i], INT8_MIN, INT8_MAX))
+MMI_LANES(mmi_pextlb, UB, 16, (i & 1 ? s : t).UB[i >> 1])
+MMI_LANES(mmi_ppacb,  UB, 16, (i < 8 ? t : s).UB[(i & 7) * 2])
+MMI_LANES(mmi_pext5,  UW, 4,  mmi_ext5(t.UW[i]))
+MMI_LANES(mmi_ppac5,  UW, 4,  mmi_pac5(t.UW[i]))
+
+// MMI1
+MMI_LANES(mmi_pabsw,  SW, 4,  t.SW[i] == INT32_MIN ? INT32_MAX : (t.SW[i] < 0 ? -t.SW[i] : t.SW[i]))
+MMI_LANES(mmi_pceqw,  UW, 4,  s.UW[i] == t.UW[i] ? 0xFFFFFFFF : 0)
+MMI_LANES(mmi_pminw,  SW, 4,  s.SW[i] < t.SW[i] ? s.SW[i] : t.SW[i])
+MMI_LANES(mmi_padsbh, UH, 8,  (u16)(i < 4 ? s.UH[i] - t.UH[i] : s.UH[i] + t.UH[i]))
+MMI_LANES(mmi_pabsh,  SH, 8,  t.SH[i] == INT16_MIN ? INT16_MAX : (s16)(t.SH[i] < 0 ? -t.SH[i] : t.SH[i]))
+MMI_LANES(mmi_pceqh,  UH, 8,  s.UH[i] == t.UH[i] ? 0xFFFF : 0)
+MMI_LANES(mmi_pminh,  SH, 8,  s.SH[i] < t.SH[i] ? s.SH[i] : t.SH[i])
+MMI_LANES(mmi_pceqb,  UB, 16, s.UB[i] == t.UB[i] ? 0xFF : 0)
+MMI_LANES(mmi_padduw, UW, 4,  (u32)mmi_clamp((s64)s.UW[i] + t.UW[i], 0, UINT32_MAX))
+MMI_LANES(mmi_psubuw, UW, 4,  (u32)mmi_clamp((s64)s.UW[i] - t.UW[i], 0, UINT32_MAX))
+MMI_LANES(mmi_pextuw, UW, 4,  (i & 1 ? s : t).UW[2 + (i >> 1)])
+MMI_LANES(mmi_padduh, UH, 8,  (u16)mmi_clamp((s32)s.UH[i] + t.UH[i], 0, UINT16_MAX))
+MMI_LANES(mmi_psubuh, UH, 8,  (u16)mmi_clamp((s32)s.UH[i] - t.UH[i], 0, UINT16_MAX))
+MMI_LANES(mmi_pextuh, UH, 8,  (i & 1 ? s : t).UH[4 + (i >> 1)])
+MMI_LANES(mmi_paddub, UB, 16, (u8)mmi_clamp((s32)s.UB[i] + t.UB[i], 0, UINT8_MAX))
+MMI_LANES(mmi_psubub, UB, 16, (u8)mmi_clamp((s32)s.UB[i] - t.UB[i], 0, UINT8_MAX))
+MMI_LANES(mmi_pextub, UB, 16, (i & 1 ? s : t).UB[8 + (i >> 1)])
+MMI_LANES(mmi_qfsrv,  UB, 16, (i + (ee->sa & 0xF) < 16 ? t.UB[i + (ee->sa & 0xF)] : s.UB[i + (ee->sa & 0xF) - 16]))
+
+// MMI2
+MMI_LANES(mmi_psllvw, SD, 2,  (s32)(t.UW[i * 2] << (s.UW[i * 2] & 0x1F)))
+MMI_LANES(mmi_psrlvw, SD, 2,  (s32)(t.UW[i * 2] >> (s.UW[i * 2] & 0x1F)))
+MMI_LANES(mmi_pinth,  UH, 8,  i & 1 ? s.UH[4 + (i >> 1)] : t.UH[i >> 1])
+MMI_LANES(mmi_pcpyld, UD, 2,  i ? s.UD[0] : t.UD[0])
+MMI_LANES(mmi_pand,   UD, 2,  s.UD[i] & t.UD[i])
+MMI_LANES(mmi_pxor,   UD, 2,  s.UD[i] ^ t.UD[i])
+MMI_LANES(mmi_pexeh,  UH, 8,  t.UH[mmi_pexeh_lanes[i]])
+MMI_LANES(mmi_prevh,  UH, 8,  t.UH[mmi_prevh_lanes[i]])
+MMI_LANES(mmi_pexew,  UW, 4,  t.UW[mmi_pexew_lanes[i]])
+MMI_LANES(mmi_prot3w, UW, 4,  t.UW[mmi_prot3w_lanes[i]])
+
+// MMI3
+MMI_LANES(mmi_psravw, SD, 2,  t.SW[i * 2] >> (s.UW[i * 2] & 0x1F))
+MMI_LANES(mmi_pinteh, UH, 8,  (i & 1 ? s : t).UH[i & ~1])
+MMI_LANES(mmi_pcpyud, UD, 2,  i ? t.UD[1] : s.UD[1])
+MMI_LANES(mmi_por,    UD, 2,  s.UD[i] | t.UD[i])
+MMI_LANES(mmi_pnor,   UD, 2,  ~(s.UD[i] | t.UD[i]))
+MMI_LANES(mmi_pexch,  UH, 8,  t.UH[mmi_pexch_lanes[i]])
+MMI_LANES(mmi_pcpyh,  UH, 8,  t.UH[mmi_pcpyh_lanes[i]])
+MMI_LANES(mmi_pexcw,  UW, 4,  t.UW[mmi_pexcw_lanes[i]])
+
+// Top level shifts by the sa field
+MMI_LANES(mmi_psllh,  UH, 8,  (u16)(t.UH[i] << (sa & 0xF)))
+MMI_LANES(mmi_psrlh,  UH, 8,  (u16)(t.UH[i] >> (sa & 0xF)))
+MMI_LANES(mmi_psrah,  SH, 8,  (s16)(t.SH[i] >> (sa & 0xF)))
+MMI_LANES(mmi_psllw,  UW, 4,  t.UW[i] << sa)
+MMI_LANES(mmi_psrlw,  UW, 4,  t.UW[i] >> sa)
+MMI_LANES(mmi_psraw,  SW, 4,  t.SW[i] >> sa)
+
+#undef MMI_LANES
+
+// MADD, MADDU, MULT1, MULTU1, MADD1 and MADDU1, the 64 bit result is split over the low words of HI and LO
+static inline void
+mmi_multiply (R5900_Core *ee, u32 instruction, u64 *hi, u64 *lo, bool is_signed, bool accumulate)
+{
+   CPU_Types *s = &ee->reg.r[MMI_RS(instruction)];
+   CPU_Types *t = &ee->reg.r[MMI_RT(instruction)];
+
+   u64 value = is_signed ? (u64)((s64)s->SW[0] * t->SW[0]) : (u64)s->UW[0] * t->UW[0];
+   if (accumulate) value += ((u64)(u32)*hi << 32) | (u32)*lo;
+
+   *lo = (u64)(s64)(s32)value;
+   *hi = (u64)(s64)(s32)(value >> 32);
+   ee->reg.r[MMI_RD(instruction)].UD[0] = *lo;
+}
+
+static void mmi_madd   (R5900_Core *ee, u32 instruction) { mmi_multiply(ee, instruction, &ee->HI,  &ee->LO,  true,  true);  }
+static void mmi_maddu  (R5900_Core *ee, u32 instruction) { mmi_multiply(ee, instruction, &ee->HI,  &ee->LO,  false, true);  }
+static void mmi_mult1  (R5900_Core *ee, u32 instruction) { mmi_multiply(ee, instruction, &ee->HI1, &ee->LO1, true,  false); }
+static void mmi_multu1 (R5900_Core *ee, u32 instruction) { mmi_multiply(ee, instruction, &ee->HI1, &ee->LO1, false, false); }
+static void mmi_madd1  (R5900_Core *ee, u32 instruction) { mmi_multiply(ee, instruction, &ee->HI1, &ee->LO1, true,  true);  }
+static void mmi_maddu1 (R5900_Core *ee, u32 instruction) { mmi_multiply(ee, instruction, &ee->HI1, &ee->LO1, false, true);  }
+
+static void
+mmi_div1 (R5900_Core *ee, u32 instruction)
+{
+   s32 quotient, remainder;
+   mmi_divide(ee->reg.r[MMI_RS(instruction)].SW[0], ee->reg.r[MMI_RT(instruction)].SW[0], &quotient, &remainder);
+
+   ee->LO1 = (u64)(s64)quotient;
+   ee->HI1 = (u64)(s64)remainder;
+}
+
+static void
+mmi_divu1 (R5900_Core *ee, u32 instruction)
+{
+   u32 quotient, remainder;
+   mmi_divide_unsigned(ee->reg.r[MMI_RS(instruction)].UW[0], ee->reg.r[MMI_RT(instruction)].UW[0], &quotient, &remainder);
+
+   ee->LO1 = (u64)(s64)(s32)quotient;
+   ee->HI1 = (u64)(s64)(s32)remainder;
+}
+
+static void mmi_mfhi1 (R5900_Core *ee, u32 instruction) { ee->reg.r[MMI_RD(instruction)].UD[0] = ee->HI1; }
+static void mmi_mthi1 (R5900_Core *ee, u32 instruction) { ee->HI1 = ee->reg.r[MMI_RS(instruction)].UD[0]; }
+static void mmi_mflo1 (R5900_Core *ee, u32 instruction) { ee->reg.r[MMI_RD(instruction)].UD[0] = ee->LO1; }
+static void mmi_mtlo1 (R5900_Core *ee, u32 instruction) { ee->LO1 = ee->reg.r[MMI_RS(instruction)].UD[0]; }
+
+static void mmi_pmfhi (R5900_Core *ee, u32 instruction) { ee->reg.r[MMI_RD(instruction)] = mmi_get_hi(ee); }
+static void mmi_pmflo (R5900_Core *ee, u32 instruction) { ee->reg.r[MMI_RD(instruction)] = mmi_get_lo(ee); }
+static void mmi_pmthi (R5900_Core *ee, u32 instruction) { ee->HI = ee->reg.r[MMI_RS(instruction)].UD[0]; ee->HI1 = ee->reg.r[MMI_RS(instruction)].UD[1]; }
+static void mmi_pmtlo (R5900_Core *ee, u32 instruction) { ee->LO = ee->reg.r[MMI_RS(instruction)].UD[0]; ee->LO1 = ee->reg.r[MMI_RS(instruction)].UD[1]; }
+
+// Counts the leading bits that match the sign bit, not including the sign bit itself
+static void
+mmi_plzcw (R5900_Core *ee, u32 instruction)
+{
+   CPU_Types *s = &ee->reg.r[MMI_RS(instruction)];
+   CPU_Types *d = &ee->reg.r[MMI_RD(instruction)];
+
+   for (int i = 0; i < 2; ++i)
+   {
+      u32 word    = s->SW[i] < 0 ? ~s->UW[i] : s->UW[i];
+      u32 count   = 0;
+      while (count < 32 && !(word & (0x80000000 >> count))) count++;
+
+      d->UW[i] = count - 1;
+   }
+}
+
+static void
+mmi_pmfhl (R5900_Core *ee, u32 instruction)
+{
+   CPU_Types hi   = mmi_get_hi(ee);
+   CPU_Types lo   = mmi_get_lo(ee);
+   CPU_Types *d   = &ee->reg.r[MMI_RD(instruction)];
+
+   switch (MMI_SA(instruction))
+   {
+      // LW
+      case 0x00:
+      {
+         d->UW[0] = lo.UW[0]; d->UW[1] = hi.UW[0]; d->UW[2] = lo.UW[2]; d->UW[3] = hi.UW[2];
+      } break;
+
+      // UW
+      case 0x01:
+      {
+         d->UW[0] = lo.UW[1]; d->UW[1] = hi.UW[1]; d->UW[2] = lo.UW[3]; d->UW[3] = hi.UW[3];
+      } break;
+
+      // SLW, the 64 bit value in HI:LO saturated to a word
+      case 0x02:
+      {
+         for (int i = 0; i < 2; ++i)
+         {
+            s64 value = (s64)(((u64)hi.UW[i * 2] << 32) | lo.UW[i * 2]);
+            d->SD[i]  = mmi_clamp(value, INT32_MIN, INT32_MAX);
+         }
+      } break;
+
+      // LH
+      case 0x03:
+      {
+         for (int i = 0; i < 8; ++i)
+            d->UH[i] = (i & 2 ? hi : lo).UH[(i & 1) * 2 + (i & 4)];
+      } break;
+
+      // SH
+      case 0x04:
+      {
+         for (int i = 0; i < 8; ++i)
+            d->SH[i] = (s16)mmi_clamp((i & 2 ? hi : lo).SW[(i & 1) + ((i & 4) >> 1)], INT16_MIN, INT16_MAX);
+      } break;
+
+      default:
+      {
+         errlog("[ERROR]: Invalid PMFHL format [{:#x}]\n", MMI_SA(instruction));
+      } break;
+   }
+}
+
+static void
+mmi_pmthl (R5900_Core *ee, u32 instruction)
+{
+   if (MMI_SA(instruction) != 0x00)
+   {
+      errlog("[ERROR]: Invalid PMTHL format [{:#x}]\n", MMI_SA(instruction));
+      return;
+   }
+
+   CPU_Types s    = ee->reg.r[MMI_RS(instruction)];
+   CPU_Types hi   = mmi_get_hi(ee);
+   CPU_Types lo   = mmi_get_lo(ee);
+
+   lo.UW[0] = s.UW[0]; hi.UW[0] = s.UW[1]; lo.UW[2] = s.UW[2]; hi.UW[2] = s.UW[3];
+   mmi_set_hi_lo(ee, hi, lo);
+}
+
+// PMADDW, PMSUBW, PMULTW, PMADDUW and PMULTUW work on words 0 and 2, rd gets the full 64 bit results
+static inline void
+mmi_multiply_words (R5900_Core *ee, u32 instruction, bool is_signed, int accumulate)
+{
+   CPU_Types s    = ee->reg.r[MMI_RS(instruction)];
+   CPU_Types t    = ee->reg.r[MMI_RT(instruction)];
+   CPU_Types hi   = mmi_get_hi(ee);
+   CPU_Types lo   = mmi_get_lo(ee);
+   CPU_Types d;
+
+   for (int i = 0; i < 2; ++i)
+   {
+      u64 value      = is_signed ? (u64)((s64)s.SW[i * 2] * t.SW[i * 2]) : (u64)s.UW[i * 2] * t.UW[i * 2];
+      u64 previous   = ((u64)hi.UW[i * 2] << 32) | lo.UW[i * 2];
+      if (accumulate > 0) value = previous + value;
+      if (accumulate < 0) value = previous - value;
+
+      lo.SD[i] = (s32)value;
+      hi.SD[i] = (s32)(value >> 32);
+      d.UD[i]  = value;
+   }
+
+   mmi_set_hi_lo(ee, hi, lo);
+   ee->reg.r[MMI_RD(instruction)] = d;
+}
+
+static void mmi_pmaddw  (R5900_Core *ee, u32 instruction) { mmi_multiply_words(ee, instruction, true,   1); }
+static void mmi_pmsubw  (R5900_Core *ee, u32 instruction) { mmi_multiply_words(ee, instruction, true,  -1); }
+static void mmi_pmultw  (R5900_Core *ee, u32 instruction) { mmi_multiply_words(ee, instruction, true,   0); }
+static void mmi_pmadduw (R5900_Core *ee, u32 instruction) { mmi_multiply_words(ee, instruction, false,  1); }
+static void mmi_pmultuw (R5900_Core *ee, u32 instruction) { mmi_multiply_words(ee, instruction, false,  0); }
+
+/*
+   PMADDH, PMSUBH and PMULTH. The eight products go to LO words 0 1, HI words 0 1, LO words 2 3 and
+   HI words 2 3 in that order, rd gets the even words of LO and HI.
+*/
+static inline void
+mmi_multiply_halfwords (R5900_Core *ee, u32 instruction, int accumulate)
+{
+   CPU_Types s    = ee->reg.r[MMI_RS(instruction)];
+   CPU_Types t    = ee->reg.r[MMI_RT(instruction)];
+   CPU_Types hi   = mmi_get_hi(ee);
+   CPU_Types lo   = mmi_get_lo(ee);
+   CPU_Types *d   = &ee->reg.r[MMI_RD(instruction)];
+
+   for (int i = 0; i < 8; ++i)
+   {
+      CPU_Types *target = i & 2 ? &hi : &lo;
+      u32 word          = (i & 1) | ((i & 4) >> 1);
+      u32 product       = (u32)((s32)s.SH[i] * t.SH[i]);
+
+      if (accumulate > 0)       target->UW[word] += product;
+      else if (accumulate < 0)  target->UW[word] -= product;
+      else                      target->UW[word]  = product;
+   }
+
+   mmi_set_hi_lo(ee, hi, lo);
+   d->UW[0] = lo.UW[0]; d->UW[1] = hi.UW[0]; d->UW[2] = lo.UW[2]; d->UW[3] = hi.UW[2];
+}
+
+static void mmi_pmaddh (R5900_Core *ee, u32 instruction) { mmi_multiply_halfwords(ee, instruction,  1); }
+static void mmi_pmsubh (R5900_Core *ee, u32 instruction) { mmi_multiply_halfwords(ee, instruction, -1); }
+static void mmi_pmulth (R5900_Core *ee, u32 instruction) { mmi_multiply_halfwords(ee, instruction,  0); }
+
+// PHMADH and PHMSBH, the odd words of HI and LO keep the product of the odd halfword (inverted for PHMSBH)
+static inline void
+mmi_horizontal_multiply (R5900_Core *ee, u32 instruction, bool subtract)
+{
+   CPU_Types s    = ee->reg.r[MMI_RS(instruction)];
+   CPU_Types t    = ee->reg.r[MMI_RT(instruction)];
+   CPU_Types hi, lo;
+   CPU_Types *d   = &ee->reg.r[MMI_RD(instruction)];
+
+   for (int i = 0; i < 4; ++i)
+   {
+      CPU_Types *target = i & 1 ? &hi : &lo;
+      u32 word          = i & 2;
+      u32 odd           = (u32)((s32)s.SH[i * 2 + 1] * t.SH[i * 2 + 1]);
+      u32 even          = (u32)((s32)s.SH[i * 2] * t.SH[i * 2]);
+
+      target->UW[word]     = subtract ? odd - even : odd + even;
+      target->UW[word + 1] = subtract ? ~odd : odd;
+      d->UW[i]             = target->UW[word];
+   }
+
+   mmi_set_hi_lo(ee, hi, lo);
+}
+
+static void mmi_phmadh (R5900_Core *ee, u32 instruction) { mmi_horizontal_multiply(ee, instruction, false); }
+static void mmi_phmsbh (R5900_Core *ee, u32 instruction) { mmi_horizontal_multiply(ee, instruction, true);  }
+
+static void
+mmi_pdivw (R5900_Core *ee, u32 instruction)
+{
+   CPU_Types *s = &ee->reg.r[MMI_RS(instruction)];
+   CPU_Types *t = &ee->reg.r[MMI_RT(instruction)];
+   CPU_Types hi, lo;
+
+   for (int i = 0; i < 2; ++i)
+   {
+      s32 quotient, remainder;
+      mmi_divide(s->SW[i * 2], t->SW[i * 2], &quotient, &remainder);
+      lo.SD[i] = quotient;
+      hi.SD[i] = remainder;
+   }
+
+   mmi_set_hi_lo(ee, hi, lo);
+}
+
+static void
+mmi_pdivuw (R5900_Core *ee, u32 instruction)
+{
+   CPU_Types *s = &ee->reg.r[MMI_RS(instruction)];
+   CPU_Types *t = &ee->reg.r[MMI_RT(instruction)];
+   CPU_Types hi, lo;
+
+   for (int i = 0; i < 2; ++i)
+   {
+      u32 quotient, remainder;
+      mmi_divide_unsigned(s->UW[i * 2], t->UW[i * 2], &quotient, &remainder);
+      lo.SD[i] = (s32)quotient;
+      hi.SD[i] = (s32)remainder;
+   }
+
+   mmi_set_hi_lo(ee, hi, lo);
+}
+
+// Every word of rs divided by halfword 0 of rt
+static void
+mmi_pdivbw (R5900_Core *ee, u32 instruction)
+{
+   CPU_Types *s = &ee->reg.r[MMI_RS(instruction)];
+   s16 divisor  = ee->reg.r[MMI_RT(instruction)].SH[0];
+   CPU_Types hi, lo;
+
+   for (int i = 0; i < 4; ++i)
+   {
+      s32 quotient, remainder;
+      mmi_divide(s->SW[i], divisor, &quotient, &remainder);
+      lo.SW[i] = quotient;
+      hi.SW[i] = (s16)remainder;
+   }
+
+   mmi_set_hi_lo(ee, hi, lo);
+}
+
+static void
+mmi_unknown (R5900_Core *ee, u32 instruction)
+{
+   (void)ee;
+   errlog("[ERROR]: Could not interpret MMI instruction [{:#09x}]\n", instruction);
+}
+
+/*******************************************
+ * SSE Implementation
+*******************************************/
+#if EE_MMI_SSE
+static inline __m128i
+mmi_load (const void *source)
+{
+   return _mm_loadu_si128((const __m128i *)source);
+}
+
+static inline void
+mmi_store (void *destination, __m128i value)
+{
+   _mm_storeu_si128((__m128i *)destination, value);
+}
+
+static inline __m128i
+mmi_select (__m128i mask, __m128i a, __m128i b)
+{
+   return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+static inline __m128i
+mmi_cmpgt_epu32 (__m128i a, __m128i b)
+{
+   __m128i bias = _mm_set1_epi32((int)0x80000000);
+   return _mm_cmpgt_epi32(_mm_xor_si128(a, bias), _mm_xor_si128(b, bias));
+}
+
+static inline __m128i
+mmi_adds_epi32 (__m128i a, __m128i b)
+{
+   __m128i sum        = _mm_add_epi32(a, b);
+   __m128i overflow   = _mm_srai_epi32(_mm_andnot_si128(_mm_xor_si128(a, b), _mm_xor_si128(a, sum)), 31);
+   __m128i saturated  = _mm_xor_si128(_mm_srai_epi32(a, 31), _mm_set1_epi32(INT32_MAX));
+   return mmi_select(overflow, saturated, sum);
+}
+
+static inline __m128i
+mmi_subs_epi32 (__m128i a, __m128i b)
+{
+   __m128i difference = _mm_sub_epi32(a, b);
+   __m128i overflow   = _mm_srai_epi32(_mm_and_si128(_mm_xor_si128(a, b), _mm_xor_si128(a, difference)), 31);
+   __m128i saturated  = _mm_xor_si128(_mm_srai_epi32(a, 31), _mm_set1_epi32(INT32_MAX));
+   return mmi_select(overflow, saturated, difference);
+}
+
+// The only negative result left after the absolute value is the minimum, which saturates one lower
+static inline __m128i
+mmi_abs_epi32 (__m128i a)
+{
+   __m128i sign     = _mm_srai_epi32(a, 31);
+   __m128i result   = _mm_sub_epi32(_mm_xor_si128(a, sign), sign);
+   return _mm_add_epi32(result, _mm_srai_epi32(result, 31));
+}
+
+static inline __m128i
+mmi_abs_epi16 (__m128i a)
+{
+   __m128i sign     = _mm_srai_epi16(a, 15);
+   __m128i result   = _mm_sub_epi16(_mm_xor_si128(a, sign), sign);
+   return _mm_add_epi16(result, _mm_srai_epi16(result, 15));
+}
+
+// Packs the low halfword of every word, PACKSSDW does not saturate once they are sign extended
+static inline __m128i
+mmi_pack_low_halfwords (__m128i low, __m128i high)
+{
+   return _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(low, 16), 16), _mm_srai_epi32(_mm_slli_epi32(high, 16), 16));
+}
+
+static inline __m128i
+mmi_pack_low_bytes (__m128i low, __m128i high)
+{
+   return _mm_packs_epi16(_mm_srai_epi16(_mm_slli_epi16(low, 8), 8), _mm_srai_epi16(_mm_slli_epi16(high, 8), 8));
+}
+
+static inline __m128i
+mmi_sse_ext5 (__m128i t)
+{
+   __m128i result = _mm_slli_epi32(_mm_and_si128(t, _mm_set1_epi32(0x1F)), 3);
+   result = _mm_or_si128(result, _mm_slli_epi32(_mm_and_si128(t, _mm_set1_epi32(0x3E0)),  6));
+   result = _mm_or_si128(result, _mm_slli_epi32(_mm_and_si128(t, _mm_set1_epi32(0x7C00)), 9));
+   result = _mm_or_si128(result, _mm_slli_epi32(_mm_and_si128(t, _mm_set1_epi32(0x8000)), 16));
+   return result;
+}
+
+static inline __m128i
+mmi_sse_pac5 (__m128i t)
+{
+   __m128i result = _mm_and_si128(_mm_srli_epi32(t, 3), _mm_set1_epi32(0x1F));
+   result = _mm_or_si128(result, _mm_and_si128(_mm_srli_epi32(t, 6),  _mm_set1_epi32(0x3E0)));
+   result = _mm_or_si128(result, _mm_and_si128(_mm_srli_epi32(t, 9),  _mm_set1_epi32(0x7C00)));
+   result = _mm_or_si128(result, _mm_and_si128(_mm_srli_epi32(t, 16), _mm_set1_epi32(0x8000)));
+   return result;
+}
+
+// Words 0 and 2 of HI and LO interleaved, what rd gets from the halfword multiplies and PMFHL.LW
+static inline __m128i
+mmi_even_words (__m128i lo, __m128i hi)
+{
+   return _mm_unpacklo_epi64(_mm_unpacklo_epi32(lo, hi), _mm_unpackhi_epi32(lo, hi));
+}
+
+static inline __m128i
+mmi_odd_words (__m128i lo, __m128i hi)
+{
+   return _mm_unpackhi_epi64(_mm_unpacklo_epi32(lo, hi), _mm_unpackhi_epi32(lo, hi));
+}
+
+// Sign extends words 0 and 1 to doublewords
+static inline __m128i
+mmi_sign_extend_words (__m128i words)
+{
+   return _mm_unpacklo_epi32(words, _mm_srai_epi32(words, 31));
+}
+
+// Splits the two 64 bit results of a word multiply over LO and HI and stores them in rd
+static inline void
+mmi_store_word_products (R5900_Core *ee, u32 instruction, __m128i products)
+{
+   mmi_store(&ee->LO, mmi_sign_extend_words(_mm_shuffle_epi32(products, _MM_SHUFFLE(3, 1, 2, 0))));
+   mmi_store(&ee->HI, mmi_sign_extend_words(_mm_shuffle_epi32(products, _MM_SHUFFLE(2, 0, 3, 1))));
+   mmi_store(&ee->reg.r[MMI_RD(instruction)], products);
+}
+
+// The 64 bit accumulators of the word multiplies, HI:LO of words 0 and 2
+static inline __m128i
+mmi_word_accumulators (R5900_Core *ee)
+{
+   __m128i lo = _mm_shuffle_epi32(mmi_load(&ee->LO), _MM_SHUFFLE(3, 1, 2, 0));
+   __m128i hi = _mm_shuffle_epi32(mmi_load(&ee->HI), _MM_SHUFFLE(3, 1, 2, 0));
+   return _mm_unpacklo_epi32(lo, hi);
+}
+
+#define MMI_SSE_LANES(name, expression)                        \
+static void                                                    \
+name (R5900_Core *ee, u32 instruction)                         \
+{                                                              \
+   __m128i s   = mmi_load(&ee->reg.r[MMI_RS(instruction)]);    \
+   __m128i t   = mmi_load(&ee->reg.r[MMI_RT(instruction)]);    \
+   u32 sa      = MMI_SA(instruction);                          \
+   (void)s; (void)t; (void)sa;                                 \
+                                                               \
+   mmi_store(&ee->reg.r[MMI_RD(instruction)], expression);     \
+}
+
+// MMI0
+MMI_SSE_LANES(mmi_sse_paddw,  _mm_add_epi32(s, t))
+MMI_SSE_LANES(mmi_sse_psubw,  _mm_sub_epi32(s, t))
+MMI_SSE_LANES(mmi_sse_pcgtw,  _mm_cmpgt_epi32(s, t))
+MMI_SSE_LANES(mmi_sse_paddh,  _mm_add_epi16(s, t))
+MMI_SSE_LANES(mmi_sse_psubh,  _mm_sub_epi16(s, t))
+MMI_SSE_LANES(mmi_sse_pcgth,  _mm_cmpgt_epi16(s, t))
+MMI_SSE_LANES(mmi_sse_pmaxh,  _mm_max_epi16(s, t))
+MMI_SSE_LANES(mmi_sse_paddb,  _mm_add_epi8(s, t))
+MMI_SSE_LANES(mmi_sse_psubb,  _mm_sub_epi8(s, t))
+MMI_SSE_LANES(mmi_sse_pcgtb,  _mm_cmpgt_epi8(s, t))
+MMI_SSE_LANES(mmi_sse_paddsw, mmi_adds_epi32(s, t))
+MMI_SSE_LANES(mmi_sse_psubsw, mmi_subs_epi32(s, t))
+MMI_SSE_LANES(mmi_sse_pextlw, _mm_unpacklo_epi32(t, s))
+MMI_SSE_LANES(mmi_sse_ppacw,  _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(t), _mm_castsi128_ps(s), _MM_SHUFFLE(2, 0, 2, 0))))
+MMI_SSE_LANES(mmi_sse_paddsh, _mm_adds_epi16(s, t))
+MMI_SSE_LANES(mmi_sse_psubsh, _mm_subs_epi16(s, t))
+MMI_SSE_LANES(mmi_sse_pextlh, _mm_unpacklo_epi16(t, s))
+MMI_SSE_LANES(mmi_sse_ppach,  mmi_pack_low_halfwords(t, s))
+MMI_SSE_LANES(mmi_sse_paddsb, _mm_adds_epi8(s, t))
+MMI_SSE_LANES(mmi_sse_psubsb, _mm_subs_epi8(s, t))
+MMI_SSE_LANES(mmi_sse_pextlb, _mm_unpacklo_epi8(t, s))
+MMI_SSE_LANES(mmi_sse_ppacb,  mmi_pack_low_bytes(t, s))
+MMI_SSE_LANES(mmi_sse_pext5,  mmi_sse_ext5(t))
+MMI_SSE_LANES(mmi_sse_ppac5,  mmi_sse_pac5(t))
+#if EE_MMI_SSE41
+MMI_SSE_LANES(mmi_sse_pmaxw,  _mm_max_epi32(s, t))
+#else
+MMI_SSE_LANES(mmi_sse_pmaxw,  mmi_select(_mm_cmpgt_epi32(s, t), s, t))
+#endif
+
+// MMI1
+MMI_SSE_LANES(mmi_sse_pabsw,  mmi_abs_epi32(t))
+MMI_SSE_LANES(mmi_sse_pceqw,  _mm_cmpeq_epi32(s, t))
+MMI_SSE_LANES(mmi_sse_padsbh, _mm_castpd_si128(_mm_move_sd(_mm_castsi128_pd(_mm_add_epi16(s, t)), _mm_castsi128_pd(_mm_sub_epi16(s, t)))))
+MMI_SSE_LANES(mmi_sse_pabsh,  mmi_abs_epi16(t))
+MMI_SSE_LANES(mmi_sse_pceqh,  _mm_cmpeq_epi16(s, t))
+MMI_SSE_LANES(mmi_sse_pminh,  _mm_min_epi16(s, t))
+MMI_SSE_LANES(mmi_sse_pceqb,  _mm_cmpeq_epi8(s, t))
+MMI_SSE_LANES(mmi_sse_padduw, _mm_or_si128(_mm_add_epi32(s, t), mmi_cmpgt_epu32(s, _mm_add_epi32(s, t))))
+MMI_SSE_LANES(mmi_sse_psubuw, _mm_andnot_si128(mmi_cmpgt_epu32(t, s), _mm_sub_epi32(s, t)))
+MMI_SSE_LANES(mmi_sse_pextuw, _mm_unpackhi_epi32(t, s))
+MMI_SSE_LANES(mmi_sse_padduh, _mm_adds_epu16(s, t))
+MMI_SSE_LANES(mmi_sse_psubuh, _mm_subs_epu16(s, t))
+MMI_SSE_LANES(mmi_sse_pextuh, _mm_unpackhi_epi16(t, s))
+MMI_SSE_LANES(mmi_sse_paddub, _mm_adds_epu8(s, t))
+MMI_SSE_LANES(mmi_sse_psubub, _mm_subs_epu8(s, t))
+MMI_SSE_LANES(mmi_sse_pextub, _mm_unpackhi_epi8(t, s))
+#if EE_MMI_SSE41
+MMI_SSE_LANES(mmi_sse_pminw,  _mm_min_epi32(s, t))
+#else
+MMI_SSE_LANES(mmi_sse_pminw,  mmi_select(_mm_cmpgt_epi32(s, t), t, s))
+#endif
+
+// MMI2
+MMI_SSE_LANES(mmi_sse_pinth,  _mm_unpacklo_epi16(t, _mm_srli_si128(s, 8)))
+MMI_SSE_LANES(mmi_sse_pcpyld, _mm_unpacklo_epi64(t, s))
+MMI_SSE_LANES(mmi_sse_pand,   _mm_and_si128(s, t))
+MMI_SSE_LANES(mmi_sse_pxor,   _mm_xor_si128(s, t))
+MMI_SSE_LANES(mmi_sse_pexeh,  _mm_shufflehi_epi16(_mm_shufflelo_epi16(t, _MM_SHUFFLE(3, 0, 1, 2)), _MM_SHUFFLE(3, 0, 1, 2)))
+MMI_SSE_LANES(mmi_sse_prevh,  _mm_shufflehi_epi16(_mm_shufflelo_epi16(t, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3)))
+MMI_SSE_LANES(mmi_sse_pexew,  _mm_shuffle_epi32(t, _MM_SHUFFLE(3, 0, 1, 2)))
+MMI_SSE_LANES(mmi_sse_prot3w, _mm_shuffle_epi32(t, _MM_SHUFFLE(3, 0, 2, 1)))
+
+// MMI3
+MMI_SSE_LANES(mmi_sse_pinteh, _mm_or_si128(_mm_and_si128(t, _mm_set1_epi32(0xFFFF)), _mm_slli_epi32(s, 16)))
+MMI_SSE_LANES(mmi_sse_pcpyud, _mm_unpackhi_epi64(s, t))
+MMI_SSE_LANES(mmi_sse_por,    _mm_or_si128(s, t))
+MMI_SSE_LANES(mmi_sse_pnor,   _mm_xor_si128(_mm_or_si128(s, t), _mm_set1_epi32(-1)))
+MMI_SSE_LANES(mmi_sse_pexch,  _mm_shufflehi_epi16(_mm_shufflelo_epi16(t, _MM_SHUFFLE(3, 1, 2, 0)), _MM_SHUFFLE(3, 1, 2, 0)))
+MMI_SSE_LANES(mmi_sse_pcpyh,  _mm_shufflehi_epi16(_mm_shufflelo_epi16(t, _MM_SHUFFLE(0, 0, 0, 0)), _MM_SHUFFLE(0, 0, 0, 0)))
+MMI_SSE_LANES(mmi_sse_pexcw,  _mm_shuffle_epi32(t, _MM_SHUFFLE(3, 1, 2, 0)))
+
+// Top level shifts by the sa field
+MMI_SSE_LANES(mmi_sse_psllh,  _mm_sll_epi16(t, _mm_cvtsi32_si128(sa & 0xF)))
+MMI_SSE_LANES(mmi_sse_psrlh,  _mm_srl_epi16(t, _mm_cvtsi32_si128(sa & 0xF)))
+MMI_SSE_LANES(mmi_sse_psrah,  _mm_sra_epi16(t, _mm_cvtsi32_si128(sa & 0xF)))
+MMI_SSE_LANES(mmi_sse_psllw,  _mm_sll_epi32(t, _mm_cvtsi32_si128(sa)))
+MMI_SSE_LANES(mmi_sse_psrlw,  _mm_srl_epi32(t, _mm_cvtsi32_si128(sa)))
+MMI_SSE_LANES(mmi_sse_psraw,  _mm_sra_epi32(t, _mm_cvtsi32_si128(sa)))
+
+#undef MMI_SSE_LANES
+
+static void
+mmi_sse_pmfhl (R5900_Core *ee, u32 instruction)
+{
+   __m128i lo = mmi_load(&ee->LO);
+   __m128i hi = mmi_load(&ee->HI);
+   CPU_Types *d = &ee->reg.r[MMI_RD(instruction)];
+
+   switch (MMI_SA(instruction))
+   {
+      case 0x00: mmi_store(d, mmi_even_words(lo, hi));                                                          break;
+      case 0x01: mmi_store(d, mmi_odd_words(lo, hi));                                                           break;
+      case 0x03: mmi_store(d, mmi_pack_low_halfwords(_mm_unpacklo_epi64(lo, hi), _mm_unpackhi_epi64(lo, hi)));  break;
+      case 0x04: mmi_store(d, _mm_packs_epi32(_mm_unpacklo_epi64(lo, hi), _mm_unpackhi_epi64(lo, hi)));         break;
+      default:   mmi_pmfhl(ee, instruction);                                                                    break;
+   }
+}
+
+static void
+mmi_sse_pmultuw (R5900_Core *ee, u32 instruction)
+{
+   __m128i s = mmi_load(&ee->reg.r[MMI_RS(instruction)]);
+   __m128i t = mmi_load(&ee->reg.r[MMI_RT(instruction)]);
+   mmi_store_word_products(ee, instruction, _mm_mul_epu32(s, t));
+}
+
+static void
+mmi_sse_pmadduw (R5900_Core *ee, u32 instruction)
+{
+   __m128i s = mmi_load(&ee->reg.r[MMI_RS(instruction)]);
+   __m128i t = mmi_load(&ee->reg.r[MMI_RT(instruction)]);
+   mmi_store_word_products(ee, instruction, _mm_add_epi64(mmi_word_accumulators(ee), _mm_mul_epu32(s, t)));
+}
+
+#if EE_MMI_SSE41
+static void
+mmi_sse_pmultw (R5900_Core *ee, u32 instruction)
+{
+   __m128i s = mmi_load(&ee->reg.r[MMI_RS(instruction)]);
+   __m128i t = mmi_load(&ee->reg.r[MMI_RT(instruction)]);
+   mmi_store_word_products(ee, instruction, _mm_mul_epi32(s, t));
+}
+
+static void
+mmi_sse_pmaddw (R5900_Core *ee, u32 instruction)
+{
+   __m128i s = mmi_load(&ee->reg.r[MMI_RS(instruction)]);
+   __m128i t = mmi_load(&ee->reg.r[MMI_RT(instruction)]);
+   mmi_store_word_products(ee, instruction, _mm_add_epi64(mmi_word_accumulators(ee), _mm_mul_epi32(s, t)));
+}
+
+static void
+mmi_sse_pmsubw (R5900_Core *ee, u32 instruction)
+{
+   __m128i s = mmi_load(&ee->reg.r[MMI_RS(instruction)]);
+   __m128i t = mmi_load(&ee->reg.r[MMI_RT(instruction)]);
+   mmi_store_word_products(ee, instruction, _mm_sub_epi64(mmi_word_accumulators(ee), _mm_mul_epi32(s, t)));
+}
+#endif
+
+static inline void
+mmi_sse_multiply_halfwords (R5900_Core *ee, u32 instruction, int accumulate)
+{
+   __m128i s         = mmi_load(&ee->reg.r[MMI_RS(instruction)]);
+   __m128i t         = mmi_load(&ee->reg.r[MMI_RT(instruction)]);
+   __m128i low       = _mm_mullo_epi16(s, t);
+   __m128i high      = _mm_mulhi_epi16(s, t);
+   __m128i products0 = _mm_unpacklo_epi16(low, high);
+   __m128i products1 = _mm_unpackhi_epi16(low, high);
+   __m128i lo        = _mm_unpacklo_epi64(products0, products1);
+   __m128i hi        = _mm_unpackhi_epi64(products0, products1);
+
+   if (accumulate > 0)
+   {
+      lo = _mm_add_epi32(mmi_load(&ee->LO), lo);
+      hi = _mm_add_epi32(mmi_load(&ee->HI), hi);
+   }
+   else if (accumulate < 0)
+   {
+      lo = _mm_sub_epi32(mmi_load(&ee->LO), lo);
+      hi = _mm_sub_epi32(mmi_load(&ee->HI), hi);
+   }
+
+   mmi_store(&ee->LO, lo);
+   mmi_store(&ee->HI, hi);
+   mmi_store(&ee->reg.r[MMI_RD(instruction)], mmi_even_words(lo, hi));
+}
+
+static void mmi_sse_pmaddh (R5900_Core *ee, u32 instruction) { mmi_sse_multiply_halfwords(ee, instruction,  1); }
+static void mmi_sse_pmsubh (R5900_Core *ee, u32 instruction) { mmi_sse_multiply_halfwords(ee, instruction, -1); }
+static void mmi_sse_pmulth (R5900_Core *ee, u32 instruction) { mmi_sse_multiply_halfwords(ee, instruction,  0); }
+
+static inline void
+mmi_sse_horizontal_multiply (R5900_Core *ee, u32 instruction, bool subtract)
+{
+   __m128i s      = mmi_load(&ee->reg.r[MMI_RS(instruction)]);
+   __m128i t      = mmi_load(&ee->reg.r[MMI_RT(instruction)]);
+   __m128i even   = _mm_madd_epi16(s, _mm_and_si128(t, _mm_set1_epi32(0x0000FFFF)));
+   __m128i odd    = _mm_madd_epi16(s, _mm_and_si128(t, _mm_set1_epi32((int)0xFFFF0000)));
+   __m128i result = subtract ? _mm_sub_epi32(odd, even) : _mm_add_epi32(odd, even);
+   if (subtract) odd = _mm_xor_si128(odd, _mm_set1_epi32(-1));
+
+   __m128i low    = _mm_unpacklo_epi32(result, odd);
+   __m128i high   = _mm_unpackhi_epi32(result, odd);
+   mmi_store(&ee->LO, _mm_unpacklo_epi64(low, high));
+   mmi_store(&ee->HI, _mm_unpackhi_epi64(low, high));
+   mmi_store(&ee->reg.r[MMI_RD(instruction)], result);
+}
+
+static void mmi_sse_phmadh (R5900_Core *ee, u32 instruction) { mmi_sse_horizontal_multiply(ee, instruction, false); }
+static void mmi_sse_phmsbh (R5900_Core *ee, u32 instruction) { mmi_sse_horizontal_multiply(ee, instruction, true);  }
+
+#define MMI_SSE(handler) handler
+#else
+#define MMI_SSE(handler) NULL
+#endif
+
+#if EE_MMI_SSE41
+#define MMI_SSE41(handler) handler
+#else
+#define MMI_SSE41(handler) NULL
+#endif
+
+/*******************************************
+ * Dispatch
+*******************************************/
+static const MMI_Op mmi_ops[] = {
+   { "MADD",    MMI_TOP(0x00), mmi_madd,    NULL,                       1  },
+   { "MADDU",   MMI_TOP(0x01), mmi_maddu,   NULL,                       1  },
+   { "PLZCW",   MMI_TOP(0x04), mmi_plzcw,   NULL,                       1  },
+   { "MFHI1",   MMI_TOP(0x10), mmi_mfhi1,   NULL,                       1  },
+   { "MTHI1",   MMI_TOP(0x11), mmi_mthi1,   NULL,                       1  },
+   { "MFLO1",   MMI_TOP(0x12), mmi_mflo1,   NULL,                       1  },
+   { "MTLO1",   MMI_TOP(0x13), mmi_mtlo1,   NULL,                       1  },
+   { "MULT1",   MMI_TOP(0x18), mmi_mult1,   NULL,                       1  },
+   { "MULTU1",  MMI_TOP(0x19), mmi_multu1,  NULL,                       1  },
+   { "DIV1",    MMI_TOP(0x1A), mmi_div1,    NULL,                       1  },
+   { "DIVU1",   MMI_TOP(0x1B), mmi_divu1,   NULL,                       1  },
+   { "MADD1",   MMI_TOP(0x20), mmi_madd1,   NULL,                       1  },
+   { "MADDU1",  MMI_TOP(0x21), mmi_maddu1,  NULL,                       1  },
+   { "PMFHL",   MMI_TOP(0x30), mmi_pmfhl,   MMI_SSE(mmi_sse_pmfhl),     5  },
+   { "PMTHL",   MMI_TOP(0x31), mmi_pmthl,   NULL,                       1  },
+   { "PSLLH",   MMI_TOP(0x34), mmi_psllh,   MMI_SSE(mmi_sse_psllh),     32 },
+   { "PSRLH",   MMI_TOP(0x36), mmi_psrlh,   MMI_SSE(mmi_sse_psrlh),     32 },
+   { "PSRAH",   MMI_TOP(0x37), mmi_psrah,   MMI_SSE(mmi_sse_psrah),     32 },
+   { "PSLLW",   MMI_TOP(0x3C), mmi_psllw,   MMI_SSE(mmi_sse_psllw),     32 },
+   { "PSRLW",   MMI_TOP(0x3E), mmi_psrlw,   MMI_SSE(mmi_sse_psrlw),     32 },
+   { "PSRAW",   MMI_TOP(0x3F), mmi_psraw,   MMI_SSE(mmi_sse_psraw),     32 },
+
+   { "PADDW",   MMI0(0x00),    mmi_paddw,   MMI_SSE(mmi_sse_paddw),     1  },
+   { "PSUBW",   MMI0(0x01),    mmi_psubw,   MMI_SSE(mmi_sse_psubw),     1  },
+   { "PCGTW",   MMI0(0x02),    mmi_pcgtw,   MMI_SSE(mmi_sse_pcgtw),     1  },
+   { "PMAXW",   MMI0(0x03),    mmi_pmaxw,   MMI_SSE(mmi_sse_pmaxw),     1  },
+   { "PADDH",   MMI0(0x04),    mmi_paddh,   MMI_SSE(mmi_sse_paddh),     1  },
+   { "PSUBH",   MMI0(0x05),    mmi_psubh,   MMI_SSE(mmi_sse_psubh),     1  },
+   { "PCGTH",   MMI0(0x06),    mmi_pcgth,   MMI_SSE(mmi_sse_pcgth),     1  },
+   { "PMAXH",   MMI0(0x07),    mmi_pmaxh,   MMI_SSE(mmi_sse_pmaxh),     1  },
+   { "PADDB",   MMI0(0x08),    mmi_paddb,   MMI_SSE(mmi_sse_paddb),     1  },
+   { "PSUBB",   MMI0(0x09),    mmi_psubb,   MMI_SSE(mmi_sse_psubb),     1  },
+   { "PCGTB",   MMI0(0x0A),    mmi_pcgtb,   MMI_SSE(mmi_sse_pcgtb),     1  },
+   { "PADDSW",  MMI0(0x10),    mmi_paddsw,  MMI_SSE(mmi_sse_paddsw),    1  },
+   { "PSUBSW",  MMI0(0x11),    mmi_psubsw,  MMI_SSE(mmi_sse_psubsw),    1  },
+   { "PEXTLW",  MMI0(0x12),    mmi_pextlw,  MMI_SSE(mmi_sse_pextlw),    1  },
+   { "PPACW",   MMI0(0x13),    mmi_ppacw,   MMI_SSE(mmi_sse_ppacw),     1  },
+   { "PADDSH",  MMI0(0x14),    mmi_paddsh,  MMI_SSE(mmi_sse_paddsh),    1  },
+   { "PSUBSH",  MMI0(0x15),    mmi_psubsh,  MMI_SSE(mmi_sse_psubsh),    1  },
+   { "PEXTLH",  MMI0(0x16),    mmi_pextlh,  MMI_SSE(mmi_sse_pextlh),    1  },
+   { "PPACH",   MMI0(0x17),    mmi_ppach,   MMI_SSE(mmi_sse_ppach),     1  },
+   { "PADDSB",  MMI0(0x18),    mmi_paddsb,  MMI_SSE(mmi_sse_paddsb),    1  },
+   { "PSUBSB",  MMI0(0x19),    mmi_psubsb,  MMI_SSE(mmi_sse_psubsb),    1  },
+   { "PEXTLB",  MMI0(0x1A),    mmi_pextlb,  MMI_SSE(mmi_sse_pextlb),    1  },
+   { "PPACB",   MMI0(0x1B),    mmi_ppacb,   MMI_SSE(mmi_sse_ppacb),     1  },
+   { "PEXT5",   MMI0(0x1E),    mmi_pext5,   MMI_SSE(mmi_sse_pext5),     1  },
+   { "PPAC5",   MMI0(0x1F),    mmi_ppac5,   MMI_SSE(mmi_sse_ppac5),     1  },
+
+   { "PABSW",   MMI1(0x01),    mmi_pabsw,   MMI_SSE(mmi_sse_pabsw),     1  },
+   { "PCEQW",   MMI1(0x02),    mmi_pceqw,   MMI_SSE(mmi_sse_pceqw),     1  },
+   { "PMINW",   MMI1(0x03),    mmi_pminw,   MMI_SSE(mmi_sse_pminw),     1  },
+   { "PADSBH",  MMI1(0x04),    mmi_padsbh,  MMI_SSE(mmi_sse_padsbh),    1  },
+   { "PABSH",   MMI1(0x05),    mmi_pabsh,   MMI_SSE(mmi_sse_pabsh),     1  },
+   { "PCEQH",   MMI1(0x06),    mmi_pceqh,   MMI_SSE(mmi_sse_pceqh),     1  },
+   { "PMINH",   MMI1(0x07),    mmi_pminh,   MMI_SSE(mmi_sse_pminh),     1  },
+   { "PCEQB",   MMI1(0x0A),    mmi_pceqb,   MMI_SSE(mmi_sse_pceqb),     1  },
+   { "PADDUW",  MMI1(0x10),    mmi_padduw,  MMI_SSE(mmi_sse_padduw),    1  },
+   { "PSUBUW",  MMI1(0x11),    mmi_psubuw,  MMI_SSE(mmi_sse_psubuw),    1  },
+   { "PEXTUW",  MMI1(0x12),    mmi_pextuw,  MMI_SSE(mmi_sse_pextuw),    1  },
+   { "PADDUH",  MMI1(0x14),    mmi_padduh,  MMI_SSE(mmi_sse_padduh),    1  },
+   { "PSUBUH",  MMI1(0x15),    mmi_psubuh,  MMI_SSE(mmi_sse_psubuh),    1  },
+   { "PEXTUH",  MMI1(0x16),    mmi_pextuh,  MMI_SSE(mmi_sse_pextuh),    1  },
+   { "PADDUB",  MMI1(0x18),    mmi_paddub,  MMI_SSE(mmi_sse_paddub),    1  },
+   { "PSUBUB",  MMI1(0x19),    mmi_psubub,  MMI_SSE(mmi_sse_psubub),    1  },
+   { "PEXTUB",  MMI1(0x1A),    mmi_pextub,  MMI_SSE(mmi_sse_pextub),    1  },
+   { "QFSRV",   MMI1(0x1B),    mmi_qfsrv,   NULL,                       1  },
+
+   { "PMADDW",  MMI2(0x00),    mmi_pmaddw,  MMI_SSE41(mmi_sse_pmaddw),  1  },
+   { "PSLLVW",  MMI2(0x02),    mmi_psllvw,  NULL,                       1  },
+   { "PSRLVW",  MMI2(0x03),    mmi_psrlvw,  NULL,                       1  },
+   { "PMSUBW",  MMI2(0x04),    mmi_pmsubw,  MMI_SSE41(mmi_sse_pmsubw),  1  },
+   { "PMFHI",   MMI2(0x08),    mmi_pmfhi,   NULL,                       1  },
+   { "PMFLO",   MMI2(0x09),    mmi_pmflo,   NULL,                       1  },
+   { "PINTH",   MMI2(0x0A),    mmi_pinth,   MMI_SSE(mmi_sse_pinth),     1  },
+   { "PMULTW",  MMI2(0x0C),    mmi_pmultw,  MMI_SSE41(mmi_sse_pmultw),  1  },
+   { "PDIVW",   MMI2(0x0D),    mmi_pdivw,   NULL,                       1  },
+   { "PCPYLD",  MMI2(0x0E),    mmi_pcpyld,  MMI_SSE(mmi_sse_pcpyld),    1  },
+   { "PMADDH",  MMI2(0x10),    mmi_pmaddh,  MMI_SSE(mmi_sse_pmaddh),    1  },
+   { "PHMADH",  MMI2(0x11),    mmi_phmadh,  MMI_SSE(mmi_sse_phmadh),    1  },
+   { "PAND",    MMI2(0x12),    mmi_pand,    MMI_SSE(mmi_sse_pand),      1  },
+   { "PXOR",    MMI2(0x13),    mmi_pxor,    MMI_SSE(mmi_sse_pxor),      1  },
+   { "PMSUBH",  MMI2(0x14),    mmi_pmsubh,  MMI_SSE(mmi_sse_pmsubh),    1  },
+   { "PHMSBH",  MMI2(0x15),    mmi_phmsbh,  MMI_SSE(mmi_sse_phmsbh),    1  },
+   { "PEXEH",   MMI2(0x1A),    mmi_pexeh,   MMI_SSE(mmi_sse_pexeh),     1  },
+   { "PREVH",   MMI2(0x1B),    mmi_prevh,   MMI_SSE(mmi_sse_prevh),     1  },
+   { "PMULTH",  MMI2(0x1C),    mmi_pmulth,  MMI_SSE(mmi_sse_pmulth),    1  },
+   { "PDIVBW",  MMI2(0x1D),    mmi_pdivbw,  NULL,                       1  },
+   { "PEXEW",   MMI2(0x1E),    mmi_pexew,   MMI_SSE(mmi_sse_pexew),     1  },
+   { "PROT3W",  MMI2(0x1F),    mmi_prot3w,  MMI_SSE(mmi_sse_prot3w),    1  },
+
+   { "PMADDUW", MMI3(0x00),    mmi_pmadduw, MMI_SSE(mmi_sse_pmadduw),   1  },
+   { "PSRAVW",  MMI3(0x03),    mmi_psravw,  NULL,                       1  },
+   { "PMTHI",   MMI3(0x08),    mmi_pmthi,   NULL,                       1  },
+   { "PMTLO",   MMI3(0x09),    mmi_pmtlo,   NULL,                       1  },
+   { "PINTEH",  MMI3(0x0A),    mmi_pinteh,  MMI_SSE(mmi_sse_pinteh),    1  },
+   { "PMULTUW", MMI3(0x0C),    mmi_pmultuw, MMI_SSE(mmi_sse_pmultuw),   1  },
+   { "PDIVUW",  MMI3(0x0D),    mmi_pdivuw,  NULL,                       1  },
+   { "PCPYUD",  MMI3(0x0E),    mmi_pcpyud,  MMI_SSE(mmi_sse_pcpyud),    1  },
+   { "POR",     MMI3(0x12),    mmi_por,     MMI_SSE(mmi_sse_por),       1  },
+   { "PNOR",    MMI3(0x13),    mmi_pnor,    MMI_SSE(mmi_sse_pnor),      1  },
+   { "PEXCH",   MMI3(0x1A),    mmi_pexch,   MMI_SSE(mmi_sse_pexch),     1  },
+   { "PCPYH",   MMI3(0x1B),    mmi_pcpyh,   MMI_SSE(mmi_sse_pcpyh),     1  },
+   { "PEXCW",   MMI3(0x1E),    mmi_pexcw,   MMI_SSE(mmi_sse_pexcw),     1  },
+};
+
+#define MMI_OP_COUNT (sizeof(mmi_ops) / sizeof(mmi_ops[0]))
+
+void
+ee_mmi_init ()
+{
+   for (u32 i = 0; i < MMI_TABLE_SIZE; ++i)
+      mmi_handlers[i] = mmi_unknown;
+
+   for (u32 i = 0; i < MMI_OP_COUNT; ++i)
+   {
+      const MMI_Op *op = &mmi_ops[i];
+      mmi_handlers[op->index] = (op->simd && !EE_MMI_SCALAR) ? op->simd : op->scalar;
+   }
+}
+
+void
+ee_mmi_execute (R5900_Core *ee, u32 instruction)
+{
+   mmi_handlers[mmi_index(instruction)](ee, instruction);
+
+   // The 128 bit writes go past the part of r0 the backends clear
+   ee->reg.r[0].UD[0] = 0;
+   ee->reg.r[0].UD[1] = 0;
+}
+
+/*******************************************
+ * Benchmark
+*******************************************/
+static u64 mmi_random_state = 0x9E3779B97F4A7C15;
+
+static inline u64
+mmi_random ()
+{
+   mmi_random_state ^= mmi_random_state << 13;
+   mmi_random_state ^= mmi_random_state >> 7;
+   mmi_random_state ^= mmi_random_state << 17;
+   return mmi_random_state;
+}
+
+// Mostly random halfwords with the values that hit saturation and sign edge cases mixed in
+static void
+mmi_random_register (CPU_Types *r)
+{
+   static const u16 edges[] = { 0x0000, 0x0001, 0x007F, 0x0080, 0x7FFF, 0x8000, 0xFFFF };
+
+   for (int i = 0; i < 8; ++i)
+   {
+      u64 random = mmi_random();
+      r->UH[i] = (random & 3) ? (u16)(random >> 16) : edges[(random >> 8) % 7];
+   }
+}
+
+static u32
+mmi_encode (u32 index, u32 rs, u32 rt, u32 rd, u32 sa)
+{
+   static const u32 groups[4] = { 0x08, 0x28, 0x09, 0x29 };
+   u32 instruction = ((u32)INSTR_MMI << 26) | (rs << 21) | (rt << 16) | (rd << 11);
+
+   if (index < 64) return instruction | (sa << 6) | index;
+   return instruction | (((index - 64) & 0x1F) << 6) | groups[(index - 64) / 32];
+}
+
+static f64
+mmi_time_handler (MMI_Handler handler, R5900_Core *ee, u32 instruction, u32 iterations)
+{
+   u64 start = SDL_GetPerformanceCounter();
+   for (u32 i = 0; i < iterations; ++i)
+      handler(ee, instruction);
+   u64 end = SDL_GetPerformanceCounter();
+
+   return (f64)(end - start) * 1e9 / (f64)SDL_GetPerformanceFrequency() / iterations;
+}
+
+/*
+   Checks every SSE version against its scalar version on random registers and times both, run with
+   --mmi-benchmark. The handlers are called through a pointer the same way the interpreter calls them.
+*/
+void
+ee_mmi_benchmark ()
+{
+   const u32 checks     = 1 << 14;
+   const u32 iterations = 1 << 22;
+
+   static R5900_Core scalar_core, simd_core;
+   u32 compared = 0, mismatches = 0;
+
+   printf("MMI benchmark, %s dispatch, SSE4.1 %s\n", EE_MMI_SCALAR ? "scalar" : "SSE", EE_MMI_SSE41 ? "on" : "off");
+   printf("%-8s %12s %12s %8s\n", "", "scalar ns", "sse ns", "speedup");
+
+   for (u32 i = 0; i < MMI_OP_COUNT; ++i)
+   {
+      const MMI_Op *op = &mmi_ops[i];
+      if (!op->simd) continue;
+
+      u32 failed = 0;
+      for (u32 check = 0; check < checks; ++check)
+      {
+         memset(&scalar_core, 0, sizeof(R5900_Core));
+         for (int r = 1; r < 4; ++r)
+            mmi_random_register(&scalar_core.reg.r[r]);
+
+         CPU_Types hi, lo;
+         mmi_random_register(&hi);
+         mmi_random_register(&lo);
+         mmi_set_hi_lo(&scalar_core, hi, lo);
+         scalar_core.sa = (u32)mmi_random();
+
+         // Random register numbers so rd also aliases rs and rt
+         u32 sa            = (u32)(mmi_random() % op->sa_values);
+         u32 instruction   = mmi_encode(op->index, 1 + mmi_random() % 3, 1 + mmi_random() % 3, 1 + mmi_random() % 3, sa);
+         simd_core         = scalar_core;
+
+         op->scalar(&scalar_core, instruction);
+         op->simd(&simd_core, instruction);
+         if (memcmp(&scalar_core, &simd_core, sizeof(R5900_Core)) != 0) failed++;
+      }
+
+      u32 instruction = mmi_encode(op->index, 2, 3, 1, 0);
+      f64 scalar_time = mmi_time_handler(op->scalar, &scalar_core, instruction, iterations);
+      f64 simd_time   = mmi_time_handler(op->simd, &simd_core, instruction, iterations);
+
+      printf("%-8s %12.2f %12.2f %7.2fx", op->name, scalar_time, simd_time, scalar_time / simd_time);
+      if (failed) printf("  MISMATCH %u/%u", failed, checks);
+      printf("\n");
+
+      compared++;
+      if (failed) mismatches++;
+   }
+
+   printf("%u of %u MMI instructions have an SSE version, %u did not match the scalar version\n", compared, (u32)MMI_OP_COUNT, mismatches);
+}
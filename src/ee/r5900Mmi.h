@@ -0,0 +1,52 @@
+/*
+ * Copyright 2023 Xaviar Roach
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef R5900MMI_H
+#define R5900MMI_H
+
+/*
+   The MMI group works on all 128 bits of the GPRs and on the 128 bit HI and LO pairs. Every instruction
+   has a plain C++ version and most of them also have an SSE version that works on the register lanes
+   directly. Building with EE_MMI_SCALAR=1 runs the plain versions, the SSE versions are still built on
+   x86 so --mmi-benchmark can compare the two.
+*/
+#ifndef EE_MMI_SCALAR
+#define EE_MMI_SCALAR 0
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define EE_MMI_SSE 1
+#include <emmintrin.h>
+#else
+#define EE_MMI_SSE 0
+#endif
+
+#if EE_MMI_SSE && (defined(__SSE4_1__) || defined(__AVX__))
+#define EE_MMI_SSE41 1
+#include <smmintrin.h>
+#else
+#define EE_MMI_SSE41 0
+#endif
+
+typedef void (*MMI_Handler)(R5900_Core *ee, u32 instruction);
+
+typedef struct _MMI_Op_ {
+   const char     *name;
+   u32            index;      // Slot in the dispatch table, see mmi_index()
+   MMI_Handler    scalar;
+   MMI_Handler    simd;       // NULL when there is nothing to gain over the scalar version
+   u32            sa_values;  // How many values of the sa field the benchmark feeds the instruction
+} MMI_Op;
+
+// The top level functions come first, then the 32 entries of MMI0, MMI1, MMI2 and MMI3
+#define MMI_TABLE_SIZE  (64 + 4 * 32)
+
+static MMI_Handler mmi_handlers[MMI_TABLE_SIZE];
+
+void  ee_mmi_init();
+void  ee_mmi_execute(R5900_Core *ee, u32 instruction);
+void  ee_mmi_benchmark();
+
+#endif
@@ -0,0 +1,332 @@
+/*
+ * Copyright 2023 Xaviar Roach
+ * SPDX-License-Identifier: MIT
+ */
+
+/*******************************************
+ * Entries
+*******************************************/
+static TLB_Entry
+tlb_entry_from_registers (COP0_Registers *cop0)
+{
+   u32 entry_lo[2] = { cop0->entryLo0, cop0->entryLo1 };
+
+   TLB_Entry entry      = {};
+   entry.page_mask      = cop0->pageMask & 0x01FFE000;
+   entry.vpn2           = (cop0->entryHi0 >> 13) & ~(entry.page_mask >> 13);
+   entry.asid           = cop0->entryHi0 & 0xFF;
+   entry.set_scratchpad = (cop0->entryLo0 >> 31) & 0x1;
+   entry.set_global     = (entry_lo[0] & entry_lo[1]) & 0x1;
+
+   for (u32 i = 0; i < 2; ++i)
+   {
+      entry.page_frame_number[i] = (entry_lo[i] >> 6) & 0xFFFFF;
+      entry.cache_mode[i]        = (entry_lo[i] >> 3) & 0x7;
+      entry.dirty[i]             = (entry_lo[i] >> 2) & 0x1;
+      entry.valid[i]             = (entry_lo[i] >> 1) & 0x1;
+   }
+
+   return entry;
+}
+
+static inline u32
+tlb_entry_lo (TLB_Entry *entry, u32 i)
+{
+   return (entry->page_frame_number[i] << 6) | (entry->cache_mode[i] << 3) |
+          (entry->dirty[i] << 2) | (entry->valid[i] << 1) | (u32)entry->set_global;
+}
+
+// Size of the even and of the odd half of an entry
+static inline u32
+tlb_entry_page_size (TLB_Entry *entry)
+{
+   return (entry->page_mask >> 1) + KILOBYTES(4);
+}
+
+static inline bool
+tlb_entry_applies (TLB_Entry *entry)
+{
+   if (!entry->valid[0] && !entry->valid[1]) return false;
+   return entry->set_global || entry->asid == ee_tlb.asid;
+}
+
+/*******************************************
+ * Translation Cache
+*******************************************/
+static void
+tlb_vmem_flush ()
+{
+   if (ee_tlb.vmem_size) ee_vmem_map_host(ee_tlb.vmem_address, ee_tlb.vmem_memory, ee_tlb.vmem_size);
+
+   ee_tlb.vmem_address = 0;
+   ee_tlb.vmem_memory  = NULL;
+   ee_tlb.vmem_size    = 0;
+}
+
+// Pages are queued up so a 16MB entry turns into one mmap instead of 4096
+static void
+tlb_vmem_queue (u32 address, u8 *memory)
+{
+   if (!ee_vmem.base) return;
+
+   bool contiguous = ee_tlb.vmem_size && address == ee_tlb.vmem_address + ee_tlb.vmem_size &&
+                     memory == (ee_tlb.vmem_memory ? ee_tlb.vmem_memory + ee_tlb.vmem_size : NULL);
+   if (!contiguous)
+   {
+      tlb_vmem_flush();
+      ee_tlb.vmem_address = address;
+      ee_tlb.vmem_memory  = memory;
+   }
+
+   ee_tlb.vmem_size += KILOBYTES(4);
+}
+
+static void
+tlb_set_page (u32 address, u8 *read, u8 *write, u32 mapped)
+{
+   u32 page = address >> 12;
+
+   // Code is cached by virtual address, so whatever was decoded from the old page is gone
+   if (_ee_read_pages_[page] != read)
+   {
+      ee_jit_invalidate_virtual_page(page);
+      ee_cache_invalidate_virtual_page(page);
+      tlb_vmem_queue(address, read);
+      ee_tlb.pages_remapped++;
+   }
+
+   _ee_read_pages_[page]   = read;
+   _ee_write_pages_[page]  = write;
+   _ee_tlb_pages_[page]    = mapped;
+}
+
+// KSEG0 and KSEG1 are never translated and keep the flat mapping, so they double as the physical view
+static inline bool
+tlb_is_mapped_segment (u32 address)
+{
+   return address < 0x80000000 || address >= 0xC0000000;
+}
+
+static void
+tlb_set_flat_page (u32 address)
+{
+   if (address >= 0x70000000 && address < 0x70004000)
+   {
+      u8 *scratchpad = _scratchpad_ + (address & 0x3FFF);
+      tlb_set_page(address, scratchpad, scratchpad, 0);
+      return;
+   }
+
+   u32 physical = (0x80000000 | ee_flat_physical(address)) >> 12;
+   tlb_set_page(address, _ee_read_pages_[physical], _ee_write_pages_[physical], 0);
+}
+
+/*
+   @@Note: The scratchpad entry always covers 16KB from the start of the even page no matter what the
+   page mask or the odd page say.
+   @Incomplete: Caching modes are not emulated, and pages without the dirty bit are still writable
+   instead of raising a TLB Modified exception.
+*/
+static void
+tlb_map_entry (u32 index)
+{
+   TLB_Entry *entry  = &ee_tlb.entries[index];
+   u32 size          = tlb_entry_page_size(entry);
+   u32 even          = entry->vpn2 << 13;
+
+   ee_tlb.ranges[index][0] = {};
+   ee_tlb.ranges[index][1] = {};
+   ee_tlb.applied[index]   = true;
+
+   if (entry->set_scratchpad)
+   {
+      ee_tlb.ranges[index][0] = { even, KILOBYTES(16) };
+      for (u32 offset = 0; offset < KILOBYTES(16); offset += KILOBYTES(4))
+      {
+         if (!tlb_is_mapped_segment(even + offset)) continue;
+
+         u8 *scratchpad = _scratchpad_ + offset;
+         tlb_set_page(even + offset, scratchpad, scratchpad, EE_TLB_SCRATCHPAD);
+      }
+      return;
+   }
+
+   for (u32 i = 0; i < 2; ++i)
+   {
+      if (!entry->valid[i]) continue;
+
+      u32 address  = even + i * size;
+      u32 physical = (entry->page_frame_number[i] << 12) & ~(size - 1);
+      ee_tlb.ranges[index][i] = { address, size };
+
+      for (u32 offset = 0; offset < size; offset += KILOBYTES(4))
+      {
+         if (!tlb_is_mapped_segment(address + offset)) continue;
+
+         u32 page = (0x80000000 | ((physical + offset) & 0x1FFFFFFF)) >> 12;
+         tlb_set_page(address + offset, _ee_read_pages_[page], _ee_write_pages_[page], (physical + offset) | EE_TLB_MAPPED);
+      }
+   }
+}
+
+static void
+tlb_unmap_entry (u32 index)
+{
+   for (u32 i = 0; i < 2; ++i)
+   {
+      EE_TLB_Range *range = &ee_tlb.ranges[index][i];
+      for (u32 offset = 0; offset < range->size; offset += KILOBYTES(4))
+      {
+         if (tlb_is_mapped_segment(range->address + offset))
+            tlb_set_flat_page(range->address + offset);
+      }
+   }
+
+   ee_tlb.ranges[index][0] = {};
+   ee_tlb.ranges[index][1] = {};
+   ee_tlb.applied[index]   = false;
+}
+
+/*
+   Brings the page tables in line with the entries. Taking an entry out puts the flat mapping back, which
+   can clobber an overlapping entry, so everything that applies is mapped again after that. Pages that end
+   up where they were before are left alone.
+*/
+static void
+tlb_update (bool dropped)
+{
+   for (u32 i = 0; i < EE_TLB_ENTRIES; ++i)
+   {
+      if (ee_tlb.applied[i] && !tlb_entry_applies(&ee_tlb.entries[i]))
+      {
+         tlb_unmap_entry(i);
+         dropped = true;
+      }
+   }
+
+   for (u32 i = 0; i < EE_TLB_ENTRIES; ++i)
+   {
+      if (tlb_entry_applies(&ee_tlb.entries[i]) && (dropped || !ee_tlb.applied[i]))
+         tlb_map_entry(i);
+   }
+
+   tlb_vmem_flush();
+}
+
+/*******************************************
+ * Instructions
+*******************************************/
+void
+ee_tlb_read (R5900_Core *ee)
+{
+   u32 index = ee->cop0.index & 0x3F;
+   if (index >= EE_TLB_ENTRIES)
+   {
+      errlog("[ERROR]: TLBR with an out of range index [{:d}]\n", index);
+      return;
+   }
+
+   TLB_Entry *entry   = &ee_tlb.entries[index];
+   ee->cop0.pageMask  = entry->page_mask;
+   ee->cop0.entryHi0  = (entry->vpn2 << 13) | entry->asid;
+   ee->cop0.entryLo0  = tlb_entry_lo(entry, 0) | ((u32)entry->set_scratchpad << 31);
+   ee->cop0.entryLo1  = tlb_entry_lo(entry, 1);
+
+   // EntryHi holds the current ASID, so reading an entry can switch address spaces
+   ee_tlb_set_asid(entry->asid);
+}
+
+void
+ee_tlb_write (R5900_Core *ee, u32 index)
+{
+   index &= 0x3F;
+   if (index >= EE_TLB_ENTRIES)
+   {
+      errlog("[ERROR]: TLB write with an out of range index [{:d}]\n", index);
+      return;
+   }
+
+   bool dropped = ee_tlb.applied[index];
+   if (dropped) tlb_unmap_entry(index);
+
+   ee_tlb.entries[index]   = tlb_entry_from_registers(&ee->cop0);
+   ee_tlb.asid             = ee->cop0.entryHi0 & 0xFF;
+   ee_tlb.writes++;
+
+   tlb_update(dropped);
+}
+
+void
+ee_tlb_probe (R5900_Core *ee)
+{
+   u32 vpn2 = ee->cop0.entryHi0 >> 13;
+   u32 asid = ee->cop0.entryHi0 & 0xFF;
+
+   for (u32 i = 0; i < EE_TLB_ENTRIES; ++i)
+   {
+      TLB_Entry *entry = &ee_tlb.entries[i];
+      u32 mask         = ~(entry->page_mask >> 13);
+
+      if ((vpn2 & mask) == entry->vpn2 && (entry->set_global || entry->asid == asid))
+      {
+         ee->cop0.index = i;
+         return;
+      }
+   }
+
+   ee->cop0.index = 0x80000000;
+}
+
+void
+ee_tlb_set_asid (u32 asid)
+{
+   if (asid == ee_tlb.asid) return;
+
+   ee_tlb.asid = asid;
+   tlb_update(false);
+}
+
+/*******************************************
+ * Bus
+*******************************************/
+// Virtual pages the entries map onto the RDRAM page, on top of the flat aliases in ee_code_page_aliases()
+u32
+ee_tlb_code_page_aliases (u32 page, u32 *vpages)
+{
+   u32 offset = page << 12;
+   u32 count  = 0;
+
+   for (u32 index = 0; index < EE_TLB_ENTRIES; ++index)
+   {
+      TLB_Entry *entry = &ee_tlb.entries[index];
+      if (!ee_tlb.applied[index] || entry->set_scratchpad) continue;
+
+      for (u32 i = 0; i < 2; ++i)
+      {
+         EE_TLB_Range *range = &ee_tlb.ranges[index][i];
+         if (!range->size) continue;
+
+         // RDRAM is mirrored every 32MB below the I/O registers, a half is never bigger than 16MB
+         u32 physical  = (entry->page_frame_number[i] << 12) & ~(range->size - 1);
+         u32 candidate = (physical & ~0x01FFFFFF) | offset;
+         if (candidate < physical) candidate += MEGABYTES(32);
+
+         if (candidate < 0x10000000 && candidate - physical < range->size)
+            vpages[count++] = (range->address + (candidate - physical)) >> 12;
+      }
+   }
+
+   return count;
+}
+
+void
+ee_tlb_reset ()
+{
+   for (u32 i = 0; i < EE_TLB_ENTRIES; ++i)
+   {
+      if (ee_tlb.applied[i]) tlb_unmap_entry(i);
+   }
+
+   tlb_vmem_flush();
+   ee_tlb = {};
+}
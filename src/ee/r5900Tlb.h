@@ -0,0 +1,78 @@
+/*
+ * Copyright 2023 Xaviar Roach
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef R5900TLB_H
+#define R5900TLB_H
+
+/*
+   The 48 entry TLB of the EE core.
+
+   Entries are never walked on a memory access. Writing an entry, or changing the ASID in EntryHi, maps
+   the pages it covers straight into the 4KB page tables of the bus so a translated access is still a
+   single lookup. Pages no entry covers keep the flat mapping from ee_map_memory(), which matches the
+   mapping the BIOS sets up for RDRAM, the I/O registers and the scratchpad.
+*/
+
+#define EE_TLB_ENTRIES        48
+#define EE_TLB_PAGE_COUNT     (1 << 20)
+
+// Flags in _ee_tlb_pages_, the rest of an entry is the physical address of the page
+#define EE_TLB_MAPPED         0x1
+#define EE_TLB_SCRATCHPAD     0x2
+
+// Where each part of an entry was mapped when it was applied, so it can be taken out again
+typedef struct _EE_TLB_Range_ {
+   u32 address;
+   u32 size;
+} EE_TLB_Range;
+
+typedef struct _EE_TLB_ {
+   TLB_Entry      entries[EE_TLB_ENTRIES];
+   bool           applied[EE_TLB_ENTRIES];
+   EE_TLB_Range   ranges[EE_TLB_ENTRIES][2];   // Even and odd pages
+   u32            asid;
+
+   // Pages that changed while an entry was mapped, sent to the host address space in one go, see vmem.h
+   u32            vmem_address;
+   u8             *vmem_memory;
+   u32            vmem_size;
+
+   u64            writes;
+   u64            pages_remapped;
+} EE_TLB;
+
+static EE_TLB ee_tlb = {};
+
+// Physical page and flags for every 4KB page of the EE virtual address space that a TLB entry maps
+static u32 _ee_tlb_pages_[EE_TLB_PAGE_COUNT];
+
+// Physical address of a page that keeps the flat mapping
+static inline u32
+ee_flat_physical (u32 address)
+{
+   if (address >= 0x30100000 && address < 0x31FFFFFF) // uncached and accelerated ram
+      address -= 0x10000000; // move to unaccelerated ram
+
+   return address & 0x1FFFFFFF;
+}
+
+// Physical address for accesses that miss the page tables and go to the bus
+static inline u32
+ee_virtual_to_physical (u32 address)
+{
+   u32 mapped = _ee_tlb_pages_[address >> 12];
+   if (mapped) return (mapped & ~0xFFF) | (address & 0xFFF);
+
+   return ee_flat_physical(address);
+}
+
+void  ee_tlb_reset();
+void  ee_tlb_read(R5900_Core *ee);
+void  ee_tlb_write(R5900_Core *ee, u32 index);
+void  ee_tlb_probe(R5900_Core *ee);
+void  ee_tlb_set_asid(u32 asid);
+u32   ee_tlb_code_page_aliases(u32 page, u32 *vpages);
+
+#endif
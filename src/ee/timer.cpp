@@ -11,16 +11,205 @@ enum Timer_Registers {
 	Tn_COMP = 0x10000020, 	Tn_HOLD = 0x10000030,
 };
 
+static const MMIO_Handler timer_mmio = { .name = "EE Timers", .read_32 = timer_read, .write_32 = timer_write };
+
+// @@Note: Timers are not ticked, their count is worked out from the EE cycles that passed since the last update,
+// see ee_current_cycles()
+static Event_Handle timer_event = -1;
+static u64 timer_last_update = 0;
+
+static void
+timer_compare_reached (int index)
+{
+	Timer &timer = timers[index];
+	if (timer.mode.compare_interrupt && !timer.mode.equal_flag) 
+	{
+		/* Edge triggered IRQ */
+		timer.mode.equal_flag = 1;
+		syslog("Trigger compare interrupt\n");
+		request_interrupt(INT_TIMER0 + index);
+	}
+}
+
+static void
+timer_overflowed (int index)
+{
+	Timer &timer = timers[index];
+	if (timer.mode.overflow_interrupt && !timer.mode.overflow_flag) 
+	{
+		/* Edge triggered IRQ */
+		timer.mode.overflow_flag = 1;
+		syslog("Trigger overflow interrupt");
+		request_interrupt(INT_TIMER0 + index);
+	}
+}
+
+/*
+	A single cycle of a timer. The internal counter synchronizes the count with the prescaler ratio, so the
+	count goes up once every prescaler + 2 cycles.
+*/
+static void
+timer_tick (int index)
+{
+	Timer &timer 			= timers[index];
+	u32 internal_counter = timer.counter;
+	bool overflow 			= false;
+	timer.counter += 1;
+
+	if (internal_counter > timer.prescaler) 
+	{
+		timer.counter = 0;
+		timer.count.count += 1;
+		/* The count register is only 16 bits in length */
+		overflow = (timer.count.count == 0);
+	}
+
+	if (timer.count.count == timer.comp.compare) 
+	{
+		timer_compare_reached(index);
+		if (timer.mode.zero_return)
+			timer.count.count = 0;
+	}
+
+	if (overflow) timer_overflowed(index);
+}
+
+// Count increments until the count next equals the compare value, a full wrap when they are already equal
+static inline u64
+timer_increments_to_compare (Timer &timer)
+{
+	u64 increments = (u16)(timer.comp.compare - timer.count.count);
+	return increments ? increments : 0x10000;
+}
+
+// EE cycles until the count goes up for the nth time
+static inline u64
+timer_cycles_to_increment (Timer &timer, u64 n)
+{
+	u64 period 	= (u64)timer.prescaler + 2;
+	u64 first 	= (timer.counter + 1 >= period) ? 1 : period - timer.counter;
+	return first + (n - 1) * period;
+}
+
+/*
+	Runs a timer for the given amount of cycles without stepping through them. The first cycle goes through
+	timer_tick() since it is the only one where the count can already be equal to the compare value, after
+	that only the count increments matter.
+*/
+static void
+timer_advance (int index, u64 cycles)
+{
+	Timer &timer = timers[index];
+	if (!timer.mode.count_enable || cycles == 0) return;
+
+	timer_tick(index);
+	cycles -= 1;
+
+	u64 period 	= (u64)timer.prescaler + 2;
+	u64 first 	= (timer.counter + 1 >= period) ? 1 : period - timer.counter;
+	if (cycles < first)
+	{
+		timer.counter += (u32)cycles;
+		return;
+	}
+
+	u64 increments = 1 + (cycles - first) / period;
+	timer.counter 	= (u32)((cycles - first) % period);
+
+	u64 to_compare 		= timer_increments_to_compare(timer);
+	u64 to_overflow 		= 0x10000 - timer.count.count;
+	bool reaches_compare = increments >= to_compare;
+	// With zero return the count only wraps when it started above the compare value
+	bool overflows 		= increments >= to_overflow && (!timer.mode.zero_return || to_overflow <= to_compare);
+
+	if (reaches_compare) timer_compare_reached(index);
+	if (overflows) 		timer_overflowed(index);
+
+	if (timer.mode.zero_return && reaches_compare)
+	{
+		u64 wrap = timer.comp.compare ? timer.comp.compare : 0x10000;
+		timer.count.count = (u16)((increments - to_compare) % wrap);
+	}
+	else
+	{
+		timer.count.count = (u16)(timer.count.count + increments);
+	}
+}
+
+// Brings every timer up to the current EE cycle, this has to happen before any of their registers are touched
+static void
+timer_update ()
+{
+	u64 now 				= ee_current_cycles();
+	u64 elapsed 		= now - timer_last_update;
+	timer_last_update = now;
+
+	for (int i = 0; i <= 3; i++)
+		timer_advance(i, elapsed);
+}
+
+// EE cycles until the timer could raise an interrupt, 0 when it never will in its current state
+static u64
+timer_cycles_to_interrupt (Timer &timer)
+{
+	if (!timer.mode.count_enable) return 0;
+
+	bool compare_pending  = timer.mode.compare_interrupt && !timer.mode.equal_flag;
+	bool overflow_pending = timer.mode.overflow_interrupt && !timer.mode.overflow_flag;
+	if (!compare_pending && !overflow_pending) return 0;
+
+	// @@Note: Scheduling early is harmless, the event just updates the timers and schedules again
+	if (compare_pending && timer.count.count == timer.comp.compare) return 1;
+
+	u64 to_compare 	= timer_increments_to_compare(timer);
+	u64 to_overflow 	= 0x10000 - timer.count.count;
+	u64 increments 	= compare_pending ? to_compare : UINT64_MAX;
+
+	if (overflow_pending && (!timer.mode.zero_return || to_overflow <= to_compare) && to_overflow < increments)
+		increments = to_overflow;
+
+	if (increments == UINT64_MAX) return 0;
+	return timer_cycles_to_increment(timer, increments);
+}
+
+static void
+timer_schedule_interrupt ()
+{
+	u64 cycles = 0;
+	for (int i = 0; i <= 3; i++)
+	{
+		u64 timer_cycles = timer_cycles_to_interrupt(timers[i]);
+		if (timer_cycles && (!cycles || timer_cycles < cycles)) cycles = timer_cycles;
+	}
+
+	// The scheduler counts from the start of the slice, the timers are already up to the current cycle
+	if (cycles) scheduler_schedule(timer_event, ee_slice_cycles() + cycles);
+	else 			scheduler_cancel(timer_event);
+}
+
+static void
+timer_interrupt_callback (u64, u64)
+{
+	timer_update();
+	timer_schedule_interrupt();
+}
+
 void
 timer_reset()
 {
 	printf("Resetting EE Timers\n");
 	memset(&timers, 0, 4 * sizeof(Timer));
+
+	ee_mmio_register(0x10000000, 0x1850, &timer_mmio);
+
+	timer_event 		= scheduler_register_event("EE Timers", timer_interrupt_callback);
+	timer_last_update = ee_current_cycles();
 }
 
 Timer 
 dump_ee_timer (int index)
 {
+   timer_update();
    return timers[index];
 }
 
@@ -29,6 +218,7 @@ timer_read (u32 address)
 {
 	int index = (address >> 11) & 0x3;
 	int reg = (address & ~0x1800);
+	timer_update();
 	//printf("Timer index: [%d] [%04x]\n", index, reg);
 	switch(reg)
 	{
@@ -64,6 +254,7 @@ timer_write (u32 address, u32 value)
 {
 	int index = (address >> 11) & 0x3;
 	int reg = (address & ~0x1800);
+	timer_update();
 	switch(reg)
 	{
 		case Tn_COUNT:
@@ -71,6 +262,7 @@ timer_write (u32 address, u32 value)
 			//syslog("Timer index: [%d]\n", index);
 			syslog("WRITE: Tn_COUNT. Value : [{:#08x}]\n", value);
 			timers[index].count.count = value & 0xFFFF;
+			timer_schedule_interrupt();
 			return;
 		} break;
 
@@ -98,6 +290,8 @@ timer_write (u32 address, u32 value)
 				/* HBLANK NTSC Timings from: https://psi-rockin.github.io/ps2tek/#eetimers */
 				case 3: { timers[index].prescaler = 9370; 	} break;
 			}
+
+			timer_schedule_interrupt();
 			return;
 		} break;
 
@@ -106,6 +300,7 @@ timer_write (u32 address, u32 value)
 			//syslog("Timer index: [%d]\n", index);
 			syslog("WRITE: Tn_COMP. Value : [{:#08x}]\n", value);
 			timers[index].comp.compare = value & 0xFFFF;
+			timer_schedule_interrupt();
 			return;
 		} break;
 
@@ -118,58 +313,3 @@ timer_write (u32 address, u32 value)
 		} break;
 	}
 }
-
-void
-timer_tick()
-{
-	u32 internal_counter;
-	/* Timers are 32 bits but the count register is only 16 bits in length */
-	u32 overflow = (1 << 16);
-	/*Technically theres 5 timers but this is for 4 */
-	for (int i = 0; i <= 3; i++) 
-   {
-		auto &timer = timers[i];
-		if (!timer.mode.count_enable) continue;
-
-		internal_counter = timer.counter;
-		timer.counter += 1;
-
-		/*
-		   We use an internal counter here in order to synchronize the timer with the prescaler ratio
-			This is quite expensive so in the future I might change it in accordance with other emulators
-			and how they do timing
-		*/
-		if (internal_counter > timer.prescaler) 
-      {
-			timer.counter = 0;
-			timer.count.count += 1;
-		}
-
-		if (timer.count.count == timer.comp.compare) 
-      {
-			if (timer.mode.compare_interrupt && !timer.mode.equal_flag) 
-         {
-				/* Edge triggered IRQ */
-				timer.mode.equal_flag = 1;
-				syslog("Trigger compare interrupt\n");
-				request_interrupt(INT_TIMER0 + i);
-			}
-
-			if (timer.mode.zero_return)
-				timer.count.count = 0;
-		}
-
-		if (timer.count.count > overflow) 
-      {
-			if (timer.mode.overflow_interrupt && !timer.mode.overflow_flag) 
-         {
-				/* Edge triggered IRQ */
-				timer.mode.overflow_flag = 1;
-				syslog("Trigger overflow interrupt");
-				request_interrupt(INT_TIMER0 + i);
-			}
-			timer.count.count = 0;
-		}
-	}
-	return;
-}
\ No newline at end of file
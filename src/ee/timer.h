@@ -92,6 +92,5 @@ struct Timer
 void 	timer_reset();
 u32 	timer_read(u32 address);
 void 	timer_write(u32 address, u32 value);
-void 	timer_tick();
 
 #endif
\ No newline at end of file
@@ -7,11 +7,17 @@
 // #include <queue>
 alignas(16) GIF gif;
 
+static const MMIO_Handler gif_mmio 		= { .name = "GIF", .read_32 = gif_read, .write_32 = gif_write };
+static const MMIO_Handler gif_fifo_mmio = { .name = "GIF FIFO", .read_128 = gif_fifo_read, .write_128 = gif_fifo_write };
+
 static void
 gif_reset ()
 {
 	syslog("Resetting GIF interface\n");
 	memset(&gif, 0, sizeof(gif));
+
+	ee_mmio_register(0x10003000, 0xB0, &gif_mmio);
+	ee_mmio_register(0x10006000, 16, 	&gif_fifo_mmio);
 }
 
 /*enum Data_Modes : u8
@@ -42,7 +48,7 @@ gif_process_packed (GIF_Tag *current_tag, u128 data)
 	u64 reg 				= 0;
 
 	if (current_tag->PRE == 1) {
-		gs_write_internal(0x00, current_tag->PRIM);
+		gs_queue_write(0x00, current_tag->PRIM);
 	} else {
 		/* Idle Cylcle Here */
 	}
@@ -50,7 +56,7 @@ gif_process_packed (GIF_Tag *current_tag, u128 data)
 	switch(destination)
 	{
 		case _PRIM: {
-			gs_write_internal(0x00, data.lo);
+			gs_queue_write(0x00, data.lo);
 		} break;
 
 		case _RGBAQ: {
@@ -59,7 +65,7 @@ gif_process_packed (GIF_Tag *current_tag, u128 data)
 			reg |= ((data.hi >> 0)  & 0xFF) >> 16; // blue
 			reg |= ((data.hi >> 32) & 0xFF) >> 24; // alpha
 
-			gs_write_internal(0x01, reg);
+			gs_queue_write(0x01, reg);
 		} break;
 
 		case _ST: {
@@ -67,14 +73,14 @@ gif_process_packed (GIF_Tag *current_tag, u128 data)
 			reg |= data.lo >> 32; 		 // t
 			f32 q = data.hi & 0xFFFFFFFF;
 
-			gs_write_internal(0x02, reg);
-			gs_set_q(q);
+			gs_queue_write(0x02, reg);
+			gs_queue_q(q);
 		} break;
 
 		case _UV: {
 			reg |= (data.lo 			& 0x3FFF); 		 // u
 			reg |= ((data.lo >> 32) & 0x3FFF) >> 16; // v
-			gs_write_internal(0x03, reg);
+			gs_queue_write(0x03, reg);
 		} break;
 
 		case _XYZF: {
@@ -85,8 +91,8 @@ gif_process_packed (GIF_Tag *current_tag, u128 data)
 
 			bool ADC = (data.hi >> 47) & 0x1;
 
-			if (ADC == 0)	gs_write_internal(0x04, reg);
-			else 				gs_write_internal(0x0c, reg);
+			if (ADC == 0)	gs_queue_write(0x04, reg);
+			else 				gs_queue_write(0x0c, reg);
 		} break;
 
 		case _XYZ: {
@@ -96,20 +102,20 @@ gif_process_packed (GIF_Tag *current_tag, u128 data)
 
 			bool ADC = (data.hi >> 47) & 0x1;
 
-			if (ADC == 0)	gs_write_internal(0x05, reg);
-			else 				gs_write_internal(0x0d, reg);
+			if (ADC == 0)	gs_queue_write(0x05, reg);
+			else 				gs_queue_write(0x0d, reg);
 		} break;
 
 		case _FOG: {
 			reg |= ((data.hi >> 36) & 0xFF) >> 56; //fog
-			gs_write_internal(0x0a, reg);
+			gs_queue_write(0x0a, reg);
 		} break;
 
 		case _A_D: {
 			/* 0xA+D */
 			u8 addr 				= data.hi & 0xFF;
 			u64 packaged_data = data.lo;
-			gs_write_internal(addr, packaged_data);
+			gs_queue_write(addr, packaged_data);
 		} break;
 
 		/*No Output */
@@ -151,11 +157,10 @@ gif_select_mode (GIF_Tag *current_tag, u128 data)
 		break;
 
 		case IMAGE:
-			gs_write_hwreg_software(data.lo);
-			gs_write_hwreg_software(data.hi);
+			gs_queue_image(data._8, sizeof(data));
 #if USE_HARDWARE
-         gs_write_hwreg_hardware(data.lo);
-         gs_write_hwreg_hardware(data.hi);
+         gs_queue_hwreg_hardware(data.lo);
+         gs_queue_hwreg_hardware(data.hi);
 #endif
 			current_tag->data_left--;
 			if (current_tag->data_left == 0)
@@ -194,7 +199,7 @@ gif_tag_unpack (u128 pack)
 			new_gif_tag.NREGS = 16;
 
 		gif.tag[0] = new_gif_tag;
-		gs_set_q(1.0);
+		gs_queue_q(1.0);
 	} else {
 		gif_select_mode(&gif.tag[0], pack);
 	}
@@ -204,6 +209,41 @@ static void
 gif_process_path3 (u128 data)
 {
 	gif_tag_unpack(data);
+
+	// The GS thread can start on a packet as soon as it is complete
+	if (!gif.tag[0].is_tag) gs_flush();
+}
+
+/*
+	Takes up to `quadwords` of a contiguous run of PATH3 data in one go while the current tag is in IMAGE
+	mode and returns how many it took. Zero means the next quadword has to go through gif_process_path3(),
+	a tag or anything that is not IMAGE data.
+*/
+static u32
+gif_process_image (const u8 *data, u32 quadwords)
+{
+	GIF_Tag *current_tag = &gif.tag[0];
+	if (!current_tag->is_tag || current_tag->data_left == 0 || current_tag->FLG != IMAGE)
+		return 0;
+
+	u32 count = std::min<u32>(quadwords, current_tag->data_left);
+	gs_queue_image(data, count * 16);
+#if USE_HARDWARE
+	for (u32 i = 0; i < count * 2; ++i)
+	{
+		u64 value;
+		memcpy(&value, data + i * 8, sizeof(value));
+		gs_queue_hwreg_hardware(value);
+	}
+#endif
+
+	current_tag->data_left -= count;
+	if (current_tag->data_left == 0)
+	{
+		current_tag->is_tag = false;
+		gs_flush();
+	}
+	return count;
 }
 
 static u32
@@ -253,7 +293,7 @@ gif_read (u32 address)
 			break;
 
 			default:
-				errlog("[ERROR] Failed to read gif_read32\n");
+				errtrace("[ERROR] Failed to read gif_read32\n");
 				return 0;
 			break;
 		}
@@ -284,23 +324,38 @@ gif_write (u32 address, u32 value)
 		break;
 
 		default:
-			errlog("[ERROR] Failed to read gif_write32\n");
+			errtrace("[ERROR] Failed to read gif_write32\n");
 			return;
 		break;
 	}
 	return;
 }
 
-//@@Incomplete: Supposed to be u128
+// Quadwords the EE writes to the FIFO go down PATH3 like the ones from the DMAC
 static void
-gif_fifo_write (u32 address)
+gif_fifo_write (u32, u128 value)
 {
-	//printf("WRITE: GIF FIFO\n");
+	gif_process_path3(value);
 }
 
-static void
-gif_fifo_read(u32 address)
+//@@Incomplete: Reading the FIFO back is only possible while the GIF is transferring to the EE
+static u128
+gif_fifo_read (u32)
+{
+	// Local => Host data comes out of VRAM, so everything queued in front of TRXDIR has to be drawn
+	gs_sync();
+
+	u128 r = {};
+	gs_memory_readback(r._8, sizeof(r));
+	systrace("READ: GIF FIFO\n");
+	return r;
+}
+
+// Local => Host data for a DMA transfer to memory, `quadwords` of it go straight to `data`
+static u32
+gif_readback (u8 *data, u32 quadwords)
 {
-	printf("READ: GIF FIFO\n");
-	//return 0;
+	gs_sync();
+	gs_memory_readback(data, (u64)quadwords * 16);
+	return quadwords;
 }
\ No newline at end of file
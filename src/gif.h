@@ -160,8 +160,10 @@ static void 	gif_reset();
 static u32  	gif_read (u32 address);
 static void 	gif_write (u32 address, u32 value);
 static void 	gif_process_path3(u128 data);
-static void 	gif_fifo_write(u32 address);
-static void 	gif_fifo_read(u32 address);
+static u32  	gif_process_image(const u8 *data, u32 quadwords);
+static void 	gif_fifo_write(u32 address, u128 value);
+static u128 	gif_fifo_read(u32 address);
+static u32  	gif_readback(u8 *data, u32 quadwords);
 
 #define GIF_H
 #endif
\ No newline at end of file
@@ -46,6 +46,15 @@ enum Alpha_Test_Methods : u8
    NOTEQUAL    = 0x7,
 };
 
+// Only 2 bits wide, so it can not share the alpha test values
+enum Depth_Test_Methods : u8
+{
+   ZTST_NEVER   = 0x0,
+   ZTST_ALWAYS  = 0x1,
+   ZTST_GEQUAL  = 0x2,
+   ZTST_GREATER = 0x3,
+};
+
 // typedef enum AlphaFailSettings;
 enum Alpha_Fail_Settings : u8
 {
@@ -63,6 +72,12 @@ enum Pixel_Storage_Mode : u8
    PSMCT16     = 0x2,
    PSMCT16S    = 0xA,
 
+   PSMT8       = 0x13,
+   PSMT4       = 0x14,
+   PSMT8H      = 0x1B,
+   PSMT4HL     = 0x24,
+   PSMT4HH     = 0x2C,
+
    PSMZ32      = 0x30,
    PSMZ24      = 0x31,
    PSMZ16      = 0x32,
@@ -112,11 +127,90 @@ pack_RGBA_to_v4 (u8 r, u8 b, u8 g, u8 a)
    return val;
 }
 
+static const MMIO_Handler gs_mmio = {
+   .name       = "GS",
+   .read_32    = gs_read_32_priviledged,
+   .read_64    = gs_read_64_priviledged,
+   .write_32   = gs_write_32_priviledged,
+   .write_64   = gs_write_64_priviledged,
+};
+
+static Event_Handle gs_hblank_event        = -1;
+static Event_Handle gs_vblank_start_event  = -1;
+static Event_Handle gs_vblank_end_event    = -1;
+
+// HSINT and VSINT go out on INT_GS unless they are masked in IMR, the CSR side is still the read hack below
+static void
+gs_hblank_callback (u64, u64 cycles_late)
+{
+   gs.scanline = (gs.scanline + 1) % GS_SCANLINES_PER_FIELD;
+   if (!gs.imr.hsync_mask) request_interrupt(INT_GS);
+
+   scheduler_schedule(gs_hblank_event, GS_SCANLINE_CYCLES - MIN(cycles_late, GS_SCANLINE_CYCLES - 1));
+}
+
+static void
+gs_vblank_start_callback (u64, u64 cycles_late)
+{
+   gs.in_vblank   = true;
+   gs.frame_ready = true;
+   gs.frame_count++;
+   request_interrupt(INT_VB_ON);
+   if (!gs.imr.vsync_mask) request_interrupt(INT_GS);
+
+   u64 cycles = (GS_SCANLINES_PER_FIELD - GS_VBLANK_START_SCANLINE) * GS_SCANLINE_CYCLES;
+   scheduler_schedule(gs_vblank_end_event, cycles - MIN(cycles_late, cycles - 1));
+}
+
+static void
+gs_vblank_end_callback (u64, u64 cycles_late)
+{
+   gs.in_vblank = false;
+   request_interrupt(INT_VB_OFF);
+
+   u64 cycles = GS_VBLANK_START_SCANLINE * GS_SCANLINE_CYCLES;
+   scheduler_schedule(gs_vblank_start_event, cycles - MIN(cycles_late, cycles - 1));
+}
+
+// Returns true once per field after VBLANK started, the frontend presents the frame when it sees it
+bool
+gs_frame_ready ()
+{
+   bool ready     = gs.frame_ready;
+   gs.frame_ready = false;
+   return ready;
+}
+
+// BUSDIR turns the GIF around for Local => Host transmissions, DMA then goes from the GIF to memory
+bool
+gs_bus_to_host ()
+{
+   return gs.busdir.direction;
+}
+
 void
 gs_reset ()
 {
    memset(&gs, 0, sizeof(gs));
+   gs_memory_reset();
+   gs_pixel_invalidate();
    syslog("Resetting Graphics Synthesizer\n");
+
+   ee_mmio_register(0x12000000, KILOBYTES(8), &gs_mmio);
+
+   // Every interrupt source is masked until the kernel writes IMR
+   gs.imr.value                  = 0x7F00;
+   gs.imr.signal_mask            = true;
+   gs.imr.finish_mask            = true;
+   gs.imr.hsync_mask             = true;
+   gs.imr.vsync_mask             = true;
+   gs.imr.write_termination_mask = true;
+
+   gs_hblank_event         = scheduler_register_event("GS HBLANK",       gs_hblank_callback);
+   gs_vblank_start_event   = scheduler_register_event("GS VBLANK Start", gs_vblank_start_callback);
+   gs_vblank_end_event     = scheduler_register_event("GS VBLANK End",   gs_vblank_end_callback);
+   scheduler_schedule(gs_hblank_event,       GS_SCANLINE_CYCLES);
+   scheduler_schedule(gs_vblank_start_event, GS_VBLANK_START_SCANLINE * GS_SCANLINE_CYCLES);
    // Software VRAM
    gs.vram = (u32*)malloc(sizeof(u32) * MEGABYTES(4));
    memset(gs.vram, 0, sizeof(u32) * MEGABYTES(4));
@@ -180,14 +274,16 @@ gs_set_crt (bool interlaced, s32 display_mode, bool ffmd)
 void
 gs_render_crt (SDL_Context *context)
 {
+   // Everything the GIF sent during the field has to be in VRAM before it is scanned out
+   gs_sync();
+
    PMODE *pmode        = &gs.pmode;
    DISPLAY *display1   = &gs.display1;
    DISPLAY *display2   = &gs.display2;
    DISPFB *dispfb1     = &gs.dispfb1;
    DISPFB *dispfb2     = &gs.dispfb2;
 
-   // @Hack
-   u16 framebuffer_width = ((dispfb2->value >> 9) & 0x3F) * 64;
+   u16 framebuffer_width = dispfb2->buffer_width * 64;
 
    // @Incomplete: Check which of the circuits are enabled then use the respective display buffer
    // But this is a low priority right now
@@ -205,65 +301,43 @@ gs_render_crt (SDL_Context *context)
          u32 frame_y = y;
          frame_x *= framebuffer_width;
          frame_x /= x_magh;
-         context->backbuffer->pixels[x + (y * x_magh)] = gs.vram[dispfb2->base_pointer + frame_x + (frame_y * framebuffer_width)];
+         context->backbuffer->pixels[x + (y * x_magh)] = gs_memory_read_color(dispfb2->storage_formats, dispfb2->base_pointer,
+                                                                              framebuffer_width, frame_x, frame_y);
          // @Hack: Temporarily assume that MMOD and AMOD are true and this is the final output value
          context->backbuffer->pixels[x + (y * x_magh)] |= 0xFF000000;
       }
    }
 }
 
+// A run of IMAGE data, HWREG writes are runs of a single doubleword
 void
-gs_host_to_host_transmission (u64 data) {}
-
-void
-gs_write_hwreg_software (u64 data)
+gs_write_image (const u8 *data, u32 size)
 {
-   TRXDIR *trxdir              = &gs.trxdir;
-   TRXPOS *trxpos              = &gs.trxpos;
-   TRXREG *trxreg              = &gs.trxreg;
-   BITBLTBUF *bitbltbuf        = &gs.bitbltbuf;
-   Transmission_Buffer *buffer = &gs.transmission_buffer;
-   u32 max_pixels              = trxreg->width * trxreg->height;
+   gs_raster_flush();
 
+   TRXDIR *trxdir = &gs.trxdir;
    if (trxdir->direction != 0x0)
       return;
 
-   // BPP is 4 for PSMCT32 but because of hwreg being written twice its actually 2
-   u32 bytes_pp    = 2;
-   u32 x           = trxpos->dest_x_coord + buffer->row;
-   u32 y           = trxpos->dest_y_coord + buffer->pitch;
-
-   // @Incomplete: Only PSMCT32 and its calculation is represented here
+   // Pixels are staged and swizzled into VRAM a band of blocks at a time, see gs_memory.h
+   if (gs_memory_upload(data, size))
    {
-      buffer->address             = (bitbltbuf->dest_base_pointer + ((x + 0) + (bitbltbuf->dest_buffer_width * y)));
-      gs.vram[buffer->address]    = data;
-      buffer->address             = (bitbltbuf->dest_base_pointer + ((x + 1) + (bitbltbuf->dest_buffer_width * y)));
-      gs.vram[buffer->address]    = data >> 32;
-
-      buffer->row                 += bytes_pp;
-      buffer->pixel_count         += bytes_pp;
-   }
-
-   if (buffer->row >= trxreg->width) {
-      buffer->pitch  += 1;
-      buffer->row     = 0;
-   }
-
-   if (buffer->pixel_count == max_pixels) {
-      buffer->pitch       = 0;
-      buffer->row         = 0;
-      buffer->pixel_count = 0;
-      buffer->address     = 0;
       gs.trxdir.direction = 3;
-
       syslog("Ending: Host => Local Transmission\n");
-      return;
    }
 }
 
+void
+gs_write_hwreg_software (u64 data)
+{
+   gs_write_image((const u8*)&data, sizeof(data));
+}
+
 void
 gs_write_hwreg_hardware (u64 data)
 {
+   gs_raster_flush();
+
    TRXDIR *trxdir              = &gs.trxdir;
    TRXPOS *trxpos              = &gs.trxpos;
    TRXREG *trxreg              = &gs.trxreg;
@@ -300,121 +374,22 @@ scissor_test_fail (s32 x, s32 y)
     2.)
 */
 static void
-draw_pixel (V3I *pos, u32 color)
+gs_write_pixel (s32 x, s32 y, u32 z, u32 color)
 {
-   //@@Incomplete: Only using context 1 for rendering for now
-   TEST *test          = &gs.test_1;
-   FRAME *frame_1      = &gs.frame_1;
-   ZBUF *zbuf_1        = &gs.zbuf_1;
-
-   // When a pixel fails a test, they are controlled by the GS in drawing
-   // (meaning they remain unchanged during buffer write)
-   bool control_zb  = gs.zbuf_1.z_value_mask == 1;
-   bool control_rgb = false;
-   bool control_a   = false;
-
-   u8 alpha            = (color >> 24) & 0xFF;
-   u8 alpha_test_value = test->alpha_comparison_value;
-   bool test_succeded  = true;
-
-   if (scissor_test_fail(pos->x, pos->y))
+   if (scissor_test_fail(x, y))
       return;
 
-   if (test->alpha_test) {
-      switch(test->alpha_test_method)
-      {
-         case NEVER:     test_succeded = false;                      break;
-         case ALWAYS:    test_succeded = true;                       break;
-         case LESS:      test_succeded = alpha < alpha_test_value;   break;
-         case LEQUAL:    test_succeded = alpha <= alpha_test_value;  break;
-         case EQUAL:     test_succeded = alpha == alpha_test_value;  break;
-         case GEQUAL:    test_succeded = alpha >= alpha_test_value;  break;
-         case GREATER:   test_succeded = alpha > alpha_test_value;   break;
-         case NOTEQUAL:  test_succeded = alpha != alpha_test_value;  break;
-      }
-
-      if (!test_succeded) {
-         switch (test->alpha_fail_method)
-         {
-            case KEEP:
-               control_zb  = true;
-               control_rgb = true;
-               control_a   = true;
-            break;
-
-            case FB_ONLY:
-               control_zb  = true;
-            break;
-
-            case ZB_ONLY:
-               control_rgb = true;
-               control_a   = true;
-            break;
-
-            case RGB_ONLY:
-               control_a   = true;
-               control_zb  = true;
-            break;
-         }
-      }
-   }
-
-   u8 storage_format   = frame_1->storage_format;
-   u8 i                = test->destination_test_mode == 1 ? 1 : 0;
-
-   if (test->destination_test) {
-      if (storage_format == PSMCT32) {
-         test_succeded = (alpha & (i << 7));
-      } else if (storage_format == PSMCT16) {
-         test_succeded = (alpha == i);
-      }
-   }
-
-   // Here we shift pos.x and pos.y by 4 bits to the right because the vertex position are floating point numbers
-   // represented as unsigned numbers. THe intial 4 bits of the register are fractional
-   //int index      = (pos->x  + pos->y) * (frame_1->buffer_width * 64);
-   int index       = ((pos->x >> 4) + (pos->y >> 4) * (frame_1->buffer_width * 64));
-   int zpointer    = zbuf_1->base_pointer + index;
-
-   bool depth_test_success = true;
-   if (test->depth_test) {
-      switch(test->depth_test_method)
-      {
-         case NEVER:
-            depth_test_success = false;
-         break;
-
-         case ALWAYS:
-            depth_test_success = true;
-         break;
-
-         case GEQUAL:
-            if (pos->z >= gs.vram[zpointer])
-            depth_test_success = true;
-         break;
-
-         case GREATER:
-            if (pos->z > gs.vram[zpointer])
-            depth_test_success = true;
-         break;
-      }
-   }
-
-   // @Incomplete: No alpha blending
-   if (gs.prim.do_alpha_blending) {}
-
-   u8 buffer_alpha = gs.vram[frame_1->base_pointer + index] >> 24;
-
-   if (!control_zb) {
-      gs.vram[zpointer] = pos->z;
-   }
+   GS_Pixel_Pipeline *pipeline = gs_pixel_select();
+   pipeline->span(&pipeline->context, x, y, 0x1, &z, &color);
+}
 
-   if (!control_rgb) {
-      if (!control_a) {
-      // @Incomplete: there is no alpha blending yet so not writes to alpha here
-      }
-      gs.vram[frame_1->base_pointer + index] = color;
-   }
+// Positions are 12.4 fixed point
+static void
+draw_pixel (V3I *pos, u32 color)
+{
+   // Drawing straight into VRAM has to come after whatever was binned before it
+   gs_raster_flush();
+   gs_write_pixel(pos->x >> 4, pos->y >> 4, pos->z, color);
 }
 
 // @Implementation: Move this into a software.cpp file
@@ -439,7 +414,7 @@ render_point_software (Vertex *vertex)
    color = pack_RGBA(vertex->col.r, vertex->col.g, vertex->col.b, 1);
 
    draw_pixel(&pos, color);
-   printf("Render Point\n");
+   systrace("Render Point\n");
 }
 
 static void
@@ -465,7 +440,7 @@ render_point_hardware (Vertex *vertex)
    color = pack_RGBA_to_v4(vertex->col.r, vertex->col.g, vertex->col.b, vertex->col.a);
 
    // gl_draw_point(&out_pos, color);
-   printf("Render Point Hardware\n");
+   systrace("Render Point Hardware\n");
 }
 
 // @Incomplete: Change to DDA drawing algorithm
@@ -504,7 +479,7 @@ render_line_software (std::vector<Vertex> vertices)
 
    V3I pos = v3i(x0, y0, (int)vertices[0].pos.z);
 
-   printf("Render line\n");
+   systrace("Render line\n");
    while (true)
    {
       draw_pixel (&pos, color);
@@ -557,35 +532,14 @@ render_line_hardware (std::vector<Vertex> vertices)
 }
 
 static void
-render_triangle (std::vector<Vertex> vertices)
+render_triangle (const Vertex *vertices)
 {
-   printf("Drawing Kick!\n");
+   systrace("Drawing Kick!\n");
 
-   // @@Incomplete: Only using context 1 for rendering for now
    // @@Incomplete: No Support for triangle fans right now
-   V3I verts[3];
-   u32 color;
-   u32 depth = 0;
-   XYOFFSET *offset = &gs.xyoffset_1;
-
-   verts[0].x = vertices[0].pos.x - offset->x;
-   verts[0].y = vertices[0].pos.y - offset->y;
-   verts[0].z = vertices[0].pos.z;
-
-   verts[1].x = vertices[1].pos.x - offset->x;
-   verts[1].y = vertices[1].pos.y - offset->y;
-   verts[1].z = vertices[1].pos.z;
-
-   verts[2].x = vertices[2].pos.x - offset->x;
-   verts[2].y = vertices[2].pos.y - offset->y;
-   verts[2].z = vertices[2].pos.z;
+   gs_raster_triangle(vertices);
 
-   u32 minx = MIN3(verts[0].x, verts[1].x, verts[2].x);
-   u32 miny = MIN3(verts[0].y, verts[1].y, verts[2].y);
-   u32 maxx = MAX3(verts[0].x, verts[1].x, verts[2].x);
-   u32 maxy = MAX3(verts[0].y, verts[1].y, verts[2].y);
-
-   printf("Render Triangle\n");
+   systrace("Render Triangle\n");
 }
 
 // @Copypaste: from pepsiman_renderer.cpp
@@ -659,8 +613,6 @@ render_sprite_software (std::vector<Vertex> vertices)
    // @Incomplete: Check if pixels are top left
    // is_top_left();
 
-   u16 base_pointer = gs.tex0_1.base_pointer;
-   u16 texture_width = gs.tex0_1.texture_width;
    V3I p;
    p.z = pos[0].z;
 
@@ -668,15 +620,14 @@ render_sprite_software (std::vector<Vertex> vertices)
       s16 v_lint = lerp(uv[0].v, uv[1].v, p.y, pos[0].y, pos[1].y) >> 4;
       for (p.x = minx; p.x < maxx; p.x++) {
          s16 u_lint = lerp(uv[0].u, uv[1].u, p.x, pos[0].x, pos[1].x) >> 4;
-         u32 tex_pointer = base_pointer + (u_lint * (v_lint * texture_width));
          if (prim->do_texture_mapping == 0x1)
-            draw_pixel(&p, gs.vram[tex_pointer]);
+            draw_pixel(&p, gs_memory_read_texel(&gs.tex0_1, u_lint, v_lint));
          else
             draw_pixel(&p, color);
       }
    }
 
-   printf("Render Sprite\n");
+   systrace("Render Sprite\n");
 }
 
 /*
@@ -748,7 +699,7 @@ render_sprite_hardware (std::vector<Vertex> vertices)
    // @Incomplete: Check if pixels are top left
    // is_top_left();
 
-   printf("Render Sprite\n");
+   systrace("Render Sprite\n");
 }
 
 static void
@@ -844,7 +795,7 @@ drawing_kick()
       {
          case _TRIANGLE: 
          {
-            render_triangle(vertex_queue.queue);
+            render_triangle(vertex_queue.queue.data());
             reset_vertex_queue(&vertex_queue);
          } break;
       }
@@ -878,6 +829,9 @@ bool vsync_generated = false;
 u32
 gs_read_32_priviledged (u32 address)
 {
+   // CSR and SIGLBLID report how far the GS got, so whatever is still in the ring has to run first
+   gs_sync();
+
    switch(address)
    {
       case 0x12001000:
@@ -895,9 +849,15 @@ gs_read_32_priviledged (u32 address)
          //return gs.csr.value;
       } break;
 
+      case 0x12001080:
+      {
+         syslog("GS_READ32: read from SIGLBLID\n");
+         return gs.siglbid.signal_id;
+      } break;
+
       default:
       {
-         errlog("ERROR: UNRECOGNIZED READ GS PRIVILEDGE32: address [{:#x}]\n", address);
+         errtrace("ERROR: UNRECOGNIZED READ GS PRIVILEDGE32: address [{:#x}]\n", address);
          return 0;
       } break;
    }
@@ -907,6 +867,9 @@ gs_read_32_priviledged (u32 address)
 u64
 gs_read_64_priviledged (u32 address)
 {
+   // CSR and SIGLBLID report how far the GS got, so whatever is still in the ring has to run first
+   gs_sync();
+
    switch(address)
    {
       case 0x12001000:
@@ -923,9 +886,15 @@ gs_read_64_priviledged (u32 address)
          //return gs.csr.value;
       } break;
 
+      case 0x12001080:
+      {
+         syslog("GS_READ: read from SIGLBLID\n");
+         return ((u64)gs.siglbid.label_id << 32) | gs.siglbid.signal_id;
+      } break;
+
       default:
       {
-         errlog("ERROR: UNRECOGNIZED READ GS PRIVILEDGE32: address [{:#x}]\n", address);
+         errtrace("ERROR: UNRECOGNIZED READ GS PRIVILEDGE32: address [{:#x}]\n", address);
          return 0;
       } break;
    }
@@ -940,7 +909,7 @@ gs_write_32_priviledged (u32 address, u32 value)
       case 0x12001000:
       {
       #if 0
-         printf("GS_WRITE32: write to CSR. Value: [%#08x]\n", value);
+         systrace("GS_WRITE32: write to CSR. Value: [{:#08x}]\n", value);
          gs.csr.signal                   = value & 0x1;
          gs.csr.finish                   = (value >> 1) & 0x1;
          gs.csr.h_interrupt              = (value >> 2) & 0x1;
@@ -975,7 +944,7 @@ gs_write_32_priviledged (u32 address, u32 value)
 
       default:
       {
-         errlog("ERROR: UNRECOGNIZED WRITE GS PRIVILEDGE32: address [{:#x}]\n", address);
+         errtrace("ERROR: UNRECOGNIZED WRITE GS PRIVILEDGE32: address [{:#x}]\n", address);
          return;
       } break;
    }
@@ -1075,13 +1044,13 @@ gs_write_64_priviledged (u32 address, u64 value)
       case 0x12000090:
       {
          syslog("GS_WRITE_PRIVILEDGED: write to DISPFB2. Value: [{:#x}]\n", value);
+         gs.dispfb2.value            = value;
          gs.dispfb2.base_pointer     = (value & 0x1FF) * 2048;
          gs.dispfb2.buffer_width     = ((value >> 9) & 0x3F) * 64;
          gs.dispfb2.buffer_width     = ((value >> 9) & 0x3F);
          gs.dispfb2.storage_formats  = (value >> 15) & 0x1F;
          gs.dispfb2.x_position       = (value >> 32) & 0x7FF;
          gs.dispfb2.y_position       = (value >> 43) & 0x7FF;
-         gs.dispfb2.value            = value;
          return;
       } break;
 
@@ -1201,7 +1170,7 @@ gs_write_64_priviledged (u32 address, u64 value)
 
       default:
       {
-         errlog("ERROR: UNRECOGNIZED WRITE GS PRIVILEDGE64: value: [{:#x}], address[{:#08x}]\n", value, address);
+         errtrace("ERROR: UNRECOGNIZED WRITE GS PRIVILEDGE64: value: [{:#x}], address[{:#08x}]\n", value, address);
       } break;
    }
    return;
@@ -1210,6 +1179,17 @@ gs_write_64_priviledged (u32 address, u64 value)
 void
 gs_write_internal (u8 address, u64 value)
 {
+   // TEX0, TEXFLUSH, SCISSOR, TEST, FRAME, ZBUF and TRXDIR change what the binned triangles would draw
+   switch(address)
+   {
+      case 0x47: case 0x48: case 0x4C: case 0x4D: case 0x4E: case 0x4F:
+         gs_pixel_invalidate();
+      // Fallthrough
+      case 0x06: case 0x07: case 0x3f: case 0x40: case 0x41: case 0x53:
+         gs_raster_flush();
+      break;
+   }
+
    switch(address)
    {
       case 0x00:
@@ -1331,6 +1311,14 @@ gs_write_internal (u8 address, u64 value)
          syslog("GS_WRITE: write to PRMODECONT. Value: [{:#x}]\n", value);
       } break;
 
+      case 0x3B:
+      {
+         gs.texa.alpha_value_field0  = value & 0xFF;
+         gs.texa.expansion_method    = (value >> 15) & 0x1;
+         gs.texa.alpha_value_field1  = (value >> 32) & 0xFF;
+         syslog("GS_WRITE: write to TEXA. Value: [{:#x}]\n", value);
+      } break;
+
       case 0x3f:
          gs.texflush.value = value;
          syslog("GS_WRITE: write to TEXFLUSH.\n");
@@ -1429,17 +1417,35 @@ gs_write_internal (u8 address, u64 value)
          syslog("GS_WRITE: write to TRXDIR. Value: [{:#x}]\n", value);
          switch(gs.trxdir.direction)
          {
-            case 0: syslog("Executing Host => Local Transmission\n");  break;
-            case 1: syslog("Executing Local => Host Transmission\n");  break;
-            case 2: syslog("Executing Local => Local Transmission\n"); break;
+            case 0:
+            {
+               syslog("Executing Host => Local Transmission\n");
+               gs_memory_upload_start();
+            } break;
+
+            case 1:
+            {
+               syslog("Executing Local => Host Transmission\n");
+               gs_memory_readback_start();
+            } break;
+
+            case 2:
+            {
+               syslog("Executing Local => Local Transmission\n");
+               gs_memory_copy();
+            } break;
          }
       } break;
 
       case 0x54:
       {
          if (gs.trxdir.direction == 0)
-         // gs_write_hwreg_software(value);
-         gs_write_hwreg_hardware(value);
+         {
+            gs_write_hwreg_software(value);
+#if USE_HARDWARE
+            gs_write_hwreg_hardware(value);
+#endif
+         }
       } break;
 
       // shut up
@@ -1447,7 +1453,7 @@ gs_write_internal (u8 address, u64 value)
 
       default:
       {
-         errlog("UNRECOGNIZED WRITE GS INTERNAL64: value: [{:#x}], address[{:#x}]\n", value, address);
+         errtrace("UNRECOGNIZED WRITE GS INTERNAL64: value: [{:#x}], address[{:#x}]\n", value, address);
          return;
       }
    }
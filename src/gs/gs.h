@@ -136,7 +136,7 @@ union XYOFFSET {
 ********************************/
 union FRAME {
 	struct {
-		u16 base_pointer : 9;	 u8 unused0 : 7;
+		u32 base_pointer;		 // In words, FBP * 2048
 		// u16 buffer_width : 6; u8 unused1 : 2;
 		u16 buffer_width ;		 u8 unused1 : 2;
 		u16 storage_format : 6;	 u8 unused2 : 2;
@@ -147,7 +147,7 @@ union FRAME {
 
 union ZBUF {
 	struct {
-		u16 base_pointer : 9;  u16 unused0 : 15;
+		u32 base_pointer;	   // In words, ZBP * 2048
 		u8 storage_format : 4; u8 unused1 : 4;
 		bool z_value_mask;	  u32 unused2 : 31;
 	};
@@ -159,13 +159,13 @@ union ZBUF {
 ********************************/
 union BITBLTBUF {
 	struct {
-		u16 src_base_pointer : 14;	    u8 unused0 : 3;
+		u32 src_base_pointer;		    // In words, SBP * 64
 		// u8 src_buffer_width : 6;	 u8 unused1 : 3;
-		u8 src_buffer_width;			    u8 unused1 : 3;
+		u16 src_buffer_width;		    u8 unused1 : 3;   // In pixels, SBW * 64
 		u8 src_storage_format : 6;	    u8 unused2 : 3;
-		u16 dest_base_pointer : 14;	 u8 unused3 : 3;
+		u32 dest_base_pointer;		    // In words, DBP * 64
 		// u8 dest_buffer_width : 6;	 u8 unused4 : 3;
-		u16 dest_buffer_width;		    u8 unused4 : 3;
+		u16 dest_buffer_width;		    u8 unused4 : 3;   // In pixels, DBW * 64
 		u8 dest_storage_format : 6;    u8 unused5 : 3;
 	};
 	u64 value;
@@ -209,7 +209,7 @@ union TRXDIR {
 ********************************/
 union TEX0 {
 	struct {
-		u16 base_pointer;
+		u32 base_pointer;		 // In words, TBP0 * 64
 		// u8 buffer_width : 6;
 		u16 buffer_width;
 		u8 pixel_storage_format : 6;
@@ -217,7 +217,7 @@ union TEX0 {
 		u16 texture_height;
 		bool color_component;
 		u8 texture_function : 2;
-		u16 clut_base_pointer : 14;
+		u32 clut_base_pointer;	 // In words, CBP * 64
 		u8 clut_storage_format : 4;
 		bool clut_storage_mode;
 		u8 clut_entry_offset : 5;
@@ -530,7 +530,7 @@ union SMODE2 {
 
 union DISPFB {
 	struct {
-		u16 base_pointer : 9;
+		u32 base_pointer;		 // In words, FBP * 2048
 		// u8  buffer_width : 6;
 		u16  buffer_width;
 		u8  storage_formats : 5;
@@ -652,6 +652,11 @@ enum CRT_MODE : int {
 	CRT_MODE_DTV_480P 	= 0x50
 };
 
+// @Incomplete: NTSC timings only, measured in EE cycles
+#define GS_SCANLINE_CYCLES 			(EECLK / HBLNK_NTSC)
+#define GS_SCANLINES_PER_FIELD 		263
+#define GS_VBLANK_START_SCANLINE 	240
+
 typedef struct _Context_ {
 	XYZF 			xyzf;
 	XYZ 			xyz;
@@ -704,6 +709,12 @@ struct GraphicsSynthesizer {
    CRT_MODE crt_mode;
    Transmission_Buffer transmission_buffer;
 
+   // Set by the HBLANK and VBLANK events
+   u32  scanline;
+   bool in_vblank;
+   bool frame_ready;
+   u64  frame_count;
+
    Context context[2];
    // GS Internal Registers
    PRIM prim;
@@ -785,6 +796,8 @@ struct GraphicsSynthesizer {
 
 void 		gs_reset();
 void 		gs_shutdown();
+bool 		gs_frame_ready();
+bool 		gs_bus_to_host();
 
 u32 		gs_read_32_priviledged(u32 address);
 u64 		gs_read_64_priviledged(u32 address);
@@ -805,6 +818,7 @@ void 		gs_set_xyz2(s16 x, s16 y, u32 z);
 void 		gs_set_xyz3(s16 x, s16 y, u32 z);
 void 		gs_set_crt(bool interlaced, s32 display_mode, bool ffmd);
 void 		gs_write_hwreg_software(u64 data);
+void 		gs_write_image(const u8 *data, u32 size);
 void 		gs_write_hwreg_hardware(u64 data);
 
 void 		gs_render_crt(SDL_Context *context);
@@ -1,2 +1,6 @@
 #include "gs.cpp"
+#include "gs_memory.cpp"
+#include "gs_pixel.cpp"
+#include "gs_raster.cpp"
+#include "gs_thread.cpp"
 #include "gl.cpp"
\ No newline at end of file
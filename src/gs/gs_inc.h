@@ -1,2 +1,6 @@
 #include "gs.h"
+#include "gs_memory.h"
+#include "gs_pixel.h"
+#include "gs_raster.h"
+#include "gs_thread.h"
 #include "gl.h"
\ No newline at end of file
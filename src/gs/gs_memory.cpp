@@ -0,0 +1,882 @@
+/*
+ * Copyright 2023 Xaviar Roach
+ * SPDX-License-Identifier: MIT
+ */
+
+/*******************************************
+ * Layout Tables
+*******************************************/
+// Bit i of a block number is the coordinate bit order[i] names, the coordinates are the ones of the block in its page
+#define GS_MEMORY_X(n) (n)
+#define GS_MEMORY_Y(n) (0x10 | (n))
+
+static constexpr std::array<u8, 32>
+gs_memory_make_blocks (u32 columns, std::array<u8, 5> order, u8 flip)
+{
+   std::array<u8, 32> table = {};
+   for (u32 y = 0; y < 32 / columns; ++y)
+   {
+      for (u32 x = 0; x < columns; ++x)
+      {
+         u32 block = 0;
+         for (u32 i = 0; i < 5; ++i)
+         {
+            u32 coordinate = (order[i] & 0x10) ? y : x;
+            block |= ((coordinate >> (order[i] & 0xF)) & 1) << i;
+         }
+         table[y * columns + x] = block ^ flip;
+      }
+   }
+   return table;
+}
+
+// Word of a column a pixel of the 32 bit layout lands in, the smaller layouts are built around it
+static constexpr u32
+gs_memory_column_word (u32 x, u32 y)
+{
+   return (x & 1) | ((y & 1) << 1) | ((x & 6) << 1);
+}
+
+static constexpr std::array<u16, 512>
+gs_memory_make_pixels (u32 bits)
+{
+   std::array<u16, 512> table = {};
+   u32 width   = bits == 32 ? 8 : bits == 4 ? 32 : 16;
+   u32 height  = bits >= 16 ? 8 : 16;
+
+   for (u32 y = 0; y < height; ++y)
+   {
+      for (u32 x = 0; x < width; ++x)
+      {
+         u32 element = 0;
+         if (bits == 32)
+         {
+            // Columns are 8x2 pixels
+            element = (y >> 1) * 16 + gs_memory_column_word(x, y);
+         }
+         else if (bits == 16)
+         {
+            // Columns are 16x2 pixels, pixel x and x + 8 share a word
+            element = ((y >> 1) * 16 + gs_memory_column_word(x & 7, y)) * 2 + (x >> 3);
+         }
+         else
+         {
+            // Columns are 4 rows, rows 2 and 3 go to the next byte or nibble of the words rows 0 and 1 use
+            // with the halves of the column swapped. Odd columns start out swapped.
+            u32 swap = ((y >> 1) ^ (y >> 2)) & 1;
+            u32 word = (y >> 2) * 16 + (gs_memory_column_word(x & 7, y) ^ (swap << 3));
+            if (bits == 8) element = word * 4 + ((x >> 3) & 1) * 2 + ((y >> 1) & 1);
+            else           element = word * 8 + ((x >> 3) & 3) * 2 + ((y >> 1) & 1);
+         }
+         table[y * width + x] = element;
+      }
+   }
+   return table;
+}
+
+static constexpr std::array<u8, 32> gs_memory_blocks_ct32  = gs_memory_make_blocks(8, { GS_MEMORY_X(0), GS_MEMORY_Y(0), GS_MEMORY_X(1), GS_MEMORY_Y(1), GS_MEMORY_X(2) }, 0x00);
+static constexpr std::array<u8, 32> gs_memory_blocks_ct16  = gs_memory_make_blocks(4, { GS_MEMORY_Y(0), GS_MEMORY_X(0), GS_MEMORY_Y(1), GS_MEMORY_X(1), GS_MEMORY_Y(2) }, 0x00);
+static constexpr std::array<u8, 32> gs_memory_blocks_ct16s = gs_memory_make_blocks(4, { GS_MEMORY_Y(0), GS_MEMORY_X(0), GS_MEMORY_Y(2), GS_MEMORY_Y(1), GS_MEMORY_X(1) }, 0x00);
+static constexpr std::array<u8, 32> gs_memory_blocks_z32   = gs_memory_make_blocks(8, { GS_MEMORY_X(0), GS_MEMORY_Y(0), GS_MEMORY_X(1), GS_MEMORY_Y(1), GS_MEMORY_X(2) }, 0x18);
+static constexpr std::array<u8, 32> gs_memory_blocks_z16   = gs_memory_make_blocks(4, { GS_MEMORY_Y(0), GS_MEMORY_X(0), GS_MEMORY_Y(1), GS_MEMORY_X(1), GS_MEMORY_Y(2) }, 0x18);
+static constexpr std::array<u8, 32> gs_memory_blocks_z16s  = gs_memory_make_blocks(4, { GS_MEMORY_Y(0), GS_MEMORY_X(0), GS_MEMORY_Y(2), GS_MEMORY_Y(1), GS_MEMORY_X(1) }, 0x18);
+
+static constexpr std::array<u16, 512> gs_memory_pixels_32 = gs_memory_make_pixels(32);
+static constexpr std::array<u16, 512> gs_memory_pixels_16 = gs_memory_make_pixels(16);
+static constexpr std::array<u16, 512> gs_memory_pixels_8  = gs_memory_make_pixels(8);
+static constexpr std::array<u16, 512> gs_memory_pixels_4  = gs_memory_make_pixels(4);
+
+static_assert(gs_memory_blocks_ct32[1 * 8 + 3]  == 7  && gs_memory_blocks_ct16s[6 * 4 + 1] == 14);
+static_assert(gs_memory_pixels_8[2 * 16 + 0]    == 33 && gs_memory_pixels_4[3 * 32 + 8]    == 83);
+
+/*******************************************
+ * Element Access
+*******************************************/
+static inline u32
+gs_memory_load (const void *data, u32 bits, u64 index)
+{
+   const u8 *bytes = (const u8*)data;
+   switch (bits)
+   {
+      case 32: return ((const u32*)data)[index];
+      case 24: return bytes[index * 3] | (bytes[index * 3 + 1] << 8) | (bytes[index * 3 + 2] << 16);
+      case 16: return ((const u16*)data)[index];
+      case 8:  return bytes[index];
+      default: return (bytes[index >> 1] >> ((index & 1) * 4)) & 0xF;
+   }
+}
+
+static inline void
+gs_memory_store (void *data, u32 bits, u64 index, u32 value)
+{
+   u8 *bytes = (u8*)data;
+   switch (bits)
+   {
+      case 32: ((u32*)data)[index] = value;  break;
+      case 24:
+      {
+         bytes[index * 3 + 0] = value;
+         bytes[index * 3 + 1] = value >> 8;
+         bytes[index * 3 + 2] = value >> 16;
+      } break;
+      case 16: ((u16*)data)[index] = value;  break;
+      case 8:  bytes[index] = value;         break;
+      default:
+      {
+         // The pixel with the lower index is in the lower nibble
+         u32 shift            = (index & 1) * 4;
+         bytes[index >> 1]    = (bytes[index >> 1] & ~(0xF << shift)) | ((value & 0xF) << shift);
+      } break;
+   }
+}
+
+// First word of the block a pixel is in
+static inline u32
+gs_memory_block_word (const GS_Memory_Format *format, u32 base, u32 width, u32 x, u32 y)
+{
+   u32 columns = format->page_width - format->block_width;
+   u32 rows    = format->page_height - format->block_height;
+   u32 page    = (x >> format->page_width) + (y >> format->page_height) * (width >> format->page_width);
+   u32 block_x = (x >> format->block_width) & ((1 << columns) - 1);
+   u32 block_y = (y >> format->block_height) & ((1 << rows) - 1);
+   u32 block   = format->blocks[(block_y << columns) | block_x];
+
+   return (base + page * GS_PAGE_WORDS + block * GS_BLOCK_WORDS) & (GS_VRAM_WORDS - 1);
+}
+
+// Index of the element a pixel is in, counted in elements of the format from the start of VRAM
+static inline u32
+gs_memory_element (const GS_Memory_Format *format, u32 base, u32 width, u32 x, u32 y)
+{
+   u32 word    = gs_memory_block_word(format, base, width, x, y);
+   u32 pixel_x = x & ((1 << format->block_width) - 1);
+   u32 pixel_y = y & ((1 << format->block_height) - 1);
+
+   return word * (32 / format->bits) + format->pixels[(pixel_y << format->block_width) | pixel_x];
+}
+
+// Word of a pixel in one of the 32 bit layouts, kept apart for the pixel pipeline
+static inline u32
+gs_memory_address_32 (const u8 *blocks, u32 base, u32 width, u32 x, u32 y)
+{
+   u32 page    = (x >> 6) + (y >> 5) * (width >> 6);
+   u32 block   = blocks[((y >> 3) & 3) * 8 + ((x >> 3) & 7)];
+   u32 word    = (base + page * GS_PAGE_WORDS + block * GS_BLOCK_WORDS) & (GS_VRAM_WORDS - 1);
+
+   return word + gs_memory_pixels_32[(y & 7) * 8 + (x & 7)];
+}
+
+u32
+gs_memory_read_pixel (const GS_Memory_Format *format, u32 base, u32 width, u32 x, u32 y)
+{
+   u32 element = gs_memory_element(format, base, width, x, y);
+   return (gs_memory_load(gs.vram, format->bits, element) >> format->shift) & format->mask;
+}
+
+void
+gs_memory_write_pixel (const GS_Memory_Format *format, u32 base, u32 width, u32 x, u32 y, u32 value)
+{
+   u32 element = gs_memory_element(format, base, width, x, y);
+   u32 owned   = format->mask << format->shift;
+
+   value = (value & format->mask) << format->shift;
+   if (format->bits == 32 && owned != 0xFFFFFFFF)
+      value |= gs.vram[element] & ~owned;
+
+   gs_memory_store(gs.vram, format->bits, element, value);
+}
+
+/*******************************************
+ * Block Kernels
+*******************************************/
+// The linear side holds whole elements, formats that only own part of a 32 bit word have them shifted into place
+static void
+gs_memory_swizzle_generic (const GS_Memory_Format *format, u32 *block, const u8 *linear, u64 element, u32 pitch)
+{
+   u32 owned = format->mask << format->shift;
+   for (u32 y = 0; y < (1u << format->block_height); ++y)
+   {
+      for (u32 x = 0; x < (1u << format->block_width); ++x)
+      {
+         u32 index = format->pixels[(y << format->block_width) | x];
+         u32 value = gs_memory_load(linear, format->bits, element + (u64)y * pitch + x);
+         if (format->bits == 32) value = (value & owned) | (block[index] & ~owned);
+
+         gs_memory_store(block, format->bits, index, value);
+      }
+   }
+}
+
+static void
+gs_memory_unswizzle_generic (const GS_Memory_Format *format, const u32 *block, u8 *linear, u64 element, u32 pitch)
+{
+   for (u32 y = 0; y < (1u << format->block_height); ++y)
+   {
+      for (u32 x = 0; x < (1u << format->block_width); ++x)
+      {
+         u32 index = format->pixels[(y << format->block_width) | x];
+         gs_memory_store(linear, format->bits, element + (u64)y * pitch + x, gs_memory_load(block, format->bits, index));
+      }
+   }
+}
+
+/*
+   A column of the 32 bit layout is two rows of 8 pixels, stored as the 64 bit pairs
+   row0[0-1] row1[0-1] row0[2-3] row1[2-3] ... so interleaving the two rows 64 bits at a time gives the
+   column. The 16 bit layout pairs pixel x with pixel x + 8 in a word first and then does the same.
+*/
+#if GS_MEMORY_AVX2
+static inline void
+gs_memory_store_256 (u32 *address, __m256i value, __m256i owned, bool merge)
+{
+   if (merge)
+   {
+      __m256i old = _mm256_loadu_si256((const __m256i*)address);
+      value = _mm256_or_si256(_mm256_and_si256(value, owned), _mm256_andnot_si256(owned, old));
+   }
+   _mm256_storeu_si256((__m256i*)address, value);
+}
+
+// Pixels x and x + 8 of a row of 16, next to each other
+static inline __m256i
+gs_memory_pair_16 (__m256i row)
+{
+   const __m256i pair = _mm256_setr_epi8(0, 1, 8, 9, 2, 3, 10, 11, 4, 5, 12, 13, 6, 7, 14, 15,
+                                         0, 1, 8, 9, 2, 3, 10, 11, 4, 5, 12, 13, 6, 7, 14, 15);
+   return _mm256_shuffle_epi8(_mm256_permute4x64_epi64(row, 0xD8), pair);
+}
+
+static inline __m256i
+gs_memory_unpair_16 (__m256i row)
+{
+   const __m256i unpair = _mm256_setr_epi8(0, 1, 4, 5, 8, 9, 12, 13, 2, 3, 6, 7, 10, 11, 14, 15,
+                                           0, 1, 4, 5, 8, 9, 12, 13, 2, 3, 6, 7, 10, 11, 14, 15);
+   return _mm256_permute4x64_epi64(_mm256_shuffle_epi8(row, unpair), 0xD8);
+}
+#elif GS_MEMORY_SSE2
+static inline void
+gs_memory_store_128 (u32 *address, __m128i value, __m128i owned, bool merge)
+{
+   if (merge)
+   {
+      __m128i old = _mm_loadu_si128((const __m128i*)address);
+      value = _mm_or_si128(_mm_and_si128(value, owned), _mm_andnot_si128(owned, old));
+   }
+   _mm_storeu_si128((__m128i*)address, value);
+}
+
+// [x0 x8 x1 x9 x2 x10 x3 x11] to [x0 x1 x2 x3 x8 x9 x10 x11]
+static inline __m128i
+gs_memory_unpair_16 (__m128i pairs)
+{
+   pairs = _mm_shufflelo_epi16(pairs, 0xD8);
+   pairs = _mm_shufflehi_epi16(pairs, 0xD8);
+   return _mm_shuffle_epi32(pairs, 0xD8);
+}
+#endif
+
+static void
+gs_memory_swizzle_32 (const GS_Memory_Format *format, u32 *block, const u8 *linear, u64 element, u32 pitch)
+{
+#if GS_MEMORY_AVX2
+   const u32 *source = (const u32*)linear + element;
+   u32 owned         = format->mask << format->shift;
+   __m256i mask      = _mm256_set1_epi32((s32)owned);
+
+   for (u32 column = 0; column < 4; ++column, source += pitch * 2, block += 16)
+   {
+      __m256i row0 = _mm256_loadu_si256((const __m256i*)source);
+      __m256i row1 = _mm256_loadu_si256((const __m256i*)(source + pitch));
+      __m256i lo   = _mm256_unpacklo_epi64(row0, row1);
+      __m256i hi   = _mm256_unpackhi_epi64(row0, row1);
+
+      gs_memory_store_256(block + 0, _mm256_permute2x128_si256(lo, hi, 0x20), mask, owned != 0xFFFFFFFF);
+      gs_memory_store_256(block + 8, _mm256_permute2x128_si256(lo, hi, 0x31), mask, owned != 0xFFFFFFFF);
+   }
+#elif GS_MEMORY_SSE2
+   const u32 *source = (const u32*)linear + element;
+   u32 owned         = format->mask << format->shift;
+   __m128i mask      = _mm_set1_epi32((s32)owned);
+
+   for (u32 column = 0; column < 4; ++column, source += pitch * 2, block += 16)
+   {
+      __m128i a0 = _mm_loadu_si128((const __m128i*)(source));
+      __m128i a1 = _mm_loadu_si128((const __m128i*)(source + 4));
+      __m128i b0 = _mm_loadu_si128((const __m128i*)(source + pitch));
+      __m128i b1 = _mm_loadu_si128((const __m128i*)(source + pitch + 4));
+
+      gs_memory_store_128(block + 0,  _mm_unpacklo_epi64(a0, b0), mask, owned != 0xFFFFFFFF);
+      gs_memory_store_128(block + 4,  _mm_unpackhi_epi64(a0, b0), mask, owned != 0xFFFFFFFF);
+      gs_memory_store_128(block + 8,  _mm_unpacklo_epi64(a1, b1), mask, owned != 0xFFFFFFFF);
+      gs_memory_store_128(block + 12, _mm_unpackhi_epi64(a1, b1), mask, owned != 0xFFFFFFFF);
+   }
+#else
+   gs_memory_swizzle_generic(format, block, linear, element, pitch);
+#endif
+}
+
+static void
+gs_memory_unswizzle_32 (const GS_Memory_Format *format, const u32 *block, u8 *linear, u64 element, u32 pitch)
+{
+   (void)format;
+#if GS_MEMORY_AVX2
+   u32 *target = (u32*)linear + element;
+   for (u32 column = 0; column < 4; ++column, target += pitch * 2, block += 16)
+   {
+      __m256i words0 = _mm256_loadu_si256((const __m256i*)(block + 0));
+      __m256i words1 = _mm256_loadu_si256((const __m256i*)(block + 8));
+      __m256i lo     = _mm256_permute2x128_si256(words0, words1, 0x20);
+      __m256i hi     = _mm256_permute2x128_si256(words0, words1, 0x31);
+
+      _mm256_storeu_si256((__m256i*)target,           _mm256_unpacklo_epi64(lo, hi));
+      _mm256_storeu_si256((__m256i*)(target + pitch), _mm256_unpackhi_epi64(lo, hi));
+   }
+#elif GS_MEMORY_SSE2
+   u32 *target = (u32*)linear + element;
+   for (u32 column = 0; column < 4; ++column, target += pitch * 2, block += 16)
+   {
+      __m128i c0 = _mm_loadu_si128((const __m128i*)(block + 0));
+      __m128i c1 = _mm_loadu_si128((const __m128i*)(block + 4));
+      __m128i c2 = _mm_loadu_si128((const __m128i*)(block + 8));
+      __m128i c3 = _mm_loadu_si128((const __m128i*)(block + 12));
+
+      _mm_storeu_si128((__m128i*)(target),             _mm_unpacklo_epi64(c0, c1));
+      _mm_storeu_si128((__m128i*)(target + 4),         _mm_unpacklo_epi64(c2, c3));
+      _mm_storeu_si128((__m128i*)(target + pitch),     _mm_unpackhi_epi64(c0, c1));
+      _mm_storeu_si128((__m128i*)(target + pitch + 4), _mm_unpackhi_epi64(c2, c3));
+   }
+#else
+   gs_memory_unswizzle_generic(format, block, linear, element, pitch);
+#endif
+}
+
+static void
+gs_memory_swizzle_16 (const GS_Memory_Format *format, u32 *block, const u8 *linear, u64 element, u32 pitch)
+{
+   (void)format;
+#if GS_MEMORY_AVX2
+   const u16 *source = (const u16*)linear + element;
+   for (u32 column = 0; column < 4; ++column, source += pitch * 2, block += 16)
+   {
+      __m256i row0 = gs_memory_pair_16(_mm256_loadu_si256((const __m256i*)source));
+      __m256i row1 = gs_memory_pair_16(_mm256_loadu_si256((const __m256i*)(source + pitch)));
+      __m256i lo   = _mm256_unpacklo_epi64(row0, row1);
+      __m256i hi   = _mm256_unpackhi_epi64(row0, row1);
+
+      _mm256_storeu_si256((__m256i*)(block + 0), _mm256_permute2x128_si256(lo, hi, 0x20));
+      _mm256_storeu_si256((__m256i*)(block + 8), _mm256_permute2x128_si256(lo, hi, 0x31));
+   }
+#elif GS_MEMORY_SSE2
+   const u16 *source = (const u16*)linear + element;
+   for (u32 column = 0; column < 4; ++column, source += pitch * 2, block += 16)
+   {
+      __m128i a0 = _mm_loadu_si128((const __m128i*)(source));
+      __m128i a1 = _mm_loadu_si128((const __m128i*)(source + 8));
+      __m128i b0 = _mm_loadu_si128((const __m128i*)(source + pitch));
+      __m128i b1 = _mm_loadu_si128((const __m128i*)(source + pitch + 8));
+
+      // Pixel pairs 0-3 and 4-7 of both rows
+      __m128i a_lo = _mm_unpacklo_epi16(a0, a1);
+      __m128i a_hi = _mm_unpackhi_epi16(a0, a1);
+      __m128i b_lo = _mm_unpacklo_epi16(b0, b1);
+      __m128i b_hi = _mm_unpackhi_epi16(b0, b1);
+
+      _mm_storeu_si128((__m128i*)(block + 0),  _mm_unpacklo_epi64(a_lo, b_lo));
+      _mm_storeu_si128((__m128i*)(block + 4),  _mm_unpackhi_epi64(a_lo, b_lo));
+      _mm_storeu_si128((__m128i*)(block + 8),  _mm_unpacklo_epi64(a_hi, b_hi));
+      _mm_storeu_si128((__m128i*)(block + 12), _mm_unpackhi_epi64(a_hi, b_hi));
+   }
+#else
+   gs_memory_swizzle_generic(format, block, linear, element, pitch);
+#endif
+}
+
+static void
+gs_memory_unswizzle_16 (const GS_Memory_Format *format, const u32 *block, u8 *linear, u64 element, u32 pitch)
+{
+   (void)format;
+#if GS_MEMORY_AVX2
+   u16 *target = (u16*)linear + element;
+   for (u32 column = 0; column < 4; ++column, target += pitch * 2, block += 16)
+   {
+      __m256i words0 = _mm256_loadu_si256((const __m256i*)(block + 0));
+      __m256i words1 = _mm256_loadu_si256((const __m256i*)(block + 8));
+      __m256i lo     = _mm256_permute2x128_si256(words0, words1, 0x20);
+      __m256i hi     = _mm256_permute2x128_si256(words0, words1, 0x31);
+
+      _mm256_storeu_si256((__m256i*)target,           gs_memory_unpair_16(_mm256_unpacklo_epi64(lo, hi)));
+      _mm256_storeu_si256((__m256i*)(target + pitch), gs_memory_unpair_16(_mm256_unpackhi_epi64(lo, hi)));
+   }
+#elif GS_MEMORY_SSE2
+   u16 *target = (u16*)linear + element;
+   for (u32 column = 0; column < 4; ++column, target += pitch * 2, block += 16)
+   {
+      __m128i c0 = _mm_loadu_si128((const __m128i*)(block + 0));
+      __m128i c1 = _mm_loadu_si128((const __m128i*)(block + 4));
+      __m128i c2 = _mm_loadu_si128((const __m128i*)(block + 8));
+      __m128i c3 = _mm_loadu_si128((const __m128i*)(block + 12));
+
+      __m128i a_lo = gs_memory_unpair_16(_mm_unpacklo_epi64(c0, c1));
+      __m128i a_hi = gs_memory_unpair_16(_mm_unpacklo_epi64(c2, c3));
+      __m128i b_lo = gs_memory_unpair_16(_mm_unpackhi_epi64(c0, c1));
+      __m128i b_hi = gs_memory_unpair_16(_mm_unpackhi_epi64(c2, c3));
+
+      _mm_storeu_si128((__m128i*)(target),             _mm_unpacklo_epi64(a_lo, a_hi));
+      _mm_storeu_si128((__m128i*)(target + 8),         _mm_unpackhi_epi64(a_lo, a_hi));
+      _mm_storeu_si128((__m128i*)(target + pitch),     _mm_unpacklo_epi64(b_lo, b_hi));
+      _mm_storeu_si128((__m128i*)(target + pitch + 8), _mm_unpackhi_epi64(b_lo, b_hi));
+   }
+#else
+   gs_memory_unswizzle_generic(format, block, linear, element, pitch);
+#endif
+}
+
+/*******************************************
+ * Formats
+*******************************************/
+#define GS_MEMORY_LAYOUT_32   .page_width = 6, .page_height = 5, .block_width = 3, .block_height = 3, \
+                              .swizzle = gs_memory_swizzle_32, .unswizzle = gs_memory_unswizzle_32
+#define GS_MEMORY_LAYOUT_16   .page_width = 6, .page_height = 6, .block_width = 4, .block_height = 3, \
+                              .swizzle = gs_memory_swizzle_16, .unswizzle = gs_memory_unswizzle_16
+#define GS_MEMORY_LAYOUT_8    .page_width = 7, .page_height = 6, .block_width = 4, .block_height = 4, \
+                              .swizzle = gs_memory_swizzle_generic, .unswizzle = gs_memory_unswizzle_generic
+#define GS_MEMORY_LAYOUT_4    .page_width = 7, .page_height = 7, .block_width = 5, .block_height = 4, \
+                              .swizzle = gs_memory_swizzle_generic, .unswizzle = gs_memory_unswizzle_generic
+
+static const GS_Memory_Format gs_memory_psmct32  = { .blocks = gs_memory_blocks_ct32.data(),  .pixels = gs_memory_pixels_32.data(), .bits = 32, .transfer_bits = 32, .shift = 0,  .mask = 0xFFFFFFFF, GS_MEMORY_LAYOUT_32 };
+static const GS_Memory_Format gs_memory_psmct24  = { .blocks = gs_memory_blocks_ct32.data(),  .pixels = gs_memory_pixels_32.data(), .bits = 32, .transfer_bits = 24, .shift = 0,  .mask = 0x00FFFFFF, GS_MEMORY_LAYOUT_32 };
+static const GS_Memory_Format gs_memory_psmct16  = { .blocks = gs_memory_blocks_ct16.data(),  .pixels = gs_memory_pixels_16.data(), .bits = 16, .transfer_bits = 16, .shift = 0,  .mask = 0xFFFF,     GS_MEMORY_LAYOUT_16 };
+static const GS_Memory_Format gs_memory_psmct16s = { .blocks = gs_memory_blocks_ct16s.data(), .pixels = gs_memory_pixels_16.data(), .bits = 16, .transfer_bits = 16, .shift = 0,  .mask = 0xFFFF,     GS_MEMORY_LAYOUT_16 };
+static const GS_Memory_Format gs_memory_psmt8    = { .blocks = gs_memory_blocks_ct32.data(),  .pixels = gs_memory_pixels_8.data(),  .bits = 8,  .transfer_bits = 8,  .shift = 0,  .mask = 0xFF,       GS_MEMORY_LAYOUT_8  };
+static const GS_Memory_Format gs_memory_psmt4    = { .blocks = gs_memory_blocks_ct16.data(),  .pixels = gs_memory_pixels_4.data(),  .bits = 4,  .transfer_bits = 4,  .shift = 0,  .mask = 0xF,        GS_MEMORY_LAYOUT_4  };
+static const GS_Memory_Format gs_memory_psmt8h   = { .blocks = gs_memory_blocks_ct32.data(),  .pixels = gs_memory_pixels_32.data(), .bits = 32, .transfer_bits = 8,  .shift = 24, .mask = 0xFF,       GS_MEMORY_LAYOUT_32 };
+static const GS_Memory_Format gs_memory_psmt4hl  = { .blocks = gs_memory_blocks_ct32.data(),  .pixels = gs_memory_pixels_32.data(), .bits = 32, .transfer_bits = 4,  .shift = 24, .mask = 0xF,        GS_MEMORY_LAYOUT_32 };
+static const GS_Memory_Format gs_memory_psmt4hh  = { .blocks = gs_memory_blocks_ct32.data(),  .pixels = gs_memory_pixels_32.data(), .bits = 32, .transfer_bits = 4,  .shift = 28, .mask = 0xF,        GS_MEMORY_LAYOUT_32 };
+static const GS_Memory_Format gs_memory_psmz32   = { .blocks = gs_memory_blocks_z32.data(),   .pixels = gs_memory_pixels_32.data(), .bits = 32, .transfer_bits = 32, .shift = 0,  .mask = 0xFFFFFFFF, GS_MEMORY_LAYOUT_32 };
+static const GS_Memory_Format gs_memory_psmz24   = { .blocks = gs_memory_blocks_z32.data(),   .pixels = gs_memory_pixels_32.data(), .bits = 32, .transfer_bits = 24, .shift = 0,  .mask = 0x00FFFFFF, GS_MEMORY_LAYOUT_32 };
+static const GS_Memory_Format gs_memory_psmz16   = { .blocks = gs_memory_blocks_z16.data(),   .pixels = gs_memory_pixels_16.data(), .bits = 16, .transfer_bits = 16, .shift = 0,  .mask = 0xFFFF,     GS_MEMORY_LAYOUT_16 };
+static const GS_Memory_Format gs_memory_psmz16s  = { .blocks = gs_memory_blocks_z16s.data(),  .pixels = gs_memory_pixels_16.data(), .bits = 16, .transfer_bits = 16, .shift = 0,  .mask = 0xFFFF,     GS_MEMORY_LAYOUT_16 };
+
+// NULL for the PSM values that do not exist
+const GS_Memory_Format *
+gs_memory_format (u8 psm)
+{
+   switch (psm)
+   {
+      case PSMCT32:  return &gs_memory_psmct32;
+      case PSMCT24:  return &gs_memory_psmct24;
+      case PSMCT16:  return &gs_memory_psmct16;
+      case PSMCT16S: return &gs_memory_psmct16s;
+      case PSMT8:    return &gs_memory_psmt8;
+      case PSMT4:    return &gs_memory_psmt4;
+      case PSMT8H:   return &gs_memory_psmt8h;
+      case PSMT4HL:  return &gs_memory_psmt4hl;
+      case PSMT4HH:  return &gs_memory_psmt4hh;
+      case PSMZ32:   return &gs_memory_psmz32;
+      case PSMZ24:   return &gs_memory_psmz24;
+      case PSMZ16:   return &gs_memory_psmz16;
+      case PSMZ16S:  return &gs_memory_psmz16s;
+      default:       return NULL;
+   }
+}
+
+void
+gs_memory_reset ()
+{
+   gs_memory_transfer.stream.clear();
+   gs_memory_transfer.size       = 0;
+   gs_memory_transfer.offset     = 0;
+   gs_memory_transfer.rows_done  = 0;
+   gs_memory_transfer.active     = false;
+}
+
+/*******************************************
+ * Colors
+*******************************************/
+// Pixel of a color format as 32 bit RGBA
+// @Incomplete: There is no CLUT yet, indexed formats come out as gray
+u32
+gs_memory_read_color (u8 psm, u32 base, u32 width, u32 x, u32 y)
+{
+   const GS_Memory_Format *format = gs_memory_format(psm);
+   if (!format) return 0;
+
+   TEXA *texa  = &gs.texa;
+   u32 value   = gs_memory_read_pixel(format, base, width, x, y);
+
+   switch (psm)
+   {
+      case PSMCT32: case PSMZ32:
+         return value;
+
+      case PSMCT24: case PSMZ24:
+      {
+         bool black = texa->expansion_method && value == 0;
+         return value | ((black ? 0 : texa->alpha_value_field0) << 24);
+      }
+
+      case PSMCT16: case PSMCT16S: case PSMZ16: case PSMZ16S:
+      {
+         u8 r     = (value & 0x1F) << 3;
+         u8 g     = ((value >> 5) & 0x1F) << 3;
+         u8 b     = ((value >> 10) & 0x1F) << 3;
+         u8 a     = (value & 0x8000) ? texa->alpha_value_field1 : texa->alpha_value_field0;
+         if (texa->expansion_method && (value & 0x7FFF) == 0) a = 0;
+         return pack_RGBA(r, g, b, a);
+      }
+
+      default:
+      {
+         u8 index = format->transfer_bits == 8 ? value : value * 0x11;
+         return pack_RGBA(index, index, index, 0x80);
+      }
+   }
+}
+
+// @Incomplete: Textures always repeat, CLAMP_1/2 are not looked at
+u32
+gs_memory_read_texel (const TEX0 *tex0, u32 u, u32 v)
+{
+   u &= tex0->texture_width - 1;
+   v &= tex0->texture_height - 1;
+   return gs_memory_read_color(tex0->pixel_storage_format, tex0->base_pointer, tex0->buffer_width * 64, u, v);
+}
+
+/*******************************************
+ * Rectangles
+*******************************************/
+static void
+gs_memory_write_pixels (const GS_Memory_Rect *rect, u32 row, u32 rows, u32 column, u32 columns, const u8 *stream)
+{
+   const GS_Memory_Format *format = rect->format;
+   for (u32 r = row; r < row + rows; ++r)
+   {
+      u32 y = (rect->y + r) & GS_MEMORY_MAX_COORD;
+      for (u32 c = column; c < column + columns; ++c)
+      {
+         u32 value = gs_memory_load(stream, format->transfer_bits, (u64)r * rect->columns + c);
+         gs_memory_write_pixel(format, rect->base, rect->width, (rect->x + c) & GS_MEMORY_MAX_COORD, y, value);
+      }
+   }
+}
+
+static void
+gs_memory_read_pixels (const GS_Memory_Rect *rect, u32 row, u32 rows, u32 column, u32 columns, u8 *stream)
+{
+   const GS_Memory_Format *format = rect->format;
+   for (u32 r = row; r < row + rows; ++r)
+   {
+      u32 y = (rect->y + r) & GS_MEMORY_MAX_COORD;
+      for (u32 c = column; c < column + columns; ++c)
+      {
+         u32 value = gs_memory_read_pixel(format, rect->base, rect->width, (rect->x + c) & GS_MEMORY_MAX_COORD, y);
+         gs_memory_store(stream, format->transfer_bits, (u64)r * rect->columns + c, value);
+      }
+   }
+}
+
+// Formats that own part of a 32 bit word have a block of 8x8 pixels widened to whole words around the kernels
+static void
+gs_memory_write_block (const GS_Memory_Rect *rect, u32 row, u32 column, const u8 *stream)
+{
+   const GS_Memory_Format *format = rect->format;
+   u32 *block  = &gs.vram[gs_memory_block_word(format, rect->base, rect->width, rect->x + column, (rect->y + row) & GS_MEMORY_MAX_COORD)];
+   u64 element = (u64)row * rect->columns + column;
+
+   if (format->transfer_bits == format->bits)
+   {
+      format->swizzle(format, block, stream, element, rect->columns);
+      return;
+   }
+
+   u32 words[GS_BLOCK_WORDS];
+   for (u32 i = 0; i < GS_BLOCK_WORDS; ++i)
+   {
+      u32 value = gs_memory_load(stream, format->transfer_bits, element + (i >> 3) * rect->columns + (i & 7));
+      words[i]  = (value & format->mask) << format->shift;
+   }
+   format->swizzle(format, block, (const u8*)words, 0, 8);
+}
+
+static void
+gs_memory_read_block (const GS_Memory_Rect *rect, u32 row, u32 column, u8 *stream)
+{
+   const GS_Memory_Format *format = rect->format;
+   const u32 *block  = &gs.vram[gs_memory_block_word(format, rect->base, rect->width, rect->x + column, (rect->y + row) & GS_MEMORY_MAX_COORD)];
+   u64 element       = (u64)row * rect->columns + column;
+
+   if (format->transfer_bits == format->bits)
+   {
+      format->unswizzle(format, block, stream, element, rect->columns);
+      return;
+   }
+
+   u32 words[GS_BLOCK_WORDS];
+   format->unswizzle(format, block, (u8*)words, 0, 8);
+   for (u32 i = 0; i < GS_BLOCK_WORDS; ++i)
+      gs_memory_store(stream, format->transfer_bits, element + (i >> 3) * rect->columns + (i & 7), (words[i] >> format->shift) & format->mask);
+}
+
+// Walks rows [first, last) a band of block rows at a time, whole blocks go to `block`, the rest to `pixels`
+template <typename Stream, typename Block_Function, typename Pixels_Function>
+static void
+gs_memory_walk_rect (const GS_Memory_Rect *rect, u32 first, u32 last, Stream stream, Block_Function block, Pixels_Function pixels)
+{
+   const GS_Memory_Format *format = rect->format;
+   u32 block_width   = 1 << format->block_width;
+   u32 block_height  = 1 << format->block_height;
+
+   // Whole blocks are the ones between the first and the last block boundary the rectangle crosses
+   u32 left    = (rect->x + block_width - 1) & ~(block_width - 1);
+   u32 right   = MIN(rect->x + rect->columns, GS_MEMORY_MAX_COORD + 1) & ~(block_width - 1);
+
+   for (u32 row = first, band = 0; row < last; row += band)
+   {
+      u32 y = (rect->y + row) & GS_MEMORY_MAX_COORD;
+      band  = MIN(block_height - (y & (block_height - 1)), last - row);
+
+      if (band < block_height || left >= right)
+      {
+         pixels(rect, row, band, 0, rect->columns, stream);
+         continue;
+      }
+
+      pixels(rect, row, band, 0, left - rect->x, stream);
+      for (u32 x = left; x < right; x += block_width)
+         block(rect, row, x - rect->x, stream);
+      pixels(rect, row, band, right - rect->x, rect->columns - (right - rect->x), stream);
+   }
+}
+
+// `stream` holds the whole rectangle packed like a transfer, only rows [first, last) of it are written
+void
+gs_memory_write_rect (const GS_Memory_Rect *rect, u32 first, u32 last, const u8 *stream)
+{
+   gs_memory_walk_rect(rect, first, last, stream, gs_memory_write_block, gs_memory_write_pixels);
+}
+
+void
+gs_memory_read_rect (const GS_Memory_Rect *rect, u32 first, u32 last, u8 *stream)
+{
+   gs_memory_walk_rect(rect, first, last, stream, gs_memory_read_block, gs_memory_read_pixels);
+}
+
+/*******************************************
+ * Transfers
+*******************************************/
+// Uploads go to VRAM a band of block rows at a time, so that whole blocks get to the kernels
+static void
+gs_memory_next_band (GS_Memory_Transfer *transfer)
+{
+   GS_Memory_Rect *rect = &transfer->rect;
+   u32 block_height     = 1 << rect->format->block_height;
+   u32 row              = transfer->rows_done + block_height - ((rect->y + transfer->rows_done) & (block_height - 1));
+
+   transfer->band_row   = MIN(row, rect->rows);
+   transfer->band_end   = ((u64)transfer->band_row * rect->columns * rect->format->transfer_bits + 7) / 8;
+}
+
+static void
+gs_memory_start_transfer (u8 psm, u32 base, u32 width, u32 x, u32 y)
+{
+   GS_Memory_Transfer *transfer  = &gs_memory_transfer;
+   const GS_Memory_Format *format = gs_memory_format(psm);
+   if (!format)
+   {
+      errtrace("[ERROR]: Transmission with unknown PSM {:#x}, using PSMCT32\n", psm);
+      format = &gs_memory_psmct32;
+   }
+
+   transfer->rect       = { format, base, width, x, y, gs.trxreg.width, gs.trxreg.height };
+   transfer->size       = ((u64)transfer->rect.columns * transfer->rect.rows * format->transfer_bits + 7) / 8;
+   transfer->offset     = 0;
+   transfer->rows_done  = 0;
+   transfer->active     = true;
+   gs_memory_next_band(transfer);
+
+   // HWREG moves whole doublewords, the padding past the last pixel is never looked at
+   transfer->stream.assign((transfer->size + 7) & ~7ull, 0);
+}
+
+void
+gs_memory_upload_start ()
+{
+   BITBLTBUF *bitbltbuf = &gs.bitbltbuf;
+   gs_memory_start_transfer(bitbltbuf->dest_storage_format, bitbltbuf->dest_base_pointer, bitbltbuf->dest_buffer_width,
+                            gs.trxpos.dest_x_coord, gs.trxpos.dest_y_coord);
+}
+
+// Takes the next bytes of a Host => Local transmission, true once the last pixel arrived. Whatever the GIF
+// sends past the end of the stream is dropped.
+bool
+gs_memory_upload (const u8 *data, u64 size)
+{
+   GS_Memory_Transfer *transfer  = &gs_memory_transfer;
+   GS_Memory_Rect *rect          = &transfer->rect;
+   if (!transfer->active) return false;
+
+   u64 count = std::min<u64>(size, transfer->stream.size() - transfer->offset);
+   memcpy(transfer->stream.data() + transfer->offset, data, count);
+   transfer->offset += count;
+
+   while (transfer->rows_done < rect->rows && transfer->offset >= transfer->band_end)
+   {
+      gs_memory_write_rect(rect, transfer->rows_done, transfer->band_row, transfer->stream.data());
+      transfer->rows_done = transfer->band_row;
+      gs_memory_next_band(transfer);
+   }
+
+   bool done = transfer->offset >= transfer->size;
+   if (done) transfer->active = false;
+   return done;
+}
+
+// The whole rectangle is read out right away, the EE takes it from the GIF FIFO afterwards
+void
+gs_memory_readback_start ()
+{
+   BITBLTBUF *bitbltbuf          = &gs.bitbltbuf;
+   GS_Memory_Transfer *transfer  = &gs_memory_transfer;
+
+   gs_memory_start_transfer(bitbltbuf->src_storage_format, bitbltbuf->src_base_pointer, bitbltbuf->src_buffer_width,
+                            gs.trxpos.src_x_coord, gs.trxpos.src_y_coord);
+   gs_memory_read_rect(&transfer->rect, 0, transfer->rect.rows, transfer->stream.data());
+}
+
+// Hands out the next bytes of a Local => Host transmission and returns how many were left. Once the
+// rectangle is drained the GIF reads zeros.
+u64
+gs_memory_readback (u8 *data, u64 size)
+{
+   GS_Memory_Transfer *transfer = &gs_memory_transfer;
+   u64 count = transfer->active ? std::min<u64>(size, transfer->stream.size() - transfer->offset) : 0;
+
+   memcpy(data, transfer->stream.data() + transfer->offset, count);
+   memset(data + count, 0, size - count);
+   transfer->offset += count;
+
+   if (transfer->offset >= transfer->stream.size()) transfer->active = false;
+   return count;
+}
+
+// The pages a rectangle touches are a single run of VRAM that can wrap around its end
+static bool
+gs_memory_rects_overlap (const GS_Memory_Rect *a, const GS_Memory_Rect *b)
+{
+   u32 first[2], size[2];
+   const GS_Memory_Rect *rects[2] = { a, b };
+   for (u32 i = 0; i < 2; ++i)
+   {
+      const GS_Memory_Rect *rect       = rects[i];
+      const GS_Memory_Format *format   = rect->format;
+      u32 pages_per_row                = rect->width >> format->page_width;
+      u32 top_left                     = (rect->x >> format->page_width) + (rect->y >> format->page_height) * pages_per_row;
+      u32 bottom_right                 = ((rect->x + rect->columns - 1) >> format->page_width) +
+                                         ((rect->y + rect->rows - 1) >> format->page_height) * pages_per_row;
+
+      first[i] = (rect->base + top_left * GS_PAGE_WORDS) & (GS_VRAM_WORDS - 1);
+      size[i]  = MIN((bottom_right - top_left + 1) * GS_PAGE_WORDS, GS_VRAM_WORDS);
+   }
+
+   return ((first[1] - first[0]) & (GS_VRAM_WORDS - 1)) < size[0] || ((first[0] - first[1]) & (GS_VRAM_WORDS - 1)) < size[1];
+}
+
+/*
+   Formats that own whole elements keep a pixel at the same spot in its block wherever the block is, so a
+   rectangle made of whole blocks moves a block at a time without being unswizzled.
+*/
+static bool
+gs_memory_copy_blocks (const GS_Memory_Rect *source, const GS_Memory_Rect *dest)
+{
+   const GS_Memory_Format *format = source->format;
+   if (dest->format != format || format->transfer_bits != format->bits) return false;
+
+   u32 block_width   = 1 << format->block_width;
+   u32 block_height  = 1 << format->block_height;
+   if ((source->x | dest->x | source->columns) & (block_width - 1))  return false;
+   if ((source->y | dest->y | source->rows) & (block_height - 1))    return false;
+
+   // Rectangles wrapping around the buffer are left to the pixels
+   if (MAX(source->x, dest->x) + source->columns > GS_MEMORY_MAX_COORD + 1) return false;
+   if (MAX(source->y, dest->y) + source->rows    > GS_MEMORY_MAX_COORD + 1) return false;
+
+   if (!gs_memory_rects_overlap(source, dest))
+   {
+      for (u32 y = 0; y < source->rows; y += block_height)
+      {
+         for (u32 x = 0; x < source->columns; x += block_width)
+            memcpy(&gs.vram[gs_memory_block_word(format, dest->base, dest->width, dest->x + x, dest->y + y)],
+                   &gs.vram[gs_memory_block_word(format, source->base, source->width, source->x + x, source->y + y)], GS_BLOCK_WORDS * 4);
+      }
+      return true;
+   }
+
+   // Overlapping rectangles go through a copy of the source blocks
+   std::vector<u32> blocks((u64)(source->columns >> format->block_width) * (source->rows >> format->block_height) * GS_BLOCK_WORDS);
+   u32 *block = blocks.data();
+   for (u32 y = 0; y < source->rows; y += block_height)
+   {
+      for (u32 x = 0; x < source->columns; x += block_width, block += GS_BLOCK_WORDS)
+         memcpy(block, &gs.vram[gs_memory_block_word(format, source->base, source->width, source->x + x, source->y + y)], GS_BLOCK_WORDS * 4);
+   }
+
+   block = blocks.data();
+   for (u32 y = 0; y < dest->rows; y += block_height)
+   {
+      for (u32 x = 0; x < dest->columns; x += block_width, block += GS_BLOCK_WORDS)
+         memcpy(&gs.vram[gs_memory_block_word(format, dest->base, dest->width, dest->x + x, dest->y + y)], block, GS_BLOCK_WORDS * 4);
+   }
+   return true;
+}
+
+/*
+   @@Note: The source is read completely before anything is written, so overlapping rectangles come out
+   like a memmove no matter what TRXPOS DIR says. That is what the GS does as long as DIR is set for the
+   way the rectangles overlap, which is what DIR is there for.
+*/
+void
+gs_memory_copy ()
+{
+   BITBLTBUF *bitbltbuf = &gs.bitbltbuf;
+   TRXPOS *trxpos       = &gs.trxpos;
+
+   const GS_Memory_Format *source_format  = gs_memory_format(bitbltbuf->src_storage_format);
+   const GS_Memory_Format *dest_format    = gs_memory_format(bitbltbuf->dest_storage_format);
+   if (!source_format || !dest_format)
+   {
+      errtrace("[ERROR]: Local => Local transmission from PSM {:#x} to PSM {:#x} is not supported\n",
+               bitbltbuf->src_storage_format, bitbltbuf->dest_storage_format);
+      return;
+   }
+
+   GS_Memory_Rect source   = { source_format, bitbltbuf->src_base_pointer, bitbltbuf->src_buffer_width,
+                               trxpos->src_x_coord, trxpos->src_y_coord, gs.trxreg.width, gs.trxreg.height };
+   GS_Memory_Rect dest     = { dest_format, bitbltbuf->dest_base_pointer, bitbltbuf->dest_buffer_width,
+                               trxpos->dest_x_coord, trxpos->dest_y_coord, gs.trxreg.width, gs.trxreg.height };
+
+   if (gs_memory_copy_blocks(&source, &dest)) return;
+
+   if (source_format->transfer_bits == dest_format->transfer_bits)
+   {
+      std::vector<u8> stream(((u64)source.columns * source.rows * source_format->transfer_bits + 7) / 8);
+      gs_memory_read_rect(&source, 0, source.rows, stream.data());
+      gs_memory_write_rect(&dest, 0, dest.rows, stream.data());
+      return;
+   }
+
+   // Pixels of different sizes are moved one at a time, the destination keeps the bits it has room for
+   std::vector<u32> pixels((u64)source.columns * source.rows);
+   for (u32 y = 0, i = 0; y < source.rows; ++y)
+   {
+      for (u32 x = 0; x < source.columns; ++x, ++i)
+         pixels[i] = gs_memory_read_pixel(source_format, source.base, source.width,
+                                          (source.x + x) & GS_MEMORY_MAX_COORD, (source.y + y) & GS_MEMORY_MAX_COORD);
+   }
+
+   for (u32 y = 0, i = 0; y < dest.rows; ++y)
+   {
+      for (u32 x = 0; x < dest.columns; ++x, ++i)
+         gs_memory_write_pixel(dest_format, dest.base, dest.width,
+                               (dest.x + x) & GS_MEMORY_MAX_COORD, (dest.y + y) & GS_MEMORY_MAX_COORD, pixels[i]);
+   }
+}
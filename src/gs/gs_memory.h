@@ -0,0 +1,117 @@
+#ifndef GS_MEMORY_H
+#define GS_MEMORY_H
+
+/*
+   GS Local Memory
+
+   The 4 MB of local memory are not a linear frame buffer. They are split into 8 KB pages, every page into
+   32 blocks of 256 bytes and every block into 4 columns of 64 bytes. Where a pixel ends up depends on the
+   pixel storage mode, each PSM has its own page and block size and its own order of the blocks in a page
+   and of the pixels in a block:
+
+      PSM                     Page        Block    Blocks in a page
+      CT32, CT24, Z32, Z24    64x32       8x8      8x4
+      CT16, CT16S, Z16, Z16S  64x64       16x8     4x8
+      T8                      128x64      16x16    8x4
+      T4                      128x128     32x16    4x8
+
+   The Z formats are the color formats with the blocks in a different order. CT24, Z24, T8H, T4HL and T4HH
+   use the 32 bit layout and only own some of the bits of every word, which is how a T8H texture can share
+   its words with a CT24 frame buffer.
+
+   Every address is looked up in tables that are generated at compile time from the bit patterns the block
+   and pixel orders follow. Everything that touches VRAM goes through here: image transfers in both
+   directions, local to local copies, the pixel pipeline, texture fetches and the CRT output.
+
+   Transfers are converted a band of block rows at a time. Blocks the transfer rectangle covers completely
+   are converted as a whole by the block kernel of the format, SSE2 or AVX2 for the 32 and 16 bit layouts,
+   the pixels around them one at a time. Local to local copies of whole blocks in a format that owns
+   whole elements do not even need the kernels, the blocks are moved as they are.
+
+   @Incomplete: The 8 and 4 bit layouts only have scalar block kernels.
+*/
+
+#if defined(__AVX2__)
+#define GS_MEMORY_AVX2 1
+#include <immintrin.h>
+#else
+#define GS_MEMORY_AVX2 0
+#endif
+
+#if !GS_MEMORY_AVX2 && (defined(__SSE2__) || defined(_M_X64))
+#define GS_MEMORY_SSE2 1
+#include <emmintrin.h>
+#else
+#define GS_MEMORY_SSE2 0
+#endif
+
+#define GS_VRAM_WORDS         (MEGABYTES(4) / 4)   // Addresses wrap around like on hardware
+#define GS_PAGE_WORDS         2048
+#define GS_BLOCK_WORDS        64
+#define GS_MEMORY_MAX_COORD   2047                 // Transfer coordinates wrap around the 2048x2048 buffer
+
+typedef struct _GS_Memory_Format_ GS_Memory_Format;
+
+// A block in VRAM to or from its linear form, `element` is the index of its top left pixel in `linear`
+// and rows are `pitch` pixels apart
+typedef void (*GS_Memory_Swizzle_Function)(const GS_Memory_Format *format, u32 *block, const u8 *linear, u64 element, u32 pitch);
+typedef void (*GS_Memory_Unswizzle_Function)(const GS_Memory_Format *format, const u32 *block, u8 *linear, u64 element, u32 pitch);
+
+struct _GS_Memory_Format_ {
+   const u8                      *blocks;          // Block number of every block in a page, row by row
+   const u16                     *pixels;          // Element of every pixel in a block, row by row
+   u8                            bits;             // Size of the element a pixel lives in: 32, 16, 8 or 4
+   u8                            transfer_bits;    // Size of a pixel in image transfers
+   u8                            shift;            // The pixel is (element >> shift) & mask
+   u32                           mask;
+   u8                            page_width;       // Sizes as log2 of the pixels
+   u8                            page_height;
+   u8                            block_width;
+   u8                            block_height;
+   GS_Memory_Swizzle_Function    swizzle;
+   GS_Memory_Unswizzle_Function  unswizzle;
+};
+
+// Part of a buffer an image transfer covers
+typedef struct _GS_Memory_Rect_ {
+   const GS_Memory_Format  *format;
+   u32                     base;       // In words
+   u32                     width;      // Buffer width in pixels
+   u32                     x;
+   u32                     y;
+   u32                     columns;
+   u32                     rows;
+} GS_Memory_Rect;
+
+// The host side of a transfer is packed like the GIF sends it: transfer_bits per pixel, row after row
+typedef struct _GS_Memory_Transfer_ {
+   GS_Memory_Rect    rect;
+   std::vector<u8>   stream;
+   u64               size;       // Bytes of the stream that carry pixels
+   u64               offset;     // Bytes received or handed out so far
+   u32               rows_done;  // Rows of an upload already in VRAM
+   u32               band_row;   // End of the band of block rows the upload waits for
+   u64               band_end;   // Bytes of the stream needed to complete it
+   bool              active;
+} GS_Memory_Transfer;
+
+static GS_Memory_Transfer gs_memory_transfer;
+
+void                       gs_memory_reset();
+const GS_Memory_Format *   gs_memory_format(u8 psm);
+
+u32   gs_memory_read_pixel(const GS_Memory_Format *format, u32 base, u32 width, u32 x, u32 y);
+void  gs_memory_write_pixel(const GS_Memory_Format *format, u32 base, u32 width, u32 x, u32 y, u32 value);
+u32   gs_memory_read_color(u8 psm, u32 base, u32 width, u32 x, u32 y);
+u32   gs_memory_read_texel(const TEX0 *tex0, u32 u, u32 v);
+
+void  gs_memory_write_rect(const GS_Memory_Rect *rect, u32 first, u32 last, const u8 *stream);
+void  gs_memory_read_rect(const GS_Memory_Rect *rect, u32 first, u32 last, u8 *stream);
+
+void  gs_memory_upload_start();
+bool  gs_memory_upload(const u8 *data, u64 size);
+void  gs_memory_readback_start();
+u64   gs_memory_readback(u8 *data, u64 size);
+void  gs_memory_copy();
+
+#endif
@@ -0,0 +1,192 @@
+/*
+ * Copyright 2023 Xaviar Roach
+ * SPDX-License-Identifier: MIT
+ */
+
+/*******************************************
+ * Pipeline Instantiations
+*******************************************/
+template <u8 ATST>
+static inline bool
+gs_pixel_alpha_test (u8 alpha, u8 aref)
+{
+   if constexpr (ATST == NEVER)    return false;
+   if constexpr (ATST == ALWAYS)   return true;
+   if constexpr (ATST == LESS)     return alpha <  aref;
+   if constexpr (ATST == LEQUAL)   return alpha <= aref;
+   if constexpr (ATST == EQUAL)    return alpha == aref;
+   if constexpr (ATST == GEQUAL)   return alpha >= aref;
+   if constexpr (ATST == GREATER)  return alpha >  aref;
+   if constexpr (ATST == NOTEQUAL) return alpha != aref;
+}
+
+// Frame buffer color as RGBA8888, 16 bit formats get the top bits of every channel back
+static inline u32
+gs_pixel_load_frame (const GS_Pixel_Context *context, u32 x, u32 y)
+{
+   u32 value = gs_memory_read_pixel(context->frame_format, context->frame_base, context->width, x, y);
+   if (context->frame_format->bits != 16) return value;
+
+   return ((value & 0x1F) << 3) | ((value & 0x3E0) << 6) | ((value & 0x7C00) << 9) | ((value & 0x8000) << 16);
+}
+
+static inline void
+gs_pixel_store_frame (const GS_Pixel_Context *context, u32 x, u32 y, u32 color)
+{
+   if (context->frame_format->bits == 16)
+      color = ((color >> 3) & 0x1F) | ((color >> 6) & 0x3E0) | ((color >> 9) & 0x7C00) | ((color >> 16) & 0x8000);
+
+   gs_memory_write_pixel(context->frame_format, context->frame_base, context->width, x, y, color);
+}
+
+template <u32 KEY>
+static void
+gs_pixel_span (const GS_Pixel_Context *context, s32 x0, s32 y, u32 mask, const u32 *z, const u32 *color)
+{
+   constexpr u8   atst     = KEY & 0x7;
+   constexpr u8   afail    = (KEY >> 3) & 0x3;
+   constexpr u8   ztst     = (KEY >> 5) & 0x3;
+   constexpr bool zmsk     = (KEY >> 7) & 0x1;
+   constexpr bool fbmsk    = (KEY >> 8) & 0x1;
+   constexpr bool formats  = (KEY >> 9) & 0x1;
+
+   if constexpr (ztst == ZTST_NEVER) return;
+
+   u32 *vram   = context->vram;
+
+   while (mask)
+   {
+      u32 i = std::countr_zero(mask);
+      mask &= mask - 1;
+
+      u32 pixel         = color[i];
+      bool write_frame  = true;
+      bool write_z      = !zmsk;
+      bool keep_alpha   = false;
+
+      // When a pixel fails the alpha test AFAIL decides which of the buffers still get written
+      if constexpr (atst != ALWAYS)
+      {
+         if (!gs_pixel_alpha_test<atst>(pixel >> 24, context->aref))
+         {
+            if constexpr (afail == KEEP)     continue;
+            if constexpr (afail == FB_ONLY)  write_z = false;
+            if constexpr (afail == ZB_ONLY)  write_frame = false;
+            if constexpr (afail == RGB_ONLY)
+            {
+               write_z     = false;
+               keep_alpha  = true;
+            }
+         }
+      }
+
+      u32 x          = x0 + i;
+      u32 z_value    = z[i];
+      u32 z_address  = 0;
+      if constexpr (formats) z_value &= context->z_format->mask;
+      else                   z_address = gs_memory_address_32(context->z_blocks, context->z_base, context->width, x, y);
+
+      if constexpr (ztst == ZTST_GEQUAL || ztst == ZTST_GREATER)
+      {
+         u32 z_buffer;
+         if constexpr (formats) z_buffer = gs_memory_read_pixel(context->z_format, context->z_base, context->width, x, y);
+         else                   z_buffer = vram[z_address];
+
+         if constexpr (ztst == ZTST_GEQUAL)  if (z_value <  z_buffer) continue;
+         if constexpr (ztst == ZTST_GREATER) if (z_value <= z_buffer) continue;
+      }
+
+      if (write_z)
+      {
+         if constexpr (formats) gs_memory_write_pixel(context->z_format, context->z_base, context->width, x, y, z_value);
+         else                   vram[z_address] = z_value;
+      }
+
+      if (write_frame)
+      {
+         u32 frame_address = 0;
+         if constexpr (!formats) frame_address = gs_memory_address_32(context->frame_blocks, context->frame_base, context->width, x, y);
+
+         if (fbmsk || keep_alpha)
+         {
+            u32 old;
+            if constexpr (formats) old = gs_pixel_load_frame(context, x, y);
+            else                   old = vram[frame_address];
+
+            if constexpr (fbmsk) pixel = (pixel & ~context->fbmsk) | (old & context->fbmsk);
+            if (keep_alpha)      pixel = (pixel & 0x00FFFFFF) | (old & 0xFF000000);
+         }
+
+         if constexpr (formats) gs_pixel_store_frame(context, x, y, pixel);
+         else                   vram[frame_address] = pixel;
+      }
+   }
+}
+
+template <u32... KEYS>
+static constexpr std::array<GS_Pixel_Span_Function, sizeof...(KEYS)>
+gs_pixel_make_table (std::integer_sequence<u32, KEYS...>)
+{
+   return {{ &gs_pixel_span<KEYS>... }};
+}
+
+static const std::array<GS_Pixel_Span_Function, GS_PIXEL_PIPELINE_COUNT> gs_pixel_pipelines =
+   gs_pixel_make_table(std::make_integer_sequence<u32, GS_PIXEL_PIPELINE_COUNT>{});
+
+/*******************************************
+ * Selection
+*******************************************/
+// Buffers can only be drawn to in the 32 and 16 bit formats, anything else is drawn as `fallback`
+static const GS_Memory_Format *
+gs_pixel_format (u8 psm, u8 fallback)
+{
+   const GS_Memory_Format *format = gs_memory_format(psm);
+   if (!format || format->bits < 16 || format->transfer_bits < 16) format = gs_memory_format(fallback);
+   return format;
+}
+
+// Called when TEST, FRAME or ZBUF is written
+void
+gs_pixel_invalidate ()
+{
+   gs_pixel_cache_valid = false;
+}
+
+// @@Incomplete: Only using context 1 for rendering for now
+GS_Pixel_Pipeline *
+gs_pixel_select ()
+{
+   if (gs_pixel_cache_valid) return &gs_pixel_cached;
+
+   TEST *test     = &gs.test_1;
+   FRAME *frame   = &gs.frame_1;
+   ZBUF *zbuf     = &gs.zbuf_1;
+
+   u32 atst    = test->alpha_test ? (u32)test->alpha_test_method : (u32)ALWAYS;
+   u32 afail   = atst == ALWAYS ? (u32)KEEP : (u32)test->alpha_fail_method;
+   u32 ztst    = test->depth_test ? (u32)test->depth_test_method : (u32)ZTST_ALWAYS;
+
+   const GS_Memory_Format *frame_format   = gs_pixel_format(frame->storage_format, PSMCT32);
+   const GS_Memory_Format *z_format       = gs_pixel_format(0x30 | zbuf->storage_format, PSMZ32);
+   bool formats = frame_format != gs_memory_format(PSMCT32) || z_format != gs_memory_format(PSMZ32);
+
+   u32 key     = atst | (afail << 3) | (ztst << 5) | ((u32)zbuf->z_value_mask << 7) | ((u32)(frame->drawing_mask != 0) << 8) |
+                 ((u32)formats << 9);
+
+   GS_Pixel_Pipeline *pipeline    = &gs_pixel_cached;
+   pipeline->key                  = key;
+   pipeline->span                 = gs_pixel_pipelines[key];
+   pipeline->context.vram         = gs.vram;
+   pipeline->context.frame_format = frame_format;
+   pipeline->context.z_format     = z_format;
+   pipeline->context.frame_blocks = frame_format->blocks;
+   pipeline->context.z_blocks     = z_format->blocks;
+   pipeline->context.frame_base   = frame->base_pointer;
+   pipeline->context.z_base       = zbuf->base_pointer;
+   pipeline->context.width        = frame->buffer_width;
+   pipeline->context.fbmsk        = frame->drawing_mask;
+   pipeline->context.aref         = test->alpha_comparison_value;
+
+   gs_pixel_cache_valid = true;
+   return pipeline;
+}
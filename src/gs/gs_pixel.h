@@ -0,0 +1,63 @@
+#ifndef GS_PIXEL_H
+#define GS_PIXEL_H
+
+/*
+   Pixel Pipeline
+
+   Everything that happens to a pixel after rasterization: alpha test, depth test, Z and frame buffer
+   writes. Instead of looking at TEST, FRAME and ZBUF for every pixel, the draw state is packed into a
+   key once per primitive and the key picks a template instantiation of gs_pixel_span() that has all of
+   those decisions compiled in. The table of instantiations is built at compile time, one entry per key.
+
+   A span is up to 8 pixels of one row, given as a bit mask with the Z and color of every set bit. The
+   values the pipeline needs that are not part of the key (AREF, FBMSK, buffer addresses) are captured
+   into a GS_Pixel_Context when the primitive is set up.
+
+   Key bits:
+      0-2   ATST, ALWAYS when the alpha test is off
+      3-4   AFAIL, KEEP when ATST is ALWAYS
+      5-6   ZTST, ALWAYS when the depth test is off
+      7     ZMSK
+      8     FBMSK is not 0
+      9     The frame buffer is not PSMCT32 or the Z buffer is not PSMZ32
+
+   PSMCT32 and PSMZ32 have their words addressed directly. Every other format goes through the local memory
+   functions, which keep to the bits the format owns: 16 bit colors are packed as RGBA5551 and Z is cut
+   down to the bits of the Z format before it is tested.
+
+   @Incomplete: No destination alpha test, alpha blending or texturing yet. They get key bits once the
+   pipeline implements them.
+*/
+
+#define GS_PIXEL_KEY_BITS        10
+#define GS_PIXEL_PIPELINE_COUNT  (1 << GS_PIXEL_KEY_BITS)
+
+typedef struct _GS_Pixel_Context_ {
+   u32                     *vram;
+   const GS_Memory_Format  *frame_format;
+   const GS_Memory_Format  *z_format;
+   const u8                *frame_blocks;   // Block order of the frame and Z buffer formats, see gs_memory.h
+   const u8                *z_blocks;
+   u32                     frame_base;
+   u32                     z_base;
+   u32                     width;
+   u32                     fbmsk;
+   u8                      aref;
+} GS_Pixel_Context;
+
+typedef void (*GS_Pixel_Span_Function)(const GS_Pixel_Context *context, s32 x0, s32 y, u32 mask, const u32 *z, const u32 *color);
+
+typedef struct _GS_Pixel_Pipeline_ {
+   u32                     key;
+   GS_Pixel_Span_Function  span;
+   GS_Pixel_Context        context;
+} GS_Pixel_Pipeline;
+
+// Last pipeline picked, valid until one of the registers it was built from is written
+static GS_Pixel_Pipeline   gs_pixel_cached;
+static bool                gs_pixel_cache_valid = false;
+
+void                 gs_pixel_invalidate();
+GS_Pixel_Pipeline *  gs_pixel_select();
+
+#endif
@@ -0,0 +1,553 @@
+/*
+ * Copyright 2023 Xaviar Roach
+ * SPDX-License-Identifier: MIT
+ */
+
+/*******************************************
+ * Triangle Setup
+*******************************************/
+static inline GS_Raster_Edge
+gs_raster_make_edge (V2I from, V2I to)
+{
+   GS_Raster_Edge edge;
+   edge.a = -(to.y - from.y);
+   edge.b = to.x - from.x;
+   edge.c = -((s64)edge.a * from.x + (s64)edge.b * from.y);
+
+   // Top-left rule: pixels exactly on a top or a left edge are drawn, pixels on any other edge are not
+   bool top_left = edge.a > 0 || (edge.a == 0 && edge.b > 0);
+   if (!top_left) edge.c -= 1;
+
+   return edge;
+}
+
+// Edge function at the pixel (x, y)
+static inline s64
+gs_raster_edge_at (const GS_Raster_Edge *edge, s32 x, s32 y)
+{
+   return (s64)edge->a * (x * GS_RASTER_SUBPIXEL) + (s64)edge->b * (y * GS_RASTER_SUBPIXEL) + edge->c;
+}
+
+// det is twice the area of the triangle in 12.4 units, the gradients are solved in 12.4 and scaled to pixels
+static GS_Raster_Plane
+gs_raster_make_plane (const V2I *pos, f64 v0, f64 v1, f64 v2, f64 det)
+{
+   f64 x1 = pos[1].x - pos[0].x;
+   f64 y1 = pos[1].y - pos[0].y;
+   f64 x2 = pos[2].x - pos[0].x;
+   f64 y2 = pos[2].y - pos[0].y;
+
+   GS_Raster_Plane plane;
+   plane.dx       = ((v1 - v0) * y2 - (v2 - v0) * y1) / det * GS_RASTER_SUBPIXEL;
+   plane.dy       = ((v2 - v0) * x1 - (v1 - v0) * x2) / det * GS_RASTER_SUBPIXEL;
+   plane.origin   = v0 - plane.dx * pos[0].x / GS_RASTER_SUBPIXEL - plane.dy * pos[0].y / GS_RASTER_SUBPIXEL;
+   return plane;
+}
+
+/*******************************************
+ * Coverage
+*******************************************/
+/*
+   Only called for the edges that cross the tile. E changes by at most (|a| + |b|) * 16 * 7 over a tile,
+   so for those edges every value in the tile fits in 32 bits.
+*/
+static void
+gs_raster_coverage (const GS_Raster_Triangle *tri, const u32 *edges, u32 count, s32 tx, s32 ty, u8 *rows)
+{
+   s32 row_value[3];
+   s32 pixel_step[3];
+   s32 row_step[3];
+
+   for (u32 i = 0; i < count; ++i)
+   {
+      const GS_Raster_Edge *edge = &tri->edges[edges[i]];
+      row_value[i]   = (s32)gs_raster_edge_at(edge, tx, ty);
+      pixel_step[i]  = edge->a * GS_RASTER_SUBPIXEL;
+      row_step[i]    = edge->b * GS_RASTER_SUBPIXEL;
+   }
+
+#if GS_RASTER_AVX2
+   const __m256i lanes        = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+   const __m256i minus_one    = _mm256_set1_epi32(-1);
+   __m256i value[3];
+
+   for (u32 i = 0; i < count; ++i)
+      value[i] = _mm256_add_epi32(_mm256_set1_epi32(row_value[i]), _mm256_mullo_epi32(lanes, _mm256_set1_epi32(pixel_step[i])));
+
+   for (u32 row = 0; row < GS_RASTER_TILE_SIZE; ++row)
+   {
+      __m256i inside = minus_one;
+      for (u32 i = 0; i < count; ++i)
+      {
+         inside   = _mm256_and_si256(inside, _mm256_cmpgt_epi32(value[i], minus_one));
+         value[i] = _mm256_add_epi32(value[i], _mm256_set1_epi32(row_step[i]));
+      }
+
+      rows[row] = (u8)_mm256_movemask_ps(_mm256_castsi256_ps(inside));
+   }
+#elif GS_RASTER_SSE2
+   const __m128i minus_one = _mm_set1_epi32(-1);
+   __m128i low[3];
+   __m128i high[3];
+
+   for (u32 i = 0; i < count; ++i)
+   {
+      s32 s    = pixel_step[i];
+      low[i]   = _mm_add_epi32(_mm_set1_epi32(row_value[i]), _mm_setr_epi32(0, s, 2 * s, 3 * s));
+      high[i]  = _mm_add_epi32(low[i], _mm_set1_epi32(4 * s));
+   }
+
+   for (u32 row = 0; row < GS_RASTER_TILE_SIZE; ++row)
+   {
+      __m128i inside_low   = minus_one;
+      __m128i inside_high  = minus_one;
+      for (u32 i = 0; i < count; ++i)
+      {
+         __m128i step   = _mm_set1_epi32(row_step[i]);
+         inside_low     = _mm_and_si128(inside_low,  _mm_cmpgt_epi32(low[i],  minus_one));
+         inside_high    = _mm_and_si128(inside_high, _mm_cmpgt_epi32(high[i], minus_one));
+         low[i]         = _mm_add_epi32(low[i],  step);
+         high[i]        = _mm_add_epi32(high[i], step);
+      }
+
+      rows[row] = (u8)(_mm_movemask_ps(_mm_castsi128_ps(inside_low)) | (_mm_movemask_ps(_mm_castsi128_ps(inside_high)) << 4));
+   }
+#else
+   for (u32 row = 0; row < GS_RASTER_TILE_SIZE; ++row)
+   {
+      u8 mask = 0xFF;
+      for (u32 i = 0; i < count; ++i)
+      {
+         u8 edge_mask = 0;
+         for (u32 x = 0; x < GS_RASTER_TILE_SIZE; ++x)
+            edge_mask |= (row_value[i] + (s32)x * pixel_step[i] >= 0) << x;
+
+         mask           &= edge_mask;
+         row_value[i]   += row_step[i];
+      }
+
+      rows[row] = mask;
+   }
+#endif
+}
+
+/*******************************************
+ * Span Shading
+*******************************************/
+static inline u32
+gs_raster_clamp (f64 value, f64 max)
+{
+   if (value <= 0)   return 0;
+   if (value >= max) return (u32)max;
+   return (u32)(value + 0.5);
+}
+
+// Interpolates every set bit of a row mask and runs the row through the pixel pipeline, bit 0 is the pixel at x0
+static void
+gs_raster_shade_span (const GS_Raster_Triangle *tri, s32 x0, s32 y, u32 mask, GS_Raster_Stats *stats)
+{
+   u32 depth[GS_RASTER_TILE_SIZE];
+   u32 pixels[GS_RASTER_TILE_SIZE];
+
+   f64 z = tri->z.origin + tri->z.dx * x0 + tri->z.dy * y;
+   f64 color[4];
+   for (u32 i = 0; i < 4; ++i)
+      color[i] = tri->color[i].origin + tri->color[i].dx * x0 + tri->color[i].dy * y;
+
+   for (u32 bits = mask; bits; bits &= bits - 1)
+   {
+      u32 i    = std::countr_zero(bits);
+      depth[i] = gs_raster_clamp(z + tri->z.dx * i, 4294967295.0);
+
+      if (tri->gouraud)
+      {
+         pixels[i] = pack_RGBA(gs_raster_clamp(color[0] + tri->color[0].dx * i, 255),
+                               gs_raster_clamp(color[1] + tri->color[1].dx * i, 255),
+                               gs_raster_clamp(color[2] + tri->color[2].dx * i, 255),
+                               gs_raster_clamp(color[3] + tri->color[3].dx * i, 255));
+      }
+      else
+      {
+         pixels[i] = tri->flat_color;
+      }
+   }
+
+   tri->pixel.span(&tri->pixel.context, x0, y, mask, depth, pixels);
+   stats->pixels += std::popcount(mask);
+}
+
+/*******************************************
+ * Tile Walk
+*******************************************/
+// True when the rectangle is entirely outside one of the edges
+static bool
+gs_raster_rect_outside (const GS_Raster_Triangle *tri, const GS_Raster_Rect *rect)
+{
+   for (u32 i = 0; i < 3; ++i)
+   {
+      const GS_Raster_Edge *edge = &tri->edges[i];
+      s64 origin  = gs_raster_edge_at(edge, rect->min_x, rect->min_y);
+      s64 dx      = (s64)edge->a * GS_RASTER_SUBPIXEL * (rect->max_x - rect->min_x);
+      s64 dy      = (s64)edge->b * GS_RASTER_SUBPIXEL * (rect->max_y - rect->min_y);
+
+      if (origin + std::max<s64>(dx, 0) + std::max<s64>(dy, 0) < 0) return true;
+   }
+
+   return false;
+}
+
+static void
+gs_raster_tile (const GS_Raster_Triangle *tri, const GS_Raster_Rect *clip, s32 tx, s32 ty, GS_Raster_Stats *stats)
+{
+   const s32 last = GS_RASTER_TILE_SIZE - 1;
+
+   // Corners of the tile give the smallest and largest value of each edge over it
+   u32 crossing[3];
+   u32 crossing_count = 0;
+   for (u32 i = 0; i < 3; ++i)
+   {
+      const GS_Raster_Edge *edge = &tri->edges[i];
+      s64 origin  = gs_raster_edge_at(edge, tx, ty);
+      s64 dx      = (s64)edge->a * GS_RASTER_SUBPIXEL * last;
+      s64 dy      = (s64)edge->b * GS_RASTER_SUBPIXEL * last;
+      s64 min     = origin + std::min<s64>(dx, 0) + std::min<s64>(dy, 0);
+      s64 max     = origin + std::max<s64>(dx, 0) + std::max<s64>(dy, 0);
+
+      if (max < 0)
+      {
+         stats->tiles_rejected++;
+         return;
+      }
+
+      if (min < 0) crossing[crossing_count++] = i;
+   }
+
+   u8 rows[GS_RASTER_TILE_SIZE];
+   if (crossing_count)
+   {
+      stats->tiles_partial++;
+      gs_raster_coverage(tri, crossing, crossing_count, tx, ty, rows);
+   }
+   else
+   {
+      stats->tiles_covered++;
+      memset(rows, 0xFF, sizeof(rows));
+   }
+
+   // Tiles on the border of the clip rectangle are cut down to it
+   s32 first_x    = std::max(clip->min_x, tx) - tx;
+   s32 last_x     = std::min(clip->max_x, tx + last) - tx;
+   s32 first_y    = std::max(clip->min_y, ty) - ty;
+   s32 last_y     = std::min(clip->max_y, ty + last) - ty;
+   u32 columns    = ((1u << (last_x + 1)) - 1) & ~((1u << first_x) - 1);
+
+   for (s32 row = first_y; row <= last_y; ++row)
+   {
+      u32 mask = rows[row] & columns;
+      if (mask) gs_raster_shade_span(tri, tx, ty + row, mask, stats);
+   }
+}
+
+// Draws the part of the triangle inside area, which has to start on a tile boundary
+static void
+gs_raster_draw (const GS_Raster_Triangle *tri, const GS_Raster_Rect *area, GS_Raster_Stats *stats)
+{
+   GS_Raster_Rect clip;
+   clip.min_x = std::max(tri->bounds.min_x, area->min_x);
+   clip.min_y = std::max(tri->bounds.min_y, area->min_y);
+   clip.max_x = std::min(tri->bounds.max_x, area->max_x);
+   clip.max_y = std::min(tri->bounds.max_y, area->max_y);
+   if (clip.min_x > clip.max_x || clip.min_y > clip.max_y) return;
+
+   s32 first_tile_x = clip.min_x & ~(GS_RASTER_TILE_SIZE - 1);
+   s32 first_tile_y = clip.min_y & ~(GS_RASTER_TILE_SIZE - 1);
+   for (s32 ty = first_tile_y; ty <= clip.max_y; ty += GS_RASTER_TILE_SIZE)
+   {
+      for (s32 tx = first_tile_x; tx <= clip.max_x; tx += GS_RASTER_TILE_SIZE)
+         gs_raster_tile(tri, &clip, tx, ty, stats);
+   }
+}
+
+/*******************************************
+ * Bins and Workers
+*******************************************/
+static inline GS_Raster_Rect
+gs_raster_bin_rect (u32 bin)
+{
+   GS_Raster_Rect rect;
+   rect.min_x = (bin % GS_RASTER_BINS_PER_ROW) << GS_RASTER_BIN_SHIFT;
+   rect.min_y = (bin / GS_RASTER_BINS_PER_ROW) << GS_RASTER_BIN_SHIFT;
+   rect.max_x = rect.min_x + GS_RASTER_BIN_SIZE - 1;
+   rect.max_y = rect.min_y + GS_RASTER_BIN_SIZE - 1;
+   return rect;
+}
+
+// Takes bins off the batch until there are none left, every triangle of a bin is drawn by the same thread
+static void
+gs_raster_work (u32 worker)
+{
+   GS_Raster_Binner *binner   = &gs_raster_binner;
+   GS_Raster_Stats *stats     = &binner->workers[worker].stats;
+   u32 bin_count              = (u32)binner->active_bins.size();
+
+   for (;;)
+   {
+      u32 index = binner->next_bin.fetch_add(1, std::memory_order_relaxed);
+      if (index >= bin_count) return;
+
+      u32 bin              = binner->active_bins[index];
+      GS_Raster_Rect rect  = gs_raster_bin_rect(bin);
+      for (u32 triangle : binner->bins[bin])
+         gs_raster_draw(&binner->triangles[triangle], &rect, stats);
+   }
+}
+
+static void
+gs_raster_worker_main (u32 worker)
+{
+   GS_Raster_Binner *binner   = &gs_raster_binner;
+   u32 generation             = 0;
+
+   for (;;)
+   {
+      binner->generation.wait(generation, std::memory_order_acquire);
+      generation = binner->generation.load(std::memory_order_acquire);
+      if (binner->exit.load()) return;
+
+      gs_raster_work(worker);
+
+      if (binner->busy.fetch_sub(1, std::memory_order_acq_rel) == 1)
+         binner->busy.notify_one();
+   }
+}
+
+// Draws everything that was binned so far, returns once VRAM is up to date
+void
+gs_raster_flush ()
+{
+   GS_Raster_Binner *binner = &gs_raster_binner;
+   if (binner->triangles.empty()) return;
+
+   binner->workers[0].stats.flushes++;
+   binner->next_bin.store(0, std::memory_order_relaxed);
+
+   // Nothing to share when there is a single bin
+   bool helpers = binner->thread_count > 1 && binner->active_bins.size() > 1 && !binner->aliased;
+   if (helpers)
+   {
+      binner->busy.store(binner->thread_count - 1);
+      binner->generation.fetch_add(1, std::memory_order_release);
+      binner->generation.notify_all();
+   }
+
+   if (binner->aliased)
+   {
+      // Bins can share VRAM words, so the triangles are drawn one after the other like without binning
+      GS_Raster_Rect window = { 0, 0, GS_RASTER_MAX_COORD, GS_RASTER_MAX_COORD };
+      for (const GS_Raster_Triangle &tri : binner->triangles)
+         gs_raster_draw(&tri, &window, &binner->workers[0].stats);
+
+      binner->workers[0].stats.aliased_flushes++;
+   }
+   else
+   {
+      gs_raster_work(0);
+   }
+
+   if (helpers)
+   {
+      u32 busy;
+      while ((busy = binner->busy.load(std::memory_order_acquire)) != 0)
+         binner->busy.wait(busy, std::memory_order_acquire);
+   }
+
+   for (u16 bin : binner->active_bins)
+      binner->bins[bin].clear();
+
+   binner->active_bins.clear();
+   binner->triangles.clear();
+   binner->aliased = false;
+}
+
+// threads counts the GS thread, 0 picks one per core that is not already busy running the EE, IOP or GS
+void
+gs_raster_start (u32 threads)
+{
+   GS_Raster_Binner *binner = &gs_raster_binner;
+
+   if (!threads)
+   {
+      u32 cores   = std::thread::hardware_concurrency();
+      threads     = cores > 3 ? cores - 3 : 1;
+   }
+
+   binner->thread_count = std::clamp<u32>(threads, 1, GS_RASTER_MAX_THREADS);
+   binner->triangles.reserve(GS_RASTER_BATCH);
+   binner->generation.store(0);
+   binner->busy.store(0);
+   binner->exit.store(false);
+
+   for (u32 i = 0; i < GS_RASTER_MAX_THREADS; ++i)
+      binner->workers[i].stats = {};
+
+   for (u32 i = 1; i < binner->thread_count; ++i)
+      binner->workers[i].thread = std::thread(gs_raster_worker_main, i);
+
+   syslog("GS rasterizer running on {:d} threads\n", binner->thread_count);
+}
+
+void
+gs_raster_stop ()
+{
+   GS_Raster_Binner *binner = &gs_raster_binner;
+   gs_raster_flush();
+
+   binner->exit.store(true);
+   binner->generation.fetch_add(1);
+   binner->generation.notify_all();
+
+   for (u32 i = 1; i < binner->thread_count; ++i)
+      binner->workers[i].thread.join();
+
+   binner->thread_count = 1;
+}
+
+/*******************************************
+ * Triangle Setup and Binning
+*******************************************/
+/*
+   Pixels in different bins can only end up in the same VRAM word when the buffers wrap: X past the
+   buffer width runs into the next row of pages, the bottom of VRAM runs into the top, and a Z buffer
+   that shares pages with the frame buffer puts the Z of one pixel on the color of another. Every buffer
+   is measured in the pages of its own format, 64x32 for the 32 bit formats and 64x64 for the 16 bit ones.
+*/
+static bool
+gs_raster_pages (const GS_Memory_Format *format, u32 base, u32 width, const GS_Raster_Rect *bounds, u32 *first, u32 *last)
+{
+   u32 pages_per_row = width >> format->page_width;
+   *first   = base / GS_PAGE_WORDS + (bounds->min_y >> format->page_height) * pages_per_row + (bounds->min_x >> format->page_width);
+   *last    = base / GS_PAGE_WORDS + (bounds->max_y >> format->page_height) * pages_per_row + (bounds->max_x >> format->page_width);
+   return *last >= GS_VRAM_WORDS / GS_PAGE_WORDS;
+}
+
+static bool
+gs_raster_aliased (const GS_Raster_Triangle *tri)
+{
+   const GS_Pixel_Context *context  = &tri->pixel.context;
+   const GS_Raster_Rect *bounds     = &tri->bounds;
+   if ((u32)bounds->max_x >= context->width) return true;
+
+   u32 frame_first, frame_last;
+   if (gs_raster_pages(context->frame_format, context->frame_base, context->width, bounds, &frame_first, &frame_last)) return true;
+
+   // Z is only touched when it is tested or written
+   u32 ztst = (tri->pixel.key >> 5) & 0x3;
+   u32 zmsk = (tri->pixel.key >> 7) & 0x1;
+   if (ztst == ZTST_ALWAYS && zmsk) return false;
+
+   u32 z_first, z_last;
+   if (gs_raster_pages(context->z_format, context->z_base, context->width, bounds, &z_first, &z_last)) return true;
+
+   return z_first <= frame_last && frame_first <= z_last;
+}
+
+void
+gs_raster_triangle (const Vertex *vertices)
+{
+   // @@Incomplete: Only using context 1 for rendering for now
+   XYOFFSET *offset  = &gs.xyoffset_1;
+   SCISSOR *scissor  = &gs.scissor_1;
+
+   const Vertex *v[3] = { &vertices[0], &vertices[1], &vertices[2] };
+   V2I pos[3];
+   for (u32 i = 0; i < 3; ++i)
+      pos[i] = v2i(v[i]->pos.x - offset->x, v[i]->pos.y - offset->y);
+
+   s64 det = (s64)(pos[1].x - pos[0].x) * (pos[2].y - pos[0].y) - (s64)(pos[1].y - pos[0].y) * (pos[2].x - pos[0].x);
+   if (det == 0) return;
+
+   // The GS does not cull, both windings are turned into the one the edge functions expect
+   if (det < 0)
+   {
+      std::swap(pos[1], pos[2]);
+      std::swap(v[1], v[2]);
+      det = -det;
+   }
+
+   GS_Raster_Triangle tri;
+   tri.edges[0] = gs_raster_make_edge(pos[0], pos[1]);
+   tri.edges[1] = gs_raster_make_edge(pos[1], pos[2]);
+   tri.edges[2] = gs_raster_make_edge(pos[2], pos[0]);
+
+   // Pixels are sampled at their integer coordinates, so the box rounds the 12.4 extents inwards
+   GS_Raster_Rect *bounds = &tri.bounds;
+   bounds->min_x = (MIN3(pos[0].x, pos[1].x, pos[2].x) + GS_RASTER_SUBPIXEL - 1) >> 4;
+   bounds->min_y = (MIN3(pos[0].y, pos[1].y, pos[2].y) + GS_RASTER_SUBPIXEL - 1) >> 4;
+   bounds->max_x = MAX3(pos[0].x, pos[1].x, pos[2].x) >> 4;
+   bounds->max_y = MAX3(pos[0].y, pos[1].y, pos[2].y) >> 4;
+
+   bounds->min_x = std::max<s32>(bounds->min_x, scissor->min_x);
+   bounds->min_y = std::max<s32>(bounds->min_y, scissor->min_y);
+   bounds->max_x = std::min<s32>(std::min<s32>(bounds->max_x, scissor->max_x), GS_RASTER_MAX_COORD);
+   bounds->max_y = std::min<s32>(std::min<s32>(bounds->max_y, scissor->max_y), GS_RASTER_MAX_COORD);
+   if (bounds->min_x > bounds->max_x || bounds->min_y > bounds->max_y) return;
+
+   // Flat shading takes the color of the last vertex sent
+   tri.pixel      = *gs_pixel_select();
+   tri.gouraud    = gs.prim.shading_method;
+   tri.flat_color = pack_RGBA(vertices[2].col.r, vertices[2].col.g, vertices[2].col.b, vertices[2].col.a);
+
+   tri.z          = gs_raster_make_plane(pos, v[0]->pos.z, v[1]->pos.z, v[2]->pos.z, (f64)det);
+   tri.color[0]   = gs_raster_make_plane(pos, v[0]->col.r, v[1]->col.r, v[2]->col.r, (f64)det);
+   tri.color[1]   = gs_raster_make_plane(pos, v[0]->col.g, v[1]->col.g, v[2]->col.g, (f64)det);
+   tri.color[2]   = gs_raster_make_plane(pos, v[0]->col.b, v[1]->col.b, v[2]->col.b, (f64)det);
+   tri.color[3]   = gs_raster_make_plane(pos, v[0]->col.a, v[1]->col.a, v[2]->col.a, (f64)det);
+
+   GS_Raster_Binner *binner   = &gs_raster_binner;
+   u32 index                  = (u32)binner->triangles.size();
+   binner->triangles.push_back(tri);
+   binner->workers[0].stats.triangles++;
+   binner->aliased |= gs_raster_aliased(&tri);
+
+   // Bins the triangle does not reach are left out, big triangles only cover part of their box
+   u32 first_bin_x = bounds->min_x >> GS_RASTER_BIN_SHIFT;
+   u32 first_bin_y = bounds->min_y >> GS_RASTER_BIN_SHIFT;
+   u32 last_bin_x  = bounds->max_x >> GS_RASTER_BIN_SHIFT;
+   u32 last_bin_y  = bounds->max_y >> GS_RASTER_BIN_SHIFT;
+   bool single_bin = first_bin_x == last_bin_x && first_bin_y == last_bin_y;
+
+   for (u32 bin_y = first_bin_y; bin_y <= last_bin_y; ++bin_y)
+   {
+      for (u32 bin_x = first_bin_x; bin_x <= last_bin_x; ++bin_x)
+      {
+         u32 bin              = bin_x + bin_y * GS_RASTER_BINS_PER_ROW;
+         GS_Raster_Rect rect  = gs_raster_bin_rect(bin);
+         if (!single_bin && gs_raster_rect_outside(&tri, &rect)) continue;
+
+         if (binner->bins[bin].empty()) binner->active_bins.push_back((u16)bin);
+         binner->bins[bin].push_back(index);
+      }
+   }
+
+   if (binner->triangles.size() == GS_RASTER_BATCH)
+      gs_raster_flush();
+}
+
+GS_Raster_Stats
+gs_raster_get_stats ()
+{
+   GS_Raster_Stats total = {};
+   for (u32 i = 0; i < GS_RASTER_MAX_THREADS; ++i)
+   {
+      GS_Raster_Stats *stats = &gs_raster_binner.workers[i].stats;
+      total.triangles       += stats->triangles;
+      total.flushes         += stats->flushes;
+      total.tiles_rejected  += stats->tiles_rejected;
+      total.tiles_covered   += stats->tiles_covered;
+      total.tiles_partial   += stats->tiles_partial;
+      total.pixels          += stats->pixels;
+      total.aliased_flushes += stats->aliased_flushes;
+   }
+
+   return total;
+}
@@ -0,0 +1,133 @@
+#ifndef GS_RASTER_H
+#define GS_RASTER_H
+
+/*
+   Software Triangle Rasterizer
+
+   Triangles are rasterized with half-space edge functions in the GS 12.4 fixed point window coordinates,
+   pixels are sampled at their integer coordinates. The bounding box, clipped to the scissor, is walked in
+   8x8 tiles. Each tile is checked against the three edges at its corners first: a tile outside any edge
+   is skipped, a tile inside all of them is covered completely without looking at a single pixel. Only the
+   tiles an edge runs through get per pixel coverage, a whole row of 8 pixels at a time with SSE2 or AVX2,
+   and only against the edges that actually cross them.
+
+   The coverage of a tile is a mask of 8 bits per row, the span stage interpolates Z and color for the
+   set bits and hands the row to the pixel pipeline picked for the triangle. Shared edges follow the
+   top-left fill rule so neighbouring triangles never draw a pixel twice or leave a gap.
+
+   Triangles are not drawn right away. After setup they are binned into 32x32 pixel bins and drawn a
+   batch at a time by gs_raster_flush(). The GS thread and a pool of workers take whole bins off the
+   batch, so a bin belongs to a single thread and gets its triangles in the order they were sent. Every
+   pixel sees the same writes in the same order as when drawing one triangle at a time, the result does
+   not depend on the thread count. --gs-raster-threads 1 draws everything on the GS thread.
+
+   That only holds while every VRAM word belongs to a single bin. A batch where the buffers wrap or the
+   Z buffer shares pages with the frame buffer is drawn on the GS thread a triangle at a time instead.
+
+   The batch has to be flushed before anything the pixel pipeline reads changes or anybody looks at
+   VRAM: TEX0, SCISSOR, TEST, FRAME and ZBUF writes, image transfers and gs_sync().
+
+   @Incomplete: No texture mapping, fogging or alpha blending yet, and only context 1.
+*/
+
+#if defined(__AVX2__)
+#define GS_RASTER_AVX2 1
+#include <immintrin.h>
+#else
+#define GS_RASTER_AVX2 0
+#endif
+
+#if !GS_RASTER_AVX2 && (defined(__SSE2__) || defined(_M_X64))
+#define GS_RASTER_SSE2 1
+#include <emmintrin.h>
+#else
+#define GS_RASTER_SSE2 0
+#endif
+
+#define GS_RASTER_TILE_SIZE   8
+#define GS_RASTER_SUBPIXEL    16    // 12.4 units in a pixel
+#define GS_RASTER_MAX_COORD   2047  // Largest pixel coordinate inside the GS drawing window
+
+#define GS_RASTER_BIN_SHIFT      5
+#define GS_RASTER_BIN_SIZE       (1 << GS_RASTER_BIN_SHIFT)
+#define GS_RASTER_BINS_PER_ROW   ((GS_RASTER_MAX_COORD + 1) >> GS_RASTER_BIN_SHIFT)
+#define GS_RASTER_BIN_COUNT      (GS_RASTER_BINS_PER_ROW * GS_RASTER_BINS_PER_ROW)
+#define GS_RASTER_BATCH          4096  // Triangles binned before a flush is forced
+#define GS_RASTER_MAX_THREADS    64    // GS thread included
+
+static_assert(TRACE_MAX_THREADS >= GS_RASTER_MAX_THREADS + 2, "Every raster worker needs a trace ring next to the EE and IOP");
+
+// E(x, y) = a * x + b * y + c with x and y in 12.4, a pixel is inside when E is not negative
+typedef struct _GS_Raster_Edge_ {
+   s32 a;
+   s32 b;
+   s64 c;
+} GS_Raster_Edge;
+
+// Value of an interpolated attribute at pixel (x, y) is origin + x * dx + y * dy
+typedef struct _GS_Raster_Plane_ {
+   f64 origin;
+   f64 dx;
+   f64 dy;
+} GS_Raster_Plane;
+
+// Pixels, inclusive
+typedef struct _GS_Raster_Rect_ {
+   s32 min_x;
+   s32 min_y;
+   s32 max_x;
+   s32 max_y;
+} GS_Raster_Rect;
+
+typedef struct _GS_Raster_Triangle_ {
+   GS_Raster_Edge    edges[3];
+   GS_Raster_Rect    bounds;  // Clipped to the scissor
+
+   GS_Pixel_Pipeline pixel;   // Picked when the triangle is set up, see gs_pixel.h
+   bool              gouraud;
+   u32               flat_color;
+   GS_Raster_Plane   z;
+   GS_Raster_Plane   color[4];
+} GS_Raster_Triangle;
+
+typedef struct _GS_Raster_Stats_ {
+   u64 triangles;
+   u64 flushes;
+   u64 tiles_rejected;
+   u64 tiles_covered;
+   u64 tiles_partial;
+   u64 pixels;
+   u64 aliased_flushes;  // Batches drawn on the GS thread alone, see gs_raster_aliased()
+} GS_Raster_Stats;
+
+typedef struct _GS_Raster_Worker_ {
+   alignas(64) GS_Raster_Stats   stats;   // Only written by the thread the worker belongs to
+   std::thread                   thread;
+} GS_Raster_Worker;
+
+typedef struct _GS_Raster_Binner_ {
+   // Only touched by the GS thread outside of a flush
+   std::vector<GS_Raster_Triangle>  triangles;
+   std::vector<u32>                 bins[GS_RASTER_BIN_COUNT];   // Indices into triangles, in order
+   std::vector<u16>                 active_bins;
+   u32                              thread_count;
+   bool                             aliased;       // Some bins share VRAM words, the batch can not be split
+
+   // Flush handshake
+   alignas(64) std::atomic<u32>     generation;
+   std::atomic<u32>                 next_bin;
+   std::atomic<u32>                 busy;
+   std::atomic<bool>                exit;
+
+   alignas(64) GS_Raster_Worker     workers[GS_RASTER_MAX_THREADS];   // workers[0] is the GS thread
+} GS_Raster_Binner;
+
+static GS_Raster_Binner gs_raster_binner;
+
+void              gs_raster_start(u32 threads);
+void              gs_raster_stop();
+void              gs_raster_flush();
+void              gs_raster_triangle(const Vertex *vertices);
+GS_Raster_Stats   gs_raster_get_stats();
+
+#endif
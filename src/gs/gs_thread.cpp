@@ -0,0 +1,263 @@
+/*
+ * Copyright 2023 Xaviar Roach
+ * SPDX-License-Identifier: MIT
+ */
+
+/*******************************************
+ * GS Thread
+*******************************************/
+static void
+gs_execute (GS_Command *command)
+{
+   switch (command->type)
+   {
+      case GS_COMMAND_WRITE:           gs_write_internal(command->address, command->value);      break;
+      case GS_COMMAND_SET_Q:           gs_set_q(std::bit_cast<f32>((u32)command->value));        break;
+      case GS_COMMAND_HWREG_SOFTWARE:  gs_write_hwreg_software(command->value);                  break;
+      case GS_COMMAND_HWREG_HARDWARE:  gs_write_hwreg_hardware(command->value);                  break;
+      case GS_COMMAND_RASTER_FLUSH:    gs_raster_flush();                                        break;
+      case GS_COMMAND_IMAGE:
+      {
+         u32 start   = (u32)command->value;
+         u32 size    = (u32)(command->value >> 32);
+         gs_write_image(&gs_ring.image[start & (GS_IMAGE_RING_SIZE - 1)], size);
+         gs_ring.image_tail.store(start + size, std::memory_order_release);
+      } break;
+      case GS_COMMAND_EXIT:                                                                      break;
+   }
+}
+
+/*
+   @@Note: sleeping and head are both sequentially consistent so either the EE sees the GS thread is
+   going to sleep and wakes it up, or the GS thread sees the new head before it sleeps.
+*/
+static void
+gs_thread_wait (u32 head)
+{
+   for (u32 spin = 0; spin < GS_THREAD_SPIN; ++spin)
+   {
+      if (gs_ring.head.load(std::memory_order_acquire) != head) return;
+      std::this_thread::yield();
+   }
+
+   trace_flush();
+   gs_ring.sleeping.store(true);
+   if (gs_ring.head.load() == head)
+   {
+      gs_ring.sleeps++;
+      gs_ring.head.wait(head);
+   }
+   gs_ring.sleeping.store(false);
+}
+
+static void
+gs_thread_main ()
+{
+   u32 tail = gs_ring.tail.load(std::memory_order_relaxed);
+   for (;;)
+   {
+      u32 head = gs_ring.head.load(std::memory_order_acquire);
+      if (head == tail)
+      {
+         gs_thread_wait(head);
+         continue;
+      }
+
+      while (tail != head)
+      {
+         GS_Command *command = &gs_ring.commands[tail & (GS_RING_SIZE - 1)];
+         gs_execute(command);
+         tail++;
+
+         if (command->type == GS_COMMAND_EXIT)
+         {
+            trace_flush();
+            gs_ring.tail.store(tail, std::memory_order_release);
+            return;
+         }
+
+         if ((tail & (GS_RING_PUBLISH - 1)) == 0)
+            gs_ring.tail.store(tail, std::memory_order_release);
+      }
+
+      gs_ring.tail.store(tail, std::memory_order_release);
+   }
+}
+
+/*******************************************
+ * EE Side
+*******************************************/
+// Hands whatever was pushed so far to the GS thread
+void
+gs_flush ()
+{
+   if (gs_ring.head.load(std::memory_order_relaxed) == gs_ring.pending_head) return;
+
+   gs_ring.head.store(gs_ring.pending_head);
+   if (gs_ring.sleeping.load())
+      gs_ring.head.notify_one();
+}
+
+static void
+gs_push (GS_Command_Type type, u8 address, u64 value)
+{
+   GS_Command command = { .type = type, .address = address, .value = value };
+   if (!gs_ring.threaded)
+   {
+      gs_execute(&command);
+      return;
+   }
+
+   u32 head = gs_ring.pending_head;
+   if (head - gs_ring.cached_tail == GS_RING_SIZE)
+   {
+      gs_flush();
+      gs_ring.cached_tail = gs_ring.tail.load(std::memory_order_acquire);
+      while (head - gs_ring.cached_tail == GS_RING_SIZE)
+      {
+         gs_ring.stalls++;
+         std::this_thread::yield();
+         gs_ring.cached_tail = gs_ring.tail.load(std::memory_order_acquire);
+      }
+   }
+
+   gs_ring.commands[head & (GS_RING_SIZE - 1)] = command;
+   gs_ring.pending_head = head + 1;
+   gs_ring.raster_dirty = type != GS_COMMAND_RASTER_FLUSH;
+   gs_ring.pushed++;
+
+   // Handing over every command would keep the cache line with head bouncing between the two threads
+   if ((gs_ring.pending_head & (GS_RING_PUBLISH - 1)) == 0 || type == GS_COMMAND_EXIT)
+      gs_flush();
+}
+
+// Waits until the GS thread ran everything that was pushed so far
+void
+gs_sync ()
+{
+   if (!gs_ring.threaded)
+   {
+      gs_raster_flush();
+      return;
+   }
+
+   if (gs_ring.raster_dirty)
+      gs_push(GS_COMMAND_RASTER_FLUSH, 0, 0);
+
+   gs_flush();
+
+   u32 head = gs_ring.pending_head;
+   if (gs_ring.tail.load(std::memory_order_acquire) == head) return;
+
+   gs_ring.syncs++;
+   while (gs_ring.tail.load(std::memory_order_acquire) != head)
+      std::this_thread::yield();
+
+   gs_ring.cached_tail = head;
+}
+
+void
+gs_queue_write (u8 address, u64 value)
+{
+   gs_push(GS_COMMAND_WRITE, address, value);
+}
+
+void
+gs_queue_q (f32 value)
+{
+   gs_push(GS_COMMAND_SET_Q, 0, std::bit_cast<u32>(value));
+}
+
+void
+gs_queue_hwreg_software (u64 data)
+{
+   gs_push(GS_COMMAND_HWREG_SOFTWARE, 0, data);
+}
+
+void
+gs_queue_hwreg_hardware (u64 data)
+{
+   gs_push(GS_COMMAND_HWREG_HARDWARE, 0, data);
+}
+
+/*
+   Runs never wrap around the end of the image ring, a run that does not fit in front of it starts over
+   at the beginning and the bytes it skips are freed along with it.
+*/
+void
+gs_queue_image (const u8 *data, u32 size)
+{
+   if (!gs_ring.threaded)
+   {
+      gs_write_image(data, size);
+      return;
+   }
+
+   while (size)
+   {
+      u32 chunk   = std::min<u32>(size, GS_IMAGE_CHUNK);
+      u32 start   = gs_ring.image_head;
+      u32 offset  = start & (GS_IMAGE_RING_SIZE - 1);
+      if (offset + chunk > GS_IMAGE_RING_SIZE)
+         start += GS_IMAGE_RING_SIZE - offset;
+
+      if (start + chunk - gs_ring.image_cached_tail > GS_IMAGE_RING_SIZE)
+      {
+         gs_flush();
+         gs_ring.image_cached_tail = gs_ring.image_tail.load(std::memory_order_acquire);
+         while (start + chunk - gs_ring.image_cached_tail > GS_IMAGE_RING_SIZE)
+         {
+            gs_ring.stalls++;
+            std::this_thread::yield();
+            gs_ring.image_cached_tail = gs_ring.image_tail.load(std::memory_order_acquire);
+         }
+      }
+
+      memcpy(&gs_ring.image[start & (GS_IMAGE_RING_SIZE - 1)], data, chunk);
+      gs_ring.image_head   = start + chunk;
+      gs_ring.image_bytes += chunk;
+      gs_push(GS_COMMAND_IMAGE, 0, ((u64)chunk << 32) | start);
+
+      data += chunk;
+      size -= chunk;
+   }
+}
+
+void
+gs_thread_start (bool threaded)
+{
+   gs_ring.head.store(0);
+   gs_ring.tail.store(0);
+   gs_ring.image_tail.store(0);
+   gs_ring.sleeping.store(false);
+   gs_ring.pending_head      = 0;
+   gs_ring.cached_tail       = 0;
+   gs_ring.raster_dirty      = false;
+   gs_ring.pushed            = 0;
+   gs_ring.syncs             = 0;
+   gs_ring.stalls            = 0;
+   gs_ring.sleeps            = 0;
+   gs_ring.image_head        = 0;
+   gs_ring.image_cached_tail = 0;
+   gs_ring.image_bytes       = 0;
+   gs_ring.threaded          = threaded;
+
+   if (threaded)
+   {
+      gs_ring.thread = std::thread(gs_thread_main);
+      syslog("Started GS thread\n");
+   }
+}
+
+void
+gs_thread_stop ()
+{
+   if (!gs_ring.threaded) return;
+
+   gs_push(GS_COMMAND_EXIT, 0, 0);
+   gs_ring.thread.join();
+   gs_ring.threaded = false;
+
+   syslog("Stopped GS thread: {:d} commands, {:d} image bytes, {:d} syncs, {:d} stalls, {:d} sleeps\n",
+          gs_ring.pushed, gs_ring.image_bytes, gs_ring.syncs, gs_ring.stalls, gs_ring.sleeps);
+}
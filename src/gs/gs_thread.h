@@ -0,0 +1,87 @@
+#ifndef GS_THREAD_H
+#define GS_THREAD_H
+
+/*
+   GS Command Ring
+
+   Everything the GIF sends to the GS is recorded into a single producer/single consumer ring instead of
+   being drawn on the spot. The GS thread pops the commands and runs them through gs_write_internal() and
+   the HWREG transfers, so vertex and drawing kicks overlap with the EE. Only the EE side pushes and only
+   the GS thread pops, neither side takes a lock. Commands are handed over GS_RING_PUBLISH at a time and
+   whenever a GIF packet ends.
+
+   IMAGE data does not go through the ring a doubleword at a time. The GIF hands over whole runs of
+   quadwords, they are copied into a second ring of bytes and a single command tells the GS thread where
+   the run is. The source can be RDRAM the EE overwrites as soon as the DMAC is done with it, so the run
+   has to be copied, but one memcpy of a burst is all it costs.
+
+   The privileged registers are still written on the EE side. Anything that looks at what the GS did has
+   to call gs_sync() first, which waits for the ring to drain and for the binned triangles to be drawn:
+   CSR and SIGLBLID reads, GIF FIFO reads for Local => Host transmissions and presenting a frame.
+
+   Run with --no-gs-thread to execute the commands on the EE thread as they are pushed.
+*/
+
+#define GS_RING_SIZE          (1 << 16)   // Has to be a power of two
+#define GS_RING_PUBLISH       256         // Commands handed between the threads at a time
+#define GS_THREAD_SPIN        4096        // Polls before the GS thread goes to sleep on an empty ring
+#define GS_IMAGE_RING_SIZE    (1 << 20)   // Bytes, has to be a power of two
+#define GS_IMAGE_CHUNK        (GS_IMAGE_RING_SIZE / 4)   // Longest run a single command carries
+
+enum GS_Command_Type : u8
+{
+   GS_COMMAND_WRITE           = 0x0, // Internal register write, kicks included
+   GS_COMMAND_SET_Q           = 0x1,
+   GS_COMMAND_HWREG_SOFTWARE  = 0x2,
+   GS_COMMAND_HWREG_HARDWARE  = 0x3,
+   GS_COMMAND_EXIT            = 0x4,
+   GS_COMMAND_RASTER_FLUSH    = 0x5, // Draws the binned triangles, see gs_raster.h
+   GS_COMMAND_IMAGE           = 0x6, // Run of IMAGE data in the image ring, size << 32 | start
+};
+
+typedef struct _GS_Command_ {
+   GS_Command_Type   type;
+   u8                address;
+   u64               value;
+} GS_Command;
+
+typedef struct _GS_Ring_ {
+   // EE side
+   alignas(64) std::atomic<u32>  head;
+   u32                           pending_head;  // Pushed but not handed to the GS thread yet
+   u32                           cached_tail;
+   bool                          raster_dirty;  // Commands were pushed since the last raster flush
+   u64                           pushed;
+   u64                           syncs;
+   u64                           stalls;
+   u32                           image_head;
+   u32                           image_cached_tail;
+   u64                           image_bytes;
+
+   // GS thread side
+   alignas(64) std::atomic<u32>  tail;
+   std::atomic<bool>             sleeping;
+   u64                           sleeps;
+   std::atomic<u32>              image_tail;    // End of the last run written to VRAM
+
+   alignas(64) GS_Command        commands[GS_RING_SIZE];
+   alignas(64) u8                image[GS_IMAGE_RING_SIZE];
+
+   std::thread                   thread;
+   bool                          threaded;
+} GS_Ring;
+
+static GS_Ring gs_ring;
+
+void  gs_thread_start(bool threaded);
+void  gs_thread_stop();
+void  gs_flush();
+void  gs_sync();
+
+void  gs_queue_write(u8 address, u64 value);
+void  gs_queue_q(f32 value);
+void  gs_queue_hwreg_software(u64 data);
+void  gs_queue_hwreg_hardware(u64 data);
+void  gs_queue_image(const u8 *data, u32 size);
+
+#endif
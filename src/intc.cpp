@@ -7,31 +7,29 @@
 
 Intc_Handler intc_handler = {0};
 
+static const MMIO_Handler intc_mmio = { .name = "INTC", .read_32 = intc_read, .write_32 = intc_write };
+
 void
 intc_reset()
 {
 	memset(&intc_handler, 0, sizeof(Intc_Handler));
 	syslog("Resetting Interrupt Controller\n");
+
+	ee_mmio_register(0x1000F000, 0x20, &intc_mmio);
 }
 
-static bool
-trigger_interrupt_int0 ()
+// INT0 is raised while any request is both set in INTC_STAT and unmasked in INTC_MASK
+static void
+update_interrupt_int0 ()
 {
-	bool int0 	= intc_handler.mask & intc_handler.stat;
-	u32 r 		= check_interrupt(int0, true, false);
-	if (r == 0)
-		return 0;
-	else 
-		syslog("[INT0]: Interrupt triggered\n");
-	return 1;
+	ee_set_interrupt_line(EE_INTERRUPT_INT0, (intc_handler.mask & intc_handler.stat) != 0);
 }
 
 void
 request_interrupt (u32 index)
 {
 	intc_handler.stat |= 1 << index;
-	// @Incomplete: Do error handling for this?
-	bool interrupt_triggered = trigger_interrupt_int0();
+	update_interrupt_int0();
 }
 
 u32 
@@ -63,7 +61,7 @@ intc_write (u32 address, u32 value)
 		{
 	        syslog("WRITE: INTC_STAT [{:#x}]\n", value);
 			intc_handler.stat &= (~value & 0x7ff);
-			trigger_interrupt_int0();
+			update_interrupt_int0();
 			return;			
 		}
 
@@ -71,7 +69,7 @@ intc_write (u32 address, u32 value)
 		{
 			syslog("WRITE: INTC_MASK [{:#x}]\n", value);
 			intc_handler.mask ^= (value & 0x7ff);
-			trigger_interrupt_int0();
+			update_interrupt_int0();
 			return;	
 		}
 	}
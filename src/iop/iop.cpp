@@ -1,6 +1,7 @@
 // #include "ps2.h"
 
 R5000_Core iop = {};
+IOP_Execution_Mode iop_execution_mode = IOP_MODE_CACHED_INTERPRETER;
 
 //@@Temporary: This are not permanant
 //u32 IOP_INTC_STAT, IOP_INTC_MASK, IOP_INTC_CTRL;
@@ -115,12 +116,9 @@ enum OPCODES : int {
 	IOP_COP0 = 0x10,
 };
 
-static void
-iop_decode_and_execute (u32 instruction)
+static inline Instruction
+iop_decode (u32 instruction)
 {
-   if (instruction == 0x00000000) return;
-	u32 opcode = instruction >> 26;
-
    Instruction i = {
       .rd          = (u8)((instruction >> 11) & 0x1F),
       .rt          = (u8)((instruction >> 16) & 0x1F),
@@ -133,6 +131,15 @@ iop_decode_and_execute (u32 instruction)
       .sign_offset = (s16)(instruction & 0xFFFF), // No real difference between imm and offset just naming conveince
       .instr_index = (u32)(instruction & 0x3FFFFFF),
    };
+   return i;
+}
+
+// The operands come from iop_decode(), the block cache keeps them around so they are only extracted once
+static void
+iop_execute (u32 instruction, const Instruction &i)
+{
+   if (instruction == 0x00000000) return;
+	u32 opcode = instruction >> 26;
 
 	switch(opcode)
 	{
@@ -149,7 +156,7 @@ iop_decode_and_execute (u32 instruction)
 				case 0x00:
             {
                iop.reg[i.rd] = (u32)((s16)iop.reg[i.rt] << i.sa);
-               intlog("I-SLL source: [{:d}] dest: [{:d}] [{:#x}]\n", rd, rt, i.sa);
+               intlog("I-SLL source: [{:d}] dest: [{:d}] [{:#x}]\n", i.rd, i.rt, i.sa);
             } break;
 
 				case 0x02:
@@ -157,7 +164,7 @@ iop_decode_and_execute (u32 instruction)
                u16 result      = (iop.reg[i.rt] >> i.sa);
                iop.reg[i.rd]   = (s32)result;
 
-               intlog("I-SRL source: [{:d}] dest: [{:d}] [{:#x}]\n", rd, rt, i.sa);
+               intlog("I-SRL source: [{:d}] dest: [{:d}] [{:#x}]\n", i.rd, i.rt, i.sa);
             } break;
 
 				case 0x03:
@@ -165,7 +172,7 @@ iop_decode_and_execute (u32 instruction)
                s16 result      = (iop.reg[i.rt]) >> (s16)i.sa; // ?? cast by s16
                iop.reg[i.rd]   = result;
 
-               intlog("I-SRA source: [{:d}] dest: [{:d}] [{:#x}]\n", rd, rt, i.sa);
+               intlog("I-SRA source: [{:d}] dest: [{:d}] [{:#x}]\n", i.rd, i.rt, i.sa);
             } break;
 
 				case 0x04:
@@ -177,7 +184,7 @@ iop_decode_and_execute (u32 instruction)
 
 				case 0x06:
             {
-               printf("SRLV\n");
+               systrace("SRLV\n");
             } break;
 
 				case 0x07:
@@ -186,7 +193,7 @@ iop_decode_and_execute (u32 instruction)
                auto result     = (s32)(iop.reg[i.rt] >> sa);
                iop.reg[i.rd]   = (s64)result;
 
-               intlog("I-SRAV [{:d}] [{:d}] [{:d}]\n", rd, rt, rs);
+               intlog("I-SRAV [{:d}] [{:d}] [{:d}]\n", i.rd, i.rt, i.rs);
             } break;
 
 				case 0x08:
@@ -206,7 +213,7 @@ iop_decode_and_execute (u32 instruction)
             case 0x10:
             {
                iop.reg[i.rd] = iop.HI;
-               intlog("I-MFHI [{:d}]\n", rd);
+               intlog("I-MFHI [{:d}]\n", i.rd);
             } break;
 
             case 0x11:
@@ -218,7 +225,7 @@ iop_decode_and_execute (u32 instruction)
             case 0x12:
             {
                iop.reg[i.rd] = iop.LO;
-               intlog("I-MFLO[{:d}]\n", rd);
+               intlog("I-MFLO[{:d}]\n", i.rd);
             } break;
 
             case 0x13:
@@ -234,7 +241,7 @@ iop_decode_and_execute (u32 instruction)
                iop.LO = product & 0xFFFFFFFF;
                iop.HI = product >> 32;
 
-               intlog("I-MULT [{:d}] [{:d}]\n", rs, rt);
+               intlog("I-MULT [{:d}] [{:d}]\n", i.rs, i.rt);
             } break;
 
             case 0x19:
@@ -244,7 +251,7 @@ iop_decode_and_execute (u32 instruction)
                iop.LO = product & 0xFFFFFFFF;
                iop.HI = product >> 32;
 
-               intlog("I-MULTU [{:d}] [{:d}]\n", i.rs, rt);
+               intlog("I-MULTU [{:d}] [{:d}]\n", i.rs, i.rt);
             } break;
 
             case 0x1A:
@@ -253,7 +260,7 @@ iop_decode_and_execute (u32 instruction)
                iop.HI = (s32)(iop.reg[i.rs] & iop.reg[i.rt]);
 
                /* @Incomplete: Result is undefined if rt is zero */
-               intlog("I-DIV [{:d}] [{:d}]\n", i.rs, rt);
+               intlog("I-DIV [{:d}] [{:d}]\n", i.rs, i.rt);
             } break;
 
             case 0x1B:
@@ -263,7 +270,7 @@ iop_decode_and_execute (u32 instruction)
                iop.HI = (iop.reg[i.rs] & iop.reg[i.rt]);
 
                /* @Incomplete: Result is undefined if rt is zero */
-               intlog("I-DIVU [{:d}] [{:d}]\n", i.rs, rt);
+               intlog("I-DIVU [{:d}] [{:d}]\n", i.rs, i.rt);
             } break;
 
             case 0x20:
@@ -271,13 +278,13 @@ iop_decode_and_execute (u32 instruction)
                iop.reg[i.rd] = iop.reg[i.rs] + iop.reg[i.rt];
 
                /* @@Incomplete: No overflow detection for now */
-               intlog("I-ADD [{:d}] [{:d}] [{:d}]\n", rd, i.rs, rt);
+               intlog("I-ADD [{:d}] [{:d}] [{:d}]\n", i.rd, i.rs, i.rt);
             } break;
 
             case 0x21:
             {
                iop.reg[i.rd] = iop.reg[i.rs] + iop.reg[i.rt];
-               intlog("I-ADDU [{:d}] [{:d}] [{:d}]\n", rd, i.rs, rt);
+               intlog("I-ADDU [{:d}] [{:d}] [{:d}]\n", i.rd, i.rs, i.rt);
             } break;
 
             case 0x22:
@@ -285,28 +292,28 @@ iop_decode_and_execute (u32 instruction)
                iop.reg[i.rd] = iop.reg[i.rs] - iop.reg[i.rt];
 
                /* @@Incomplete: No overflow detection for now */
-               intlog("I-SUB [{:d}] [{:d}] [{:d}]\n", rd, i.rs, rt);
+               intlog("I-SUB [{:d}] [{:d}] [{:d}]\n", i.rd, i.rs, i.rt);
             } break;
 
             case 0x23:
             {
                iop.reg[i.rd] = iop.reg[i.rs] - iop.reg[i.rt];
 
-               intlog("I-SUBU [{:d}] [{:d}] [{:d}]\n", rd, i.rs, rt);
+               intlog("I-SUBU [{:d}] [{:d}] [{:d}]\n", i.rd, i.rs, i.rt);
             } break;
 
             case 0x24:
             {
                iop.reg[i.rd] = iop.reg[i.rs] & iop.reg[i.rt];
 
-               intlog("I-AND [{:d}] [{:d}] [{:d}] \n", rd, i.rs, rt);
+               intlog("I-AND [{:d}] [{:d}] [{:d}] \n", i.rd, i.rs, i.rt);
             } break;
 
             case 0x25:
             {
                iop.reg[i.rd] = iop.reg[i.rs] | iop.reg[i.rt];
 
-               intlog("I-OR [{:d}] [{:d}] [{:d}]\n", rd, i.rs, rt);
+               intlog("I-OR [{:d}] [{:d}] [{:d}]\n", i.rd, i.rs, i.rt);
             } break;
 
             case 0x26:
@@ -318,7 +325,7 @@ iop_decode_and_execute (u32 instruction)
             case 0x27:
             {
                iop.reg[i.rd] = ~(iop.reg[i.rs] | iop.reg[i.rt]);
-               intlog("I-NOR [{:d}] [{:d}] [{:d}]\n", rd, i.rs, rt);
+               intlog("I-NOR [{:d}] [{:d}] [{:d}]\n", i.rd, i.rs, i.rt);
             } break;
 
             case 0x2A:
@@ -326,7 +333,7 @@ iop_decode_and_execute (u32 instruction)
                auto result = iop.reg[i.rs] < iop.reg[i.rt] ? 1 : 0;
                iop.reg[i.rd] = result;
 
-               intlog("I-SLT [{:d}] [{:d}] [{:d}]\n", rd, i.rs, rt);
+               intlog("I-SLT [{:d}] [{:d}] [{:d}]\n", i.rd, i.rs, i.rt);
             } break;
 
             case 0x2B:
@@ -334,7 +341,7 @@ iop_decode_and_execute (u32 instruction)
                uint32_t result = (iop.reg[i.rs] < iop.reg[i.rt]) ? 1 : 0;
                iop.reg[i.rd] = result;
 
-               intlog("I-SLTU [{:d}] [{:d}] [{:d}]\n", rd, i.rs, rt);
+               intlog("I-SLTU [{:d}] [{:d}] [{:d}]\n", i.rd, i.rs, i.rt);
             } break;
 			}
 		} break;
@@ -474,7 +481,7 @@ iop_decode_and_execute (u32 instruction)
 
       case 0x0A:
       {
-         auto result     = (iop.reg[i.rs] < (s32)i.sign_imm) ? 1 : 0;
+         auto result     = ((s32)iop.reg[i.rs] < (s32)i.sign_imm) ? 1 : 0;
          iop.reg[i.rt]   = result;
 
          intlog("I-SLTI [{:d}] [{:d}], [{:#x}]\n", i.rt, i.rs, i.sign_imm);
@@ -482,7 +489,7 @@ iop_decode_and_execute (u32 instruction)
 
       case 0x0B:
       {
-         u32 result      = (iop.reg[i.rs] < i.sign_imm) ? 1 : 0;
+         u32 result      = (iop.reg[i.rs] < (u32)(s32)i.sign_imm) ? 1 : 0;
          iop.reg[i.rt]   = result;
 
          intlog("I-SLTIU [{:d}] [{:d}] [{:#x}]\n", i.rt, i.rs, i.sign_imm);
@@ -572,14 +579,14 @@ iop_decode_and_execute (u32 instruction)
             assert(1);
          }
          iop.reg[i.rt] = (s64)iop_core_load_32(translate_address(vaddr));
-         intlog("I-LW [{:d}] [{:#x}] [{:d}] \n", rt, i.sign_offset, i.rs;);
+         intlog("I-LW [{:d}] [{:#x}] [{:d}] \n", i.rt, i.sign_offset, i.rs);
       } break;
 
 		case 0x24:
       {
          u32 vaddr       = iop.reg[i.rs] + i.sign_offset;
          iop.reg[i.rt]   = (u64)iop_core_load_8(vaddr);
-         intlog("I-LBU [{:d}] [{:#x}] [{:d}] \n", i.rt, i.sign_offset, i.rs;);
+         intlog("I-LBU [{:d}] [{:#x}] [{:d}] \n", i.rt, i.sign_offset, i.rs);
       } break;
 
 		case 0x26:
@@ -599,7 +606,7 @@ iop_decode_and_execute (u32 instruction)
          u32 result          = ((iop.reg[i.rt] & LWR_MASK[shift]) | (aligned_vaddr << LWR_SHIFT[shift]));
          iop.reg[i.rt]       = result;
 
-         intlog("I-LDR [{:d}] [{:#x}] [{:d}]\n", i.rt, i.sign_offset, i.rs;);
+         intlog("I-LDR [{:d}] [{:#x}] [{:d}]\n", i.rt, i.sign_offset, i.rs);
       } break;
 
 		case 0x28:
@@ -622,7 +629,7 @@ iop_decode_and_execute (u32 instruction)
          }
 
          iop_core_store_16(vaddr, value);
-         intlog("I-SH [{:d}] [{:#x}] [{:d}] \n", i.rt, i.sign_offset, i.rs;);
+         intlog("I-SH [{:d}] [{:#x}] [{:d}] \n", i.rt, i.sign_offset, i.rs);
       } break;
 
       case 0x2A:
@@ -642,7 +649,7 @@ iop_decode_and_execute (u32 instruction)
          u32 result          = ((iop.reg[i.rt] & SWL_MASK[shift]) | (aligned_vaddr << SWL_SHIFT[shift]));
          //iop_core_store_32(aligned_vaddr, aligned_dword);
          iop_core_store_32(aligned_vaddr, result);
-         intlog("I-SWL [{:d}] [{:#x}] [{:d}]\n", i.rt, i.sign_offset, i.rs;);
+         intlog("I-SWL [{:d}] [{:#x}] [{:d}]\n", i.rt, i.sign_offset, i.rs);
       } break;
 
       case 0x2B:
@@ -656,7 +663,7 @@ iop_decode_and_execute (u32 instruction)
          }
 
          iop_core_store_32(vaddr, value);
-         intlog("I-SW [{:d}] [{:#x}] [{:d}] \n", i.rt, i.sign_offset, i.rs;);
+         intlog("I-SW [{:d}] [{:#x}] [{:d}] \n", i.rt, i.sign_offset, i.rs);
       } break;
 
       case 0x2E:
@@ -681,20 +688,42 @@ iop_decode_and_execute (u32 instruction)
 	};
 }
 
+static inline void
+iop_decode_and_execute (u32 instruction)
+{
+   iop_execute(instruction, iop_decode(instruction));
+}
+
+// Steps a single instruction, a delay slot is its own step and jumps to the branch target once it ran
 void
 iop_cycle()
 {
    if (iop.delay_slot > 0) iop.delay_slot -= 1;
-	if (iop.is_branching) {
-		iop.is_branching      = false;
-      iop.next_instruction  = iop_core_load_32(iop.pc);
-      iop_decode_and_execute(iop.next_instruction);
-      iop.pc = iop.branch_pc;
-	}
-	iop.current_instruction = iop_core_load_32(iop.pc);
-	iop.next_instruction 	= iop_core_load_32(iop.pc + 4);
-	iop_decode_and_execute(iop.current_instruction);
-	iop.pc += 4;
+
+   bool in_delay_slot      = iop.is_branching;
+   iop.is_branching        = false;
+   iop.current_instruction = iop_core_load_32(iop.pc);
+   iop_decode_and_execute(iop.current_instruction);
+
+   iop.pc = in_delay_slot ? iop.branch_pc : iop.pc + 4;
+}
+
+// Runs the IOP for a number of IOP cycles, every instruction counts as one cycle for now
+u32
+iop_run (u32 cycles)
+{
+   if (iop_execution_mode == IOP_MODE_CACHED_INTERPRETER)
+   {
+      iop_cached_cycle(cycles);
+   }
+   else
+   {
+      for (u32 i = 0; i < cycles; ++i)
+         iop_cycle();
+   }
+
+   iop.current_cycle += cycles;
+   return cycles;
 }
 
 void
@@ -706,4 +735,6 @@ iop_reset()
 	  .current_cycle = 0,
 	};
    iop.cop0.r[15] = 0x0F;
+
+   iop_cache_flush();
 }
\ No newline at end of file
@@ -86,11 +86,18 @@ typedef struct _R5000Core_ {
    u32 next_instruction;
 } R5000_Core;
   
+// Selectable at runtime like the EE backends, both run exactly the amount of instructions they are given
+enum IOP_Execution_Mode : int {
+   IOP_MODE_INTERPRETER,
+   IOP_MODE_CACHED_INTERPRETER,
+};
+
 // @Temporary @Note: Only using this for EE and IOP loads in the interconnect
 u32 get_iop_pc();
 u32 get_iop_register(u32 r);
 
 void iop_cycle();
+u32  iop_run(u32 cycles);
 void iop_reset();
 
 #define IOP_H
@@ -0,0 +1,233 @@
+/*
+ * Copyright 2023 Xaviar Roach
+ * SPDX-License-Identifier: MIT
+ */
+
+// One per 4KB page of IOP RAM or BIOS that has decoded blocks in it
+typedef struct _IOP_Cache_Page_ {
+   IOP_Cached_Block *blocks[1024];
+} IOP_Cache_Page;
+
+typedef struct _IOP_Block_Cache_ {
+   // IOP RAM pages first, then the BIOS pages
+   IOP_Cache_Page *pages[IOP_CACHE_PAGE_COUNT];
+
+   // Invalidated blocks can still be running, so they are only freed on the next iop_cached_cycle()
+   std::vector<IOP_Cached_Block *> retired;
+
+   bool block_invalidated;
+   IOP_Cache_Stats stats;
+} IOP_Block_Cache;
+
+static IOP_Block_Cache iop_block_cache = {};
+
+/*******************************************
+ * Block Decoding
+*******************************************/
+static inline bool
+iop_is_branch_instruction (u32 instruction)
+{
+   u32 opcode = instruction >> 26;
+   if (opcode == IOP_SPECIAL)
+   {
+      u32 function = instruction & 0x3F;
+      return function == 0x08 || function == 0x09;
+   }
+
+   return opcode >= 0x01 && opcode <= 0x07;
+}
+
+// Page of the cache a physical address belongs to, or -1 when it is neither IOP RAM nor BIOS
+static inline s32
+iop_cache_page_index (u32 physical)
+{
+   if (PSX_RAM.contains(physical)) return physical >> 12;
+   if (BIOS.contains(physical))    return IOP_CACHE_RAM_PAGES + ((physical & 0x3FFFFF) >> 12);
+   return -1;
+}
+
+static inline u32 *
+iop_cache_code_pointer (u32 physical)
+{
+   if (PSX_RAM.contains(physical)) return (u32 *)&_iop_ram_[physical];
+   return (u32 *)&_bios_memory_[physical & 0x3FFFFF];
+}
+
+/*
+   @@Note: Instructions are stepped one at a time with the delay slot as its own step, so a block can
+   stop anywhere and a delay slot that is left over is run by iop_cycle.
+*/
+static IOP_Cached_Block *
+iop_cache_decode_block (u32 physical, s32 index)
+{
+   IOP_Decoded_Instruction decoded[IOP_CACHE_MAX_BLOCK_INSTRUCTIONS];
+   u32 *code = iop_cache_code_pointer(physical);
+   u32 count = 0;
+
+   while (count < IOP_CACHE_MAX_BLOCK_INSTRUCTIONS)
+   {
+      // Blocks never cross a page so a store only has to invalidate the page it hit
+      if (count && ((physical + count * 4) & 0xFFF) == 0) break;
+
+      u32 instruction   = code[count];
+      decoded[count++]  = { .instruction = instruction, .instr = iop_decode(instruction) };
+
+      if (iop_is_branch_instruction(instruction))
+      {
+         bool delay_slot_fits = count < IOP_CACHE_MAX_BLOCK_INSTRUCTIONS && ((physical + count * 4) & 0xFFF) != 0;
+         if (delay_slot_fits)
+         {
+            u32 delay_slot   = code[count];
+            decoded[count++] = { .instruction = delay_slot, .instr = iop_decode(delay_slot) };
+         }
+         break;
+      }
+   }
+
+   IOP_Cached_Block *block = (IOP_Cached_Block *)malloc(sizeof(IOP_Cached_Block) + count * sizeof(IOP_Decoded_Instruction));
+   block->count         = count;
+   block->instructions  = (IOP_Decoded_Instruction *)(block + 1);
+   memcpy(block->instructions, decoded, count * sizeof(IOP_Decoded_Instruction));
+
+   if (index < IOP_CACHE_RAM_PAGES) _iop_code_pages_[index] = 1;
+
+   IOP_Cache_Page **page = &iop_block_cache.pages[index];
+   if (!*page) *page = (IOP_Cache_Page *)calloc(1, sizeof(IOP_Cache_Page));
+   (*page)->blocks[(physical >> 2) & 0x3FF] = block;
+
+   iop_block_cache.stats.blocks_decoded++;
+   iop_block_cache.stats.blocks_alive++;
+   return block;
+}
+
+/*******************************************
+ * Invalidation
+*******************************************/
+static void
+iop_cache_invalidate_page_index (u32 index)
+{
+   IOP_Cache_Page *page = iop_block_cache.pages[index];
+   if (!page) return;
+
+   for (u32 i = 0; i < 1024; ++i)
+   {
+      if (page->blocks[i])
+      {
+         iop_block_cache.retired.push_back(page->blocks[i]);
+         iop_block_cache.stats.blocks_alive--;
+      }
+   }
+
+   free(page);
+   iop_block_cache.pages[index] = NULL;
+}
+
+static void
+iop_cache_free_retired ()
+{
+   for (IOP_Cached_Block *block : iop_block_cache.retired)
+      free(block);
+
+   iop_block_cache.retired.clear();
+}
+
+// Called from the IOP bus when a store hits an IOP RAM page that holds decoded code
+void
+iop_cache_invalidate_page (u32 page)
+{
+   _iop_code_pages_[page] = 0;
+
+   iop_block_cache.block_invalidated = true;
+   iop_block_cache.stats.pages_invalidated++;
+   iop_cache_invalidate_page_index(page);
+}
+
+void
+iop_cache_flush ()
+{
+   for (u32 i = 0; i < IOP_CACHE_PAGE_COUNT; ++i)
+      iop_cache_invalidate_page_index(i);
+
+   memset(_iop_code_pages_, 0, sizeof(_iop_code_pages_));
+}
+
+void
+iop_cache_shutdown ()
+{
+   iop_cache_flush();
+   iop_cache_free_retired();
+
+   iop_block_cache.stats = {};
+}
+
+/*******************************************
+ * Execution
+*******************************************/
+// Same order of operations as iop_cycle, stops after a delay slot or when the budget runs out
+static u32
+iop_cache_run_block (IOP_Cached_Block *block, u32 budget)
+{
+   u32 count    = block->count < budget ? block->count : budget;
+   u32 executed = 0;
+
+   for (u32 i = 0; i < count; ++i)
+   {
+      IOP_Decoded_Instruction *decoded = &block->instructions[i];
+      bool in_delay_slot = iop.is_branching;
+
+      iop.is_branching = false;
+      iop_execute(decoded->instruction, decoded->instr);
+      executed += 1;
+
+      if (in_delay_slot)
+      {
+         iop.pc = iop.branch_pc;
+         break;
+      }
+
+      iop.pc += 4;
+      if (iop_block_cache.block_invalidated && !iop.is_branching) break;
+   }
+
+   return executed;
+}
+
+// Runs exactly budget instructions, pending delay slots and code outside of RAM and BIOS go through iop_cycle
+void
+iop_cached_cycle (u32 budget)
+{
+   iop_cache_free_retired();
+
+   u32 executed = 0;
+   while (executed < budget)
+   {
+      iop_block_cache.block_invalidated = false;
+
+      IOP_Cached_Block *block = NULL;
+      u32 physical            = translate_address(iop.pc);
+      s32 index               = iop_cache_page_index(physical);
+
+      if (!iop.is_branching && index >= 0 && !(physical & 0x3))
+      {
+         IOP_Cache_Page *page = iop_block_cache.pages[index];
+         block = page ? page->blocks[(physical >> 2) & 0x3FF] : NULL;
+         if (!block) block = iop_cache_decode_block(physical, index);
+      }
+
+      if (!block)
+      {
+         iop_cycle();
+         executed += 1;
+         continue;
+      }
+
+      executed += iop_cache_run_block(block, budget - executed);
+      iop_block_cache.stats.block_runs++;
+   }
+}
+
+IOP_Cache_Stats
+iop_cache_get_stats ()
+{
+   return iop_block_cache.stats;
+}
@@ -0,0 +1,51 @@
+/*
+ * Copyright 2023 Xaviar Roach
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef IOP_BLOCK_CACHE_H
+#define IOP_BLOCK_CACHE_H
+
+/*
+   Cached interpreter for the IOP core.
+
+   Works like the EE one in r5900BlockCache.h. Blocks are decoded straight out of IOP RAM or the BIOS
+   and stored by physical pc, so KUSEG, KSEG0 and KSEG1 share them. An IOP store to a RAM page that
+   holds blocks throws the page away.
+
+   @Incomplete: Writes to IOP RAM from the EE side do not invalidate anything yet, they only happen
+   for SIF buffers so far.
+*/
+
+#define IOP_CACHE_MAX_BLOCK_INSTRUCTIONS  64
+#define IOP_CACHE_RAM_PAGES               (MEGABYTES(2) / KILOBYTES(4))
+#define IOP_CACHE_BIOS_PAGES              (MEGABYTES(4) / KILOBYTES(4))
+#define IOP_CACHE_PAGE_COUNT              (IOP_CACHE_RAM_PAGES + IOP_CACHE_BIOS_PAGES)
+
+typedef struct _IOP_Decoded_Instruction_ {
+   u32         instruction;
+   Instruction instr;
+} IOP_Decoded_Instruction;
+
+typedef struct _IOP_Cached_Block_ {
+   u32 count;
+   IOP_Decoded_Instruction *instructions;
+} IOP_Cached_Block;
+
+typedef struct _IOP_Cache_Stats_ {
+   u64 blocks_decoded;
+   u64 block_runs;
+   u64 pages_invalidated;
+   u32 blocks_alive;
+} IOP_Cache_Stats;
+
+// One entry per 4KB page of IOP RAM, set while the page holds decoded blocks
+static u8 _iop_code_pages_[IOP_CACHE_RAM_PAGES];
+
+void              iop_cache_shutdown();
+void              iop_cache_flush();
+void              iop_cache_invalidate_page(u32 page);
+void              iop_cached_cycle(u32 budget);
+IOP_Cache_Stats   iop_cache_get_stats();
+
+#endif
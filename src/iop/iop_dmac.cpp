@@ -9,7 +9,7 @@ iop_dmac_write_32 (u32 address, u32 value)
    {
       default:
       {
-         printf("ERROR: UNRECOGNIZED IOP_DMAC_WRITE: address[%#x]\n", address);
+         errtrace("ERROR: UNRECOGNIZED IOP_DMAC_WRITE: address[{:#x}]\n", address);
       	return;
       } break;
    }
@@ -22,7 +22,7 @@ iop_dmac_read_32 (u32 address)
    {
       default:
       {
-         printf("ERROR: UNRECOGNIZED IOP_DMAC_READ: address[%#x]\n", address);
+         errtrace("ERROR: UNRECOGNIZED IOP_DMAC_READ: address[{:#x}]\n", address);
       	return 0;
       } break;
    }
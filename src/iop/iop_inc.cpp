@@ -1,2 +1,4 @@
 #include "iop.cpp"
-#include "iop_dmac.cpp"
\ No newline at end of file
+#include "iop_dmac.cpp"
+#include "iop_block_cache.cpp"
+#include "iop_thread.cpp"
\ No newline at end of file
@@ -3,5 +3,7 @@
 
 #include "iop.h"
 #include "iop_dmac.h"
+#include "iop_block_cache.h"
+#include "iop_thread.h"
 
 #endif
\ No newline at end of file
@@ -0,0 +1,147 @@
+/*
+ * Copyright 2023 Xaviar Roach
+ * SPDX-License-Identifier: MIT
+ */
+
+/*******************************************
+ * IOP Thread
+*******************************************/
+// Same handshake as the GS thread: either the EE sees the IOP going to sleep or the IOP sees the new target
+static void
+iop_thread_wait (u64 target)
+{
+   for (u32 spin = 0; spin < IOP_THREAD_SPIN; ++spin)
+   {
+      if (iop_sync.target.load(std::memory_order_acquire) != target) return;
+      std::this_thread::yield();
+   }
+
+   trace_flush();
+   iop_sync.sleeping.store(true);
+   if (iop_sync.target.load() == target)
+   {
+      iop_sync.sleeps++;
+      iop_sync.target.wait(target);
+   }
+   iop_sync.sleeping.store(false);
+}
+
+static void
+iop_thread_main ()
+{
+   u64 cycles = iop_sync.cycles.load(std::memory_order_relaxed);
+   for (;;)
+   {
+      u64 target = iop_sync.target.load(std::memory_order_acquire);
+      if (iop_sync.exit.load())
+      {
+         trace_flush();
+         return;
+      }
+
+      if (cycles >= target)
+      {
+         iop_thread_wait(target);
+         continue;
+      }
+
+      // Handing the time back a slice at a time lets a waiting EE go on as early as possible
+      u32 run  = (u32)std::min<u64>(target - cycles, iop_sync.slice);
+      cycles  += iop_run(run);
+      iop_sync.cycles.store(cycles, std::memory_order_release);
+   }
+}
+
+/*******************************************
+ * EE Side
+*******************************************/
+static void
+iop_wait_for (u64 cycles)
+{
+   while (iop_sync.cycles.load(std::memory_order_acquire) < cycles)
+      std::this_thread::yield();
+}
+
+// Most EE cycles the main loop runs before the IOP gets its share
+u64
+iop_ee_slice ()
+{
+   return (u64)iop_sync.slice * IOP_CLOCK_DIVIDER;
+}
+
+void
+iop_advance (u32 ee_cycles)
+{
+   u64 total               = (u64)ee_cycles + iop_sync.ee_remainder;
+   u32 cycles              = (u32)(total / IOP_CLOCK_DIVIDER);
+   iop_sync.ee_remainder   = (u32)(total % IOP_CLOCK_DIVIDER);
+   if (!cycles) return;
+
+   if (iop_sync.mode == IOP_SYNC_INTERLEAVED)
+   {
+      iop_run(cycles);
+      return;
+   }
+
+   // Bounded skew, the IOP may still be working on the previous slice but not on the one before it
+   u64 target = iop_sync.target.load(std::memory_order_relaxed);
+   if (iop_sync.cycles.load(std::memory_order_acquire) + iop_sync.slice < target)
+   {
+      iop_sync.stalls++;
+      iop_wait_for(target - iop_sync.slice);
+   }
+
+   iop_sync.target.store(target + cycles);
+   if (iop_sync.sleeping.load())
+      iop_sync.target.notify_one();
+}
+
+// Waits until the IOP ran all the time it was given, it stays parked until the next call to iop_advance()
+void
+iop_hard_sync ()
+{
+   if (iop_sync.mode != IOP_SYNC_THREADED) return;
+
+   u64 target = iop_sync.target.load(std::memory_order_relaxed);
+   if (iop_sync.cycles.load(std::memory_order_acquire) >= target) return;
+
+   iop_sync.hard_syncs++;
+   iop_wait_for(target);
+}
+
+void
+iop_thread_start (IOP_Sync_Mode mode, u32 slice)
+{
+   iop_sync.mode           = mode;
+   iop_sync.slice          = slice ? slice : IOP_DEFAULT_SLICE;
+   iop_sync.ee_remainder   = 0;
+   iop_sync.hard_syncs     = 0;
+   iop_sync.stalls         = 0;
+   iop_sync.sleeps         = 0;
+   iop_sync.target.store(0);
+   iop_sync.cycles.store(0);
+   iop_sync.exit.store(false);
+   iop_sync.sleeping.store(false);
+
+   if (mode == IOP_SYNC_THREADED)
+   {
+      iop_sync.thread = std::thread(iop_thread_main);
+      syslog("Started IOP thread, slice of {:d} cycles\n", iop_sync.slice);
+   }
+}
+
+void
+iop_thread_stop ()
+{
+   if (iop_sync.mode != IOP_SYNC_THREADED) return;
+
+   // The target has to change for the IOP thread to wake up, it checks exit before running anything
+   iop_sync.exit.store(true);
+   iop_sync.target.fetch_add(1);
+   iop_sync.target.notify_one();
+   iop_sync.thread.join();
+   iop_sync.mode = IOP_SYNC_INTERLEAVED;
+
+   syslog("Stopped IOP thread: {:d} hard syncs, {:d} stalls, {:d} sleeps\n",
+          iop_sync.hard_syncs, iop_sync.stalls, iop_sync.sleeps);
+}
@@ -0,0 +1,57 @@
+#ifndef IOP_THREAD_H
+#define IOP_THREAD_H
+
+/*
+   IOP Synchronization
+
+   The IOP runs at 1/8 of the EE clock. The EE hands it time at the end of every slice of the main loop,
+   slices are capped at iop_sync.slice IOP cycles so the two never drift further apart than that.
+
+   IOP_SYNC_INTERLEAVED runs the IOP on the EE thread right after each EE slice. The result only depends
+   on the slice size, use it when debugging.
+
+   IOP_SYNC_THREADED runs the IOP on its own thread. The IOP never gets ahead of the time the EE granted,
+   and the EE waits at a slice boundary when the IOP is more than a slice behind. SIF register accesses
+   from the EE are hard sync points: the EE waits for the IOP to use up everything it was granted, which
+   leaves the IOP parked until the next slice, so the registers are never touched by both at once. IOP
+   RAM is shared without syncing, the same as on hardware the SIF flags order the transfers.
+*/
+
+#define IOP_CLOCK_DIVIDER     8
+#define IOP_DEFAULT_SLICE     4096     // IOP cycles
+#define IOP_THREAD_SPIN       4096     // Polls before the IOP thread goes to sleep waiting for time
+
+enum IOP_Sync_Mode : u8
+{
+   IOP_SYNC_INTERLEAVED = 0x0,
+   IOP_SYNC_THREADED    = 0x1,
+};
+
+typedef struct _IOP_Sync_ {
+   IOP_Sync_Mode                 mode;
+   u32                           slice;
+   u32                           ee_remainder;   // EE cycles that did not make up a whole IOP cycle yet
+
+   // Written by the EE
+   alignas(64) std::atomic<u64>  target;
+   std::atomic<bool>             exit;
+   u64                           hard_syncs;
+   u64                           stalls;
+
+   // Written by the IOP thread
+   alignas(64) std::atomic<u64>  cycles;
+   std::atomic<bool>             sleeping;
+   u64                           sleeps;
+
+   std::thread                   thread;
+} IOP_Sync;
+
+static IOP_Sync iop_sync;
+
+void  iop_thread_start(IOP_Sync_Mode mode, u32 slice);
+void  iop_thread_stop();
+u64   iop_ee_slice();
+void  iop_advance(u32 ee_cycles);
+void  iop_hard_sync();
+
+#endif
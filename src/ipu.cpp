@@ -9,11 +9,25 @@
 
 IPU ipu = {};
 
+static void ipu_fifo_write_64 (u32, u64) { ipu_fifo_write(); }
+
+static const MMIO_Handler ipu_mmio = {
+	.name 		= "IPU",
+	.read_32 	= ipu_read_32,
+	.read_64 	= ipu_read_64,
+	.write_32 	= ipu_write_32,
+	.write_64 	= ipu_write_64,
+};
+static const MMIO_Handler ipu_fifo_mmio = { .name = "IPU FIFO", .write_64 = ipu_fifo_write_64 };
+
 void
 ipu_reset() 
 {
 	memset(&ipu, 0, sizeof(ipu));
 	syslog("Resetting IPU \n");
+
+	ee_mmio_register(0x10002000, 0x40, &ipu_mmio);
+	ee_mmio_register(0x10007010, 16, 	&ipu_fifo_mmio);
 }
 
 void 
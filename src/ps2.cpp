@@ -18,12 +18,17 @@ ___________________________________________________________
 // #define function static
 
 #include <thread>
+#include <atomic>
+#include <mutex>
+#include <chrono>
 #include <typeinfo>
 #include <assert.h>
 #include <cmath>
+#include <bit>
 #include <fstream>
 #include <cstring>
 #include <queue>
+#include <array>
 
 #include "SDL2/include/SDL.h"
 #include "SDL2/include/SDL_timer.h"
@@ -53,13 +58,16 @@ ___________________________________________________________
 
 #include "ps2types.h"
 #include "common.h"
+#include "trace.h"
 #include "loader.h"
 #include "ps2.h"
+#include "scheduler.h"
 
 #include "ee/ee_inc.h"
 #include "iop/iop_inc.h"
 
 #include "bus.h"
+#include "vmem.h"
 #include "kernel.h"
 #include "gif.h"
 #include "sif.h"
@@ -72,7 +80,10 @@ ___________________________________________________________
 #include "debugtools/debug_graphics.h"
 
 
+#include "trace.cpp"
+#include "scheduler.cpp"
 #include "bus.cpp"
+#include "vmem.cpp"
 #include "kernel.cpp"
 #include "ee/ee_inc.cpp"
 #include "iop/iop_inc.cpp"
@@ -93,36 +104,14 @@ ___________________________________________________________
 alignas(16) R5900_Core ee = {};
 alignas(16) OpenGL opengl = {};
 
-u32
-check_interrupt (bool value, bool int0_priority, bool int1_priorirty)
+// INT0 comes from the INTC and INT1 from the DMAC, both stay raised for as long as their source is
+void
+ee_set_interrupt_line (u32 line, bool asserted)
 {
-   Exception e = get_exception(V_INTERRUPT, __INTERRUPT);
-   if (!value)
-      return 0;
-
-   //@@Note: Not sure what to do when they both assert interrupts
-   // Edge triggered interrupt
-   if (int0_priority) {
-      ee.cop0.status.IM_2         = 1;
-      ee.cop0.cause.int0_pending &= ~1;
-      ee.cop0.cause.int0_pending |= value;
-      printf("Asserting INT0 signal\n");
-   } else if (int1_priorirty) {
-      ee.cop0.status.IM_3         = true;
-      ee.cop0.cause.int1_pending  &= ~true;
-      ee.cop0.cause.int1_pending  |= ~true;
-      printf("Asserting INT1 signal\n");
-   }
+   if (line == EE_INTERRUPT_INT0) ee.cop0.cause.int0_pending = asserted;
+   else                           ee.cop0.cause.int1_pending = asserted;
 
-   bool interrupt_enable               = ee.cop0.status.IE && ee.cop0.status.EIE;
-   bool check_exception_error_level    = ee.cop0.status.ERL && ee.cop0.status.EXL;
-   interrupt_enable                    = interrupt_enable && !check_exception_error_level;
-
-   if (!interrupt_enable)
-      return 0;
-
-   handle_exception_level_1(&ee.cop0, &e, ee.pc, ee.is_branching);
-   return 1;
+   ee_update_interrupts(&ee);
 }
 
 // @Implementation: This would be eventually defined in the command line arguement
@@ -180,13 +169,45 @@ main (int argc, char **argv)
    // const char *bios_filename = "..\\Mikustation-2\\data\\bios\\scph10000.bin";
    const char *bios_filename = "..\\Mikustation-2\\data\\bios\\scph39001.bin";
 
+   bool use_vmem           = false;
+   bool use_gs_thread      = true;
+   bool use_trace_writer   = true;
+   u32 gs_raster_threads   = 0;
+   IOP_Sync_Mode iop_mode  = IOP_SYNC_THREADED;
+   u32 iop_slice           = IOP_DEFAULT_SLICE;
+   for (int i = 1; i < argc; ++i)
+   {
+      if (strcmp(argv[i], "--jit") == 0)         ee_execution_mode = EE_MODE_JIT;
+      if (strcmp(argv[i], "--cached") == 0)      ee_execution_mode = EE_MODE_CACHED_INTERPRETER;
+      if (strcmp(argv[i], "--interpreter") == 0) ee_execution_mode = EE_MODE_INTERPRETER;
+      if (strcmp(argv[i], "--vmem") == 0)        use_vmem = true;
+      if (strcmp(argv[i], "--no-gs-thread") == 0) use_gs_thread = false;
+      if (strcmp(argv[i], "--no-trace-writer") == 0) use_trace_writer = false;
+      if (strcmp(argv[i], "--gs-raster-threads") == 0 && i + 1 < argc) gs_raster_threads = (u32)strtoul(argv[++i], NULL, 0);
+      if (strcmp(argv[i], "--iop-interleave") == 0) iop_mode = IOP_SYNC_INTERLEAVED;
+      if (strcmp(argv[i], "--iop-interpreter") == 0) iop_execution_mode = IOP_MODE_INTERPRETER;
+      if (strcmp(argv[i], "--iop-slice") == 0 && i + 1 < argc) iop_slice = (u32)strtoul(argv[++i], NULL, 0);
+      if (strcmp(argv[i], "--no-idle-skip") == 0) ee_idle.enabled = false;
+      if (strcmp(argv[i], "--cop1-strict") == 0)  cop1_float_mode = COP1_FLOAT_STRICT;
+      if (strcmp(argv[i], "--cop1-benchmark") == 0)
+      {
+         cop1_benchmark();
+         return 0;
+      }
+      if (strcmp(argv[i], "--mmi-benchmark") == 0)
+      {
+         ee_mmi_init();
+         ee_mmi_benchmark();
+         return 0;
+      }
+   }
+
    SDL_Context     main_context = {};
    SDL_Event       event        = {};
    SDL_Window      *window      = NULL;
    SDL_Surface     *surface     = NULL;
    bool running                 = true;
    bool left_down               = false;
-   u32 instructions_run         = 0;
 
    const int window_w = 1280;
    const int window_h = 720;
@@ -240,34 +261,61 @@ main (int argc, char **argv)
    printf("===========================================================================\n");
 
    printf("\n=========================\nInitializing System\n=========================\n");
-   // @Incomplete: Create a Virtual Memmory map for the VM and map these mallocs to the virtual memory
-   _bios_memory_       = (u8 *)malloc(sizeof(u8) * MEGABYTES(4));
-   _rdram_             = (u8 *)malloc(sizeof(u8) * MEGABYTES(32));
-   _iop_ram_           = (u8 *)malloc(sizeof(u8) * MEGABYTES(2));
-   _vu0_code_memory_   = (u8 *)malloc(sizeof(u8) * KILOBYTES(4));
-   _vu0_data_memory_   = (u8 *)malloc(sizeof(u8) * KILOBYTES(4));
-   _vu1_code_memory_   = (u8 *)malloc(sizeof(u8) * KILOBYTES(16));
-   _vu1_data_memory_   = (u8 *)malloc(sizeof(u8) * KILOBYTES(16));
+   if (use_vmem && ee_vmem_init())
+   {
+      free(_scratchpad_);
+      _scratchpad_ = ee_vmem.scratchpad;
+   }
+   else
+   {
+      _bios_memory_       = (u8 *)malloc(sizeof(u8) * MEGABYTES(4));
+      _rdram_             = (u8 *)malloc(sizeof(u8) * MEGABYTES(32));
+      _iop_ram_           = (u8 *)malloc(sizeof(u8) * MEGABYTES(2));
+      _vu0_code_memory_   = (u8 *)malloc(sizeof(u8) * KILOBYTES(4));
+      _vu0_data_memory_   = (u8 *)malloc(sizeof(u8) * KILOBYTES(4));
+      _vu1_code_memory_   = (u8 *)malloc(sizeof(u8) * KILOBYTES(16));
+      _vu1_data_memory_   = (u8 *)malloc(sizeof(u8) * KILOBYTES(16));
+   }
+   ee_map_memory();
 
+   trace_start(use_trace_writer);
+   scheduler_reset();
    ee_reset(&ee);
+   ee_jit_init();
+   ee_cache_init();
+   ee_mmio_reset();
    dmac_reset();
    gs_reset();
+   gs_raster_start(gs_raster_threads);
+   gs_thread_start(use_gs_thread);
    // #if USE_HARDWARE
    // Hardware VRAM
    gl_init_vram(&opengl);
 // #endif
    gif_reset();
    intc_reset();
+   sif_reset();
    timer_reset();
    cop1_reset();
    ipu_reset();
    iop_reset();
    vu_reset();
    vif_reset();
+   iop_thread_start(iop_mode, iop_slice);
 
    if (read_bios(bios_filename, _bios_memory_) != 1) return 0;
    // load_elf(&ee, elf_filename);
 
+   // @Todo: When the backbuffer is resized the bb should retrieve
+   // the new screen w and h
+   SDL_Backbuffer backbuffer   = {};
+   backbuffer.w                = screen_w;
+   backbuffer.h                = screen_h;
+   backbuffer.pixel_format     = SDL_PIXELFORMAT_ARGB8888;
+   backbuffer.pitch            = screen_w * 4;
+   backbuffer.pixels           = (u32*)calloc(sizeof(u32), screen_w * screen_h);
+   main_context.backbuffer     = &backbuffer;
+
    // u64 begin_time = 0, end_time = 0, delta_time = 0;
    while (running) 
    {
@@ -303,78 +351,65 @@ main (int argc, char **argv)
 #endif
       }
 
-      // instructions_run = 0;
-      // @Todo: When the backbuffer is resized the bb should retrieve
-      // the new screen w and h
-      SDL_Backbuffer backbuffer   = {};
-      backbuffer.w                = screen_w;
-      backbuffer.h                = screen_h;
-      backbuffer.pixel_format     = SDL_PIXELFORMAT_ARGB8888;
-      backbuffer.pitch            = screen_w * 4;
-      backbuffer.pixels           = (u32*)calloc(sizeof(u32), screen_w * screen_h);
-      main_context.backbuffer     = &backbuffer;
-
       /*
-      *   @@Note: In dobiestation and chonkystation there is a random instruction limit in order to
-      *   synch the ee and iop cycle rate by 1/8 it looks like an arbitrary number.
+      *   @@Note: The guest runs a whole field at a time. The EE runs uninterrupted up to the next scheduled event
+      *   or the end of an IOP slice and the rest of the system catches up afterwards, until the GS reaches VBLANK.
+      *   The IOP gets its share after every slice, see iop_thread.h
       */
-      // while (instructions_run < 1000000) 
-      // {
-         // backbuffer.pixels           = (u32*)malloc(sizeof(u32) * (screen_w * screen_h));
-
-         /*
-         *   @Note: This is a performance critical loop so no branching should exist here however the dmac and the iop operate and
-         *   half and 1/8 the speed of the ee but since we're not emulating the iop and dmac sufficently we can just ignore these
-         *   until a scheduler is written and can be performed better
-         */
-         r5900_cycle(&ee);
-         if (instructions_run % 2 == 0) { dmac_cycle(); }
-         timer_tick();
-         // if (instructions_run % 8 == 0) { iop_cycle(); }
-         instructions_run++;
-
-         // if (intc_read(0x1000f010) & 0x4) 
-         // {
-         
-         gl_render_frame(&opengl, &ee);
-         gl_swap_framebuffers(main_context.window, &backbuffer);
-
-         if (instructions_run == 975000) 
-         {
-            // request_interrupt(INT_VB_ON);
-            gs_render_crt(&main_context);
-   #if USE_HARDWARE
-            // gl_render_frame(&opengl, &ee);
-            // gl_swap_framebuffers(main_context.window, &backbuffer);
-   #elif USE_SOFTWARE
-            swap_framebuffers(main_context.window, &backbuffer, main_context.surface);
-   #endif
-         }
+      while (!gs_frame_ready())
+      {
+         u32 slice    = (u32)std::min(scheduler_cycles_until_next_event(), iop_ee_slice());
+         u32 executed = r5900_run(&ee, slice);
+         scheduler_advance(executed);
+         iop_advance(executed);
+      }
 
-         if (instructions_run == 1000000)
-         {
-            instructions_run = 0;
-         }
-            // request_interrupt(INT_VB_OFF);
-      // }
-         free(backbuffer.pixels);
+      gs_render_crt(&main_context);
+
+      // Without the writer thread the trace rings are formatted once per frame
+      trace_flush();
+      if (!use_trace_writer) trace_drain();
+#if USE_SOFTWARE
+      swap_framebuffers(main_context.window, &backbuffer, main_context.surface);
+#endif
+
+      // @@Note: Renders the debugger and presents once per guest frame
+      gl_render_frame(&opengl, &ee);
+      gl_swap_framebuffers(main_context.window, &backbuffer);
    }
 
-   r5900_shutdown();
+   free(backbuffer.pixels);
+
+   ee_jit_shutdown();
+   ee_cache_shutdown();
+   iop_thread_stop();
+   iop_cache_shutdown();
+   gs_thread_stop();
+   gs_raster_stop();
    gs_shutdown();
+   trace_stop();
+   flush_console_line();
 
 #ifdef USE_HARDWARE
     shutdown_opengl(&opengl);
     imgui_shutdown();
 #endif
 
-   free(_bios_memory_);
-   free(_rdram_);
-   free(_iop_ram_);
-   free(_vu0_code_memory_);
-   free(_vu0_data_memory_);
-   free(_vu1_code_memory_);
-   free(_vu1_data_memory_);
+   if (ee_vmem.base)
+   {
+      ee_vmem_shutdown();
+   }
+   else
+   {
+      r5900_shutdown();
+      free(_bios_memory_);
+      free(_rdram_);
+      free(_iop_ram_);
+      free(_vu0_code_memory_);
+      free(_vu0_data_memory_);
+      free(_vu1_code_memory_);
+      free(_vu1_data_memory_);
+   }
 
    SDL_DestroyWindow(window);
    SDL_Quit();
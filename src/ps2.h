@@ -32,6 +32,6 @@ typedef struct _SDL_Context_ {
    bool            left_down;
 } SDL_Context;
 
-u32     check_interrupt (bool value, bool int0_priority, bool int1_priorirty);
+void    ee_set_interrupt_line (u32 line, bool asserted);
 
 #endif
\ No newline at end of file
@@ -34,16 +34,17 @@ typedef double f64;
 /*
 //@@Note: This was inspired by PCSX2 type system.
 */
+// @@Note: The halves are in memory order so a quadword can be copied straight from guest memory
 typedef union _u128_ {
    struct {
-      u64 hi;
       u64 lo;
+      u64 hi;
    };
 
    u64 _64[2];
    u32 _32[4];
    u16 _16[8];
-   u8  _8[12];
+   u8  _8[16];
    inline bool operator ==(_u128_ r)
    {
       return ( hi == r.hi || lo == r.lo );
@@ -0,0 +1,175 @@
+/*
+ * Copyright 2023 Xaviar Roach
+ * SPDX-License-Identifier: MIT
+ */
+
+/*******************************************
+ * Heap
+*******************************************/
+static inline bool
+heap_before (u32 a, u32 b)
+{
+   Scheduler_Event *event_a = &scheduler.events[a];
+   Scheduler_Event *event_b = &scheduler.events[b];
+
+   if (event_a->timestamp != event_b->timestamp) return event_a->timestamp < event_b->timestamp;
+   return event_a->order < event_b->order;
+}
+
+static inline void
+heap_set (u32 index, u32 event)
+{
+   scheduler.heap[index]               = event;
+   scheduler.events[event].heap_index  = (s32)index;
+}
+
+static void
+heap_sift_up (u32 index)
+{
+   u32 event = scheduler.heap[index];
+   while (index > 0)
+   {
+      u32 parent = (index - 1) / 2;
+      if (!heap_before(event, scheduler.heap[parent])) break;
+
+      heap_set(index, scheduler.heap[parent]);
+      index = parent;
+   }
+   heap_set(index, event);
+}
+
+static void
+heap_sift_down (u32 index)
+{
+   u32 event = scheduler.heap[index];
+   for (;;)
+   {
+      u32 child = index * 2 + 1;
+      if (child >= scheduler.heap_size) break;
+      if (child + 1 < scheduler.heap_size && heap_before(scheduler.heap[child + 1], scheduler.heap[child])) child++;
+      if (!heap_before(scheduler.heap[child], event)) break;
+
+      heap_set(index, scheduler.heap[child]);
+      index = child;
+   }
+   heap_set(index, event);
+}
+
+static void
+heap_remove (u32 index)
+{
+   u32 removed = scheduler.heap[index];
+   scheduler.heap_size--;
+
+   if (index != scheduler.heap_size)
+   {
+      heap_set(index, scheduler.heap[scheduler.heap_size]);
+      heap_sift_up(index);
+      heap_sift_down((u32)scheduler.events[scheduler.heap[index]].heap_index);
+   }
+
+   scheduler.events[removed].heap_index = -1;
+}
+
+/*******************************************
+ * Scheduler
+*******************************************/
+void
+scheduler_reset ()
+{
+   memset(&scheduler, 0, sizeof(scheduler));
+   printf("Resetting Scheduler\n");
+}
+
+// Registering the same callback again returns its handle so a subsystem can be reset on its own
+Event_Handle
+scheduler_register_event (const char *name, Scheduler_Callback callback)
+{
+   for (u32 i = 0; i < scheduler.event_count; ++i)
+   {
+      if (scheduler.events[i].callback == callback) return (Event_Handle)i;
+   }
+
+   if (scheduler.event_count == SCHEDULER_MAX_EVENTS)
+   {
+      errlog("[ERROR]: Could not register event {:s}, the scheduler is full\n", name);
+      return -1;
+   }
+
+   Event_Handle handle     = (Event_Handle)scheduler.event_count++;
+   Scheduler_Event *event  = &scheduler.events[handle];
+   event->name             = name;
+   event->callback         = callback;
+   event->heap_index       = -1;
+
+   return handle;
+}
+
+// Moves the event if it is already pending
+void
+scheduler_schedule (Event_Handle handle, u64 cycles_from_now, u64 param)
+{
+   if (handle < 0) return;
+
+   Scheduler_Event *event  = &scheduler.events[handle];
+   event->timestamp        = scheduler.cycles + cycles_from_now;
+   event->order            = scheduler.next_order++;
+   event->param            = param;
+
+   if (event->heap_index < 0)
+   {
+      scheduler.heap[scheduler.heap_size] = (u32)handle;
+      scheduler.heap_size++;
+      heap_sift_up(scheduler.heap_size - 1);
+   }
+   else
+   {
+      heap_sift_up((u32)event->heap_index);
+      heap_sift_down((u32)event->heap_index);
+   }
+}
+
+void
+scheduler_cancel (Event_Handle handle)
+{
+   if (handle < 0) return;
+
+   s32 index = scheduler.events[handle].heap_index;
+   if (index >= 0) heap_remove((u32)index);
+}
+
+bool
+scheduler_is_scheduled (Event_Handle handle)
+{
+   return handle >= 0 && scheduler.events[handle].heap_index >= 0;
+}
+
+u64
+scheduler_cycles_until_next_event ()
+{
+   if (scheduler.heap_size == 0) return SCHEDULER_MAX_SLICE;
+
+   u64 timestamp = scheduler.events[scheduler.heap[0]].timestamp;
+   if (timestamp <= scheduler.cycles) return 0;
+
+   u64 cycles = timestamp - scheduler.cycles;
+   return cycles < SCHEDULER_MAX_SLICE ? cycles : SCHEDULER_MAX_SLICE;
+}
+
+// Moves time forward and runs every event that became due, callbacks are free to schedule again
+void
+scheduler_advance (u64 cycles)
+{
+   scheduler.cycles += cycles;
+
+   while (scheduler.heap_size)
+   {
+      u32 handle              = scheduler.heap[0];
+      Scheduler_Event *event  = &scheduler.events[handle];
+      if (event->timestamp > scheduler.cycles) break;
+
+      heap_remove(0);
+      scheduler.events_dispatched++;
+      event->callback(event->param, scheduler.cycles - event->timestamp);
+   }
+}
@@ -0,0 +1,52 @@
+#ifndef SCHEDULER_H
+
+/*
+   Cycle based event scheduler.
+
+   Time is counted in EE cycles. Subsystems register their events once at reset and then schedule or
+   cancel them whenever their state changes, the EE runs uninterrupted until the next deadline and
+   everything that is due gets dispatched afterwards. Pending events are kept in a binary min-heap.
+*/
+
+#define SCHEDULER_MAX_EVENTS     32
+// @@Note: Upper bound for one EE slice so the host still gets to poll events when nothing is scheduled
+#define SCHEDULER_MAX_SLICE      KILOBYTES(16)
+
+// cycles_late is how far past its deadline the event ran since the EE only stops between blocks
+typedef void (*Scheduler_Callback)(u64 param, u64 cycles_late);
+typedef s32 Event_Handle;
+
+typedef struct _Scheduler_Event_ {
+   const char           *name;
+   Scheduler_Callback   callback;
+   u64                  timestamp;
+   u64                  order;      // Keeps events with the same timestamp in the order they were scheduled
+   u64                  param;
+   s32                  heap_index; // -1 while the event is not scheduled
+} Scheduler_Event;
+
+typedef struct _Scheduler_ {
+   u64 cycles;
+   u64 next_order;
+
+   Scheduler_Event events[SCHEDULER_MAX_EVENTS];
+   u32 event_count;
+
+   u32 heap[SCHEDULER_MAX_EVENTS];
+   u32 heap_size;
+
+   u64 events_dispatched;
+} Scheduler;
+
+static Scheduler scheduler = {};
+
+void           scheduler_reset();
+Event_Handle   scheduler_register_event(const char *name, Scheduler_Callback callback);
+void           scheduler_schedule(Event_Handle handle, u64 cycles_from_now, u64 param = 0);
+void           scheduler_cancel(Event_Handle handle);
+bool           scheduler_is_scheduled(Event_Handle handle);
+u64            scheduler_cycles_until_next_event();
+void           scheduler_advance(u64 cycles);
+
+#define SCHEDULER_H
+#endif
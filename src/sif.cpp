@@ -3,16 +3,23 @@
 
 Sif sif = {0};
 
+static const MMIO_Handler sif_mmio = { .name = "SIF", .read_32 = sif_read, .write_32 = sif_write };
+
 void 
 sif_reset()
 {
 	syslog("Resetting SIF\n");
 	memset(&sif, 0, sizeof(Sif));
+
+	ee_mmio_register(0x1000F200, 0x70, &sif_mmio);
 }
 
 void
 sif_write(u32 address, u32 value) 
 {
+	// The IOP reads these on its own thread, it has to be parked before they change
+	iop_hard_sync();
+
 	switch(address)
 	{
 		/*************
@@ -29,6 +36,11 @@ sif_write(u32 address, u32 value)
 			syslog("SIF_WRITE: MSFLG. Value [{:#08x}]\n", value);
 		break;
 
+		case 0x1000F230:
+			sif.smflg &= ~value;
+			syslog("SIF_WRITE: SMFLG. Value [{:#08x}]\n", value);
+		break;
+
 		case 0x1000F240: 
 			sif.ctrl = value;
 			syslog("SIF_WRITE: CTRL. Value [{:#08x}]\n", value);
@@ -43,7 +55,7 @@ sif_write(u32 address, u32 value)
 			IOP Base
 		*************/ 
 		default:
-			errlog("[ERROR]: Unrecognized address from sif_write [{:#08x}]\n", address);
+			errtrace("[ERROR]: Unrecognized address from sif_write [{:#08x}]\n", address);
 		break;
 	}
 
@@ -53,6 +65,8 @@ sif_write(u32 address, u32 value)
 u32 
 sif_read(u32 address) 
 {
+   iop_hard_sync();
+
    switch(address)
    {
       case 0x1000F200:
@@ -60,6 +74,11 @@ sif_read(u32 address)
    		return sif.mscom;
    	break; 
    	
+   	case 0x1000F210:
+   		syslog("SIF_READ: SMCOM\n");
+   		return sif.smcom;
+   	break;
+
    	case 0x1000F220: 
    		syslog("SIF_READ: MSFLG\n");
    		return sif.msflg;
@@ -71,8 +90,51 @@ sif_read(u32 address)
    	break;
 
    	default:
-   		errlog("[ERROR]: Unrecognized address from sif_write [{:#08x}]\n", address);
+   		errtrace("[ERROR]: Unrecognized address from sif_write [{:#08x}]\n", address);
    		return 0;
    	break;
    }
-}
\ No newline at end of file
+}
+
+/*************
+	IOP Base
+*************/
+// Only called from the IOP, the EE side never touches the registers while the IOP is running
+u32
+sif_iop_read(u32 address)
+{
+	switch(address)
+	{
+		case 0x1D000000: return sif.mscom;	break;
+		case 0x1D000010: return sif.smcom;	break;
+		case 0x1D000020: return sif.msflg;	break;
+		case 0x1D000030: return sif.smflg;	break;
+		case 0x1D000040: return sif.ctrl;	break;
+		case 0x1D000060: return sif.bd6;		break;
+
+		default:
+			errtrace("[ERROR]: Unrecognized address from sif_iop_read [{:#08x}]\n", address);
+			return 0;
+		break;
+	}
+}
+
+void
+sif_iop_write(u32 address, u32 value)
+{
+	switch(address)
+	{
+		case 0x1D000010:
+			sif.smcom = value;
+			syslog("IOP->EE Communication\n");
+		break;
+
+		case 0x1D000020: sif.msflg &= ~value;	break;
+		case 0x1D000030: sif.smflg |= value;	break;
+		case 0x1D000040: sif.ctrl = value;		break;
+
+		default:
+			errtrace("[ERROR]: Unrecognized address from sif_iop_write [{:#08x}]\n", address);
+		break;
+	}
+}
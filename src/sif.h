@@ -16,6 +16,9 @@ struct Sif {
 };
 
 
+void sif_reset();
 void sif_write(u32 address, u32 value);
 u32  sif_read(u32 address);
+u32  sif_iop_read(u32 address);
+void sif_iop_write(u32 address, u32 value);
 #endif
\ No newline at end of file
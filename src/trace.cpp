@@ -0,0 +1,120 @@
+/*
+ * Copyright 2023 Xaviar Roach
+ * SPDX-License-Identifier: MIT
+ */
+
+/*******************************************
+ * Producer Side
+*******************************************/
+// Hands the calling thread its own ring the first time it traces something, NULL once they ran out
+Trace_Ring *
+trace_register_thread ()
+{
+   u32 index = trace.ring_count.load();
+   while (index < TRACE_MAX_THREADS && !trace.ring_count.compare_exchange_weak(index, index + 1)) {}
+   if (index >= TRACE_MAX_THREADS) return NULL;
+
+   trace_local_ring = &trace.rings[index];
+   return trace_local_ring;
+}
+
+// Publishes the last event of the calling thread, it stops being collapsed into after this
+void
+trace_flush ()
+{
+   Trace_Ring *ring = trace_local_ring;
+   if (!ring || !ring->pending) return;
+
+   ring->pending = false;
+   ring->head.store(ring->head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+/*******************************************
+ * Formatting
+*******************************************/
+static void
+trace_print_record (Trace_Record *record)
+{
+   std::string text = fmt::format(fmt::runtime(record->format), record->args[0], record->args[1],
+                                  record->args[2], record->args[3]);
+
+   if (record->repeat > 1)
+   {
+      bool newline = !text.empty() && text.back() == '\n';
+      if (newline) text.pop_back();
+      text += fmt::format(" (repeated {:d} times)", record->repeat);
+      if (newline) text += '\n';
+   }
+
+   if (record->level == LOG_LEVEL_ERROR)
+      fmt::print(fg(fmt::color::crimson) | fmt::emphasis::bold, "{:s}", text);
+   else
+      fmt::print("{:s}", text);
+}
+
+// Formats everything that was published so far, safe to call from any thread
+void
+trace_drain ()
+{
+   std::lock_guard<std::mutex> lock(trace.drain_lock);
+
+   u32 count = std::min<u32>(trace.ring_count.load(), TRACE_MAX_THREADS);
+   for (u32 i = 0; i < count; ++i)
+   {
+      Trace_Ring *ring = &trace.rings[i];
+      u32 head = ring->head.load(std::memory_order_acquire);
+      u32 tail = ring->tail.load(std::memory_order_relaxed);
+
+      for (; tail != head; ++tail)
+         trace_print_record(&ring->records[tail & (TRACE_RING_SIZE - 1)]);
+
+      ring->tail.store(tail, std::memory_order_release);
+
+      u64 dropped = ring->dropped.exchange(0, std::memory_order_relaxed);
+      if (dropped)
+         errlog("[ERROR]: Trace ring {:d} was full, dropped {:d} events\n", i, dropped);
+   }
+
+   u64 ringless = trace.ringless_dropped.exchange(0, std::memory_order_relaxed);
+   if (ringless)
+      errlog("[ERROR]: Out of trace rings, dropped {:d} events\n", ringless);
+}
+
+/*******************************************
+ * Writer Thread
+*******************************************/
+static void
+trace_writer_main ()
+{
+   while (!trace.writer_exit.load())
+   {
+      trace_drain();
+      std::this_thread::sleep_for(std::chrono::milliseconds(TRACE_WRITER_PERIOD));
+   }
+}
+
+// Without the writer thread the records are only formatted when somebody calls trace_drain()
+void
+trace_start (bool threaded)
+{
+   trace.threaded = threaded;
+   trace.writer_exit.store(false);
+
+   if (threaded)
+      trace.writer = std::thread(trace_writer_main);
+}
+
+void
+trace_stop ()
+{
+   trace_flush();
+
+   if (trace.threaded)
+   {
+      trace.writer_exit.store(true);
+      trace.writer.join();
+      trace.threaded = false;
+   }
+
+   trace_drain();
+}
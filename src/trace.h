@@ -0,0 +1,134 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+/*
+   Trace Rings
+
+   errtrace() and systrace() are for logging on hot paths: unmapped accesses, unknown registers, per
+   primitive messages and so on. Nothing is formatted where the event happens, the call site only copies
+   the format string pointer and up to TRACE_MAX_ARGS integer arguments into a fixed size record in a ring
+   owned by the calling thread. The format string pointer doubles as the id of the event.
+
+   An event that is identical to the one before it (same format, same arguments) only bumps a counter, so
+   a guest hammering the same unmapped address shows up as a single line with a repeat count.
+
+   The records are formatted later, either by the trace writer thread or by calling trace_drain(). Each
+   ring has a single producer (the thread that owns it) and the drain is the only consumer, nobody takes
+   a lock on the producer side. When a ring is full new events are dropped and counted instead of
+   blocking the emulator. Every thread the emulator starts gets a ring of its own, if some thread still
+   comes after the last one its events are counted as dropped as well.
+
+   The last event of a thread stays in its ring unpublished until a different event comes along, so it
+   can still be collapsed into. Threads call trace_flush() at points where they go idle so it shows up.
+
+   Only integers and enums can be traced, anything else has to go through errlog()/syslog().
+*/
+
+#define TRACE_RING_SIZE       4096     // Records per thread, has to be a power of two
+#define TRACE_MAX_THREADS     72       // Main + IOP + GS and raster workers (GS_RASTER_MAX_THREADS) + spare
+#define TRACE_MAX_ARGS        4
+#define TRACE_WRITER_PERIOD   10       // Milliseconds between writer thread drains
+
+typedef struct _Trace_Record_ {
+   const char  *format;
+   u64         args[TRACE_MAX_ARGS];
+   u32         repeat;
+   u8          level;
+} Trace_Record;
+
+typedef struct _Trace_Ring_ {
+   // Owner thread side
+   alignas(64) std::atomic<u32>  head;
+   bool                          pending;       // records[head] holds an event that is not published yet
+   std::atomic<u64>              dropped;
+
+   // Drain side
+   alignas(64) std::atomic<u32>  tail;
+
+   alignas(64) Trace_Record      records[TRACE_RING_SIZE];
+} Trace_Ring;
+
+typedef struct _Trace_ {
+   Trace_Ring                    rings[TRACE_MAX_THREADS];
+   std::atomic<u32>              ring_count;
+   std::atomic<u64>              ringless_dropped;    // Events of threads that came after the last ring
+   std::mutex                    drain_lock;
+
+   std::thread                   writer;
+   std::atomic<bool>             writer_exit;
+   bool                          threaded;
+} Trace;
+
+static Trace trace;
+static thread_local Trace_Ring *trace_local_ring = NULL;
+
+Trace_Ring *   trace_register_thread();
+void           trace_flush();
+void           trace_drain();
+void           trace_start(bool threaded);
+void           trace_stop();
+
+template <typename T>
+static inline u64
+trace_arg (T value)
+{
+   static_assert(std::is_integral_v<T> || std::is_enum_v<T>, "Only integers and enums can be traced");
+   return (u64)value;
+}
+
+template <typename... Args>
+static inline void
+trace_record (u8 level, const char *format, Args... values)
+{
+   static_assert(sizeof...(Args) <= TRACE_MAX_ARGS, "Too many arguments for a trace record");
+
+   Trace_Ring *ring = trace_local_ring ? trace_local_ring : trace_register_thread();
+   if (!ring)
+   {
+      trace.ringless_dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+   }
+
+   u64 args[TRACE_MAX_ARGS] = { trace_arg(values)... };
+   u32 head = ring->head.load(std::memory_order_relaxed);
+
+   if (ring->pending)
+   {
+      Trace_Record *last = &ring->records[head & (TRACE_RING_SIZE - 1)];
+      if (last->format == format && memcmp(last->args, args, sizeof(args)) == 0)
+      {
+         last->repeat++;
+         return;
+      }
+
+      ring->head.store(++head, std::memory_order_release);
+      ring->pending = false;
+   }
+
+   if (head - ring->tail.load(std::memory_order_acquire) >= TRACE_RING_SIZE)
+   {
+      ring->dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+   }
+
+   Trace_Record *record = &ring->records[head & (TRACE_RING_SIZE - 1)];
+   record->format       = format;
+   record->repeat       = 1;
+   record->level        = level;
+   memcpy(record->args, args, sizeof(args));
+   ring->pending        = true;
+}
+
+#if MIKU_LOG_LEVEL >= LOG_LEVEL_ERROR
+   #define errtrace(...) trace_record(LOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+   #define errtrace(...) (void)0
+#endif
+
+#if MIKU_LOG_LEVEL >= LOG_LEVEL_SYSTEM
+   #define systrace(...) trace_record(LOG_LEVEL_SYSTEM, __VA_ARGS__)
+#else
+   #define systrace(...) (void)0
+#endif
+
+#endif
@@ -0,0 +1,156 @@
+#if EE_VMEM_SUPPORTED
+
+#include <sys/mman.h>
+#include <signal.h>
+#include <unistd.h>
+
+static struct sigaction vmem_previous_action;
+
+static void
+vmem_fault_handler (int, siginfo_t *info, void *context)
+{
+   u8 *address = (u8 *)info->si_addr;
+   if (address >= ee_vmem.base && address < ee_vmem.base + EE_VMEM_SIZE)
+   {
+      if (ee_jit_handle_fault(context))
+      {
+         ee_vmem.faults++;
+         return;
+      }
+   }
+
+   // Not one of ours, let the fault through so it still crashes where it happened
+   sigaction(SIGSEGV, &vmem_previous_action, NULL);
+}
+
+static bool
+vmem_map (u32 address, u32 offset, u32 size, bool writable)
+{
+   int protection = writable ? (PROT_READ | PROT_WRITE) : PROT_READ;
+   void *view     = mmap(ee_vmem.base + address, size, protection, MAP_SHARED | MAP_FIXED, ee_vmem.fd, offset);
+
+   return view != MAP_FAILED;
+}
+
+/*
+   Mirrors the layout ee_map_memory() builds for the page tables, every 512MB segment sees the same
+   physical memory. MMIO and unused ranges stay PROT_NONE.
+*/
+static bool
+vmem_map_address_space ()
+{
+   bool mapped = true;
+
+   for (u32 segment = 0; segment < 8; ++segment)
+   {
+      u32 base = segment << 29;
+      for (u32 mirror = 0; mirror < 8; ++mirror)
+         mapped &= vmem_map(base + mirror * MEGABYTES(32), EE_VMEM_RDRAM_OFFSET, MEGABYTES(32), true);
+
+      mapped &= vmem_map(base + BIOS.start,            EE_VMEM_BIOS_OFFSET,     BIOS.size,            false);
+      mapped &= vmem_map(base + IOP_RAM.start,         EE_VMEM_IOP_RAM_OFFSET,  IOP_RAM.size,         true);
+      mapped &= vmem_map(base + VU0_CODE_MEMORY.start, EE_VMEM_VU0_CODE_OFFSET, VU0_CODE_MEMORY.size, true);
+      mapped &= vmem_map(base + VU0_DATA_MEMORY.start, EE_VMEM_VU0_DATA_OFFSET, VU0_DATA_MEMORY.size, true);
+      mapped &= vmem_map(base + VU1_CODE_MEMORY.start, EE_VMEM_VU1_CODE_OFFSET, VU1_CODE_MEMORY.size, true);
+      mapped &= vmem_map(base + VU1_DATA_MEMORY.start, EE_VMEM_VU1_DATA_OFFSET, VU1_DATA_MEMORY.size, true);
+   }
+
+   // uncached and accelerated ram
+   mapped &= vmem_map(0x30100000, EE_VMEM_RDRAM_OFFSET + 0x100000, MEGABYTES(31), true);
+   mapped &= vmem_map(0x70000000, EE_VMEM_SCRATCHPAD_OFFSET, KILOBYTES(16), true);
+
+   return mapped;
+}
+
+/*
+   Reserves the guest address space and points _rdram_, _bios_memory_, _iop_ram_ and the VU memories
+   into the backing memfd. Returns false when anything fails, the caller then falls back to malloc.
+*/
+bool
+ee_vmem_init ()
+{
+   ee_vmem.fd = memfd_create("mikustation2", 0);
+   if (ee_vmem.fd < 0 || ftruncate(ee_vmem.fd, EE_VMEM_BACKING_SIZE) != 0)
+   {
+      errlog("[ERROR]: Could not create the EE memory backing file\n");
+      ee_vmem_shutdown();
+      return false;
+   }
+
+   void *base     = mmap(NULL, EE_VMEM_SIZE, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+   void *memory   = mmap(NULL, EE_VMEM_BACKING_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, ee_vmem.fd, 0);
+   ee_vmem.base   = (base == MAP_FAILED) ? NULL : (u8 *)base;
+   ee_vmem.memory = (memory == MAP_FAILED) ? NULL : (u8 *)memory;
+
+   if (!ee_vmem.base || !ee_vmem.memory || !vmem_map_address_space())
+   {
+      errlog("[ERROR]: Could not reserve the EE address space\n");
+      ee_vmem_shutdown();
+      return false;
+   }
+
+   struct sigaction action = {};
+   action.sa_sigaction = vmem_fault_handler;
+   action.sa_flags     = SA_SIGINFO;
+   sigemptyset(&action.sa_mask);
+   sigaction(SIGSEGV, &action, &vmem_previous_action);
+
+   _rdram_             = ee_vmem.memory + EE_VMEM_RDRAM_OFFSET;
+   _bios_memory_       = ee_vmem.memory + EE_VMEM_BIOS_OFFSET;
+   _iop_ram_           = ee_vmem.memory + EE_VMEM_IOP_RAM_OFFSET;
+   _vu0_code_memory_   = ee_vmem.memory + EE_VMEM_VU0_CODE_OFFSET;
+   _vu0_data_memory_   = ee_vmem.memory + EE_VMEM_VU0_DATA_OFFSET;
+   _vu1_code_memory_   = ee_vmem.memory + EE_VMEM_VU1_CODE_OFFSET;
+   _vu1_data_memory_   = ee_vmem.memory + EE_VMEM_VU1_DATA_OFFSET;
+   ee_vmem.scratchpad  = ee_vmem.memory + EE_VMEM_SCRATCHPAD_OFFSET;
+
+   printf("EE VMem: Reserved 4 GB of address space at [%p]\n", ee_vmem.base);
+   return true;
+}
+
+/*
+   Points guest pages at host memory for the TLB. Only memory inside the backing memfd can be viewed
+   through the address space, anything else is left PROT_NONE and faults into the ee_load_* handlers.
+*/
+void
+ee_vmem_map_host (u32 address, u8 *memory, u32 size)
+{
+   if (!ee_vmem.base) return;
+
+   if (memory >= ee_vmem.memory && memory < ee_vmem.memory + EE_VMEM_BACKING_SIZE)
+   {
+      u32 offset    = (u32)(memory - ee_vmem.memory);
+      bool writable = offset < EE_VMEM_BIOS_OFFSET || offset >= EE_VMEM_IOP_RAM_OFFSET;
+      if (vmem_map(address, offset, size, writable)) return;
+   }
+   else
+   {
+      void *view = mmap(ee_vmem.base + address, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED | MAP_NORESERVE, -1, 0);
+      if (view != MAP_FAILED) return;
+   }
+
+   errlog("[ERROR]: Could not map the EE page [{:#09x}] into the address space\n", address);
+}
+
+void
+ee_vmem_shutdown ()
+{
+   if (ee_vmem.base)
+   {
+      sigaction(SIGSEGV, &vmem_previous_action, NULL);
+      munmap(ee_vmem.base, EE_VMEM_SIZE);
+   }
+
+   if (ee_vmem.memory) munmap(ee_vmem.memory, EE_VMEM_BACKING_SIZE);
+   if (ee_vmem.fd > 0) close(ee_vmem.fd);
+
+   ee_vmem = {};
+}
+
+#else
+
+bool ee_vmem_init() { return false; }
+void ee_vmem_shutdown() {}
+void ee_vmem_map_host(u32, u8 *, u32) {}
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef VMEM_H
+
+/*
+   Host virtual memory backed EE address space.
+
+   One 4GB host region is reserved and every page of the EE virtual address space that is backed by
+   memory gets mapped into it from a single memfd, so RDRAM mirrors and segments are aliased views
+   of the same pages. A guest access is then base + address. Pages that are left unmapped fault, and
+   the SIGSEGV handler routes faulting loads from translated code to the ee_load_* handlers. The JIT
+   then translates that load as a call into the interpreter, so MMIO only faults once per load site.
+*/
+
+#if defined(__linux__) && (defined(__x86_64__) || defined(_M_X64))
+#define EE_VMEM_SUPPORTED 1
+#else
+#define EE_VMEM_SUPPORTED 0
+#endif
+
+#define EE_VMEM_SIZE                (1ull << 32)
+
+// Offsets of each memory inside the backing memfd
+#define EE_VMEM_RDRAM_OFFSET        0
+#define EE_VMEM_BIOS_OFFSET         (EE_VMEM_RDRAM_OFFSET     + MEGABYTES(32))
+#define EE_VMEM_IOP_RAM_OFFSET      (EE_VMEM_BIOS_OFFSET      + MEGABYTES(4))
+#define EE_VMEM_VU0_CODE_OFFSET     (EE_VMEM_IOP_RAM_OFFSET   + MEGABYTES(2))
+#define EE_VMEM_VU0_DATA_OFFSET     (EE_VMEM_VU0_CODE_OFFSET  + KILOBYTES(4))
+#define EE_VMEM_VU1_CODE_OFFSET     (EE_VMEM_VU0_DATA_OFFSET  + KILOBYTES(4))
+#define EE_VMEM_VU1_DATA_OFFSET     (EE_VMEM_VU1_CODE_OFFSET  + KILOBYTES(16))
+#define EE_VMEM_SCRATCHPAD_OFFSET   (EE_VMEM_VU1_DATA_OFFSET  + KILOBYTES(16))
+#define EE_VMEM_BACKING_SIZE        (EE_VMEM_SCRATCHPAD_OFFSET + KILOBYTES(16))
+
+typedef struct _EE_VMem_ {
+   u8  *base;        // 4GB view of the guest virtual address space
+   u8  *memory;      // Linear view of the backing memfd, this is what _rdram_ and friends point into
+   u8  *scratchpad;
+   int fd;
+
+   u64 faults;
+} EE_VMem;
+
+static EE_VMem ee_vmem = {};
+
+bool  ee_vmem_init();
+void  ee_vmem_shutdown();
+void  ee_vmem_map_host(u32 address, u8 *memory, u32 size);
+
+#define VMEM_H
+#endif